@@ -28,15 +28,18 @@
 #include <utility>
 #include <vector>
 
+#include "diagnostic_updater/diagnostic_updater.hpp"
 #include "geometry_msgs/msg/pose_stamped.hpp"
 #include "message_filters/subscriber.h"
 #include "nav2_util/lifecycle_node.hpp"
 #include "nav2_amcl/motion_model/motion_model.hpp"
 #include "nav2_amcl/sensors/laser/laser.hpp"
+#include "nav2_amcl/sensors/point_cloud/point_cloud_projector.hpp"
 #include "nav2_msgs/msg/particle.hpp"
 #include "nav2_msgs/msg/particle_cloud.hpp"
 #include "nav_msgs/srv/set_map.hpp"
 #include "sensor_msgs/msg/laser_scan.hpp"
+#include "sensor_msgs/msg/point_cloud2.hpp"
 #include "std_srvs/srv/empty.hpp"
 #include "tf2_ros/transform_broadcaster.h"
 #include "tf2_ros/transform_listener.h"
@@ -130,10 +133,23 @@ protected:
    * @param msg Map message
    */
   void handleMapMessage(const nav_msgs::msg::OccupancyGrid & msg);
+  /*
+   * @brief Apply a map with the same geometry as the current one in place, updating only
+   * the likelihood field and free cells around the changed cells
+   * @param msg Map message
+   * @return false if the geometry differs and the map must be rebuilt from scratch
+   */
+  bool updateMapInPlace(const nav_msgs::msg::OccupancyGrid & msg);
   /*
    * @brief Creates lookup table of free cells in map
    */
   void createFreeSpaceVector();
+  /*
+   * @brief Rebuild the part of the free cell lookup table for a range of map columns
+   * @param min_i First column to rebuild
+   * @param max_i Last column to rebuild
+   */
+  void updateFreeSpaceVector(int min_i, int max_i);
   /*
    * @brief Frees allocated map related memory
    */
@@ -175,6 +191,11 @@ protected:
     rclcpp_lifecycle::LifecycleNode>> laser_scan_sub_;
   std::unique_ptr<tf2_ros::MessageFilter<sensor_msgs::msg::LaserScan>> laser_scan_filter_;
   message_filters::Connection laser_scan_connection_;
+  std::unique_ptr<message_filters::Subscriber<sensor_msgs::msg::PointCloud2,
+    rclcpp_lifecycle::LifecycleNode>> point_cloud_sub_;
+  std::unique_ptr<tf2_ros::MessageFilter<sensor_msgs::msg::PointCloud2>> point_cloud_filter_;
+  message_filters::Connection point_cloud_connection_;
+  std::unique_ptr<PointCloudProjector> point_cloud_projector_;
 
   // Publishers and subscribers
   /*
@@ -187,6 +208,9 @@ protected:
     pose_pub_;
   rclcpp_lifecycle::LifecyclePublisher<nav2_msgs::msg::ParticleCloud>::SharedPtr
     particle_cloud_pub_;
+  rclcpp_lifecycle::LifecyclePublisher<sensor_msgs::msg::PointCloud2>::SharedPtr
+    particle_cloud_2d_pub_;
+  rclcpp::Time last_particle_cloud_publish_time_;
   /*
    * @brief Handle with an initial pose estimate is received
    */
@@ -195,6 +219,10 @@ protected:
    * @brief Handle when a laser scan is received
    */
   void laserReceived(sensor_msgs::msg::LaserScan::ConstSharedPtr laser_scan);
+  /*
+   * @brief Handle when a point cloud is received, projecting it into a virtual laser scan
+   */
+  void pointCloudReceived(sensor_msgs::msg::PointCloud2::ConstSharedPtr point_cloud);
 
   // Services and service callbacks
   /*
@@ -259,6 +287,34 @@ protected:
   pf_vector_t pf_odom_pose_;
   int resample_count_{0};
 
+  // Adaptive pose tracking
+  /*
+   * @brief Update the tracking confidence from the weights of the last sensor update
+   * @return Whether tracking was lost and the filter must be resampled right away
+   */
+  bool updateTrackingState();
+  /*
+   * @brief Switch the particle filter between the tracking and the configured sample bounds
+   * @param tracking Whether to use the reduced tracking bounds
+   */
+  void setTrackingMode(bool tracking);
+  /*
+   * @brief Create the updater publishing the adaptive tracking diagnostics, if not yet created
+   */
+  void createDiagnosticsUpdater();
+  /*
+   * @brief Report the adaptive tracking state as diagnostics
+   */
+  void trackingDiagnostic(diagnostic_updater::DiagnosticStatusWrapper & stat);
+  std::unique_ptr<diagnostic_updater::Updater> diagnostics_updater_;
+  // Creates the updater when adaptive tracking is enabled at runtime
+  rclcpp::TimerBase::SharedPtr diagnostics_timer_;
+  bool tracking_{false};
+  double tracking_ess_ratio_{0.0};
+  double likelihood_avg_{0.0};
+  unsigned int skipped_updates_{0};
+  unsigned int tracking_losses_{0};
+
   // Laser scan related
   /*
    * @brief Initialize laser scan
@@ -299,7 +355,8 @@ protected:
     const sensor_msgs::msg::LaserScan::ConstSharedPtr & laser_scan,
     const pf_vector_t & pose);
   /*
-   * @brief Publish particle cloud
+   * @brief Publish particle cloud, as full poses and as compact (x, y, yaw, weight) floats,
+   * to whichever of the two topics has subscribers, at most at particle_cloud_publish_rate
    */
   void publishParticleCloud(const pf_sample_set_t * set);
   /*
@@ -366,6 +423,12 @@ protected:
   double pf_z_;
   double alpha_fast_;
   double alpha_slow_;
+  bool adaptive_tracking_;
+  int tracking_max_particles_;
+  double tracking_min_ess_ratio_;
+  double tracking_surprise_ratio_;
+  double tracking_update_scale_;
+  double particle_cloud_publish_rate_;
   int resample_interval_;
   std::string robot_model_type_;
   tf2::Duration save_pose_period_;
@@ -379,6 +442,13 @@ protected:
   double z_short_;
   double z_rand_;
   std::string scan_topic_{"scan"};
+  bool use_point_cloud_;
+  std::string point_cloud_topic_{"points"};
+  double point_cloud_min_height_;
+  double point_cloud_max_height_;
+  double point_cloud_angle_increment_;
+  double point_cloud_range_min_;
+  double point_cloud_range_max_;
   std::string map_topic_{"map"};
 };
 
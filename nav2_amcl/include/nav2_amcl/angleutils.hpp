@@ -41,6 +41,13 @@ public:
    */
   static double normalize(double z);
 
+  /*
+   * @brief Normalize angles without trigonometric calls, for hot loops
+   * @brief z Angle to normalize
+   * @return angle in [-pi, pi)
+   */
+  static double wrap(double z);
+
   /*
    * @brief Find minimum distance between 2 angles
    * @brief a Angle 1
@@ -56,6 +63,12 @@ angleutils::normalize(double z)
   return atan2(sin(z), cos(z));
 }
 
+inline double
+angleutils::wrap(double z)
+{
+  return z - 2 * M_PI * floor((z + M_PI) / (2 * M_PI));
+}
+
 inline double
 angleutils::angle_diff(double a, double b)
 {
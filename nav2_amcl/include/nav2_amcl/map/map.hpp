@@ -90,6 +90,10 @@ void map_free(map_t * map);
 // Update the cspace distances
 void map_update_cspace(map_t * map, double max_occ_dist);
 
+// Update the cspace distances affected by occupancy changes within the given
+// (inclusive) cell bounds, keeping the current max_occ_dist
+void map_update_cspace_region(map_t * map, int min_i, int min_j, int max_i, int max_j);
+
 
 /**************************************************************************
  * Range functions
@@ -25,7 +25,9 @@
 #include <sys/types.h>
 #include <math.h>
 #include <algorithm>
+#include <vector>
 #include "nav2_amcl/motion_model/motion_model.hpp"
+#include "nav2_amcl/motion_model/gaussian_noise.hpp"
 #include "nav2_amcl/angleutils.hpp"
 
 
@@ -42,6 +44,8 @@ public:
 
 private:
   double alpha1_, alpha2_, alpha3_, alpha4_, alpha5_;
+  GaussianNoise noise_generator_;
+  std::vector<double> noise_;
 };
 }  // namespace nav2_amcl
 #endif  // NAV2_AMCL__MOTION_MODEL__DIFFERENTIAL_MOTION_MODEL_HPP_
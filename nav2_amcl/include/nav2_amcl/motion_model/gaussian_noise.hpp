@@ -0,0 +1,79 @@
+/*
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef NAV2_AMCL__MOTION_MODEL__GAUSSIAN_NOISE_HPP_
+#define NAV2_AMCL__MOTION_MODEL__GAUSSIAN_NOISE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nav2_amcl
+{
+
+/*
+ * @class GaussianNoise
+ * @brief Batched standard normal sampler for the motion models. Draws whole buffers at once
+ * with a xoshiro256+ generator and the trigonometric Box-Muller transform, which avoids the
+ * per-sample rejection loop and drand48() calls of pf_ran_gaussian()
+ */
+class GaussianNoise
+{
+public:
+  /*
+   * @brief GaussianNoise constructor, seeded from the current time like the particle filter
+   */
+  GaussianNoise();
+
+  /*
+   * @brief GaussianNoise constructor
+   * @param seed Seed to make the generated sequence reproducible
+   */
+  explicit GaussianNoise(uint64_t seed);
+
+  /*
+   * @brief Reseed the generator
+   * @param seed Seed to make the generated sequence reproducible
+   */
+  void seed(uint64_t seed);
+
+  /*
+   * @brief Fill a buffer with zero-mean, unit variance samples
+   * @param out Buffer to fill
+   * @param n Number of samples to draw
+   */
+  void fill(double * out, size_t n);
+
+  /*
+   * @brief Resize a buffer to n samples and fill it
+   * @param out Buffer to fill, only reallocated when it grows
+   * @param n Number of samples to draw
+   */
+  void fill(std::vector<double> & out, size_t n);
+
+private:
+  /*
+   * @brief Next 64 random bits
+   */
+  inline uint64_t next();
+
+  uint64_t state_[4];
+};
+
+}  // namespace nav2_amcl
+
+#endif  // NAV2_AMCL__MOTION_MODEL__GAUSSIAN_NOISE_HPP_
@@ -124,6 +124,9 @@ typedef struct _pf_t
   // Running averages, slow and fast, of likelihood
   double w_slow, w_fast;
 
+  // Average likelihood of the samples at the last sensor update
+  double w_avg;
+
   // Decay rates for running averages
   double alpha_slow, alpha_fast;
 
@@ -0,0 +1,70 @@
+/*
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef NAV2_AMCL__SENSORS__POINT_CLOUD__POINT_CLOUD_PROJECTOR_HPP_
+#define NAV2_AMCL__SENSORS__POINT_CLOUD__POINT_CLOUD_PROJECTOR_HPP_
+
+#include "sensor_msgs/msg/laser_scan.hpp"
+#include "sensor_msgs/msg/point_cloud2.hpp"
+
+namespace nav2_amcl
+{
+
+/*
+ * @class PointCloudProjector
+ * @brief Projects a height band of a 3D point cloud into a virtual 2D laser scan,
+ * so multi-layer lidars can feed the laser sensor models without an external
+ * pointcloud_to_laserscan hop
+ */
+class PointCloudProjector
+{
+public:
+  /*
+   * @brief PointCloudProjector constructor
+   * @param min_height Lowest point height kept, in the cloud's frame
+   * @param max_height Highest point height kept, in the cloud's frame
+   * @param angle_min Start angle of the virtual scan
+   * @param angle_max End angle of the virtual scan
+   * @param angle_increment Angular width of a virtual scan bin
+   * @param range_min Points closer than this are discarded
+   * @param range_max Points farther than this are discarded, and empty bins report it
+   */
+  PointCloudProjector(
+    double min_height, double max_height,
+    double angle_min, double angle_max, double angle_increment,
+    double range_min, double range_max);
+
+  /*
+   * @brief Project a point cloud into the virtual scan
+   * @param cloud Point cloud with float32 x, y and z fields
+   * @return Virtual scan in the cloud's frame. The scan buffer is owned by the projector
+   * and reused by the next call, so it must not be retained past the caller's update
+   */
+  sensor_msgs::msg::LaserScan::ConstSharedPtr project(const sensor_msgs::msg::PointCloud2 & cloud);
+
+protected:
+  double min_height_;
+  double max_height_;
+  double range_min_sq_;
+  double range_max_sq_;
+  // Preallocated virtual scan, whose ranges act as the angular binning buffer
+  sensor_msgs::msg::LaserScan::SharedPtr scan_;
+};
+
+}  // namespace nav2_amcl
+
+#endif  // NAV2_AMCL__SENSORS__POINT_CLOUD__POINT_CLOUD_PROJECTOR_HPP_
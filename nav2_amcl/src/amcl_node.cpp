@@ -34,6 +34,7 @@
 #include "nav2_amcl/pf/pf.hpp"
 #include "nav2_util/string_utils.hpp"
 #include "nav2_amcl/sensors/laser/laser.hpp"
+#include "sensor_msgs/point_cloud2_iterator.hpp"
 #include "tf2/convert.h"
 #include "tf2_geometry_msgs/tf2_geometry_msgs.hpp"
 #include "tf2/LinearMath/Transform.h"
@@ -83,6 +84,29 @@ AmclNode::AmclNode(const rclcpp::NodeOptions & options)
     "alpha5", rclcpp::ParameterValue(0.2),
     "This is the alpha5 parameter", "These are additional constraints for alpha5");
 
+  add_parameter(
+    "adaptive_tracking", rclcpp::ParameterValue(false),
+    "Shrink the particle set and skip low-value updates while localization is confident",
+    "Reverts to the configured particle bounds as soon as the scans stop matching");
+
+  add_parameter(
+    "tracking_max_particles", rclcpp::ParameterValue(100),
+    "Maximum allowed number of particles while confidently tracking");
+
+  add_parameter(
+    "tracking_min_ess_ratio", rclcpp::ParameterValue(0.5),
+    "Minimum effective sample size, as a fraction of the particle count, to consider "
+    "tracking confident");
+
+  add_parameter(
+    "tracking_surprise_ratio", rclcpp::ParameterValue(0.5),
+    "Tracking is lost when the average scan likelihood drops below this fraction of its "
+    "running average");
+
+  add_parameter(
+    "tracking_update_scale", rclcpp::ParameterValue(2.0),
+    "Scale applied to update_min_d and update_min_a while confidently tracking");
+
   add_parameter(
     "base_frame_id", rclcpp::ParameterValue(std::string("base_footprint")),
     "Which frame to use for the robot base");
@@ -171,6 +195,11 @@ AmclNode::AmclNode(const rclcpp::NodeOptions & options)
     "by adding random poses",
     "A good value might be 0.001");
 
+  add_parameter(
+    "particle_cloud_publish_rate", rclcpp::ParameterValue(0.0),
+    "Maximum rate (Hz) at which the particle cloud is published",
+    "0.0 to publish after every filter update");
+
   add_parameter(
     "resample_interval", rclcpp::ParameterValue(1),
     "Number of filter updates required before resampling");
@@ -219,6 +248,34 @@ AmclNode::AmclNode(const rclcpp::NodeOptions & options)
     "scan_topic", rclcpp::ParameterValue("scan"),
     "Topic to subscribe to in order to receive the laser scan for localization");
 
+  add_parameter(
+    "use_point_cloud", rclcpp::ParameterValue(false),
+    "Also localize against a PointCloud2 topic, projected into a virtual laser scan");
+
+  add_parameter(
+    "point_cloud_topic", rclcpp::ParameterValue("points"),
+    "Topic to subscribe to in order to receive the point cloud for localization");
+
+  add_parameter(
+    "point_cloud_min_height", rclcpp::ParameterValue(-0.1),
+    "Lowest point height, in the point cloud's frame, projected into the virtual scan");
+
+  add_parameter(
+    "point_cloud_max_height", rclcpp::ParameterValue(0.1),
+    "Highest point height, in the point cloud's frame, projected into the virtual scan");
+
+  add_parameter(
+    "point_cloud_angle_increment", rclcpp::ParameterValue(M_PI / 360.0),
+    "Angular resolution of the virtual scan built from the point cloud");
+
+  add_parameter(
+    "point_cloud_range_min", rclcpp::ParameterValue(0.0),
+    "Points closer than this to the point cloud's origin are discarded");
+
+  add_parameter(
+    "point_cloud_range_max", rclcpp::ParameterValue(100.0),
+    "Points farther than this from the point cloud's origin are discarded");
+
   add_parameter(
     "map_topic", rclcpp::ParameterValue("map"),
     "Topic to subscribe to in order to receive the map to localize on");
@@ -249,6 +306,10 @@ AmclNode::on_configure(const rclcpp_lifecycle::State & /*state*/)
   executor_ = std::make_shared<rclcpp::executors::SingleThreadedExecutor>();
   executor_->add_callback_group(callback_group_, get_node_base_interface());
   executor_thread_ = std::make_unique<nav2_util::NodeThread>(executor_);
+
+  if (adaptive_tracking_) {
+    createDiagnosticsUpdater();
+  }
   return nav2_util::CallbackReturn::SUCCESS;
 }
 
@@ -260,6 +321,7 @@ AmclNode::on_activate(const rclcpp_lifecycle::State & /*state*/)
   // Lifecycle publishers must be explicitly activated
   pose_pub_->on_activate();
   particle_cloud_pub_->on_activate();
+  particle_cloud_2d_pub_->on_activate();
 
   first_pose_sent_ = false;
 
@@ -305,6 +367,7 @@ AmclNode::on_deactivate(const rclcpp_lifecycle::State & /*state*/)
   // Lifecycle publishers must be explicitly deactivated
   pose_pub_->on_deactivate();
   particle_cloud_pub_->on_deactivate();
+  particle_cloud_2d_pub_->on_deactivate();
 
   // reset dynamic parameter handler
   dyn_params_handler_.reset();
@@ -330,6 +393,10 @@ AmclNode::on_cleanup(const rclcpp_lifecycle::State & /*state*/)
   laser_scan_connection_.disconnect();
   laser_scan_filter_.reset();
   laser_scan_sub_.reset();
+  point_cloud_connection_.disconnect();
+  point_cloud_filter_.reset();
+  point_cloud_sub_.reset();
+  point_cloud_projector_.reset();
 
   // Map
   if (map_ != NULL) {
@@ -347,10 +414,13 @@ AmclNode::on_cleanup(const rclcpp_lifecycle::State & /*state*/)
   // PubSub
   pose_pub_.reset();
   particle_cloud_pub_.reset();
+  particle_cloud_2d_pub_.reset();
 
   // Odometry
   motion_model_.reset();
 
+  diagnostics_timer_.reset();
+
   // Particle Filter
   pf_free(pf_);
   pf_ = nullptr;
@@ -485,6 +555,8 @@ AmclNode::globalLocalizationCallback(
 
   RCLCPP_INFO(get_logger(), "Initializing with uniform distribution");
 
+  setTrackingMode(false);
+  likelihood_avg_ = 0.0;
   pf_init_model(
     pf_, (pf_init_model_fn_t)AmclNode::uniformPoseGenerator,
     reinterpret_cast<void *>(map_));
@@ -598,6 +670,9 @@ AmclNode::handleInitialPose(geometry_msgs::msg::PoseWithCovarianceStamped & msg)
 
   pf_init_pose_cov.m[2][2] = msg.pose.covariance[6 * 5 + 5];
 
+  // The likelihoods of the previous estimate say nothing about the new one
+  setTrackingMode(false);
+  likelihood_avg_ = 0.0;
   pf_init(pf_, pf_init_pose_mean, pf_init_pose_cov);
   pf_init_ = false;
   init_pose_received_on_inactive = false;
@@ -677,8 +752,11 @@ AmclNode::laserReceived(sensor_msgs::msg::LaserScan::ConstSharedPtr laser_scan)
   if (lasers_update_[laser_index]) {
     updateFilter(laser_index, laser_scan, pose);
 
+    // Losing track re-expands the particle set, which only happens on resampling
+    const bool tracking_lost = adaptive_tracking_ && updateTrackingState();
+
     // Resample the particles
-    if (!(++resample_count_ % resample_interval_)) {
+    if (!(++resample_count_ % resample_interval_) || tracking_lost) {
       pf_update_resample(pf_, reinterpret_cast<void *>(map_));
       resampled = true;
     }
@@ -720,6 +798,18 @@ AmclNode::laserReceived(sensor_msgs::msg::LaserScan::ConstSharedPtr laser_scan)
   }
 }
 
+void
+AmclNode::pointCloudReceived(sensor_msgs::msg::PointCloud2::ConstSharedPtr point_cloud)
+{
+  std::lock_guard<std::recursive_mutex> cfl(mutex_);
+
+  // Don't spend time projecting clouds that laserReceived() would drop anyway
+  if (!active_ || !first_map_received_) {return;}
+
+  // The projected scan lives in the cloud's frame and is handled exactly as a real one
+  laserReceived(point_cloud_projector_->project(*point_cloud));
+}
+
 bool AmclNode::addNewScanner(
   int & laser_index,
   const sensor_msgs::msg::LaserScan::ConstSharedPtr & laser_scan,
@@ -765,10 +855,112 @@ bool AmclNode::shouldUpdateFilter(const pf_vector_t pose, pf_vector_t & delta)
   bool update = fabs(delta.v[0]) > d_thresh_ ||
     fabs(delta.v[1]) > d_thresh_ ||
     fabs(delta.v[2]) > a_thresh_;
+
+  // A confident filter gains little from short motions, so wait for a longer one
+  if (update && tracking_) {
+    const double d_thresh = d_thresh_ * tracking_update_scale_;
+    const double a_thresh = a_thresh_ * tracking_update_scale_;
+    update = fabs(delta.v[0]) > d_thresh ||
+      fabs(delta.v[1]) > d_thresh ||
+      fabs(delta.v[2]) > a_thresh;
+    if (!update) {
+      ++skipped_updates_;
+    }
+  }
+
   update = update || force_update_;
   return update;
 }
 
+bool AmclNode::updateTrackingState()
+{
+  // Effective sample size of the normalized weights, as a fraction of the particle count
+  pf_sample_set_t * set = pf_->sets + pf_->current_set;
+  double sum_sq = 0.0;
+  for (int i = 0; i < set->sample_count; i++) {
+    sum_sq += set->samples[i].weight * set->samples[i].weight;
+  }
+  tracking_ess_ratio_ = sum_sq > 0.0 ? 1.0 / (sum_sq * set->sample_count) : 0.0;
+
+  // A scan far less likely than usual means the estimate no longer explains the data
+  const double likelihood = pf_->w_avg;
+  const bool surprise = likelihood_avg_ > 0.0 &&
+    likelihood < tracking_surprise_ratio_ * likelihood_avg_;
+  if (likelihood_avg_ == 0.0) {
+    likelihood_avg_ = likelihood;
+  } else {
+    likelihood_avg_ += 0.1 * (likelihood - likelihood_avg_);
+  }
+
+  if (tracking_) {
+    if (surprise || tracking_ess_ratio_ < tracking_min_ess_ratio_) {
+      RCLCPP_INFO(
+        get_logger(), "Lost confident tracking (likelihood %.3g of %.3g, ESS ratio %.2f)",
+        likelihood, likelihood_avg_, tracking_ess_ratio_);
+      ++tracking_losses_;
+      setTrackingMode(false);
+      return true;
+    }
+  } else if (!surprise && pf_->converged && tracking_ess_ratio_ >= tracking_min_ess_ratio_) {
+    RCLCPP_INFO(get_logger(), "Tracking confidently, reducing the particle set");
+    setTrackingMode(true);
+  }
+  return false;
+}
+
+void AmclNode::setTrackingMode(bool tracking)
+{
+  tracking_ = tracking;
+  if (pf_ == nullptr) {
+    return;
+  }
+
+  if (tracking) {
+    pf_->max_samples = std::min(tracking_max_particles_, max_particles_);
+    pf_->min_samples = std::min(min_particles_, pf_->max_samples);
+  } else {
+    pf_->max_samples = max_particles_;
+    pf_->min_samples = min_particles_;
+  }
+}
+
+void
+AmclNode::createDiagnosticsUpdater()
+{
+  // The updater declares its own parameters, so it is only created once per node
+  if (diagnostics_updater_) {
+    return;
+  }
+  diagnostics_updater_ = std::make_unique<diagnostic_updater::Updater>(this);
+  diagnostics_updater_->setHardwareID("Nav2");
+  diagnostics_updater_->add("AMCL Tracking", this, &AmclNode::trackingDiagnostic);
+}
+
+void
+AmclNode::trackingDiagnostic(diagnostic_updater::DiagnosticStatusWrapper & stat)
+{
+  std::lock_guard<std::recursive_mutex> cfl(mutex_);
+
+  if (!adaptive_tracking_) {
+    stat.summary(diagnostic_msgs::msg::DiagnosticStatus::OK, "Adaptive tracking disabled");
+    return;
+  }
+
+  if (pf_ == nullptr || !initial_pose_is_known_) {
+    stat.summary(diagnostic_msgs::msg::DiagnosticStatus::WARN, "Not localized");
+    return;
+  }
+
+  stat.summary(
+    diagnostic_msgs::msg::DiagnosticStatus::OK,
+    tracking_ ? "Tracking confidently" : "Localizing with full particle set");
+  stat.add("particles", pf_->sets[pf_->current_set].sample_count);
+  stat.add("effective sample size ratio", tracking_ess_ratio_);
+  stat.add("average likelihood", likelihood_avg_);
+  stat.add("skipped updates", skipped_updates_);
+  stat.add("tracking losses", tracking_losses_);
+}
+
 bool AmclNode::updateFilter(
   const int & laser_index,
   const sensor_msgs::msg::LaserScan::ConstSharedPtr & laser_scan,
@@ -855,21 +1047,65 @@ AmclNode::publishParticleCloud(const pf_sample_set_t * set)
 {
   // If initial pose is not known, AMCL does not know the current pose
   if (!initial_pose_is_known_) {return;}
-  auto cloud_with_weights_msg = std::make_unique<nav2_msgs::msg::ParticleCloud>();
-  cloud_with_weights_msg->header.stamp = this->now();
-  cloud_with_weights_msg->header.frame_id = global_frame_id_;
-  cloud_with_weights_msg->particles.resize(set->sample_count);
 
-  for (int i = 0; i < set->sample_count; i++) {
-    cloud_with_weights_msg->particles[i].pose.position.x = set->samples[i].pose.v[0];
-    cloud_with_weights_msg->particles[i].pose.position.y = set->samples[i].pose.v[1];
-    cloud_with_weights_msg->particles[i].pose.position.z = 0;
-    cloud_with_weights_msg->particles[i].pose.orientation = orientationAroundZAxis(
-      set->samples[i].pose.v[2]);
-    cloud_with_weights_msg->particles[i].weight = set->samples[i].weight;
+  // Don't build messages nobody is listening to
+  const bool publish_poses = particle_cloud_pub_->get_subscription_count() +
+    particle_cloud_pub_->get_intra_process_subscription_count() > 0;
+  const bool publish_2d = particle_cloud_2d_pub_->get_subscription_count() +
+    particle_cloud_2d_pub_->get_intra_process_subscription_count() > 0;
+  if (!publish_poses && !publish_2d) {return;}
+
+  const rclcpp::Time stamp = now();
+  if (particle_cloud_publish_rate_ > 0.0 &&
+    (stamp - last_particle_cloud_publish_time_).seconds() < 1.0 / particle_cloud_publish_rate_)
+  {
+    return;
+  }
+  last_particle_cloud_publish_time_ = stamp;
+
+  if (publish_poses) {
+    auto cloud_with_weights_msg = std::make_unique<nav2_msgs::msg::ParticleCloud>();
+    cloud_with_weights_msg->header.stamp = stamp;
+    cloud_with_weights_msg->header.frame_id = global_frame_id_;
+    cloud_with_weights_msg->particles.resize(set->sample_count);
+
+    for (int i = 0; i < set->sample_count; i++) {
+      cloud_with_weights_msg->particles[i].pose.position.x = set->samples[i].pose.v[0];
+      cloud_with_weights_msg->particles[i].pose.position.y = set->samples[i].pose.v[1];
+      cloud_with_weights_msg->particles[i].pose.position.z = 0;
+      cloud_with_weights_msg->particles[i].pose.orientation = orientationAroundZAxis(
+        set->samples[i].pose.v[2]);
+      cloud_with_weights_msg->particles[i].weight = set->samples[i].weight;
+    }
+
+    particle_cloud_pub_->publish(std::move(cloud_with_weights_msg));
   }
 
-  particle_cloud_pub_->publish(std::move(cloud_with_weights_msg));
+  if (publish_2d) {
+    // Compact encoding: 16 bytes per particle instead of a full Pose and a double weight
+    auto cloud_2d_msg = std::make_unique<sensor_msgs::msg::PointCloud2>();
+    cloud_2d_msg->header.stamp = stamp;
+    cloud_2d_msg->header.frame_id = global_frame_id_;
+
+    sensor_msgs::PointCloud2Modifier modifier(*cloud_2d_msg);
+    modifier.setPointCloud2Fields(
+      4,
+      "x", 1, sensor_msgs::msg::PointField::FLOAT32,
+      "y", 1, sensor_msgs::msg::PointField::FLOAT32,
+      "yaw", 1, sensor_msgs::msg::PointField::FLOAT32,
+      "weight", 1, sensor_msgs::msg::PointField::FLOAT32);
+    modifier.resize(set->sample_count);
+
+    float * data = reinterpret_cast<float *>(cloud_2d_msg->data.data());
+    for (int i = 0; i < set->sample_count; i++) {
+      *data++ = static_cast<float>(set->samples[i].pose.v[0]);
+      *data++ = static_cast<float>(set->samples[i].pose.v[1]);
+      *data++ = static_cast<float>(set->samples[i].pose.v[2]);
+      *data++ = static_cast<float>(set->samples[i].weight);
+    }
+
+    particle_cloud_2d_pub_->publish(std::move(cloud_2d_msg));
+  }
 }
 
 bool
@@ -1049,6 +1285,11 @@ AmclNode::initParameters()
   get_parameter("alpha3", alpha3_);
   get_parameter("alpha4", alpha4_);
   get_parameter("alpha5", alpha5_);
+  get_parameter("adaptive_tracking", adaptive_tracking_);
+  get_parameter("tracking_max_particles", tracking_max_particles_);
+  get_parameter("tracking_min_ess_ratio", tracking_min_ess_ratio_);
+  get_parameter("tracking_surprise_ratio", tracking_surprise_ratio_);
+  get_parameter("tracking_update_scale", tracking_update_scale_);
   get_parameter("base_frame_id", base_frame_id_);
   get_parameter("beam_skip_distance", beam_skip_distance_);
   get_parameter("beam_skip_error_threshold", beam_skip_error_threshold_);
@@ -1073,6 +1314,7 @@ AmclNode::initParameters()
   get_parameter("pf_z", pf_z_);
   get_parameter("recovery_alpha_fast", alpha_fast_);
   get_parameter("recovery_alpha_slow", alpha_slow_);
+  get_parameter("particle_cloud_publish_rate", particle_cloud_publish_rate_);
   get_parameter("resample_interval", resample_interval_);
   get_parameter("robot_model_type", robot_model_type_);
   get_parameter("save_pose_rate", save_pose_rate);
@@ -1089,6 +1331,13 @@ AmclNode::initParameters()
   get_parameter("always_reset_initial_pose", always_reset_initial_pose_);
   get_parameter("scan_topic", scan_topic_);
   get_parameter("map_topic", map_topic_);
+  get_parameter("use_point_cloud", use_point_cloud_);
+  get_parameter("point_cloud_topic", point_cloud_topic_);
+  get_parameter("point_cloud_min_height", point_cloud_min_height_);
+  get_parameter("point_cloud_max_height", point_cloud_max_height_);
+  get_parameter("point_cloud_angle_increment", point_cloud_angle_increment_);
+  get_parameter("point_cloud_range_min", point_cloud_range_min_);
+  get_parameter("point_cloud_range_max", point_cloud_range_max_);
 
   save_pose_period_ = tf2::durationFromSec(1.0 / save_pose_rate);
   transform_tolerance_ = tf2::durationFromSec(tmp_tol);
@@ -1127,6 +1376,20 @@ AmclNode::initParameters()
     max_particles_ = min_particles_;
   }
 
+  if (tracking_max_particles_ <= 0) {
+    RCLCPP_WARN(
+      get_logger(), "You've set tracking_max_particles to be zero or negative,"
+      " this isn't allowed so it will be set to default value 100.");
+    tracking_max_particles_ = 100;
+  }
+
+  if (tracking_update_scale_ < 1.0) {
+    RCLCPP_WARN(
+      get_logger(), "You've set tracking_update_scale to be less than one,"
+      " this isn't allowed so it will be set to 1.0.");
+    tracking_update_scale_ = 1.0;
+  }
+
   if (resample_interval_ <= 0) {
     RCLCPP_WARN(
       get_logger(), "You've set resample_interval to be zero or negtive,"
@@ -1134,6 +1397,13 @@ AmclNode::initParameters()
     resample_interval_ = 1;
   }
 
+  if (point_cloud_angle_increment_ <= 0.0) {
+    RCLCPP_WARN(
+      get_logger(), "You've set point_cloud_angle_increment to be zero or negative,"
+      " this isn't allowed so it will be set to default value to pi/360.");
+    point_cloud_angle_increment_ = M_PI / 360.0;
+  }
+
   if (always_reset_initial_pose_) {
     initial_pose_is_known_ = false;
   }
@@ -1248,6 +1518,14 @@ AmclNode::dynamicParametersCallback(
       } else if (param_name == "recovery_alpha_slow") {
         alpha_slow_ = parameter.as_double();
         reinit_pf = true;
+      } else if (param_name == "tracking_min_ess_ratio") {
+        tracking_min_ess_ratio_ = parameter.as_double();
+      } else if (param_name == "tracking_surprise_ratio") {
+        tracking_surprise_ratio_ = parameter.as_double();
+      } else if (param_name == "tracking_update_scale") {
+        tracking_update_scale_ = std::max(1.0, parameter.as_double());
+      } else if (param_name == "particle_cloud_publish_rate") {
+        particle_cloud_publish_rate_ = parameter.as_double();
       } else if (param_name == "save_pose_rate") {
         save_pose_rate = parameter.as_double();
         save_pose_period_ = tf2::durationFromSec(1.0 / save_pose_rate);
@@ -1274,6 +1552,27 @@ AmclNode::dynamicParametersCallback(
       } else if (param_name == "z_short") {
         z_short_ = parameter.as_double();
         reinit_laser = true;
+      } else if (param_name == "point_cloud_min_height") {
+        point_cloud_min_height_ = parameter.as_double();
+        reinit_laser = true;
+      } else if (param_name == "point_cloud_max_height") {
+        point_cloud_max_height_ = parameter.as_double();
+        reinit_laser = true;
+      } else if (param_name == "point_cloud_angle_increment") {
+        if (parameter.as_double() <= 0.0) {
+          RCLCPP_WARN(
+            get_logger(), "You've set point_cloud_angle_increment to be zero or negative,"
+            " this isn't allowed, so the previous value will be kept.");
+        } else {
+          point_cloud_angle_increment_ = parameter.as_double();
+          reinit_laser = true;
+        }
+      } else if (param_name == "point_cloud_range_min") {
+        point_cloud_range_min_ = parameter.as_double();
+        reinit_laser = true;
+      } else if (param_name == "point_cloud_range_max") {
+        point_cloud_range_max_ = parameter.as_double();
+        reinit_laser = true;
       }
     } else if (param_type == ParameterType::PARAMETER_STRING) {
       if (param_name == "base_frame_id") {
@@ -1292,6 +1591,9 @@ AmclNode::dynamicParametersCallback(
       } else if (param_name == "scan_topic") {
         scan_topic_ = parameter.as_string();
         reinit_laser = true;
+      } else if (param_name == "point_cloud_topic") {
+        point_cloud_topic_ = parameter.as_string();
+        reinit_laser = true;
       } else if (param_name == "robot_model_type") {
         robot_model_type_ = parameter.as_string();
         reinit_odom = true;
@@ -1306,6 +1608,22 @@ AmclNode::dynamicParametersCallback(
         set_initial_pose_ = parameter.as_bool();
       } else if (param_name == "first_map_only") {
         first_map_only_ = parameter.as_bool();
+      } else if (param_name == "adaptive_tracking") {
+        adaptive_tracking_ = parameter.as_bool();
+        setTrackingMode(false);
+        if (adaptive_tracking_ && !diagnostics_updater_ && !diagnostics_timer_) {
+          // Parameters cannot be declared from this callback, so the updater is created
+          // from a timer once the callback returned
+          diagnostics_timer_ = create_wall_timer(
+            0s, [this]() {
+              std::lock_guard<std::recursive_mutex> cfl(mutex_);
+              diagnostics_timer_->cancel();
+              createDiagnosticsUpdater();
+            });
+        }
+      } else if (param_name == "use_point_cloud") {
+        use_point_cloud_ = parameter.as_bool();
+        reinit_laser = true;
       }
     } else if (param_type == ParameterType::PARAMETER_INTEGER) {
       if (param_name == "max_beams") {
@@ -1319,6 +1637,11 @@ AmclNode::dynamicParametersCallback(
         reinit_pf = true;
       } else if (param_name == "resample_interval") {
         resample_interval_ = parameter.as_int();
+      } else if (param_name == "tracking_max_particles") {
+        tracking_max_particles_ = std::max(1, static_cast<int>(parameter.as_int()));
+        if (tracking_) {
+          setTrackingMode(true);
+        }
       }
     }
   }
@@ -1358,6 +1681,10 @@ AmclNode::dynamicParametersCallback(
     frame_to_laser_.clear();
     laser_scan_connection_.disconnect();
     laser_scan_sub_.reset();
+    point_cloud_connection_.disconnect();
+    point_cloud_filter_.reset();
+    point_cloud_sub_.reset();
+    point_cloud_projector_.reset();
 
     initMessageFilters();
   }
@@ -1402,6 +1729,12 @@ AmclNode::handleMapMessage(const nav_msgs::msg::OccupancyGrid & msg)
       msg.header.frame_id.c_str(),
       global_frame_id_.c_str());
   }
+
+  // Edits of the current map keep the lasers and their likelihood field
+  if (updateMapInPlace(msg)) {
+    return;
+  }
+
   freeMapDependentMemory();
   map_ = convertMap(msg);
 
@@ -1410,6 +1743,60 @@ AmclNode::handleMapMessage(const nav_msgs::msg::OccupancyGrid & msg)
 #endif
 }
 
+bool
+AmclNode::updateMapInPlace(const nav_msgs::msg::OccupancyGrid & msg)
+{
+  if (map_ == nullptr ||
+    map_->size_x != static_cast<int>(msg.info.width) ||
+    map_->size_y != static_cast<int>(msg.info.height) ||
+    map_->scale != msg.info.resolution ||
+    map_->origin_x != msg.info.origin.position.x + (map_->size_x / 2) * map_->scale ||
+    map_->origin_y != msg.info.origin.position.y + (map_->size_y / 2) * map_->scale)
+  {
+    return false;
+  }
+
+  // Apply the new occupancy and find the bounds of what changed
+  int min_i = map_->size_x, min_j = map_->size_y, max_i = -1, max_j = -1;
+  for (int j = 0; j < map_->size_y; j++) {
+    for (int i = 0; i < map_->size_x; i++) {
+      const int index = MAP_INDEX(map_, i, j);
+      int occ_state = 0;
+      if (msg.data[index] == 0) {
+        occ_state = -1;
+      } else if (msg.data[index] == 100) {
+        occ_state = +1;
+      }
+      if (map_->cells[index].occ_state != occ_state) {
+        map_->cells[index].occ_state = occ_state;
+        min_i = std::min(min_i, i);
+        min_j = std::min(min_j, j);
+        max_i = std::max(max_i, i);
+        max_j = std::max(max_j, j);
+      }
+    }
+  }
+
+  if (max_i < 0) {
+    RCLCPP_INFO(get_logger(), "Map is unchanged, keeping the current one");
+    return true;
+  }
+
+  RCLCPP_INFO(
+    get_logger(), "Map changed within cells [%d, %d] x [%d, %d], updating in place",
+    min_i, max_i, min_j, max_j);
+
+  // Only set once a likelihood field model has built the distance field
+  if (map_->max_occ_dist > 0.0) {
+    map_update_cspace_region(map_, min_i, min_j, max_i, max_j);
+  }
+
+#if NEW_UNIFORM_SAMPLING
+  updateFreeSpaceVector(min_i, max_i);
+#endif
+  return true;
+}
+
 void
 AmclNode::createFreeSpaceVector()
 {
@@ -1424,6 +1811,27 @@ AmclNode::createFreeSpaceVector()
   }
 }
 
+void
+AmclNode::updateFreeSpaceVector(int min_i, int max_i)
+{
+  // The table is sorted by column then row, so a column range is a contiguous slice
+  std::vector<std::pair<int, int>> slice;
+  for (int i = min_i; i <= max_i; i++) {
+    for (int j = 0; j < map_->size_y; j++) {
+      if (map_->cells[MAP_INDEX(map_, i, j)].occ_state == -1) {
+        slice.push_back(std::make_pair(i, j));
+      }
+    }
+  }
+
+  auto first = std::lower_bound(
+    free_space_indices.begin(), free_space_indices.end(), std::make_pair(min_i, 0));
+  auto last = std::lower_bound(
+    first, free_space_indices.end(), std::make_pair(max_i + 1, 0));
+  first = free_space_indices.erase(first, last);
+  free_space_indices.insert(first, slice.begin(), slice.end());
+}
+
 void
 AmclNode::freeMapDependentMemory()
 {
@@ -1509,6 +1917,30 @@ AmclNode::initMessageFilters()
     std::bind(
       &AmclNode::laserReceived,
       this, std::placeholders::_1));
+
+  if (!use_point_cloud_) {
+    return;
+  }
+
+  point_cloud_projector_ = std::make_unique<PointCloudProjector>(
+    point_cloud_min_height_, point_cloud_max_height_,
+    -M_PI, M_PI, point_cloud_angle_increment_,
+    point_cloud_range_min_, point_cloud_range_max_);
+
+  point_cloud_sub_ = std::make_unique<message_filters::Subscriber<sensor_msgs::msg::PointCloud2,
+      rclcpp_lifecycle::LifecycleNode>>(
+    shared_from_this(), point_cloud_topic_, rmw_qos_profile_sensor_data, sub_opt);
+
+  point_cloud_filter_ = std::make_unique<tf2_ros::MessageFilter<sensor_msgs::msg::PointCloud2>>(
+    *point_cloud_sub_, *tf_buffer_, odom_frame_id_, 10,
+    get_node_logging_interface(),
+    get_node_clock_interface(),
+    transform_tolerance_);
+
+  point_cloud_connection_ = point_cloud_filter_->registerCallback(
+    std::bind(
+      &AmclNode::pointCloudReceived,
+      this, std::placeholders::_1));
 }
 
 void
@@ -1520,6 +1952,11 @@ AmclNode::initPubSub()
     "particle_cloud",
     rclcpp::SensorDataQoS());
 
+  particle_cloud_2d_pub_ = create_publisher<sensor_msgs::msg::PointCloud2>(
+    "particle_cloud_2d",
+    rclcpp::SensorDataQoS());
+  last_particle_cloud_publish_time_ = rclcpp::Time(0, 0, get_clock()->get_clock_type());
+
   pose_pub_ = create_publisher<geometry_msgs::msg::PoseWithCovarianceStamped>(
     "amcl_pose",
     rclcpp::QoS(rclcpp::KeepLast(1)).transient_local().reliable());
@@ -1600,6 +2037,9 @@ AmclNode::initParticleFilter()
   pf_init_ = false;
   resample_count_ = 0;
   memset(&pf_odom_pose_, 0, sizeof(pf_odom_pose_));
+
+  tracking_ = false;
+  likelihood_avg_ = 0.0;
 }
 
 void
@@ -53,6 +53,9 @@ map_t * map_alloc(void)
   // Allocate storage for main map
   map->cells = (map_cell_t *) NULL;
 
+  // No likelihood field computed yet
+  map->max_occ_dist = 0;
+
   return map;
 }
 
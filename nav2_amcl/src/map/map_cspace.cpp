@@ -22,7 +22,9 @@
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
 #include <queue>
+#include <vector>
 #include "nav2_amcl/map/map.hpp"
 
 /*
@@ -211,3 +213,120 @@ void map_update_cspace(map_t * map, double max_occ_dist)
 
   delete[] marked;
 }
+
+/*
+ * @class RegionCellData
+ * @brief Cell of a local window, carrying its own distance so the map is only
+ * written where the result is final
+ */
+class RegionCellData
+{
+public:
+  double dist_;
+  int i_, j_;
+  int src_i_, src_j_;
+};
+
+/*
+ * @brief operator<
+ */
+bool operator<(const RegionCellData & a, const RegionCellData & b)
+{
+  return a.dist_ > b.dist_;
+}
+
+/*
+ * @brief Update the cspace distance values around a changed region
+ * @param map Map to update
+ * @param min_i Lowest changed column
+ * @param min_j Lowest changed row
+ * @param max_i Highest changed column
+ * @param max_j Highest changed row
+ */
+void map_update_cspace_region(map_t * map, int min_i, int min_j, int max_i, int max_j)
+{
+  CachedDistanceMap * cdm = get_distance_map(map->scale, map->max_occ_dist);
+  const int radius = cdm->cell_radius_ + 1;
+
+  // Only cells within the obstacle radius of a change can see a new distance, and
+  // only obstacles within the radius of those cells can set it
+  const int upd_min_i = std::max(min_i - radius, 0);
+  const int upd_min_j = std::max(min_j - radius, 0);
+  const int upd_max_i = std::min(max_i + radius, map->size_x - 1);
+  const int upd_max_j = std::min(max_j + radius, map->size_y - 1);
+  const int win_min_i = std::max(upd_min_i - radius, 0);
+  const int win_min_j = std::max(upd_min_j - radius, 0);
+  const int win_max_i = std::min(upd_max_i + radius, map->size_x - 1);
+  const int win_max_j = std::min(upd_max_j + radius, map->size_y - 1);
+
+  const int win_size_x = win_max_i - win_min_i + 1;
+  const int win_size_y = win_max_j - win_min_j + 1;
+  std::vector<double> dist(win_size_x * win_size_y, map->max_occ_dist);
+  std::vector<unsigned char> marked(win_size_x * win_size_y, 0);
+  std::priority_queue<RegionCellData> Q;
+
+  // Enqueue all the obstacle cells of the window
+  RegionCellData cell;
+  for (int i = win_min_i; i <= win_max_i; i++) {
+    for (int j = win_min_j; j <= win_max_j; j++) {
+      if (map->cells[MAP_INDEX(map, i, j)].occ_state == +1) {
+        const int local = (i - win_min_i) + (j - win_min_j) * win_size_x;
+        dist[local] = 0.0;
+        marked[local] = 1;
+        cell.dist_ = 0.0;
+        cell.src_i_ = cell.i_ = i;
+        cell.src_j_ = cell.j_ = j;
+        Q.push(cell);
+      }
+    }
+  }
+
+  while (!Q.empty()) {
+    // Expand before popping, in the same order as map_update_cspace()
+    const RegionCellData current_cell = Q.top();
+
+    const int neighbors[4][2] = {
+      {current_cell.i_ - 1, current_cell.j_},
+      {current_cell.i_, current_cell.j_ - 1},
+      {current_cell.i_ + 1, current_cell.j_},
+      {current_cell.i_, current_cell.j_ + 1}};
+
+    for (const auto & neighbor : neighbors) {
+      const int i = neighbor[0];
+      const int j = neighbor[1];
+      if (i < win_min_i || i > win_max_i || j < win_min_j || j > win_max_j) {
+        continue;
+      }
+      const int local = (i - win_min_i) + (j - win_min_j) * win_size_x;
+      if (marked[local]) {
+        continue;
+      }
+
+      const double distance =
+        cdm->distances_[abs(i - current_cell.src_i_)][abs(j - current_cell.src_j_)];
+      if (distance > cdm->cell_radius_) {
+        continue;
+      }
+
+      dist[local] = distance * map->scale;
+      marked[local] = 1;
+
+      cell.dist_ = dist[local];
+      cell.i_ = i;
+      cell.j_ = j;
+      cell.src_i_ = current_cell.src_i_;
+      cell.src_j_ = current_cell.src_j_;
+      Q.push(cell);
+    }
+
+    Q.pop();
+  }
+
+  // Window borders lack obstacles beyond the window, so only the inner region is final
+  for (int j = upd_min_j; j <= upd_max_j; j++) {
+    for (int i = upd_min_i; i <= upd_max_i; i++) {
+      map->cells[MAP_INDEX(map, i, j)].occ_dist =
+        dist[(i - win_min_i) + (j - win_min_j) * win_size_x];
+    }
+  }
+}
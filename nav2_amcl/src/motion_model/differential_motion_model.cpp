@@ -79,28 +79,32 @@ DifferentialMotionModel::odometryUpdate(
     fabs(angleutils::angle_diff(delta_rot2, 0.0)),
     fabs(angleutils::angle_diff(delta_rot2, M_PI)));
 
-  for (int i = 0; i < set->sample_count; i++) {
+  const double rot1_stddev = sqrt(
+    alpha1_ * delta_rot1_noise * delta_rot1_noise +
+    alpha2_ * delta_trans * delta_trans);
+  const double trans_stddev = sqrt(
+    alpha3_ * delta_trans * delta_trans +
+    alpha4_ * delta_rot1_noise * delta_rot1_noise +
+    alpha4_ * delta_rot2_noise * delta_rot2_noise);
+  const double rot2_stddev = sqrt(
+    alpha1_ * delta_rot2_noise * delta_rot2_noise +
+    alpha2_ * delta_trans * delta_trans);
+
+  // Draw the noise for every particle at once, one contiguous column per term
+  const int count = set->sample_count;
+  noise_generator_.fill(noise_, 3 * count);
+  const double * rot1_noise = noise_.data();
+  const double * trans_noise = rot1_noise + count;
+  const double * rot2_noise = trans_noise + count;
+
+  for (int i = 0; i < count; i++) {
     pf_sample_t * sample = set->samples + i;
 
-    // Sample pose differences
-    delta_rot1_hat = angleutils::angle_diff(
-      delta_rot1,
-      pf_ran_gaussian(
-        sqrt(
-          alpha1_ * delta_rot1_noise * delta_rot1_noise +
-          alpha2_ * delta_trans * delta_trans)));
-    delta_trans_hat = delta_trans -
-      pf_ran_gaussian(
-      sqrt(
-        alpha3_ * delta_trans * delta_trans +
-        alpha4_ * delta_rot1_noise * delta_rot1_noise +
-        alpha4_ * delta_rot2_noise * delta_rot2_noise));
-    delta_rot2_hat = angleutils::angle_diff(
-      delta_rot2,
-      pf_ran_gaussian(
-        sqrt(
-          alpha1_ * delta_rot2_noise * delta_rot2_noise +
-          alpha2_ * delta_trans * delta_trans)));
+    // Sample pose differences. delta_rot1 and delta_rot2 are already normalized, so
+    // the cheap wrap gives the same result as angle_diff() against the noise
+    delta_rot1_hat = angleutils::wrap(delta_rot1 - rot1_stddev * rot1_noise[i]);
+    delta_trans_hat = delta_trans - trans_stddev * trans_noise[i];
+    delta_rot2_hat = angleutils::wrap(delta_rot2 - rot2_stddev * rot2_noise[i]);
 
     // Apply sampled update to particle pose
     sample->pose.v[0] += delta_trans_hat *
@@ -0,0 +1,97 @@
+/*
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <math.h>
+#include <time.h>
+
+#include "nav2_amcl/motion_model/gaussian_noise.hpp"
+
+namespace nav2_amcl
+{
+
+GaussianNoise::GaussianNoise()
+{
+  seed(static_cast<uint64_t>(time(NULL)));
+}
+
+GaussianNoise::GaussianNoise(uint64_t seed_value)
+{
+  seed(seed_value);
+}
+
+void
+GaussianNoise::seed(uint64_t seed_value)
+{
+  // Expand the seed with splitmix64, as recommended for the xoshiro family
+  for (auto & word : state_) {
+    uint64_t z = (seed_value += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    word = z ^ (z >> 31);
+  }
+}
+
+inline uint64_t
+GaussianNoise::next()
+{
+  const uint64_t result = state_[0] + state_[3];
+  const uint64_t t = state_[1] << 17;
+
+  state_[2] ^= state_[0];
+  state_[3] ^= state_[1];
+  state_[1] ^= state_[2];
+  state_[0] ^= state_[3];
+  state_[2] ^= t;
+  state_[3] = (state_[3] << 45) | (state_[3] >> 19);
+
+  return result;
+}
+
+void
+GaussianNoise::fill(double * out, size_t n)
+{
+  // The generator is inherently serial, so draw all uniforms first and leave the
+  // transform as a dependency-free loop over contiguous memory
+  for (size_t i = 0; i < n; i++) {
+    // 53 random mantissa bits, shifted to (0, 1] so the log below is finite
+    out[i] = static_cast<double>((next() >> 11) + 1) * (1.0 / 9007199254740992.0);
+  }
+
+  const size_t pairs = n / 2;
+  for (size_t i = 0; i < pairs; i++) {
+    const double radius = sqrt(-2.0 * log(out[2 * i]));
+    const double theta = 2.0 * M_PI * out[2 * i + 1];
+    out[2 * i] = radius * cos(theta);
+    out[2 * i + 1] = radius * sin(theta);
+  }
+
+  if (n % 2) {
+    const double u = static_cast<double>((next() >> 11) + 1) * (1.0 / 9007199254740992.0);
+    out[n - 1] = sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * out[n - 1]);
+  }
+}
+
+void
+GaussianNoise::fill(std::vector<double> & out, size_t n)
+{
+  if (out.size() < n) {
+    out.resize(n);
+  }
+  fill(out.data(), n);
+}
+
+}  // namespace nav2_amcl
@@ -66,19 +66,29 @@ OmniMotionModel::odometryUpdate(
     alpha4_ * (delta_rot * delta_rot) +
     alpha5_ * (delta_trans * delta_trans) );
 
-  for (int i = 0; i < set->sample_count; i++) {
+  // The bearing of the motion relative to the robot is the same for every particle
+  const double relative_bearing = angleutils::angle_diff(
+    atan2(delta.v[1], delta.v[0]),
+    old_pose.v[2]);
+
+  // Draw the noise for every particle at once, one contiguous column per term
+  const int count = set->sample_count;
+  noise_generator_.fill(noise_, 3 * count);
+  const double * trans_noise = noise_.data();
+  const double * rot_noise = trans_noise + count;
+  const double * strafe_noise = rot_noise + count;
+
+  for (int i = 0; i < count; i++) {
     pf_sample_t * sample = set->samples + i;
 
-    delta_bearing = angleutils::angle_diff(
-      atan2(delta.v[1], delta.v[0]),
-      old_pose.v[2]) + sample->pose.v[2];
+    delta_bearing = relative_bearing + sample->pose.v[2];
     double cs_bearing = cos(delta_bearing);
     double sn_bearing = sin(delta_bearing);
 
     // Sample pose differences
-    delta_trans_hat = delta_trans + pf_ran_gaussian(trans_hat_stddev);
-    delta_rot_hat = delta_rot + pf_ran_gaussian(rot_hat_stddev);
-    delta_strafe_hat = 0 + pf_ran_gaussian(strafe_hat_stddev);
+    delta_trans_hat = delta_trans + trans_hat_stddev * trans_noise[i];
+    delta_rot_hat = delta_rot + rot_hat_stddev * rot_noise[i];
+    delta_strafe_hat = 0 + strafe_hat_stddev * strafe_noise[i];
     // Apply sampled update to particle pose
     sample->pose.v[0] += (delta_trans_hat * cs_bearing +
       delta_strafe_hat * sn_bearing);
@@ -100,6 +100,7 @@ pf_t * pf_alloc(
 
   pf->w_slow = 0.0;
   pf->w_fast = 0.0;
+  pf->w_avg = 0.0;
 
   pf->alpha_slow = alpha_slow;
   pf->alpha_fast = alpha_fast;
@@ -269,6 +270,7 @@ void pf_update_sensor(pf_t * pf, pf_sensor_model_fn_t sensor_fn, void * sensor_d
     }
     // Update running averages of likelihood of samples (Prob Rob p258)
     w_avg /= set->sample_count;
+    pf->w_avg = w_avg;
     if (pf->w_slow == 0.0) {
       pf->w_slow = w_avg;
     } else {
@@ -281,6 +283,7 @@ void pf_update_sensor(pf_t * pf, pf_sensor_model_fn_t sensor_fn, void * sensor_d
     }
   } else {
     // Handle zero total
+    pf->w_avg = 0.0;
     for (i = 0; i < set->sample_count; i++) {
       sample = set->samples + i;
       sample->weight = 1.0 / set->sample_count;
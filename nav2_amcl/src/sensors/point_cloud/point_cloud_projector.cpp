@@ -0,0 +1,98 @@
+/*
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+#include "nav2_amcl/sensors/point_cloud/point_cloud_projector.hpp"
+#include "sensor_msgs/point_cloud2_iterator.hpp"
+
+namespace nav2_amcl
+{
+
+PointCloudProjector::PointCloudProjector(
+  double min_height, double max_height,
+  double angle_min, double angle_max, double angle_increment,
+  double range_min, double range_max)
+: min_height_(min_height),
+  max_height_(max_height),
+  range_min_sq_(range_min * range_min),
+  range_max_sq_(range_max * range_max)
+{
+  scan_ = std::make_shared<sensor_msgs::msg::LaserScan>();
+  scan_->angle_min = angle_min;
+  scan_->angle_max = angle_max;
+  scan_->angle_increment = angle_increment;
+  scan_->range_min = range_min;
+  scan_->range_max = range_max;
+  scan_->time_increment = 0.0;
+  scan_->scan_time = 0.0;
+
+  const unsigned int bins = std::max(
+    1u, static_cast<unsigned int>(std::ceil((angle_max - angle_min) / angle_increment)));
+  scan_->ranges.resize(bins);
+}
+
+sensor_msgs::msg::LaserScan::ConstSharedPtr
+PointCloudProjector::project(const sensor_msgs::msg::PointCloud2 & cloud)
+{
+  scan_->header = cloud.header;
+
+  // Bins without a return report max range, which the sensor models treat as "no hit"
+  const float range_max = scan_->range_max;
+  std::fill(scan_->ranges.begin(), scan_->ranges.end(), range_max);
+
+  const double angle_min = scan_->angle_min;
+  const double angle_max = scan_->angle_max;
+  const double inv_increment = 1.0 / scan_->angle_increment;
+  const int bins = static_cast<int>(scan_->ranges.size());
+
+  sensor_msgs::PointCloud2ConstIterator<float> iter_x(cloud, "x");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_y(cloud, "y");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_z(cloud, "z");
+
+  for (; iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
+    const float z = *iter_z;
+    // Comparisons against NaN are false, so invalid points are rejected here too
+    if (!(z >= min_height_ && z <= max_height_)) {
+      continue;
+    }
+
+    const double x = *iter_x;
+    const double y = *iter_y;
+    const double range_sq = x * x + y * y;
+    if (!(range_sq >= range_min_sq_ && range_sq < range_max_sq_)) {
+      continue;
+    }
+
+    const double angle = std::atan2(y, x);
+    if (angle < angle_min || angle > angle_max) {
+      continue;
+    }
+
+    const int bin = std::min(static_cast<int>((angle - angle_min) * inv_increment), bins - 1);
+    const float range = std::sqrt(range_sq);
+    if (range < scan_->ranges[bin]) {
+      scan_->ranges[bin] = range;
+    }
+  }
+
+  return scan_;
+}
+
+}  // namespace nav2_amcl
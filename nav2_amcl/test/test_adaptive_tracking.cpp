@@ -0,0 +1,186 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "rclcpp/rclcpp.hpp"
+#include "diagnostic_msgs/msg/diagnostic_array.hpp"
+#include "nav2_amcl/amcl_node.hpp"
+
+using namespace std::chrono_literals;  // NOLINT
+
+class RclCppFixture
+{
+public:
+  RclCppFixture() {rclcpp::init(0, nullptr);}
+  ~RclCppFixture() {rclcpp::shutdown();}
+};
+RclCppFixture g_rclcppfixture;
+
+class AmclShim : public nav2_amcl::AmclNode
+{
+public:
+  explicit AmclShim(const rclcpp::NodeOptions & options)
+  : nav2_amcl::AmclNode(options)
+  {
+  }
+
+  void configure()
+  {
+    rclcpp_lifecycle::State state;
+    on_configure(state);
+  }
+
+  void activate()
+  {
+    rclcpp_lifecycle::State state;
+    on_activate(state);
+  }
+
+  void deactivate()
+  {
+    rclcpp_lifecycle::State state;
+    on_deactivate(state);
+  }
+
+  void cleanup()
+  {
+    rclcpp_lifecycle::State state;
+    on_cleanup(state);
+  }
+
+  // Weights with the given effective sample size ratio, then a sensor update of that likelihood
+  bool sensorUpdate(const double & ess_ratio, const double & likelihood, const bool converged)
+  {
+    pf_sample_set_t * set = pf_->sets + pf_->current_set;
+    const int heavy = std::max(1, static_cast<int>(ess_ratio * set->sample_count));
+    for (int i = 0; i < set->sample_count; i++) {
+      set->samples[i].weight = i < heavy ? 1.0 / heavy : 0.0;
+    }
+    pf_->w_avg = likelihood;
+    pf_->converged = converged;
+    return updateTrackingState();
+  }
+
+  bool isTracking() const {return tracking_;}
+
+  int getMaxSamples() const {return pf_->max_samples;}
+
+  int getMinSamples() const {return pf_->min_samples;}
+};
+
+TEST(AdaptiveTracking, trackingMode)
+{
+  auto amcl = std::make_shared<AmclShim>(
+    rclcpp::NodeOptions().parameter_overrides(
+      {rclcpp::Parameter("adaptive_tracking", true),
+        rclcpp::Parameter("tracking_max_particles", 300)}));
+  amcl->configure();
+  EXPECT_FALSE(amcl->isTracking());
+  EXPECT_EQ(amcl->getMaxSamples(), 2000);
+
+  // Not converged yet, or with a poor effective sample size, the full set is kept
+  EXPECT_FALSE(amcl->sensorUpdate(1.0, 1.0, false));
+  EXPECT_FALSE(amcl->isTracking());
+  EXPECT_FALSE(amcl->sensorUpdate(0.1, 1.0, true));
+  EXPECT_FALSE(amcl->isTracking());
+
+  // Converged and consistent, the particle set is reduced
+  EXPECT_FALSE(amcl->sensorUpdate(0.9, 1.0, true));
+  EXPECT_TRUE(amcl->isTracking());
+  EXPECT_EQ(amcl->getMaxSamples(), 300);
+  EXPECT_EQ(amcl->getMinSamples(), 300);
+  EXPECT_FALSE(amcl->sensorUpdate(0.9, 0.9, true));
+  EXPECT_TRUE(amcl->isTracking());
+
+  // A scan far less likely than usual loses tracking, and restores the configured bounds
+  EXPECT_TRUE(amcl->sensorUpdate(0.9, 0.1, true));
+  EXPECT_FALSE(amcl->isTracking());
+  EXPECT_EQ(amcl->getMaxSamples(), 2000);
+  EXPECT_EQ(amcl->getMinSamples(), 500);
+
+  // and so does a collapsing effective sample size
+  EXPECT_FALSE(amcl->sensorUpdate(0.9, 0.5, true));
+  EXPECT_TRUE(amcl->isTracking());
+  EXPECT_TRUE(amcl->sensorUpdate(0.1, 0.5, true));
+  EXPECT_FALSE(amcl->isTracking());
+
+  amcl->cleanup();
+}
+
+TEST(AdaptiveTracking, diagnosticsWhenEnabledAtRuntime)
+{
+  auto amcl = std::make_shared<AmclShim>(rclcpp::NodeOptions());
+  amcl->configure();
+  amcl->activate();
+
+  auto listener = std::make_shared<rclcpp::Node>("diagnostics_listener");
+  std::mutex mutex;
+  std::string message;
+  auto sub = listener->create_subscription<diagnostic_msgs::msg::DiagnosticArray>(
+    "diagnostics", rclcpp::SystemDefaultsQoS(),
+    [&](const diagnostic_msgs::msg::DiagnosticArray::SharedPtr msg) {
+      for (const auto & status : msg->status) {
+        if (status.name.find("AMCL Tracking") != std::string::npos) {
+          std::lock_guard<std::mutex> guard(mutex);
+          message = status.message;
+        }
+      }
+    });
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(amcl->get_node_base_interface());
+  executor.add_node(listener);
+  std::thread spin_thread([&executor]() {executor.spin();});
+
+  auto wait_for_message = [&](const std::string & expected) {
+      const auto deadline = std::chrono::steady_clock::now() + 10s;
+      while (std::chrono::steady_clock::now() < deadline) {
+        {
+          std::lock_guard<std::mutex> guard(mutex);
+          if (message == expected) {
+            return true;
+          }
+        }
+        std::this_thread::sleep_for(50ms);
+      }
+      return false;
+    };
+
+  // Nothing is published while the mode is disabled, the diagnostics being published
+  // every second once created
+  std::this_thread::sleep_for(1500ms);
+  {
+    std::lock_guard<std::mutex> guard(mutex);
+    EXPECT_TRUE(message.empty());
+  }
+
+  // Enabling the mode at runtime publishes them
+  auto results = amcl->set_parameters({rclcpp::Parameter("adaptive_tracking", true)});
+  ASSERT_EQ(results.size(), 1u);
+  EXPECT_TRUE(results[0].successful);
+  EXPECT_TRUE(wait_for_message("Not localized"));
+
+  executor.cancel();
+  spin_thread.join();
+  amcl->deactivate();
+  amcl->cleanup();
+}
@@ -0,0 +1,127 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <random>
+
+#include "gtest/gtest.h"
+#include "nav2_amcl/map/map.hpp"
+
+// Map with a few percent of its cells occupied at random, the rest free
+map_t * makeMap(int size_x, int size_y, unsigned int seed)
+{
+  map_t * map = map_alloc();
+  map->size_x = size_x;
+  map->size_y = size_y;
+  map->scale = 0.05;
+  map->cells = static_cast<map_cell_t *>(malloc(sizeof(map_cell_t) * size_x * size_y));
+
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  for (int k = 0; k < size_x * size_y; k++) {
+    map->cells[k].occ_state = uniform(generator) < 0.03 ? +1 : -1;
+    map->cells[k].occ_dist = 0.0;
+  }
+  return map;
+}
+
+map_t * copyMap(const map_t * map)
+{
+  map_t * copy = makeMap(map->size_x, map->size_y, 0);
+  for (int k = 0; k < map->size_x * map->size_y; k++) {
+    copy->cells[k] = map->cells[k];
+  }
+  copy->max_occ_dist = map->max_occ_dist;
+  return copy;
+}
+
+// Flip the occupancy of the cells within the bounds, recomputing only around them
+void editRegion(map_t * map, int min_i, int min_j, int max_i, int max_j)
+{
+  for (int j = min_j; j <= max_j; j++) {
+    for (int i = min_i; i <= max_i; i++) {
+      map_cell_t & cell = map->cells[MAP_INDEX(map, i, j)];
+      cell.occ_state = cell.occ_state == +1 ? -1 : +1;
+    }
+  }
+  map_update_cspace_region(map, min_i, min_j, max_i, max_j);
+}
+
+TEST(MapCspace, fullRegionIsIdentical)
+{
+  map_t * map = makeMap(80, 60, 1);
+  map_update_cspace(map, 0.5);
+
+  map_t * region = copyMap(map);
+  for (int k = 0; k < region->size_x * region->size_y; k++) {
+    region->cells[k].occ_dist = -1.0;
+  }
+  map_update_cspace_region(region, 0, 0, region->size_x - 1, region->size_y - 1);
+
+  for (int k = 0; k < map->size_x * map->size_y; k++) {
+    EXPECT_EQ(region->cells[k].occ_dist, map->cells[k].occ_dist) << "cell " << k;
+  }
+
+  map_free(region);
+  map_free(map);
+}
+
+TEST(MapCspace, localEditsNearBorders)
+{
+  map_t * map = makeMap(80, 60, 2);
+  map_update_cspace(map, 0.5);
+
+  // Corners, edges and a region wider than the obstacle radius along a border
+  editRegion(map, 0, 0, 2, 1);
+  editRegion(map, 77, 58, 79, 59);
+  editRegion(map, 0, 55, 0, 59);
+  editRegion(map, 78, 0, 79, 3);
+  editRegion(map, 30, 0, 35, 0);
+  editRegion(map, 10, 57, 50, 59);
+  editRegion(map, 40, 30, 41, 31);
+
+  // The same distances as a full update, up to the order obstacles reach the cells in
+  map_t * full = copyMap(map);
+  map_update_cspace(full, 0.5);
+  for (int k = 0; k < map->size_x * map->size_y; k++) {
+    EXPECT_NEAR(map->cells[k].occ_dist, full->cells[k].occ_dist, map->scale) << "cell " << k;
+  }
+
+  map_free(full);
+  map_free(map);
+}
+
+TEST(MapCspace, clearedObstacles)
+{
+  map_t * map = makeMap(40, 40, 3);
+  map_update_cspace(map, 0.3);
+
+  // Removing every obstacle near a corner leaves its cells at the maximum distance
+  for (int j = 0; j < 20; j++) {
+    for (int i = 0; i < 20; i++) {
+      map->cells[MAP_INDEX(map, i, j)].occ_state = -1;
+    }
+  }
+  map_update_cspace_region(map, 0, 0, 19, 19);
+
+  map_t * full = copyMap(map);
+  map_update_cspace(full, 0.3);
+  for (int k = 0; k < map->size_x * map->size_y; k++) {
+    EXPECT_NEAR(map->cells[k].occ_dist, full->cells[k].occ_dist, map->scale) << "cell " << k;
+  }
+  EXPECT_EQ(map->cells[MAP_INDEX(map, 0, 0)].occ_dist, 0.3);
+
+  map_free(full);
+  map_free(map);
+}
@@ -0,0 +1,109 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <math.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "nav2_amcl/angleutils.hpp"
+#include "nav2_amcl/motion_model/gaussian_noise.hpp"
+
+using nav2_amcl::angleutils;
+using nav2_amcl::GaussianNoise;
+
+TEST(GaussianNoise, deterministicWithSeed)
+{
+  GaussianNoise first(42), second(42);
+  std::vector<double> a, b;
+  first.fill(a, 1001);
+  second.fill(b, 1001);
+  EXPECT_EQ(a, b);
+
+  // Reseeding restarts the sequence
+  first.seed(42);
+  first.fill(b, 1001);
+  EXPECT_EQ(a, b);
+
+  // while another seed draws another one
+  second.seed(43);
+  second.fill(b, 1001);
+  EXPECT_NE(a, b);
+
+  // and the buffer is only reallocated when it grows
+  first.fill(a, 10);
+  EXPECT_EQ(a.size(), 1001u);
+}
+
+TEST(GaussianNoise, standardNormal)
+{
+  // Odd count, so the unpaired last sample is drawn too
+  const size_t n = 200001;
+  GaussianNoise noise(7);
+  std::vector<double> samples;
+  noise.fill(samples, n);
+
+  double sum = 0.0, sum_sq = 0.0;
+  size_t within_one = 0, within_two = 0;
+  for (const double & sample : samples) {
+    ASSERT_TRUE(std::isfinite(sample));
+    sum += sample;
+    sum_sq += sample * sample;
+    within_one += fabs(sample) < 1.0;
+    within_two += fabs(sample) < 2.0;
+  }
+  const double mean = sum / n;
+  const double variance = sum_sq / n - mean * mean;
+  EXPECT_NEAR(mean, 0.0, 0.01);
+  EXPECT_NEAR(variance, 1.0, 0.02);
+  EXPECT_NEAR(static_cast<double>(within_one) / n, 0.6827, 0.005);
+  EXPECT_NEAR(static_cast<double>(within_two) / n, 0.9545, 0.005);
+
+  // The last sample follows the same distribution as the paired ones
+  double last_sum_sq = 0.0;
+  for (unsigned int seed = 0; seed != 20000; seed++) {
+    noise.seed(seed);
+    noise.fill(samples, 3);
+    last_sum_sq += samples[2] * samples[2];
+  }
+  EXPECT_NEAR(last_sum_sq / 20000, 1.0, 0.05);
+}
+
+TEST(AngleUtils, wrapAgreesWithAngleDiff)
+{
+  const double eps = 1e-9;
+  const std::vector<double> angles = {
+    0.0, eps, -eps, 1.0, -1.0, M_PI / 2, -M_PI / 2, M_PI - eps, -M_PI + eps,
+    M_PI + eps, -M_PI - eps, 2 * M_PI, -2 * M_PI, 3 * M_PI - eps, -3 * M_PI + eps,
+    7.5, -7.5, 100.0, -100.0};
+
+  for (const double & a : angles) {
+    for (const double & b : angles) {
+      const double wrapped = angleutils::wrap(a - b);
+      const double diff = angleutils::angle_diff(a, b);
+      EXPECT_GE(wrapped, -M_PI);
+      EXPECT_LT(wrapped, M_PI);
+      if (fabs(diff) < M_PI - 1e-6) {
+        EXPECT_NEAR(wrapped, diff, 1e-9) << "a " << a << " b " << b;
+      } else {
+        // Half a turn either way is the same angle
+        EXPECT_NEAR(fabs(wrapped), fabs(diff), 1e-6) << "a " << a << " b " << b;
+      }
+    }
+  }
+
+  // At exactly half a turn, both are -pi or pi
+  EXPECT_DOUBLE_EQ(angleutils::wrap(M_PI), -M_PI);
+  EXPECT_DOUBLE_EQ(angleutils::wrap(-M_PI), -M_PI);
+  EXPECT_DOUBLE_EQ(fabs(angleutils::angle_diff(M_PI, 0.0)), M_PI);
+}
@@ -0,0 +1,91 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "nav2_amcl/sensors/point_cloud/point_cloud_projector.hpp"
+#include "sensor_msgs/point_cloud2_iterator.hpp"
+
+sensor_msgs::msg::PointCloud2 makeCloud(const std::vector<std::array<float, 3>> & points)
+{
+  sensor_msgs::msg::PointCloud2 cloud;
+  cloud.header.frame_id = "lidar";
+  sensor_msgs::PointCloud2Modifier modifier(cloud);
+  modifier.setPointCloud2FieldsByString(1, "xyz");
+  modifier.resize(points.size());
+
+  sensor_msgs::PointCloud2Iterator<float> iter_x(cloud, "x");
+  sensor_msgs::PointCloud2Iterator<float> iter_y(cloud, "y");
+  sensor_msgs::PointCloud2Iterator<float> iter_z(cloud, "z");
+  for (const auto & point : points) {
+    *iter_x = point[0];
+    *iter_y = point[1];
+    *iter_z = point[2];
+    ++iter_x;
+    ++iter_y;
+    ++iter_z;
+  }
+  return cloud;
+}
+
+TEST(PointCloudProjector, projectsHeightBand)
+{
+  // Four bins of a quarter turn each, keeping points between 0.1 m and 10 m away
+  // and between -0.1 m and 0.5 m high
+  nav2_amcl::PointCloudProjector projector(-0.1, 0.5, -M_PI, M_PI, M_PI / 2, 0.1, 10.0);
+
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  auto cloud = makeCloud(
+  {
+    // first bin
+    {-3.0f, -1.0f, 0.1f},
+    // second bin, beyond the maximum range
+    {1.0f, -20.0f, 0.0f},
+    // third bin, where the closest point in the band is kept
+    {2.0f, 1.0f, 0.2f},
+    {1.0f, 0.5f, 0.0f},
+    {0.5f, 0.5f, 1.0f},
+    {0.3f, 0.3f, -0.5f},
+    // fourth bin, with a point closer than the minimum range
+    {-1.0f, 1.0f, 0.0f},
+    {-0.05f, 0.05f, 0.0f},
+    // invalid point
+    {nan, nan, nan},
+  });
+
+  auto scan = projector.project(cloud);
+  EXPECT_EQ(scan->header.frame_id, "lidar");
+  EXPECT_FLOAT_EQ(scan->range_min, 0.1f);
+  EXPECT_FLOAT_EQ(scan->range_max, 10.0f);
+  ASSERT_EQ(scan->ranges.size(), 4u);
+  EXPECT_FLOAT_EQ(scan->ranges[0], std::sqrt(10.0f));
+  EXPECT_FLOAT_EQ(scan->ranges[1], 10.0f);
+  EXPECT_FLOAT_EQ(scan->ranges[2], std::sqrt(1.25f));
+  EXPECT_FLOAT_EQ(scan->ranges[3], std::sqrt(2.0f));
+
+  // The scan is reused, bins without points reporting the maximum range again
+  cloud = makeCloud({{1.0f, 0.5f, 0.6f}, {-1.0f, 1.0f, 0.5f}});
+  cloud.header.frame_id = "other_lidar";
+  scan = projector.project(cloud);
+  EXPECT_EQ(scan->header.frame_id, "other_lidar");
+  ASSERT_EQ(scan->ranges.size(), 4u);
+  EXPECT_FLOAT_EQ(scan->ranges[0], 10.0f);
+  EXPECT_FLOAT_EQ(scan->ranges[1], 10.0f);
+  EXPECT_FLOAT_EQ(scan->ranges[2], 10.0f);
+  EXPECT_FLOAT_EQ(scan->ranges[3], std::sqrt(2.0f));
+}
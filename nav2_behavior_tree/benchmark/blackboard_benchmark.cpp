@@ -0,0 +1,138 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+#include "geometry_msgs/msg/pose_stamped.hpp"
+#include "nav_msgs/msg/path.hpp"
+
+#include "behaviortree_cpp_v3/bt_factory.h"
+#include "nav2_behavior_tree/bt_port_handle.hpp"
+#include "nav2_behavior_tree/plugins/condition/goal_updated_condition.hpp"
+
+// Reads its ports the way FollowPath does while waiting for its result
+class GetInputReader : public BT::SyncActionNode
+{
+public:
+  GetInputReader(const std::string & name, const BT::NodeConfiguration & config)
+  : SyncActionNode(name, config)
+  {}
+
+  BT::NodeStatus tick() override
+  {
+    getInput("path", path_);
+    getInput("controller_id", controller_id_);
+    getInput("goal_checker_id", goal_checker_id_);
+    getInput("progress_checker_id", progress_checker_id_);
+    return BT::NodeStatus::SUCCESS;
+  }
+
+  static BT::PortsList providedPorts()
+  {
+    return {
+      BT::InputPort<nav_msgs::msg::Path>("path"),
+      BT::InputPort<std::string>("controller_id", ""),
+      BT::InputPort<std::string>("goal_checker_id", ""),
+      BT::InputPort<std::string>("progress_checker_id", "")
+    };
+  }
+
+protected:
+  nav_msgs::msg::Path path_;
+  std::string controller_id_, goal_checker_id_, progress_checker_id_;
+};
+
+class HandleReader : public GetInputReader
+{
+public:
+  HandleReader(const std::string & name, const BT::NodeConfiguration & config)
+  : GetInputReader(name, config),
+    path_port_(*this, "path"),
+    controller_id_port_(*this, "controller_id"),
+    goal_checker_id_port_(*this, "goal_checker_id"),
+    progress_checker_id_port_(*this, "progress_checker_id")
+  {}
+
+  BT::NodeStatus tick() override
+  {
+    path_port_.get(path_);
+    controller_id_port_.get(controller_id_);
+    goal_checker_id_port_.get(goal_checker_id_);
+    progress_checker_id_port_.get(progress_checker_id_);
+    return BT::NodeStatus::SUCCESS;
+  }
+
+protected:
+  nav2_behavior_tree::InputPortHandle<nav_msgs::msg::Path> path_port_;
+  nav2_behavior_tree::InputPortHandle<std::string> controller_id_port_;
+  nav2_behavior_tree::InputPortHandle<std::string> goal_checker_id_port_;
+  nav2_behavior_tree::InputPortHandle<std::string> progress_checker_id_port_;
+};
+
+// Follow phase of the default navigate trees: the path follower and goal update check
+// ticked on every BT loop, with the path on the blackboard
+static void tickNavigateTree(const std::string & reader, benchmark::State & state)
+{
+  const std::string xml_txt =
+    R"(
+      <root main_tree_to_execute = "MainTree" >
+        <BehaviorTree ID="MainTree">
+          <Sequence>
+            <Inverter>
+              <GoalUpdated/>
+            </Inverter>
+            <)" + reader + R"( path="{path}" controller_id="FollowPath"/>
+          </Sequence>
+        </BehaviorTree>
+      </root>)";
+
+  BT::BehaviorTreeFactory factory;
+  factory.registerNodeType<GetInputReader>("GetInputReader");
+  factory.registerNodeType<HandleReader>("HandleReader");
+  factory.registerNodeType<nav2_behavior_tree::GoalUpdatedCondition>("GoalUpdated");
+
+  auto blackboard = BT::Blackboard::create();
+  nav_msgs::msg::Path path;
+  path.header.frame_id = "map";
+  path.poses.resize(state.range(0));
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    path.poses[i].header.frame_id = "map";
+    path.poses[i].pose.position.x = 0.05 * i;
+  }
+  blackboard->set<nav_msgs::msg::Path>("path", path);
+  blackboard->set<geometry_msgs::msg::PoseStamped>("goal", path.poses.back());
+  blackboard->set<std::vector<geometry_msgs::msg::PoseStamped>>("goals", {path.poses.back()});
+
+  auto tree = factory.createTreeFromText(xml_txt, blackboard);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tree.tickRoot());
+  }
+}
+
+static void BM_GetInput(benchmark::State & state)
+{
+  tickNavigateTree("GetInputReader", state);
+}
+
+static void BM_PortHandle(benchmark::State & state)
+{
+  tickNavigateTree("HandleReader", state);
+}
+
+BENCHMARK(BM_GetInput)->Arg(10)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PortHandle)->Arg(10)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -23,6 +23,7 @@
 #include "nav2_util/node_utils.hpp"
 #include "rclcpp_action/rclcpp_action.hpp"
 #include "nav2_behavior_tree/bt_utils.hpp"
+#include "nav2_behavior_tree/bt_port_handle.hpp"
 
 namespace nav2_behavior_tree
 {
@@ -47,7 +48,8 @@ public:
     const std::string & xml_tag_name,
     const std::string & action_name,
     const BT::NodeConfiguration & conf)
-  : BT::ActionNodeBase(xml_tag_name, conf), action_name_(action_name), should_send_goal_(true)
+  : BT::ActionNodeBase(xml_tag_name, conf), action_name_(action_name), should_send_goal_(true),
+    recovery_count_entry_(conf.blackboard, "number_recoveries")
   {
     node_ = config().blackboard->template get<rclcpp::Node::SharedPtr>("node");
     callback_group_ = node_->create_callback_group(
@@ -432,9 +434,8 @@ protected:
   void increment_recovery_count()
   {
     int recovery_count = 0;
-    config().blackboard->template get<int>("number_recoveries", recovery_count);  // NOLINT
-    recovery_count += 1;
-    config().blackboard->template set<int>("number_recoveries", recovery_count);  // NOLINT
+    recovery_count_entry_.get(recovery_count);
+    recovery_count_entry_.set(recovery_count + 1);
   }
 
   std::string action_name_;
@@ -469,6 +470,8 @@ protected:
 
   // Can be set in on_tick or on_wait_for_result to indicate if a goal should be sent.
   bool should_send_goal_;
+
+  BlackboardEntryHandle<int> recovery_count_entry_;
 };
 
 }  // namespace nav2_behavior_tree
@@ -0,0 +1,236 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NAV2_BEHAVIOR_TREE__BT_PORT_HANDLE_HPP_
+#define NAV2_BEHAVIOR_TREE__BT_PORT_HANDLE_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "behaviortree_cpp_v3/tree_node.h"
+#include "behaviortree_cpp_v3/blackboard.h"
+
+namespace nav2_behavior_tree
+{
+
+/**
+ * @brief Get the key of the version of a blackboard entry. Writers of large values such as
+ * paths increment it, so that readers holding the previous value tell whether it was
+ * replaced without comparing them
+ * @param key Key of the entry
+ * @return Key of the version of the entry
+ */
+inline std::string getVersionKey(const std::string & key)
+{
+  return key + "__version";
+}
+
+/**
+ * @brief Increment the version of a blackboard entry, once the entry was written
+ * @param blackboard Blackboard holding the entry
+ * @param key Key of the entry
+ */
+inline void incrementVersion(const BT::Blackboard::Ptr & blackboard, const std::string & key)
+{
+  const std::string version_key = getVersionKey(key);
+  uint64_t version = 0;
+  blackboard->get<uint64_t>(version_key, version);
+  blackboard->set<uint64_t>(version_key, version + 1);
+}
+
+/**
+ * @brief Set an output port of a BT node and increment the version of the blackboard entry
+ * it is remapped to. All the writers of a versioned entry must set it this way
+ * @param node BT node owning the port
+ * @param port_name Name of the output port
+ * @param value Value to write
+ * @return Result of BT::TreeNode::setOutput
+ */
+template<typename T>
+BT::Result setVersionedOutput(BT::TreeNode & node, const std::string & port_name, const T & value)
+{
+  BT::Result result = node.setOutput(port_name, value);
+  if (!result) {
+    return result;
+  }
+
+  const auto & config = node.config();
+  const auto remap_it = config.output_ports.find(port_name);
+  if (remap_it != config.output_ports.end()) {
+    const auto remapped_key = BT::TreeNode::getRemappedKey(port_name, remap_it->second);
+    if (remapped_key) {
+      incrementVersion(config.blackboard, std::string(remapped_key.value()));
+    }
+  }
+  return result;
+}
+
+/**
+ * @class nav2_behavior_tree::BlackboardEntryHandle
+ * @brief Typed access to a blackboard entry. The entry is looked up by key only until
+ * it exists, it is then read directly, without hashing the key again on every tick.
+ * Blackboard entries are never removed, so the entry stays valid as long as the
+ * blackboard it belongs to.
+ */
+template<typename T>
+class BlackboardEntryHandle
+{
+public:
+  BlackboardEntryHandle() = default;
+
+  /**
+   * @brief A constructor for nav2_behavior_tree::BlackboardEntryHandle
+   * @param blackboard Blackboard holding the entry
+   * @param key Key of the entry
+   */
+  BlackboardEntryHandle(BT::Blackboard::Ptr blackboard, std::string key)
+  : blackboard_(std::move(blackboard)), key_(std::move(key))
+  {}
+
+  /**
+   * @brief Read the value of the entry
+   * @param value Value read, left untouched if the entry is missing or of another type
+   * @return true if the value was read
+   */
+  bool get(T & value)
+  {
+    const BT::Any * entry = resolve();
+    if (!entry || entry->empty()) {
+      return false;
+    }
+
+    try {
+      // Same conversion as BT::TreeNode::getInput for entries set from strings
+      if constexpr (!std::is_same_v<T, std::string>) {
+        if (entry->type() == typeid(std::string)) {
+          value = BT::convertFromString<T>(entry->cast<std::string>());
+          return true;
+        }
+      }
+      value = entry->cast<T>();
+    } catch (const std::exception &) {
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Write the value of the entry
+   * @param value Value to write
+   */
+  void set(const T & value)
+  {
+    blackboard_->set<T>(key_, value);
+  }
+
+  /**
+   * @brief Get the key of the entry
+   * @return Key
+   */
+  const std::string & key() const {return key_;}
+
+protected:
+  /**
+   * @brief Find the entry once it exists
+   * @return Entry, null if it does not exist yet
+   */
+  const BT::Any * resolve()
+  {
+    if (!entry_ && blackboard_) {
+      entry_ = blackboard_->getAny(key_);
+    }
+    return entry_;
+  }
+
+  BT::Blackboard::Ptr blackboard_;
+  std::string key_;
+  const BT::Any * entry_{nullptr};
+};
+
+/**
+ * @class nav2_behavior_tree::InputPortHandle
+ * @brief Typed access to an input port of a BT node, resolved once at construction.
+ * Literal port values are parsed once and remapped ports read their blackboard entry
+ * directly, so reading the port on every tick does no string parsing or lookup.
+ */
+template<typename T>
+class InputPortHandle
+{
+public:
+  /**
+   * @brief A constructor for nav2_behavior_tree::InputPortHandle
+   * @param node BT node owning the port
+   * @param port_name Name of the input port
+   */
+  InputPortHandle(const BT::TreeNode & node, const std::string & port_name)
+  {
+    const auto & config = node.config();
+    const auto remap_it = config.input_ports.find(port_name);
+    if (remap_it == config.input_ports.end()) {
+      return;
+    }
+
+    const auto remapped_key = BT::TreeNode::getRemappedKey(port_name, remap_it->second);
+    if (remapped_key) {
+      const std::string key(remapped_key.value());
+      entry_ = BlackboardEntryHandle<T>(config.blackboard, key);
+      version_entry_ = BlackboardEntryHandle<uint64_t>(config.blackboard, getVersionKey(key));
+      return;
+    }
+
+    try {
+      literal_ = BT::convertFromString<T>(remap_it->second);
+    } catch (const std::exception &) {
+      // Left unset so that reading the port fails, as with getInput
+    }
+  }
+
+  /**
+   * @brief Read the value of the port
+   * @param value Value read, left untouched if the port cannot be read
+   * @return true if the value was read
+   */
+  bool get(T & value)
+  {
+    if (literal_) {
+      value = *literal_;
+      return true;
+    }
+    return entry_.get(value);
+  }
+
+  /**
+   * @brief Get the version of the blackboard entry the port is remapped to, see
+   * setVersionedOutput
+   * @param version Version read, left untouched if the entry is not versioned
+   * @return false if the entry is not versioned, values then having to be compared
+   */
+  bool getVersion(uint64_t & version)
+  {
+    return version_entry_.get(version);
+  }
+
+protected:
+  std::optional<T> literal_;
+  BlackboardEntryHandle<T> entry_;
+  BlackboardEntryHandle<uint64_t> version_entry_;
+};
+
+}  // namespace nav2_behavior_tree
+
+#endif  // NAV2_BEHAVIOR_TREE__BT_PORT_HANDLE_HPP_
@@ -23,6 +23,7 @@
 #include "nav2_util/node_utils.hpp"
 #include "rclcpp/rclcpp.hpp"
 #include "nav2_behavior_tree/bt_utils.hpp"
+#include "nav2_behavior_tree/bt_port_handle.hpp"
 
 namespace nav2_behavior_tree
 {
@@ -48,7 +49,7 @@ public:
     const BT::NodeConfiguration & conf,
     const std::string & service_name = "")
   : BT::ActionNodeBase(service_node_name, conf), service_name_(service_name), service_node_name_(
-      service_node_name)
+      service_node_name), recovery_count_entry_(conf.blackboard, "number_recoveries")
   {
     node_ = config().blackboard->template get<rclcpp::Node::SharedPtr>("node");
     callback_group_ = node_->create_callback_group(
@@ -228,9 +229,8 @@ protected:
   void increment_recovery_count()
   {
     int recovery_count = 0;
-    config().blackboard->template get<int>("number_recoveries", recovery_count);  // NOLINT
-    recovery_count += 1;
-    config().blackboard->template set<int>("number_recoveries", recovery_count);  // NOLINT
+    recovery_count_entry_.get(recovery_count);
+    recovery_count_entry_.set(recovery_count + 1);
   }
 
   std::string service_name_, service_node_name_;
@@ -256,6 +256,8 @@ protected:
 
   // Can be set in on_tick or on_wait_for_result to indicate if a request should be sent.
   bool should_send_request_;
+
+  BlackboardEntryHandle<int> recovery_count_entry_;
 };
 
 }  // namespace nav2_behavior_tree
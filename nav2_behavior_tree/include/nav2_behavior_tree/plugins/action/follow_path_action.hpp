@@ -17,9 +17,11 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "nav2_msgs/action/follow_path.hpp"
 #include "nav2_behavior_tree/bt_action_node.hpp"
+#include "nav2_behavior_tree/bt_port_handle.hpp"
 
 namespace nav2_behavior_tree
 {
@@ -81,6 +83,9 @@ public:
     return providedBasicPorts(
       {
         BT::InputPort<nav_msgs::msg::Path>("path", "Path to follow"),
+        BT::InputPort<std::vector<double>>(
+          "velocities", "Velocity profile of the path limiting the robot velocity at each pose, "
+          "as output by SmoothPath"),
         BT::InputPort<std::string>("controller_id", ""),
         BT::InputPort<std::string>("goal_checker_id", ""),
         BT::InputPort<std::string>("progress_checker_id", ""),
@@ -88,6 +93,13 @@ public:
           "error_code_id", "The follow path error code"),
       });
   }
+
+protected:
+  InputPortHandle<nav_msgs::msg::Path> path_port_;
+  InputPortHandle<std::vector<double>> velocities_port_;
+  InputPortHandle<std::string> controller_id_port_;
+  InputPortHandle<std::string> goal_checker_id_port_;
+  InputPortHandle<std::string> progress_checker_id_port_;
 };
 
 }  // namespace nav2_behavior_tree
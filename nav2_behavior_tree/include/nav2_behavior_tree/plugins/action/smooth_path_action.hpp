@@ -17,6 +17,7 @@
 #define NAV2_BEHAVIOR_TREE__PLUGINS__ACTION__SMOOTH_PATH_ACTION_HPP_
 
 #include <string>
+#include <vector>
 
 #include "nav2_msgs/action/smooth_path.hpp"
 #include "nav_msgs/msg/path.h"
@@ -82,6 +83,11 @@ public:
         BT::OutputPort<nav_msgs::msg::Path>(
           "smoothed_path",
           "Path smoothed by SmootherServer node"),
+        BT::OutputPort<std::vector<double>>(
+          "velocities",
+          "Velocity profile of the smoothed path if enabled on the server, empty otherwise"),
+        BT::OutputPort<std::vector<double>>(
+          "times_from_start", "Time at which each pose of the profile is reached, in seconds"),
         BT::OutputPort<double>("smoothing_duration", "Time taken to smooth path"),
         BT::OutputPort<bool>(
           "was_completed", "True if smoothing was not interrupted by time limit"),
@@ -17,12 +17,15 @@
 #define NAV2_BEHAVIOR_TREE__PLUGINS__ACTION__TRUNCATE_PATH_LOCAL_ACTION_HPP_
 
 #include <memory>
+#include <cstdint>
+#include <optional>
 #include <string>
-#include <limits>
+#include <vector>
 
 #include "nav_msgs/msg/path.hpp"
 
 #include "behaviortree_cpp_v3/action_node.h"
+#include "nav2_behavior_tree/bt_port_handle.hpp"
 #include "tf2_ros/buffer.h"
 
 namespace nav2_behavior_tree
@@ -73,9 +76,9 @@ public:
         "Weight of angular distance relative to positional distance when finding which path "
         "pose is closest to robot. Not applicable on paths without orientations assigned"),
       BT::InputPort<double>(
-        "max_robot_pose_search_dist", std::numeric_limits<double>::infinity(),
+        "max_robot_pose_search_dist", 10.0,
         "Maximum forward integrated distance along the path (starting from the last detected pose) "
-        "to bound the search for the closest pose to the robot. When set to infinity (default), "
+        "to bound the search for the closest pose to the robot. When set to infinity, "
         "whole path is searched every time"),
     };
   }
@@ -100,6 +103,28 @@ private:
    */
   bool getRobotPose(std::string path_frame_id, geometry_msgs::msg::PoseStamped & pose);
 
+  /**
+   * @brief Integrate the arc length along the path up to each of its poses
+   */
+  void updateCumulativeLength();
+
+  /**
+   * @brief Find the first pose further than a distance forward along the path,
+   * as geometry_utils::first_after_integrated_distance does
+   * @param begin Index of the pose to start from
+   * @param distance Distance along the path
+   * @return Index of the pose, the path size if there is none
+   */
+  size_t firstAfterDistance(size_t begin, double distance) const;
+
+  /**
+   * @brief Find the first pose within a distance backward along the path
+   * @param end Index of the pose to start from
+   * @param distance Distance along the path
+   * @return Index of the pose
+   */
+  size_t lastBeforeDistance(size_t end, double distance) const;
+
   /**
    * @brief A custom pose distance method which takes angular distance into account
    * in addition to spatial distance (to improve picking a correct pose near cusps and loops)
@@ -114,9 +139,14 @@ private:
     const double angular_distance_weight);
 
   std::shared_ptr<tf2_ros::Buffer> tf_buffer_;
+  InputPortHandle<nav_msgs::msg::Path> input_path_port_;
 
   nav_msgs::msg::Path path_;
-  nav_msgs::msg::Path::_poses_type::iterator closest_pose_detection_begin_;
+  // Version of path_ when the input path is versioned, see setVersionedOutput
+  std::optional<uint64_t> path_version_;
+  // Arc length from the start of the path to each pose
+  std::vector<double> cumulative_length_;
+  size_t closest_pose_detection_begin_ = 0;
 };
 
 }  // namespace nav2_behavior_tree
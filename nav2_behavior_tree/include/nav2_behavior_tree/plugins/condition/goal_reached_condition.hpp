@@ -21,6 +21,8 @@
 #include "rclcpp/rclcpp.hpp"
 #include "behaviortree_cpp_v3/condition_node.h"
 #include "tf2_ros/buffer.h"
+#include "geometry_msgs/msg/pose_stamped.hpp"
+#include "nav2_behavior_tree/bt_port_handle.hpp"
 
 namespace nav2_behavior_tree
 {
@@ -93,6 +95,7 @@ private:
   double goal_reached_tol_;
   double transform_tolerance_;
   std::string global_frame_, robot_base_frame_;
+  InputPortHandle<geometry_msgs::msg::PoseStamped> goal_port_;
 };
 
 }  // namespace nav2_behavior_tree
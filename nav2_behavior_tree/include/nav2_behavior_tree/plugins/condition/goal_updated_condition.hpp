@@ -20,6 +20,7 @@
 
 #include "behaviortree_cpp_v3/condition_node.h"
 #include "geometry_msgs/msg/pose_stamped.hpp"
+#include "nav2_behavior_tree/bt_port_handle.hpp"
 
 namespace nav2_behavior_tree
 {
@@ -60,6 +61,8 @@ public:
 private:
   geometry_msgs::msg::PoseStamped goal_;
   std::vector<geometry_msgs::msg::PoseStamped> goals_;
+  BlackboardEntryHandle<std::vector<geometry_msgs::msg::PoseStamped>> goals_entry_;
+  BlackboardEntryHandle<geometry_msgs::msg::PoseStamped> goal_entry_;
 };
 
 }  // namespace nav2_behavior_tree
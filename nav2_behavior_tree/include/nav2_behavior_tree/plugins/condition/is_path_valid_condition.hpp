@@ -22,6 +22,7 @@
 #include "behaviortree_cpp_v3/condition_node.h"
 #include "geometry_msgs/msg/pose_stamped.hpp"
 #include "nav2_msgs/srv/is_path_valid.hpp"
+#include "nav2_behavior_tree/bt_port_handle.hpp"
 
 namespace nav2_behavior_tree
 {
@@ -68,6 +69,7 @@ private:
   // The timeout value while waiting for a responce from the
   // is path valid service
   std::chrono::milliseconds server_timeout_;
+  InputPortHandle<nav_msgs::msg::Path> path_port_;
 };
 
 }  // namespace nav2_behavior_tree
@@ -20,6 +20,7 @@
 #include "rclcpp/rclcpp.hpp"
 #include "behaviortree_cpp_v3/condition_node.h"
 #include "nav_msgs/msg/path.hpp"
+#include "nav2_behavior_tree/bt_port_handle.hpp"
 
 namespace nav2_behavior_tree
 {
@@ -66,6 +67,7 @@ private:
   nav_msgs::msg::Path prev_path_;
   double period_;
   bool first_time_;
+  InputPortHandle<nav_msgs::msg::Path> path_port_;
 };
 
 }  // namespace nav2_behavior_tree
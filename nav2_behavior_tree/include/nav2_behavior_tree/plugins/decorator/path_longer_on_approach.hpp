@@ -15,13 +15,16 @@
 #ifndef NAV2_BEHAVIOR_TREE__PLUGINS__DECORATOR__PATH_LONGER_ON_APPROACH_HPP_
 #define NAV2_BEHAVIOR_TREE__PLUGINS__DECORATOR__PATH_LONGER_ON_APPROACH_HPP_
 
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <limits>
+#include <optional>
 
 #include "geometry_msgs/msg/pose_stamped.hpp"
 #include "nav_msgs/msg/path.hpp"
 #include "behaviortree_cpp_v3/decorator_node.h"
+#include "nav2_behavior_tree/bt_port_handle.hpp"
 #include "rclcpp/rclcpp.hpp"
 
 namespace nav2_behavior_tree
@@ -69,43 +72,51 @@ public:
 private:
   /**
    * @brief Checks if the global path is updated
-   * @param new_path new path to the goal
-   * @param old_path current path to the goal
    * @return whether the path is updated for the current goal
    */
-  bool isPathUpdated(
-    nav_msgs::msg::Path & new_path,
-    nav_msgs::msg::Path & old_path);
+  bool isPathUpdated();
 
   /**
    * @brief Checks if the robot is in the goal proximity
-   * @param old_path current path to the goal
-   * @param prox_leng proximity length from the goal
    * @return whether the robot is in the goal proximity
    */
-  bool isRobotInGoalProximity(
-    nav_msgs::msg::Path & old_path,
-    double & prox_leng);
+  bool isRobotInGoalProximity();
 
   /**
    * @brief Checks if the new path is longer
-   * @param new_path new path to the goal
-   * @param old_path current path to the goal
-   * @param length_factor multipler for path length check
    * @return whether the new path is longer
    */
-  bool isNewPathLonger(
-    nav_msgs::msg::Path & new_path,
-    nav_msgs::msg::Path & old_path,
-    double & length_factor);
+  bool isNewPathLonger();
+
+  /**
+   * @brief Get the length of a path, computed only if not known yet
+   * @param path Path to measure
+   * @param length Cached length of the path, negative if unknown
+   * @return Length of the path
+   */
+  static double getPathLength(const nav_msgs::msg::Path & path, double & length);
+
+  /**
+   * @brief Replace the current path with the new one, along with its cached length
+   */
+  void updateOldPath();
 
 private:
   nav_msgs::msg::Path new_path_;
   nav_msgs::msg::Path old_path_;
+  double new_path_length_ = -1.0;
+  double old_path_length_ = -1.0;
+  // Versions of the paths when the input path is versioned, see setVersionedOutput
+  std::optional<uint64_t> new_path_version_;
+  std::optional<uint64_t> old_path_version_;
+  bool path_changed_ = false;
   double prox_len_ = std::numeric_limits<double>::max();
   double length_factor_ = std::numeric_limits<double>::max();
   rclcpp::Node::SharedPtr node_;
   bool first_time_ = true;
+  InputPortHandle<nav_msgs::msg::Path> path_port_;
+  InputPortHandle<double> prox_len_port_;
+  InputPortHandle<double> length_factor_port_;
 };
 
 }  // namespace nav2_behavior_tree
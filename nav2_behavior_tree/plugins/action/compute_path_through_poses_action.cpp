@@ -40,7 +40,7 @@ void ComputePathThroughPosesAction::on_tick()
 
 BT::NodeStatus ComputePathThroughPosesAction::on_success()
 {
-  setOutput("path", result_.result->path);
+  setVersionedOutput(*this, "path", result_.result->path);
   // Set empty error code, action was successful
   setOutput("error_code_id", ActionResult::NONE);
   return BT::NodeStatus::SUCCESS;
@@ -49,7 +49,7 @@ BT::NodeStatus ComputePathThroughPosesAction::on_success()
 BT::NodeStatus ComputePathThroughPosesAction::on_aborted()
 {
   nav_msgs::msg::Path empty_path;
-  setOutput("path", empty_path);
+  setVersionedOutput(*this, "path", empty_path);
   setOutput("error_code_id", result_.result->error_code);
   return BT::NodeStatus::FAILURE;
 }
@@ -57,7 +57,7 @@ BT::NodeStatus ComputePathThroughPosesAction::on_aborted()
 BT::NodeStatus ComputePathThroughPosesAction::on_cancelled()
 {
   nav_msgs::msg::Path empty_path;
-  setOutput("path", empty_path);
+  setVersionedOutput(*this, "path", empty_path);
   // Set empty error code, action was cancelled
   setOutput("error_code_id", ActionResult::NONE);
   return BT::NodeStatus::SUCCESS;
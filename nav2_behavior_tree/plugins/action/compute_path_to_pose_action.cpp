@@ -39,7 +39,7 @@ void ComputePathToPoseAction::on_tick()
 
 BT::NodeStatus ComputePathToPoseAction::on_success()
 {
-  setOutput("path", result_.result->path);
+  setVersionedOutput(*this, "path", result_.result->path);
   // Set empty error code, action was successful
   setOutput("error_code_id", ActionResult::NONE);
   return BT::NodeStatus::SUCCESS;
@@ -48,7 +48,7 @@ BT::NodeStatus ComputePathToPoseAction::on_success()
 BT::NodeStatus ComputePathToPoseAction::on_aborted()
 {
   nav_msgs::msg::Path empty_path;
-  setOutput("path", empty_path);
+  setVersionedOutput(*this, "path", empty_path);
   setOutput("error_code_id", result_.result->error_code);
   return BT::NodeStatus::FAILURE;
 }
@@ -56,7 +56,7 @@ BT::NodeStatus ComputePathToPoseAction::on_aborted()
 BT::NodeStatus ComputePathToPoseAction::on_cancelled()
 {
   nav_msgs::msg::Path empty_path;
-  setOutput("path", empty_path);
+  setVersionedOutput(*this, "path", empty_path);
   // Set empty error code, action was cancelled
   setOutput("error_code_id", ActionResult::NONE);
   return BT::NodeStatus::SUCCESS;
@@ -65,7 +65,7 @@ BT::NodeStatus ComputePathToPoseAction::on_cancelled()
 void ComputePathToPoseAction::halt()
 {
   nav_msgs::msg::Path empty_path;
-  setOutput("path", empty_path);
+  setVersionedOutput(*this, "path", empty_path);
   BtActionNode::halt();
 }
 
@@ -14,6 +14,8 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "nav2_behavior_tree/plugins/action/follow_path_action.hpp"
 
@@ -24,16 +26,23 @@ FollowPathAction::FollowPathAction(
   const std::string & xml_tag_name,
   const std::string & action_name,
   const BT::NodeConfiguration & conf)
-: BtActionNode<Action>(xml_tag_name, action_name, conf)
+: BtActionNode<Action>(xml_tag_name, action_name, conf),
+  path_port_(*this, "path"),
+  velocities_port_(*this, "velocities"),
+  controller_id_port_(*this, "controller_id"),
+  goal_checker_id_port_(*this, "goal_checker_id"),
+  progress_checker_id_port_(*this, "progress_checker_id")
 {
 }
 
 void FollowPathAction::on_tick()
 {
-  getInput("path", goal_.path);
-  getInput("controller_id", goal_.controller_id);
-  getInput("goal_checker_id", goal_.goal_checker_id);
-  getInput("progress_checker_id", goal_.progress_checker_id);
+  path_port_.get(goal_.path);
+  goal_.velocities.clear();
+  velocities_port_.get(goal_.velocities);
+  controller_id_port_.get(goal_.controller_id);
+  goal_checker_id_port_.get(goal_.goal_checker_id);
+  progress_checker_id_port_.get(goal_.progress_checker_id);
 }
 
 BT::NodeStatus FollowPathAction::on_success()
@@ -60,17 +69,25 @@ void FollowPathAction::on_wait_for_result(
 {
   // Grab the new path
   nav_msgs::msg::Path new_path;
-  getInput("path", new_path);
+  path_port_.get(new_path);
 
   // Check if it is not same with the current one
   if (goal_.path != new_path) {
     // the action server on the next loop iteration
-    goal_.path = new_path;
+    goal_.path = std::move(new_path);
+    goal_updated_ = true;
+  }
+
+  std::vector<double> new_velocities;
+  velocities_port_.get(new_velocities);
+
+  if (goal_.velocities != new_velocities) {
+    goal_.velocities = std::move(new_velocities);
     goal_updated_ = true;
   }
 
   std::string new_controller_id;
-  getInput("controller_id", new_controller_id);
+  controller_id_port_.get(new_controller_id);
 
   if (goal_.controller_id != new_controller_id) {
     goal_.controller_id = new_controller_id;
@@ -78,7 +95,7 @@ void FollowPathAction::on_wait_for_result(
   }
 
   std::string new_goal_checker_id;
-  getInput("goal_checker_id", new_goal_checker_id);
+  goal_checker_id_port_.get(new_goal_checker_id);
 
   if (goal_.goal_checker_id != new_goal_checker_id) {
     goal_.goal_checker_id = new_goal_checker_id;
@@ -86,7 +103,7 @@ void FollowPathAction::on_wait_for_result(
   }
 
   std::string new_progress_checker_id;
-  getInput("progress_checker_id", new_progress_checker_id);
+  progress_checker_id_port_.get(new_progress_checker_id);
 
   if (goal_.progress_checker_id != new_progress_checker_id) {
     goal_.progress_checker_id = new_progress_checker_id;
@@ -15,6 +15,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "nav2_behavior_tree/plugins/action/smooth_path_action.hpp"
 
@@ -41,7 +42,14 @@ void SmoothPathAction::on_tick()
 
 BT::NodeStatus SmoothPathAction::on_success()
 {
-  setOutput("smoothed_path", result_.result->path);
+  setVersionedOutput(*this, "smoothed_path", result_.result->path);
+  setOutput("velocities", result_.result->velocities);
+  std::vector<double> times_from_start;
+  times_from_start.reserve(result_.result->times_from_start.size());
+  for (const auto & time : result_.result->times_from_start) {
+    times_from_start.push_back(rclcpp::Duration(time).seconds());
+  }
+  setOutput("times_from_start", times_from_start);
   setOutput("smoothing_duration", rclcpp::Duration(result_.result->smoothing_duration).seconds());
   setOutput("was_completed", result_.result->was_completed);
   // Set empty error code, action was successful
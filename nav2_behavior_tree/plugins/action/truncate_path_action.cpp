@@ -22,6 +22,7 @@
 #include "nav2_util/geometry_utils.hpp"
 #include "behaviortree_cpp_v3/decorator_node.h"
 
+#include "nav2_behavior_tree/bt_port_handle.hpp"
 #include "nav2_behavior_tree/plugins/action/truncate_path_action.hpp"
 
 namespace nav2_behavior_tree
@@ -45,7 +46,7 @@ inline BT::NodeStatus TruncatePath::tick()
   getInput("input_path", input_path);
 
   if (input_path.poses.empty()) {
-    setOutput("output_path", input_path);
+    setVersionedOutput(*this, "output_path", input_path);
     return BT::NodeStatus::SUCCESS;
   }
 
@@ -75,7 +76,7 @@ inline BT::NodeStatus TruncatePath::tick()
   input_path.poses.back().pose.orientation = nav2_util::geometry_utils::orientationAroundZAxis(
     final_angle);
 
-  setOutput("output_path", input_path);
+  setVersionedOutput(*this, "output_path", input_path);
 
   return BT::NodeStatus::SUCCESS;
 }
@@ -12,9 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "behaviortree_cpp_v3/decorator_node.h"
@@ -32,7 +34,8 @@ namespace nav2_behavior_tree
 TruncatePathLocal::TruncatePathLocal(
   const std::string & name,
   const BT::NodeConfiguration & conf)
-: BT::ActionNodeBase(name, conf)
+: BT::ActionNodeBase(name, conf),
+  input_path_port_(*this, "input_path")
 {
   tf_buffer_ =
     config().blackboard->template get<std::shared_ptr<tf2_ros::Buffer>>(
@@ -54,11 +57,31 @@ inline BT::NodeStatus TruncatePathLocal::tick()
   getInput("max_robot_pose_search_dist", max_robot_pose_search_dist);
 
   bool path_pruning = std::isfinite(max_robot_pose_search_dist);
-  nav_msgs::msg::Path new_path;
-  getInput("input_path", new_path);
-  if (!path_pruning || new_path != path_) {
-    path_ = new_path;
-    closest_pose_detection_begin_ = path_.poses.begin();
+  bool path_changed = false;
+  uint64_t version;
+  if (input_path_port_.getVersion(version)) {
+    // Versioned paths are only copied once replaced
+    if (!path_version_ || *path_version_ != version) {
+      path_version_ = version;
+      path_ = nav_msgs::msg::Path();
+      input_path_port_.get(path_);
+      path_changed = true;
+    }
+  } else {
+    path_version_.reset();
+    nav_msgs::msg::Path new_path;
+    input_path_port_.get(new_path);
+    if (!nav2_util::geometry_utils::is_same_path(new_path, path_)) {
+      path_ = std::move(new_path);
+      path_changed = true;
+    }
+  }
+
+  if (path_changed) {
+    updateCumulativeLength();
+    closest_pose_detection_begin_ = 0;
+  } else if (!path_pruning) {
+    closest_pose_detection_begin_ = 0;
   }
 
   if (!getRobotPose(path_.header.frame_id, pose)) {
@@ -66,45 +89,73 @@ inline BT::NodeStatus TruncatePathLocal::tick()
   }
 
   if (path_.poses.empty()) {
-    setOutput("output_path", path_);
+    setVersionedOutput(*this, "output_path", path_);
     return BT::NodeStatus::SUCCESS;
   }
 
   auto closest_pose_detection_end = path_.poses.end();
   if (path_pruning) {
-    closest_pose_detection_end = nav2_util::geometry_utils::first_after_integrated_distance(
-      closest_pose_detection_begin_, path_.poses.end(), max_robot_pose_search_dist);
+    closest_pose_detection_end = path_.poses.begin() +
+      firstAfterDistance(closest_pose_detection_begin_, max_robot_pose_search_dist);
   }
 
   // find the closest pose on the path
   auto current_pose = nav2_util::geometry_utils::min_by(
-    closest_pose_detection_begin_, closest_pose_detection_end,
+    path_.poses.begin() + closest_pose_detection_begin_, closest_pose_detection_end,
     [&pose, angular_distance_weight](const geometry_msgs::msg::PoseStamped & ps) {
       return poseDistance(pose, ps, angular_distance_weight);
     });
+  const size_t current_idx = current_pose - path_.poses.begin();
 
   if (path_pruning) {
-    closest_pose_detection_begin_ = current_pose;
+    closest_pose_detection_begin_ = current_idx;
   }
 
-  // expand forwards to extract desired length
-  auto forward_pose_it = nav2_util::geometry_utils::first_after_integrated_distance(
-    current_pose, path_.poses.end(), distance_forward);
-
-  // expand backwards to extract desired length
-  // Note: current_pose + 1 is used because reverse iterator points to a cell before it
-  auto backward_pose_it = nav2_util::geometry_utils::first_after_integrated_distance(
-    std::reverse_iterator(current_pose + 1), path_.poses.rend(), distance_backward);
+  // expand forwards and backwards to extract desired length
+  auto forward_pose_it = path_.poses.begin() + firstAfterDistance(current_idx, distance_forward);
+  auto backward_pose_it = path_.poses.begin() + lastBeforeDistance(current_idx, distance_backward);
 
   nav_msgs::msg::Path output_path;
   output_path.header = path_.header;
   output_path.poses = std::vector<geometry_msgs::msg::PoseStamped>(
-    backward_pose_it.base(), forward_pose_it);
-  setOutput("output_path", output_path);
+    backward_pose_it, forward_pose_it);
+  setVersionedOutput(*this, "output_path", output_path);
 
   return BT::NodeStatus::SUCCESS;
 }
 
+void TruncatePathLocal::updateCumulativeLength()
+{
+  cumulative_length_.resize(path_.poses.size());
+  double length = 0.0;
+  for (size_t idx = 0; idx < path_.poses.size(); ++idx) {
+    if (idx > 0) {
+      length += nav2_util::geometry_utils::euclidean_distance(
+        path_.poses[idx - 1], path_.poses[idx]);
+    }
+    cumulative_length_[idx] = length;
+  }
+}
+
+size_t TruncatePathLocal::firstAfterDistance(size_t begin, double distance) const
+{
+  // First pose further than distance along the path, or the path end
+  const double limit = cumulative_length_[begin] + distance;
+  return std::upper_bound(
+    cumulative_length_.begin() + begin + 1, cumulative_length_.end(), limit) -
+         cumulative_length_.begin();
+}
+
+size_t TruncatePathLocal::lastBeforeDistance(size_t end, double distance) const
+{
+  // First pose within distance back along the path from end, and never past end
+  const double limit = cumulative_length_[end] - distance;
+  const size_t idx = std::lower_bound(
+    cumulative_length_.begin(), cumulative_length_.begin() + end, limit) -
+    cumulative_length_.begin();
+  return std::min(idx, end);
+}
+
 inline bool TruncatePathLocal::getRobotPose(
   std::string path_frame_id, geometry_msgs::msg::PoseStamped & pose)
 {
@@ -14,6 +14,7 @@
 
 #include <vector>
 #include <string>
+#include <utility>
 
 #include "nav2_behavior_tree/plugins/condition/globally_updated_goal_condition.hpp"
 
@@ -24,7 +25,9 @@ GloballyUpdatedGoalCondition::GloballyUpdatedGoalCondition(
   const std::string & condition_name,
   const BT::NodeConfiguration & conf)
 : BT::ConditionNode(condition_name, conf),
-  first_time(true)
+  first_time(true),
+  goals_entry_(config().blackboard, "goals"),
+  goal_entry_(config().blackboard, "goal")
 {
   node_ = config().blackboard->get<rclcpp::Node::SharedPtr>("node");
 }
@@ -33,19 +36,19 @@ BT::NodeStatus GloballyUpdatedGoalCondition::tick()
 {
   if (first_time) {
     first_time = false;
-    config().blackboard->get<std::vector<geometry_msgs::msg::PoseStamped>>("goals", goals_);
-    config().blackboard->get<geometry_msgs::msg::PoseStamped>("goal", goal_);
+    goals_entry_.get(goals_);
+    goal_entry_.get(goal_);
     return BT::NodeStatus::SUCCESS;
   }
 
   std::vector<geometry_msgs::msg::PoseStamped> current_goals;
-  config().blackboard->get<std::vector<geometry_msgs::msg::PoseStamped>>("goals", current_goals);
+  goals_entry_.get(current_goals);
   geometry_msgs::msg::PoseStamped current_goal;
-  config().blackboard->get<geometry_msgs::msg::PoseStamped>("goal", current_goal);
+  goal_entry_.get(current_goal);
 
   if (goal_ != current_goal || goals_ != current_goals) {
-    goal_ = current_goal;
-    goals_ = current_goals;
+    goal_ = std::move(current_goal);
+    goals_ = std::move(current_goals);
     return BT::NodeStatus::SUCCESS;
   }
 
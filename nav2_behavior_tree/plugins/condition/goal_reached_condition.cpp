@@ -29,7 +29,8 @@ GoalReachedCondition::GoalReachedCondition(
   const std::string & condition_name,
   const BT::NodeConfiguration & conf)
 : BT::ConditionNode(condition_name, conf),
-  initialized_(false)
+  initialized_(false),
+  goal_port_(*this, "goal")
 {
   auto node = config().blackboard->get<rclcpp::Node::SharedPtr>("node");
 
@@ -83,7 +84,7 @@ bool GoalReachedCondition::isGoalReached()
   }
 
   geometry_msgs::msg::PoseStamped goal;
-  getInput("goal", goal);
+  goal_port_.get(goal);
   double dx = goal.pose.position.x - current_pose.pose.position.x;
   double dy = goal.pose.position.y - current_pose.pose.position.y;
 
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <string>
+#include <utility>
 #include <vector>
 #include "nav2_behavior_tree/plugins/condition/goal_updated_condition.hpp"
 
@@ -22,25 +23,27 @@ namespace nav2_behavior_tree
 GoalUpdatedCondition::GoalUpdatedCondition(
   const std::string & condition_name,
   const BT::NodeConfiguration & conf)
-: BT::ConditionNode(condition_name, conf)
+: BT::ConditionNode(condition_name, conf),
+  goals_entry_(config().blackboard, "goals"),
+  goal_entry_(config().blackboard, "goal")
 {}
 
 BT::NodeStatus GoalUpdatedCondition::tick()
 {
   if (status() == BT::NodeStatus::IDLE) {
-    config().blackboard->get<std::vector<geometry_msgs::msg::PoseStamped>>("goals", goals_);
-    config().blackboard->get<geometry_msgs::msg::PoseStamped>("goal", goal_);
+    goals_entry_.get(goals_);
+    goal_entry_.get(goal_);
     return BT::NodeStatus::FAILURE;
   }
 
   std::vector<geometry_msgs::msg::PoseStamped> current_goals;
-  config().blackboard->get<std::vector<geometry_msgs::msg::PoseStamped>>("goals", current_goals);
+  goals_entry_.get(current_goals);
   geometry_msgs::msg::PoseStamped current_goal;
-  config().blackboard->get<geometry_msgs::msg::PoseStamped>("goal", current_goal);
+  goal_entry_.get(current_goal);
 
   if (goal_ != current_goal || goals_ != current_goals) {
-    goal_ = current_goal;
-    goals_ = current_goals;
+    goal_ = std::move(current_goal);
+    goals_ = std::move(current_goals);
     return BT::NodeStatus::SUCCESS;
   }
 
@@ -14,6 +14,7 @@
 
 #include <string>
 #include <memory>
+#include <utility>
 
 #include "behaviortree_cpp_v3/condition_node.h"
 
@@ -27,7 +28,8 @@ PathExpiringTimerCondition::PathExpiringTimerCondition(
   const BT::NodeConfiguration & conf)
 : BT::ConditionNode(condition_name, conf),
   period_(1.0),
-  first_time_(true)
+  first_time_(true),
+  path_port_(*this, "path")
 {
   getInput("seconds", period_);
   node_ = config().blackboard->get<rclcpp::Node::SharedPtr>("node");
@@ -36,7 +38,7 @@ PathExpiringTimerCondition::PathExpiringTimerCondition(
 BT::NodeStatus PathExpiringTimerCondition::tick()
 {
   if (first_time_) {
-    getInput("path", prev_path_);
+    path_port_.get(prev_path_);
     first_time_ = false;
     start_ = node_->now();
     return BT::NodeStatus::FAILURE;
@@ -44,11 +46,11 @@ BT::NodeStatus PathExpiringTimerCondition::tick()
 
   // Grab the new path
   nav_msgs::msg::Path path;
-  getInput("path", path);
+  path_port_.get(path);
 
   // Reset timer if the path has been updated
   if (prev_path_ != path) {
-    prev_path_ = path;
+    prev_path_ = std::move(path);
     start_ = node_->now();
   }
 
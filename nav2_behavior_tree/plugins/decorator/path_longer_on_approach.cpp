@@ -14,6 +14,7 @@
 
 #include <string>
 #include <memory>
+#include <utility>
 #include <vector>
 #include "nav2_util/geometry_utils.hpp"
 
@@ -25,42 +26,72 @@ namespace nav2_behavior_tree
 PathLongerOnApproach::PathLongerOnApproach(
   const std::string & name,
   const BT::NodeConfiguration & conf)
-: BT::DecoratorNode(name, conf)
+: BT::DecoratorNode(name, conf),
+  path_port_(*this, "path"),
+  prox_len_port_(*this, "prox_len"),
+  length_factor_port_(*this, "length_factor")
 {
   node_ = config().blackboard->get<rclcpp::Node::SharedPtr>("node");
 }
 
-bool PathLongerOnApproach::isPathUpdated(
-  nav_msgs::msg::Path & new_path,
-  nav_msgs::msg::Path & old_path)
+bool PathLongerOnApproach::isPathUpdated()
 {
-  return new_path != old_path && old_path.poses.size() != 0 &&
-         new_path.poses.size() != 0 &&
-         old_path.poses.back() == new_path.poses.back();
+  return path_changed_ && old_path_.poses.size() != 0 && new_path_.poses.size() != 0 &&
+         old_path_.poses.back() == new_path_.poses.back();
 }
 
-bool PathLongerOnApproach::isRobotInGoalProximity(
-  nav_msgs::msg::Path & old_path,
-  double & prox_leng)
+bool PathLongerOnApproach::isRobotInGoalProximity()
 {
-  return nav2_util::geometry_utils::calculate_path_length(old_path, 0) < prox_leng;
+  return getPathLength(old_path_, old_path_length_) < prox_len_;
 }
 
-bool PathLongerOnApproach::isNewPathLonger(
-  nav_msgs::msg::Path & new_path,
-  nav_msgs::msg::Path & old_path,
-  double & length_factor)
+bool PathLongerOnApproach::isNewPathLonger()
 {
-  return nav2_util::geometry_utils::calculate_path_length(new_path, 0) >
-         length_factor * nav2_util::geometry_utils::calculate_path_length(
-    old_path, 0);
+  return getPathLength(new_path_, new_path_length_) >
+         length_factor_ * getPathLength(old_path_, old_path_length_);
+}
+
+double PathLongerOnApproach::getPathLength(const nav_msgs::msg::Path & path, double & length)
+{
+  if (length < 0.0) {
+    length = nav2_util::geometry_utils::calculate_path_length(path, 0);
+  }
+  return length;
+}
+
+void PathLongerOnApproach::updateOldPath()
+{
+  // The new path is read again on the next tick, so it can be swapped in
+  if (path_changed_) {
+    std::swap(old_path_, new_path_);
+    old_path_length_ = new_path_length_;
+  }
+  old_path_version_ = new_path_version_;
 }
 
 inline BT::NodeStatus PathLongerOnApproach::tick()
 {
-  getInput("path", new_path_);
-  getInput("prox_len", prox_len_);
-  getInput("length_factor", length_factor_);
+  prox_len_port_.get(prox_len_);
+  length_factor_port_.get(length_factor_);
+
+  // A versioned path is only read and compared once replaced
+  uint64_t version;
+  new_path_version_.reset();
+  if (path_port_.getVersion(version)) {
+    new_path_version_ = version;
+  }
+
+  if (new_path_version_ && new_path_version_ == old_path_version_) {
+    path_changed_ = false;
+  } else {
+    if (!path_port_.get(new_path_)) {
+      new_path_ = old_path_;
+    }
+    path_changed_ = !nav2_util::geometry_utils::is_same_path(new_path_, old_path_);
+  }
+
+  // The lengths are only computed again once the path changed
+  new_path_length_ = path_changed_ ? -1.0 : old_path_length_;
 
   if (status() == BT::NodeStatus::IDLE) {
     // Reset the starting point since we're starting a new iteration of
@@ -72,25 +103,23 @@ inline BT::NodeStatus PathLongerOnApproach::tick()
 
   // Check if the path is updated and valid, compare the old and the new path length,
   // given the goal proximity and check if the new path is longer
-  if (isPathUpdated(new_path_, old_path_) && isRobotInGoalProximity(old_path_, prox_len_) &&
-    isNewPathLonger(new_path_, old_path_, length_factor_) && !first_time_)
-  {
+  if (isPathUpdated() && isRobotInGoalProximity() && isNewPathLonger() && !first_time_) {
     const BT::NodeStatus child_state = child_node_->executeTick();
     switch (child_state) {
       case BT::NodeStatus::RUNNING:
         return BT::NodeStatus::RUNNING;
       case BT::NodeStatus::SUCCESS:
-        old_path_ = new_path_;
+        updateOldPath();
         return BT::NodeStatus::SUCCESS;
       case BT::NodeStatus::FAILURE:
-        old_path_ = new_path_;
+        updateOldPath();
         return BT::NodeStatus::FAILURE;
       default:
-        old_path_ = new_path_;
+        updateOldPath();
         return BT::NodeStatus::FAILURE;
     }
   }
-  old_path_ = new_path_;
+  updateOldPath();
   first_time_ = false;
   return BT::NodeStatus::SUCCESS;
 }
@@ -17,6 +17,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "nav_msgs/msg/path.hpp"
 #include "geometry_msgs/msg/pose_stamped.hpp"
@@ -140,6 +141,7 @@ TEST_F(FollowPathActionTestFixture, test_tick)
   EXPECT_EQ(action_server_->getCurrentGoal()->path.poses.size(), 1u);
   EXPECT_EQ(action_server_->getCurrentGoal()->path.poses[0].pose.position.x, 1.0);
   EXPECT_EQ(action_server_->getCurrentGoal()->controller_id, std::string("FollowPath"));
+  EXPECT_TRUE(action_server_->getCurrentGoal()->velocities.empty());
 
   // halt node so another goal can be sent
   tree_->rootNode()->halt();
@@ -158,6 +160,35 @@ TEST_F(FollowPathActionTestFixture, test_tick)
   EXPECT_EQ(action_server_->getCurrentGoal()->path.poses[0].pose.position.x, -2.5);
 }
 
+TEST_F(FollowPathActionTestFixture, test_velocity_profile)
+{
+  // create tree
+  std::string xml_txt =
+    R"(
+      <root main_tree_to_execute = "MainTree" >
+        <BehaviorTree ID="MainTree">
+            <FollowPath path="{path}" velocities="{velocities}"/>
+        </BehaviorTree>
+      </root>)";
+
+  tree_ = std::make_shared<BT::Tree>(factory_->createTreeFromText(xml_txt, config_->blackboard));
+
+  // set a path with its velocity profile on blackboard
+  nav_msgs::msg::Path path;
+  path.poses.resize(2);
+  path.poses[1].pose.position.x = 1.0;
+  config_->blackboard->set<nav_msgs::msg::Path>("path", path);
+  config_->blackboard->set<std::vector<double>>("velocities", {0.5, 0.0});
+
+  while (tree_->rootNode()->status() != BT::NodeStatus::SUCCESS) {
+    tree_->rootNode()->executeTick();
+  }
+
+  // the profile is sent along with the path
+  EXPECT_EQ(action_server_->getCurrentGoal()->path.poses.size(), 2u);
+  EXPECT_EQ(action_server_->getCurrentGoal()->velocities, std::vector<double>({0.5, 0.0}));
+}
+
 int main(int argc, char ** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -18,6 +18,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "nav_msgs/msg/path.hpp"
 
@@ -41,6 +42,12 @@ protected:
   {
     const auto goal = goal_handle->get_goal();
     auto result = std::make_shared<nav2_msgs::action::SmoothPath::Result>();
+    result->path = goal->path;
+    // Velocity profile of the path, the poses being reached every 2 seconds
+    for (size_t i = 0; i < goal->path.poses.size(); ++i) {
+      result->velocities.push_back(0.5);
+      result->times_from_start.push_back(rclcpp::Duration::from_seconds(2.0 * i));
+    }
     goal_handle->succeed(result);
   }
 };
@@ -117,7 +124,8 @@ TEST_F(SmoothPathActionTestFixture, test_tick)
     R"(
       <root main_tree_to_execute = "MainTree" >
         <BehaviorTree ID="MainTree">
-            <SmoothPath unsmoothed_path="{unsmoothed_path}" />
+            <SmoothPath unsmoothed_path="{unsmoothed_path}" velocities="{velocities}"
+              times_from_start="{times_from_start}" />
         </BehaviorTree>
       </root>)";
 
@@ -143,6 +151,8 @@ TEST_F(SmoothPathActionTestFixture, test_tick)
   pose.pose.position.x = -2.5;
   pose.pose.orientation.x = 1.0;
   path.poses.push_back(pose);
+  pose.pose.position.x = -1.5;
+  path.poses.push_back(pose);
   config_->blackboard->set<nav_msgs::msg::Path>("unsmoothed_path", path);
 
   while (tree_->rootNode()->status() != BT::NodeStatus::SUCCESS) {
@@ -153,6 +163,13 @@ TEST_F(SmoothPathActionTestFixture, test_tick)
   EXPECT_NE(path_empty, path);
   EXPECT_EQ(action_server_->getCurrentGoal()->path, path);
   EXPECT_EQ(tree_->rootNode()->status(), BT::NodeStatus::SUCCESS);
+
+  // the velocity profile of the result is output for the path follower
+  EXPECT_EQ(
+    config_->blackboard->get<std::vector<double>>("velocities"), std::vector<double>({0.5, 0.5}));
+  EXPECT_EQ(
+    config_->blackboard->get<std::vector<double>>("times_from_start"),
+    std::vector<double>({0.0, 2.0}));
 }
 
 int main(int argc, char ** argv)
@@ -118,6 +118,7 @@ TEST_F(TruncatePathLocalTestFixture, test_tick)
             pose="{pose}"
             input_path="{path}"
             output_path="{truncated_path}"
+            max_robot_pose_search_dist="infinity"
           />
         </BehaviorTree>
       </root>)";
@@ -442,6 +443,130 @@ TEST_F(TruncatePathLocalTestFixture, test_path_pruning)
   SUCCEED();
 }
 
+TEST_F(TruncatePathLocalTestFixture, test_path_modified_in_place)
+{
+  // create tree
+  std::string xml_txt =
+    R"(
+      <root main_tree_to_execute = "MainTree" >
+        <BehaviorTree ID="MainTree">
+          <TruncatePathLocal
+            distance_forward="1.0"
+            distance_backward="0.5"
+            robot_frame="base_link"
+            transform_tolerance="0.2"
+            angular_distance_weight="0.0"
+            pose="{pose}"
+            input_path="{path}"
+            output_path="{truncated_path}"
+            max_robot_pose_search_dist="3.0"
+          />
+        </BehaviorTree>
+      </root>)";
+
+  tree_ = std::make_shared<BT::Tree>(factory_->createTreeFromText(xml_txt, config_->blackboard));
+
+  // straight path along x, with a pose every 0.5m
+  nav_msgs::msg::Path path;
+  path.header.stamp = node_->now();
+  path.header.frame_id = "map";
+  for (int i = 0; i <= 10; ++i) {
+    path.poses.push_back(poseMsg(0.5 * i, 0.0, 0.0));
+  }
+  config_->blackboard->set("path", path);
+  config_->blackboard->set("pose", poseMsg(1.0, 0.0, 0.0));
+
+  tree_->rootNode()->executeTick();
+  EXPECT_EQ(tree_->rootNode()->status(), BT::NodeStatus::SUCCESS);
+  nav_msgs::msg::Path truncated_path;
+  config_->blackboard->get("truncated_path", truncated_path);
+  ASSERT_EQ(truncated_path.poses.size(), 4u);
+  EXPECT_EQ(truncated_path.poses.front().pose.position.x, 0.5);
+  EXPECT_EQ(truncated_path.poses.back().pose.position.x, 2.0);
+
+  // the same path smoothed in place, keeping its header and ends, is truncated again
+  path.poses[3].pose.position.y = 0.3;
+  config_->blackboard->set("path", path);
+
+  tree_->haltTree();
+  tree_->rootNode()->executeTick();
+  EXPECT_EQ(tree_->rootNode()->status(), BT::NodeStatus::SUCCESS);
+  config_->blackboard->get("truncated_path", truncated_path);
+  ASSERT_EQ(truncated_path.poses.size(), 3u);
+  EXPECT_EQ(truncated_path.poses.front().pose.position.x, 0.5);
+  EXPECT_EQ(truncated_path.poses.back().pose.position.x, 1.5);
+  EXPECT_EQ(truncated_path.poses.back().pose.position.y, 0.3);
+}
+
+TEST_F(TruncatePathLocalTestFixture, test_versioned_path)
+{
+  // create tree
+  std::string xml_txt =
+    R"(
+      <root main_tree_to_execute = "MainTree" >
+        <BehaviorTree ID="MainTree">
+          <TruncatePathLocal
+            distance_forward="1.0"
+            distance_backward="0.5"
+            robot_frame="base_link"
+            transform_tolerance="0.2"
+            angular_distance_weight="0.0"
+            pose="{pose}"
+            input_path="{path}"
+            output_path="{truncated_path}"
+          />
+        </BehaviorTree>
+      </root>)";
+
+  tree_ = std::make_shared<BT::Tree>(factory_->createTreeFromText(xml_txt, config_->blackboard));
+
+  // straight path along x, with a pose every 0.5m, written as path planners do
+  nav_msgs::msg::Path path;
+  path.header.stamp = node_->now();
+  path.header.frame_id = "map";
+  for (int i = 0; i <= 10; ++i) {
+    path.poses.push_back(poseMsg(0.5 * i, 0.0, 0.0));
+  }
+  config_->blackboard->set("path", path);
+  nav2_behavior_tree::incrementVersion(config_->blackboard, "path");
+  config_->blackboard->set("pose", poseMsg(1.0, 0.0, 0.0));
+  const std::string output_version_key = nav2_behavior_tree::getVersionKey("truncated_path");
+  uint64_t previous_output_version = 0;
+  config_->blackboard->get(output_version_key, previous_output_version);
+
+  tree_->rootNode()->executeTick();
+  EXPECT_EQ(tree_->rootNode()->status(), BT::NodeStatus::SUCCESS);
+  nav_msgs::msg::Path truncated_path;
+  config_->blackboard->get("truncated_path", truncated_path);
+  ASSERT_EQ(truncated_path.poses.size(), 4u);
+  EXPECT_EQ(truncated_path.poses.front().pose.position.x, 0.5);
+  EXPECT_EQ(truncated_path.poses.back().pose.position.x, 2.0);
+
+  // the output is versioned as well
+  uint64_t output_version = 0;
+  EXPECT_TRUE(config_->blackboard->get(output_version_key, output_version));
+  EXPECT_EQ(output_version, previous_output_version + 1);
+
+  // the path of the same version is not read again
+  path.poses[3].pose.position.y = 0.3;
+  config_->blackboard->set("path", path);
+
+  tree_->haltTree();
+  tree_->rootNode()->executeTick();
+  config_->blackboard->get("truncated_path", truncated_path);
+  ASSERT_EQ(truncated_path.poses.size(), 4u);
+  EXPECT_EQ(truncated_path.poses[2].pose.position.y, 0.0);
+
+  // until its version is incremented
+  nav2_behavior_tree::incrementVersion(config_->blackboard, "path");
+
+  tree_->haltTree();
+  tree_->rootNode()->executeTick();
+  config_->blackboard->get("truncated_path", truncated_path);
+  ASSERT_EQ(truncated_path.poses.size(), 3u);
+  EXPECT_EQ(truncated_path.poses.back().pose.position.y, 0.3);
+}
+
 int main(int argc, char ** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -147,6 +147,44 @@ TEST_F(PathLongerOnApproachTestFixture, test_tick)
   EXPECT_EQ(tree_->rootNode()->status(), BT::NodeStatus::FAILURE);
 }
 
+TEST_F(PathLongerOnApproachTestFixture, test_path_modified_in_place)
+{
+  // create tree
+  std::string xml_txt =
+    R"(
+      <root main_tree_to_execute = "MainTree" >
+        <BehaviorTree ID="MainTree">
+          <PathLongerOnApproach path="{path}" prox_len="20.0" length_factor="1.5">
+            <AlwaysFailure/>
+          </PathLongerOnApproach>
+        </BehaviorTree>
+      </root>)";
+
+  tree_ = std::make_shared<BT::Tree>(factory_->createTreeFromText(xml_txt, config_->blackboard));
+
+  // straight stamped path of 4m
+  nav_msgs::msg::Path path;
+  path.header.stamp = node_->now();
+  path.header.frame_id = "map";
+  path.poses.resize(5);
+  for (unsigned int i = 0; i < path.poses.size(); i++) {
+    path.poses[i].pose.position.x = 1.0 * i;
+  }
+  config_->blackboard->set<nav_msgs::msg::Path>("path", path);
+  tree_->rootNode()->executeTick();
+  EXPECT_EQ(tree_->rootNode()->status(), BT::NodeStatus::SUCCESS);
+
+  // the same path is not updated
+  tree_->rootNode()->executeTick();
+  EXPECT_EQ(tree_->rootNode()->status(), BT::NodeStatus::SUCCESS);
+
+  // the path modified in place, keeping its header and ends, is much longer
+  path.poses[2].pose.position.y = 5.0;
+  config_->blackboard->set<nav_msgs::msg::Path>("path", path);
+  tree_->rootNode()->executeTick();
+  EXPECT_EQ(tree_->rootNode()->status(), BT::NodeStatus::FAILURE);
+}
+
 int main(int argc, char ** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
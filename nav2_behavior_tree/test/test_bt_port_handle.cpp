@@ -0,0 +1,197 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+#include "nav_msgs/msg/path.hpp"
+
+#include "behaviortree_cpp_v3/bt_factory.h"
+#include "nav2_behavior_tree/bt_utils.hpp"
+#include "nav2_behavior_tree/bt_port_handle.hpp"
+
+class HandleTestNode : public BT::SyncActionNode
+{
+public:
+  HandleTestNode(const std::string & name, const BT::NodeConfiguration & config)
+  : SyncActionNode(name, config),
+    path_port_(*this, "path"),
+    id_port_(*this, "id"),
+    distance_port_(*this, "distance"),
+    missing_port_(*this, "missing")
+  {}
+
+  BT::NodeStatus tick() override
+  {
+    return BT::NodeStatus::SUCCESS;
+  }
+
+  static BT::PortsList providedPorts()
+  {
+    return {
+      BT::InputPort<nav_msgs::msg::Path>("path"),
+      BT::InputPort<std::string>("id"),
+      BT::InputPort<double>("distance", 1.0, ""),
+      BT::InputPort<double>("missing")
+    };
+  }
+
+  nav2_behavior_tree::InputPortHandle<nav_msgs::msg::Path> path_port_;
+  nav2_behavior_tree::InputPortHandle<std::string> id_port_;
+  nav2_behavior_tree::InputPortHandle<double> distance_port_;
+  nav2_behavior_tree::InputPortHandle<double> missing_port_;
+};
+
+class VersionedWriterNode : public BT::SyncActionNode
+{
+public:
+  VersionedWriterNode(const std::string & name, const BT::NodeConfiguration & config)
+  : SyncActionNode(name, config)
+  {}
+
+  BT::NodeStatus tick() override
+  {
+    nav_msgs::msg::Path path;
+    path.poses.resize(++size_);
+    nav2_behavior_tree::setVersionedOutput(*this, "output", path);
+    return BT::NodeStatus::SUCCESS;
+  }
+
+  static BT::PortsList providedPorts()
+  {
+    return {BT::OutputPort<nav_msgs::msg::Path>("output")};
+  }
+
+  size_t size_{0};
+};
+
+TEST(InputPortHandleTest, test_ports)
+{
+  std::string xml_txt =
+    R"(
+      <root main_tree_to_execute = "MainTree" >
+        <BehaviorTree ID="MainTree">
+            <HandleTestNode path="{path}" id="FollowPath"/>
+        </BehaviorTree>
+      </root>)";
+
+  BT::BehaviorTreeFactory factory;
+  factory.registerNodeType<HandleTestNode>("HandleTestNode");
+  auto blackboard = BT::Blackboard::create();
+  auto tree = factory.createTreeFromText(xml_txt, blackboard);
+  auto node = dynamic_cast<HandleTestNode *>(tree.rootNode());
+  ASSERT_NE(node, nullptr);
+
+  // Literal and default values
+  std::string id;
+  EXPECT_TRUE(node->id_port_.get(id));
+  EXPECT_EQ(id, "FollowPath");
+  double distance = 0.0;
+  EXPECT_TRUE(node->distance_port_.get(distance));
+  EXPECT_EQ(distance, 1.0);
+  double missing = 0.0;
+  EXPECT_FALSE(node->missing_port_.get(missing));
+
+  // Blackboard entries are followed as they change
+  nav_msgs::msg::Path path;
+  path.poses.resize(10);
+  blackboard->set<nav_msgs::msg::Path>("path", path);
+  nav_msgs::msg::Path read_path;
+  EXPECT_TRUE(node->path_port_.get(read_path));
+  EXPECT_EQ(read_path, path);
+
+  path.poses.resize(20);
+  blackboard->set<nav_msgs::msg::Path>("path", path);
+  EXPECT_TRUE(node->path_port_.get(read_path));
+  EXPECT_EQ(read_path.poses.size(), 20u);
+}
+
+TEST(BlackboardEntryHandleTest, test_entries)
+{
+  auto blackboard = BT::Blackboard::create();
+  nav2_behavior_tree::BlackboardEntryHandle<int> handle(blackboard, "count");
+
+  int value = 3;
+  EXPECT_FALSE(handle.get(value));
+  EXPECT_EQ(value, 3);
+
+  // Entries created after the handle are found
+  blackboard->set<int>("count", 5);
+  EXPECT_TRUE(handle.get(value));
+  EXPECT_EQ(value, 5);
+
+  handle.set(7);
+  EXPECT_EQ(blackboard->get<int>("count"), 7);
+  EXPECT_TRUE(handle.get(value));
+  EXPECT_EQ(value, 7);
+
+  // Entries set from strings are converted
+  auto string_blackboard = BT::Blackboard::create();
+  string_blackboard->set<std::string>("count", "11");
+  nav2_behavior_tree::BlackboardEntryHandle<int> string_handle(string_blackboard, "count");
+  EXPECT_TRUE(string_handle.get(value));
+  EXPECT_EQ(value, 11);
+}
+
+TEST(InputPortHandleTest, test_versions)
+{
+  std::string xml_txt =
+    R"(
+      <root main_tree_to_execute = "MainTree" >
+        <BehaviorTree ID="MainTree">
+          <Sequence>
+            <VersionedWriterNode output="{path}"/>
+            <HandleTestNode path="{path}" id="FollowPath"/>
+          </Sequence>
+        </BehaviorTree>
+      </root>)";
+
+  BT::BehaviorTreeFactory factory;
+  factory.registerNodeType<VersionedWriterNode>("VersionedWriterNode");
+  factory.registerNodeType<HandleTestNode>("HandleTestNode");
+  auto blackboard = BT::Blackboard::create();
+  auto tree = factory.createTreeFromText(xml_txt, blackboard);
+  HandleTestNode * node = nullptr;
+  for (auto & tree_node : tree.nodes) {
+    if (auto handle_node = dynamic_cast<HandleTestNode *>(tree_node.get())) {
+      node = handle_node;
+    }
+  }
+  ASSERT_NE(node, nullptr);
+
+  // Not versioned until written
+  uint64_t version = 0;
+  EXPECT_FALSE(node->path_port_.getVersion(version));
+
+  // Each write increments the version of the entry
+  tree.tickRoot();
+  EXPECT_TRUE(node->path_port_.getVersion(version));
+  EXPECT_EQ(version, 1u);
+  EXPECT_EQ(blackboard->get<uint64_t>(nav2_behavior_tree::getVersionKey("path")), 1u);
+  tree.tickRoot();
+  EXPECT_TRUE(node->path_port_.getVersion(version));
+  EXPECT_EQ(version, 2u);
+  nav_msgs::msg::Path read_path;
+  EXPECT_TRUE(node->path_port_.get(read_path));
+  EXPECT_EQ(read_path.poses.size(), 2u);
+
+  // Writers outside of the tree increment it too
+  nav2_behavior_tree::incrementVersion(blackboard, "path");
+  EXPECT_TRUE(node->path_port_.getVersion(version));
+  EXPECT_EQ(version, 3u);
+
+  // Literal ports are not versioned
+  EXPECT_FALSE(node->id_port_.getVersion(version));
+}
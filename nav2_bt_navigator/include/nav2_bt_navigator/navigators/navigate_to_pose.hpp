@@ -27,6 +27,7 @@
 #include "nav2_util/robot_utils.hpp"
 #include "nav_msgs/msg/path.hpp"
 #include "nav2_util/odometry_utils.hpp"
+#include "nav2_util/path_progress_tracker.hpp"
 
 namespace nav2_bt_navigator
 {
@@ -129,6 +130,9 @@ protected:
 
   // Odometry smoother object
   std::shared_ptr<nav2_util::OdomSmoother> odom_smoother_;
+
+  // Progress along the path for the distance remaining feedback
+  nav2_util::PathProgressTracker path_progress_tracker_;
 };
 
 }  // namespace nav2_bt_navigator
@@ -16,7 +16,8 @@
 #include <string>
 #include <set>
 #include <memory>
-#include <limits>
+#include <optional>
+#include "nav2_behavior_tree/bt_port_handle.hpp"
 #include "nav2_bt_navigator/navigators/navigate_through_poses.hpp"
 
 namespace nav2_bt_navigator
@@ -119,29 +120,24 @@ NavigateThroughPosesNavigator::onLoop()
     feedback_utils_.transform_tolerance);
 
   try {
-    // Get current path points
-    nav_msgs::msg::Path current_path;
-    blackboard->get<nav_msgs::msg::Path>(path_blackboard_id_, current_path);
-
-    // Find the closest pose to current pose on global path
-    auto find_closest_pose_idx =
-      [&current_pose, &current_path]() {
-        size_t closest_pose_idx = 0;
-        double curr_min_dist = std::numeric_limits<double>::max();
-        for (size_t curr_idx = 0; curr_idx < current_path.poses.size(); ++curr_idx) {
-          double curr_dist = nav2_util::geometry_utils::euclidean_distance(
-            current_pose, current_path.poses[curr_idx]);
-          if (curr_dist < curr_min_dist) {
-            curr_min_dist = curr_dist;
-            closest_pose_idx = curr_idx;
-          }
-        }
-        return closest_pose_idx;
-      };
-
-    // Calculate distance on the path
-    double distance_remaining =
-      nav2_util::geometry_utils::calculate_path_length(current_path, find_closest_pose_idx());
+    // Get current path points, the progress along it is only reset once replanned.
+    // The path is only copied once its version changed, when its writers keep one
+    uint64_t path_version;
+    std::optional<uint64_t> version;
+    if (blackboard->get<uint64_t>(
+        nav2_behavior_tree::getVersionKey(path_blackboard_id_), path_version))
+    {
+      version = path_version;
+    }
+    if (!version || !path_progress_tracker_.isSameVersion(*version)) {
+      nav_msgs::msg::Path current_path;
+      blackboard->get<nav_msgs::msg::Path>(path_blackboard_id_, current_path);
+      path_progress_tracker_.setPath(
+        std::make_shared<const nav_msgs::msg::Path>(std::move(current_path)), version);
+    }
+
+    // Calculate distance on the path from the closest pose to current pose
+    double distance_remaining = path_progress_tracker_.update(current_pose);
 
     // Default value for time remaining
     rclcpp::Duration estimated_time_remaining = rclcpp::Duration::from_seconds(0.0);
@@ -211,6 +207,7 @@ NavigateThroughPosesNavigator::initializeGoalPoses(ActionT::Goal::ConstSharedPtr
   start_time_ = clock_->now();
   auto blackboard = bt_action_server_->getBlackboard();
   blackboard->set<int>("number_recoveries", 0);  // NOLINT
+  path_progress_tracker_.reset();
 
   // Update the goal pose on the blackboard
   blackboard->set<Goals>(goals_blackboard_id_, goal->poses);
@@ -18,6 +18,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <mutex>
 
 #include "rclcpp/rclcpp.hpp"
 #include "geometry_msgs/msg/twist.hpp"
@@ -56,6 +57,17 @@ public:
    */
   ~CollisionMonitor();
 
+  /**
+   * @brief Checks a velocity command against the polygons and sources, as a stage of an
+   * in-process command pipeline when the monitor is composed with the controller server,
+   * instead of subscribing to its output. It can run concurrently with the node callbacks,
+   * the sources and polygons data being synchronized with their subscriptions.
+   * @param cmd Desired robot velocity, replaced in place by the allowed one
+   * @return False if the command should not be sent: invalid, monitor not active,
+   * or robot stopped for longer than stop_pub_timeout_
+   */
+  bool processCommand(geometry_msgs::msg::Twist & cmd);
+
 protected:
   /**
    * @brief: Initializes and obtains ROS-parameters, creates main subscribers and publishers,
@@ -101,6 +113,13 @@ protected:
    * @param robot_action Robot action to publish
    */
   void publishVelocity(const Action & robot_action);
+  /**
+   * @brief Updates the stop timestamp and checks whether the robot action velocity
+   * should be sent, or if robot was stopped more than stop_pub_timeout_ seconds
+   * @param robot_action Robot action to send
+   * @return True if the velocity should be sent
+   */
+  bool shouldPublishVelocity(const Action & robot_action);
 
   /**
    * @brief Supporting routine obtaining all ROS-parameters
@@ -146,6 +165,14 @@ protected:
    */
   void process(const Velocity & cmd_vel_in);
 
+  /**
+   * @brief Collects the data from sources and finds the robot action from the polygons
+   * @param cmd_vel_in Input desired robot velocity
+   * @param robot_action Output robot action
+   * @return False if main worker is in non-active state, otherwise true
+   */
+  bool computeAction(const Velocity & cmd_vel_in, Action & robot_action);
+
   /**
    * @brief Processes the polygon of STOP, SLOWDOWN and LIMIT action type
    * @param polygon Polygon to process
@@ -210,6 +237,11 @@ protected:
   rclcpp_lifecycle::LifecyclePublisher<nav2_msgs::msg::CollisionMonitorState>::SharedPtr
     state_pub_;
 
+  /// @brief Serializes the processing of velocity commands, from the cmd_vel_in subscription
+  /// or processCommand(), with the lifecycle transitions. Guards process_active_,
+  /// robot_action_prev_ and stop_stamp_
+  std::mutex mutex_;
+
   /// @brief Whether main routine is active
   bool process_active_;
 
@@ -15,7 +15,9 @@
 #ifndef NAV2_COLLISION_MONITOR__POLYGON_HPP_
 #define NAV2_COLLISION_MONITOR__POLYGON_HPP_
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -237,7 +239,7 @@ protected:
   /// @brief Time step for robot movement simulation
   double simulation_time_step_;
   /// @brief Whether polygon is enabled
-  bool enabled_;
+  std::atomic<bool> enabled_;
   /// @brief Polygon subscription
   rclcpp::Subscription<geometry_msgs::msg::PolygonStamped>::SharedPtr polygon_sub_;
   /// @brief Footprint subscriber
@@ -261,6 +263,9 @@ protected:
 
   /// @brief Polygon points (vertices) in a base_frame_id_
   std::vector<Point> poly_;
+  /// @brief Guards poly_ and polygon_, updated by the polygon subscription callback
+  /// while being checked against on the thread processing the velocity commands
+  mutable std::mutex mutex_;
 };  // class Polygon
 
 }  // namespace nav2_collision_monitor
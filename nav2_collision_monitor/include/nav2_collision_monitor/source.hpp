@@ -15,6 +15,7 @@
 #ifndef NAV2_COLLISION_MONITOR__SOURCE_HPP_
 #define NAV2_COLLISION_MONITOR__SOURCE_HPP_
 
+#include <atomic>
 #include <memory>
 #include <vector>
 #include <string>
@@ -65,7 +66,9 @@ public:
 
   /**
    * @brief Adds latest data from source to the data array.
-   * Empty virtual method intended to be used in child implementations.
+   * Empty virtual method intended to be used in child implementations, which swap the latest
+   * message with std::atomic_store/atomic_load so that it can run concurrently with
+   * the subscription callback.
    * @param curr_time Current node time for data interpolation
    * @param data Array where the data from source to be added.
    * Added data is transformed to base_frame_id_ coordinate system at curr_time.
@@ -138,7 +141,7 @@ protected:
   /// considering the difference between current time and latest source time
   bool base_shift_correction_;
   /// @brief Whether source is enabled
-  bool enabled_;
+  std::atomic<bool> enabled_;
 };  // class Source
 
 }  // namespace nav2_collision_monitor
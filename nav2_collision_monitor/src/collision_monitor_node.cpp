@@ -97,7 +97,10 @@ CollisionMonitor::on_activate(const rclcpp_lifecycle::State & /*state*/)
   publishPolygons();
 
   // Activating main worker
-  process_active_ = true;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    process_active_ = true;
+  }
 
   // Creating bond connection
   createBond();
@@ -110,11 +113,16 @@ CollisionMonitor::on_deactivate(const rclcpp_lifecycle::State & /*state*/)
 {
   RCLCPP_INFO(get_logger(), "Deactivating");
 
-  // Deactivating main worker
-  process_active_ = false;
+  {
+    // Waits for a command being processed in the controller thread, if composed
+    std::lock_guard<std::mutex> lock(mutex_);
 
-  // Reset action type to default after worker deactivating
-  robot_action_prev_ = {DO_NOTHING, {-1.0, -1.0, -1.0}, ""};
+    // Deactivating main worker
+    process_active_ = false;
+
+    // Reset action type to default after worker deactivating
+    robot_action_prev_ = {DO_NOTHING, {-1.0, -1.0, -1.0}, ""};
+  }
 
   // Deactivating polygons
   for (std::shared_ptr<Polygon> polygon : polygons_) {
@@ -142,8 +150,11 @@ CollisionMonitor::on_cleanup(const rclcpp_lifecycle::State & /*state*/)
   cmd_vel_out_pub_.reset();
   state_pub_.reset();
 
-  polygons_.clear();
-  sources_.clear();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    polygons_.clear();
+    sources_.clear();
+  }
 
   tf_listener_.reset();
   tf_buffer_.reset();
@@ -170,7 +181,35 @@ void CollisionMonitor::cmdVelInCallback(geometry_msgs::msg::Twist::ConstSharedPt
   process({msg->linear.x, msg->linear.y, msg->angular.z});
 }
 
-void CollisionMonitor::publishVelocity(const Action & robot_action)
+bool CollisionMonitor::processCommand(geometry_msgs::msg::Twist & cmd)
+{
+  // If message contains NaN or Inf, drop it
+  if (!nav2_util::validateTwist(cmd)) {
+    RCLCPP_ERROR(get_logger(), "Velocity message contains NaNs or Infs! Ignoring as invalid!");
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  Action robot_action;
+  if (!computeAction({cmd.linear.x, cmd.linear.y, cmd.angular.z}, robot_action)) {
+    return false;
+  }
+
+  const bool publish = shouldPublishVelocity(robot_action);
+
+  // Publish polygons for better visualization
+  publishPolygons();
+
+  robot_action_prev_ = robot_action;
+
+  cmd = geometry_msgs::msg::Twist();
+  cmd.linear.x = robot_action.req_vel.x;
+  cmd.linear.y = robot_action.req_vel.y;
+  cmd.angular.z = robot_action.req_vel.tw;
+  return publish;
+}
+
+bool CollisionMonitor::shouldPublishVelocity(const Action & robot_action)
 {
   if (robot_action.req_vel.isZero()) {
     if (!robot_action_prev_.req_vel.isZero()) {
@@ -179,9 +218,17 @@ void CollisionMonitor::publishVelocity(const Action & robot_action)
     } else if (this->now() - stop_stamp_ > stop_pub_timeout_) {
       // More than stop_pub_timeout_ passed after robot has been stopped.
       // Cease publishing output cmd_vel.
-      return;
+      return false;
     }
   }
+  return true;
+}
+
+void CollisionMonitor::publishVelocity(const Action & robot_action)
+{
+  if (!shouldPublishVelocity(robot_action)) {
+    return;
+  }
 
   std::unique_ptr<geometry_msgs::msg::Twist> cmd_vel_out_msg =
     std::make_unique<geometry_msgs::msg::Twist>();
@@ -359,13 +406,30 @@ bool CollisionMonitor::configureSources(
 }
 
 void CollisionMonitor::process(const Velocity & cmd_vel_in)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  Action robot_action;
+  if (!computeAction(cmd_vel_in, robot_action)) {
+    return;
+  }
+
+  // Publish requred robot velocity
+  publishVelocity(robot_action);
+
+  // Publish polygons for better visualization
+  publishPolygons();
+
+  robot_action_prev_ = robot_action;
+}
+
+bool CollisionMonitor::computeAction(const Velocity & cmd_vel_in, Action & robot_action)
 {
   // Current timestamp for all inner routines prolongation
   rclcpp::Time curr_time = this->now();
 
   // Do nothing if main worker in non-active state
   if (!process_active_) {
-    return;
+    return false;
   }
 
   // Points array collected from different data sources in a robot base frame
@@ -379,7 +443,7 @@ void CollisionMonitor::process(const Velocity & cmd_vel_in)
   }
 
   // By default - there is no action
-  Action robot_action{DO_NOTHING, cmd_vel_in, ""};
+  robot_action = {DO_NOTHING, cmd_vel_in, ""};
   // Polygon causing robot action (if any)
   std::shared_ptr<Polygon> action_polygon;
 
@@ -414,13 +478,7 @@ void CollisionMonitor::process(const Velocity & cmd_vel_in)
     notifyActionState(robot_action, action_polygon);
   }
 
-  // Publish requred robot velocity
-  publishVelocity(robot_action);
-
-  // Publish polygons for better visualization
-  publishPolygons();
-
-  robot_action_prev_ = robot_action;
+  return true;
 }
 
 bool CollisionMonitor::processStopSlowdownLimit(
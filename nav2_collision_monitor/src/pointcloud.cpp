@@ -14,6 +14,7 @@
 
 #include "nav2_collision_monitor/pointcloud.hpp"
 
+#include <atomic>
 #include <functional>
 
 #include "sensor_msgs/point_cloud2_iterator.hpp"
@@ -69,12 +70,14 @@ void PointCloud::getData(
   const rclcpp::Time & curr_time,
   std::vector<Point> & data) const
 {
+  const auto latest = std::atomic_load(&data_);
+
   // Ignore data from the source if it is not being published yet or
   // not published for a long time
-  if (data_ == nullptr) {
+  if (latest == nullptr) {
     return;
   }
-  if (!sourceValid(data_->header.stamp, curr_time)) {
+  if (!sourceValid(latest->header.stamp, curr_time)) {
     return;
   }
 
@@ -84,7 +87,7 @@ void PointCloud::getData(
     // to the base frame and current time
     if (
       !nav2_util::getTransform(
-        data_->header.frame_id, data_->header.stamp,
+        latest->header.frame_id, latest->header.stamp,
         base_frame_id_, curr_time, global_frame_id_,
         transform_tolerance_, tf_buffer_, tf_transform))
     {
@@ -96,16 +99,16 @@ void PointCloud::getData(
     // frames.
     if (
       !nav2_util::getTransform(
-        data_->header.frame_id, base_frame_id_,
+        latest->header.frame_id, base_frame_id_,
         transform_tolerance_, tf_buffer_, tf_transform))
     {
       return;
     }
   }
 
-  sensor_msgs::PointCloud2ConstIterator<float> iter_x(*data_, "x");
-  sensor_msgs::PointCloud2ConstIterator<float> iter_y(*data_, "y");
-  sensor_msgs::PointCloud2ConstIterator<float> iter_z(*data_, "z");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_x(*latest, "x");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_y(*latest, "y");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_z(*latest, "z");
 
   // Refill data array with PointCloud points in base frame
   for (; iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
@@ -139,7 +142,7 @@ void PointCloud::getParameters(std::string & source_topic)
 
 void PointCloud::dataCallback(sensor_msgs::msg::PointCloud2::ConstSharedPtr msg)
 {
-  data_ = msg;
+  std::atomic_store(&data_, msg);
 }
 
 }  // namespace nav2_collision_monitor
@@ -15,6 +15,7 @@
 #include "nav2_collision_monitor/polygon.hpp"
 
 #include <exception>
+#include <mutex>
 #include <utility>
 
 #include "geometry_msgs/msg/point.hpp"
@@ -166,11 +167,13 @@ double Polygon::getTimeBeforeCollision() const
 
 void Polygon::getPolygon(std::vector<Point> & poly) const
 {
+  std::lock_guard<std::mutex> lock(mutex_);
   poly = poly_;
 }
 
 bool Polygon::isShapeSet()
 {
+  std::lock_guard<std::mutex> lock(mutex_);
   if (poly_.empty()) {
     RCLCPP_WARN(logger_, "[%s]: Polygon shape is not set yet", polygon_name_.c_str());
     return false;
@@ -180,6 +183,7 @@ bool Polygon::isShapeSet()
 
 void Polygon::updatePolygon()
 {
+  std::lock_guard<std::mutex> lock(mutex_);
   if (footprint_sub_ != nullptr) {
     // Get latest robot footprint from footprint subscriber
     std::vector<geometry_msgs::msg::Point> footprint_vec;
@@ -227,6 +231,7 @@ void Polygon::updatePolygon()
 
 int Polygon::getPointsInside(const std::vector<Point> & points) const
 {
+  std::lock_guard<std::mutex> lock(mutex_);
   int num = 0;
   for (const Point & point : points) {
     if (isPointInside(point)) {
@@ -278,8 +283,12 @@ void Polygon::publish()
   }
 
   // Actualize the time to current and publish the polygon
-  polygon_.header.stamp = node->now();
-  auto msg = std::make_unique<geometry_msgs::msg::PolygonStamped>(polygon_);
+  std::unique_ptr<geometry_msgs::msg::PolygonStamped> msg;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    polygon_.header.stamp = node->now();
+    msg = std::make_unique<geometry_msgs::msg::PolygonStamped>(polygon_);
+  }
   polygon_pub_->publish(std::move(msg));
 }
 
@@ -486,6 +495,7 @@ void Polygon::updatePolygon(geometry_msgs::msg::PolygonStamped::ConstSharedPtr m
   }
 
   // Set main poly_ vertices first time
+  std::lock_guard<std::mutex> lock(mutex_);
   poly_.resize(new_size);
   for (std::size_t i = 0; i < new_size; i++) {
     // Transform point coordinates from PolygonStamped frame -> to base frame
@@ -15,6 +15,7 @@
 #include "nav2_collision_monitor/range.hpp"
 
 #include <math.h>
+#include <atomic>
 #include <cmath>
 #include <functional>
 
@@ -69,21 +70,23 @@ void Range::getData(
   const rclcpp::Time & curr_time,
   std::vector<Point> & data) const
 {
+  const auto latest = std::atomic_load(&data_);
+
   // Ignore data from the source if it is not being published yet or
   // not being published for a long time
-  if (data_ == nullptr) {
+  if (latest == nullptr) {
     return;
   }
-  if (!sourceValid(data_->header.stamp, curr_time)) {
+  if (!sourceValid(latest->header.stamp, curr_time)) {
     return;
   }
 
   // Ignore data, if its range is out of scope of range sensor abilities
-  if (data_->range < data_->min_range || data_->range > data_->max_range) {
+  if (latest->range < latest->min_range || latest->range > latest->max_range) {
     RCLCPP_DEBUG(
       logger_,
       "[%s]: Data range %fm is out of {%f..%f} sensor span. Ignoring...",
-      source_name_.c_str(), data_->range, data_->min_range, data_->max_range);
+      source_name_.c_str(), latest->range, latest->min_range, latest->max_range);
     return;
   }
 
@@ -93,7 +96,7 @@ void Range::getData(
     // to the base frame and current time
     if (
       !nav2_util::getTransform(
-        data_->header.frame_id, data_->header.stamp,
+        latest->header.frame_id, latest->header.stamp,
         base_frame_id_, curr_time, global_frame_id_,
         transform_tolerance_, tf_buffer_, tf_transform))
     {
@@ -105,7 +108,7 @@ void Range::getData(
     // frames.
     if (
       !nav2_util::getTransform(
-        data_->header.frame_id, base_frame_id_,
+        latest->header.frame_id, base_frame_id_,
         transform_tolerance_, tf_buffer_, tf_transform))
     {
       return;
@@ -115,14 +118,14 @@ void Range::getData(
   // Calculate poses and refill data array
   float angle;
   for (
-    angle = -data_->field_of_view / 2;
-    angle < data_->field_of_view / 2;
+    angle = -latest->field_of_view / 2;
+    angle < latest->field_of_view / 2;
     angle += obstacles_angle_)
   {
     // Transform point coordinates from source frame -> to base frame
     tf2::Vector3 p_v3_s(
-      data_->range * std::cos(angle),
-      data_->range * std::sin(angle),
+      latest->range * std::cos(angle),
+      latest->range * std::sin(angle),
       0.0);
     tf2::Vector3 p_v3_b = tf_transform * p_v3_s;
 
@@ -131,12 +134,12 @@ void Range::getData(
   }
 
   // Make sure that last (field_of_view / 2) point will be in the data array
-  angle = data_->field_of_view / 2;
+  angle = latest->field_of_view / 2;
 
   // Transform point coordinates from source frame -> to base frame
   tf2::Vector3 p_v3_s(
-    data_->range * std::cos(angle),
-    data_->range * std::sin(angle),
+    latest->range * std::cos(angle),
+    latest->range * std::sin(angle),
     0.0);
   tf2::Vector3 p_v3_b = tf_transform * p_v3_s;
 
@@ -160,7 +163,7 @@ void Range::getParameters(std::string & source_topic)
 
 void Range::dataCallback(sensor_msgs::msg::Range::ConstSharedPtr msg)
 {
-  data_ = msg;
+  std::atomic_store(&data_, msg);
 }
 
 }  // namespace nav2_collision_monitor
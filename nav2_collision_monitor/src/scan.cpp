@@ -14,6 +14,7 @@
 
 #include "nav2_collision_monitor/scan.hpp"
 
+#include <atomic>
 #include <cmath>
 #include <functional>
 
@@ -68,12 +69,14 @@ void Scan::getData(
   const rclcpp::Time & curr_time,
   std::vector<Point> & data) const
 {
+  const auto latest = std::atomic_load(&data_);
+
   // Ignore data from the source if it is not being published yet or
   // not being published for a long time
-  if (data_ == nullptr) {
+  if (latest == nullptr) {
     return;
   }
-  if (!sourceValid(data_->header.stamp, curr_time)) {
+  if (!sourceValid(latest->header.stamp, curr_time)) {
     return;
   }
 
@@ -83,7 +86,7 @@ void Scan::getData(
     // to the base frame and current time
     if (
       !nav2_util::getTransform(
-        data_->header.frame_id, data_->header.stamp,
+        latest->header.frame_id, latest->header.stamp,
         base_frame_id_, curr_time, global_frame_id_,
         transform_tolerance_, tf_buffer_, tf_transform))
     {
@@ -95,7 +98,7 @@ void Scan::getData(
     // frames.
     if (
       !nav2_util::getTransform(
-        data_->header.frame_id, base_frame_id_,
+        latest->header.frame_id, base_frame_id_,
         transform_tolerance_, tf_buffer_, tf_transform))
     {
       return;
@@ -103,26 +106,26 @@ void Scan::getData(
   }
 
   // Calculate poses and refill data array
-  float angle = data_->angle_min;
-  for (size_t i = 0; i < data_->ranges.size(); i++) {
-    if (data_->ranges[i] >= data_->range_min && data_->ranges[i] <= data_->range_max) {
+  float angle = latest->angle_min;
+  for (size_t i = 0; i < latest->ranges.size(); i++) {
+    if (latest->ranges[i] >= latest->range_min && latest->ranges[i] <= latest->range_max) {
       // Transform point coordinates from source frame -> to base frame
       tf2::Vector3 p_v3_s(
-        data_->ranges[i] * std::cos(angle),
-        data_->ranges[i] * std::sin(angle),
+        latest->ranges[i] * std::cos(angle),
+        latest->ranges[i] * std::sin(angle),
         0.0);
       tf2::Vector3 p_v3_b = tf_transform * p_v3_s;
 
       // Refill data array
       data.push_back({p_v3_b.x(), p_v3_b.y()});
     }
-    angle += data_->angle_increment;
+    angle += latest->angle_increment;
   }
 }
 
 void Scan::dataCallback(sensor_msgs::msg::LaserScan::ConstSharedPtr msg)
 {
-  data_ = msg;
+  std::atomic_store(&data_, msg);
 }
 
 }  // namespace nav2_collision_monitor
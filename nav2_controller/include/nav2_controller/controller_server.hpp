@@ -30,6 +30,7 @@
 #include "nav2_msgs/action/follow_path.hpp"
 #include "nav2_msgs/msg/speed_limit.hpp"
 #include "nav_2d_utils/odom_subscriber.hpp"
+#include "nav2_util/cmd_vel_pipeline.hpp"
 #include "nav2_util/lifecycle_node.hpp"
 #include "nav2_util/simple_action_server.hpp"
 #include "nav2_util/robot_utils.hpp"
@@ -62,6 +63,15 @@ public:
    */
   ~ControllerServer();
 
+  /**
+   * @brief Set the stages applied to velocity commands before they are published,
+   * e.g. velocity smoothing and collision monitoring when those servers are composed in
+   * the same process, in place of chaining them through topics. Stop commands are published
+   * bypassing the pipeline, which is reset instead. To be set before activation.
+   * @param pipeline Command pipeline, or nullptr to publish the controller commands directly
+   */
+  void setCmdVelPipeline(std::shared_ptr<nav2_util::CmdVelPipeline> pipeline);
+
 protected:
   /**
    * @brief Configures controller parameters and member variables
@@ -155,12 +165,23 @@ protected:
   /**
    * @brief Assigns path to controller
    * @param path Path received from action server
+   * @param velocities Velocity profile of the path, the velocity to not exceed at each
+   * pose, or empty
    */
-  void setPlannerPath(const nav_msgs::msg::Path & path);
+  void setPlannerPath(
+    const nav_msgs::msg::Path & path,
+    const std::vector<double> & velocities = std::vector<double>());
   /**
    * @brief Calculates velocity and publishes to "cmd_vel" topic
    */
   void computeAndPublishVelocity();
+  /**
+   * @brief Limits a command to the velocity profile of the path at the pose closest to the
+   * robot, scaling it as a whole to keep its curvature. The stops of the profile, at cusps,
+   * in-place rotations and the goal, are left to the controller
+   * @param cmd_vel Velocity command, modified in place
+   */
+  void applyVelocityProfile(geometry_msgs::msg::Twist & cmd_vel) const;
   /**
    * @brief Calls setPlannerPath method with an updated path received from
    * action server
@@ -172,7 +193,7 @@ protected:
    */
   void publishVelocity(const geometry_msgs::msg::TwistStamped & velocity);
   /**
-   * @brief Calls velocity publisher to publish zero velocity
+   * @brief Calls velocity publisher to publish zero velocity, bypassing the command pipeline
    */
   void publishZeroVelocity();
   /**
@@ -231,6 +252,9 @@ protected:
   std::unique_ptr<nav_2d_utils::OdomSubscriber> odom_sub_;
   rclcpp_lifecycle::LifecyclePublisher<geometry_msgs::msg::Twist>::SharedPtr vel_publisher_;
   rclcpp::Subscription<nav2_msgs::msg::SpeedLimit>::SharedPtr speed_limit_sub_;
+  std::shared_ptr<nav2_util::CmdVelPipeline> cmd_vel_pipeline_;
+  // Command run through the pipeline and published, kept to not allocate one per cycle
+  geometry_msgs::msg::Twist cmd_vel_;
 
   // Progress Checker Plugin
   pluginlib::ClassLoader<nav2_core::ProgressChecker> progress_checker_loader_;
@@ -265,6 +289,8 @@ protected:
   double min_theta_velocity_threshold_;
 
   double failure_tolerance_;
+  // Distance within which a replan is considered to follow the current path
+  double path_update_tolerance_;
 
   // Whether we've published the single controller warning yet
   geometry_msgs::msg::PoseStamped end_pose_;
@@ -274,6 +300,12 @@ protected:
 
   // Current path container
   nav_msgs::msg::Path current_path_;
+  // Controller which was given the current path
+  std::string current_path_controller_;
+  // Pose of the current path closest to the robot, from the last control cycle
+  size_t closest_pose_idx_{0};
+  // Velocity profile of the current path, empty if none was given
+  std::vector<double> current_velocities_;
 
 private:
   /**
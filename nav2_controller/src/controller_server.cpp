@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <chrono>
 #include <vector>
 #include <memory>
@@ -62,6 +63,7 @@ ControllerServer::ControllerServer(const rclcpp::NodeOptions & options)
   declare_parameter("speed_limit_topic", rclcpp::ParameterValue("speed_limit"));
 
   declare_parameter("failure_tolerance", rclcpp::ParameterValue(0.0));
+  declare_parameter("path_update_tolerance", rclcpp::ParameterValue(0.1));
 
   // The costmap node is used in the implementation of the controller
   costmap_ros_ = std::make_shared<nav2_costmap_2d::Costmap2DROS>(
@@ -126,6 +128,7 @@ ControllerServer::on_configure(const rclcpp_lifecycle::State & /*state*/)
   std::string speed_limit_topic;
   get_parameter("speed_limit_topic", speed_limit_topic);
   get_parameter("failure_tolerance", failure_tolerance_);
+  get_parameter("path_update_tolerance", path_update_tolerance_);
 
   costmap_ros_->configure();
   // Launch a thread to run the costmap node
@@ -287,6 +290,13 @@ ControllerServer::on_deactivate(const rclcpp_lifecycle::State & /*state*/)
 
   publishZeroVelocity();
   vel_publisher_->on_deactivate();
+
+  if (cmd_vel_pipeline_) {
+    RCLCPP_INFO(
+      get_logger(), "Command pipeline max latency: %.3f ms",
+      cmd_vel_pipeline_->getMaxLatency() * 1e3);
+  }
+
   dyn_params_handler_.reset();
 
   // destroy bond connection
@@ -441,7 +451,10 @@ void ControllerServer::computeControl()
       throw nav2_core::ControllerException("Failed to find progress checker name: " + pc_name);
     }
 
-    setPlannerPath(action_server_->get_current_goal()->path);
+    // A new task starts the controller on a fresh path
+    current_path_controller_.clear();
+    setPlannerPath(
+      action_server_->get_current_goal()->path, action_server_->get_current_goal()->velocities);
     progress_checkers_[current_progress_checker_]->reset();
 
     last_valid_cmd_time_ = now();
@@ -546,7 +559,8 @@ void ControllerServer::computeControl()
   action_server_->succeeded_current();
 }
 
-void ControllerServer::setPlannerPath(const nav_msgs::msg::Path & path)
+void ControllerServer::setPlannerPath(
+  const nav_msgs::msg::Path & path, const std::vector<double> & velocities)
 {
   RCLCPP_DEBUG(
     get_logger(),
@@ -554,7 +568,48 @@ void ControllerServer::setPlannerPath(const nav_msgs::msg::Path & path)
   if (path.poses.empty()) {
     throw nav2_core::InvalidPath("Path is empty.");
   }
-  controllers_[current_controller_]->setPlan(path);
+
+  const bool has_profile = velocities.size() == path.poses.size();
+  if (!velocities.empty() && !has_profile) {
+    RCLCPP_WARN(
+      get_logger(), "Ignoring a velocity profile of %zu velocities for a path of %zu poses",
+      velocities.size(), path.poses.size());
+  }
+
+  // A replan from the robot pose rejoining the path the current controller already follows
+  // is spliced onto it, so that only the poses past where it departs from it are processed again
+  size_t first_changed_index = 0;
+  nav_msgs::msg::Path spliced_path;
+  if (current_controller_ == current_path_controller_ &&
+    path.header.frame_id == current_path_.header.frame_id)
+  {
+    first_changed_index = nav2_util::geometry_utils::splice_replanned_path(
+      path, current_path_, path_update_tolerance_, spliced_path, closest_pose_idx_);
+  }
+
+  if (first_changed_index > 0) {
+    RCLCPP_DEBUG(
+      get_logger(), "Path unchanged up to pose %zu of %zu", first_changed_index,
+      spliced_path.poses.size());
+    controllers_[current_controller_]->updatePlan(spliced_path, first_changed_index);
+
+    // The profile is spliced as the path, if both were profiled
+    if (has_profile && current_velocities_.size() == current_path_.poses.size()) {
+      const size_t replan_start =
+        path.poses.size() - (spliced_path.poses.size() - first_changed_index);
+      current_velocities_.resize(first_changed_index);
+      current_velocities_.insert(
+        current_velocities_.end(), velocities.begin() + replan_start, velocities.end());
+    } else {
+      current_velocities_.clear();
+    }
+    current_path_ = std::move(spliced_path);
+  } else {
+    controllers_[current_controller_]->setPlan(path);
+    current_path_ = path;
+    current_velocities_ = has_profile ? velocities : std::vector<double>();
+    closest_pose_idx_ = 0;
+  }
 
   end_pose_ = path.poses.back();
   end_pose_.header.frame_id = path.header.frame_id;
@@ -564,7 +619,7 @@ void ControllerServer::setPlannerPath(const nav_msgs::msg::Path & path)
     get_logger(), "Path end point is (%.2f, %.2f)",
     end_pose_.pose.position.x, end_pose_.pose.position.y);
 
-  current_path_ = path;
+  current_path_controller_ = current_controller_;
 }
 
 void ControllerServer::computeAndPublishVelocity()
@@ -613,9 +668,6 @@ void ControllerServer::computeAndPublishVelocity()
     }
   }
 
-  std::shared_ptr<Action::Feedback> feedback = std::make_shared<Action::Feedback>();
-  feedback->speed = std::hypot(cmd_vel_2d.twist.linear.x, cmd_vel_2d.twist.linear.y);
-
   // Find the closest pose to current pose on global path
   nav_msgs::msg::Path & current_path = current_path_;
   auto find_closest_pose_idx =
@@ -633,14 +685,42 @@ void ControllerServer::computeAndPublishVelocity()
       return closest_pose_idx;
     };
 
+  // also where the next replan is searched for on the path
+  closest_pose_idx_ = find_closest_pose_idx();
+  applyVelocityProfile(cmd_vel_2d.twist);
+
+  std::shared_ptr<Action::Feedback> feedback = std::make_shared<Action::Feedback>();
+  feedback->speed = std::hypot(cmd_vel_2d.twist.linear.x, cmd_vel_2d.twist.linear.y);
   feedback->distance_to_goal =
-    nav2_util::geometry_utils::calculate_path_length(current_path_, find_closest_pose_idx());
+    nav2_util::geometry_utils::calculate_path_length(current_path_, closest_pose_idx_);
   action_server_->publish_feedback(feedback);
 
   RCLCPP_DEBUG(get_logger(), "Publishing velocity at time %.2f", now().seconds());
   publishVelocity(cmd_vel_2d);
 }
 
+void ControllerServer::applyVelocityProfile(geometry_msgs::msg::Twist & cmd_vel) const
+{
+  if (closest_pose_idx_ >= current_velocities_.size()) {
+    return;
+  }
+
+  // Limit of the segment ahead of the closest pose, so as to accelerate from its stops
+  double limit = current_velocities_[closest_pose_idx_];
+  if (closest_pose_idx_ + 1 < current_velocities_.size()) {
+    limit = std::max(limit, current_velocities_[closest_pose_idx_ + 1]);
+  }
+  const double speed = std::hypot(cmd_vel.linear.x, cmd_vel.linear.y);
+  if (limit <= 0.0 || speed <= limit) {
+    return;
+  }
+
+  const double scale = limit / speed;
+  cmd_vel.linear.x *= scale;
+  cmd_vel.linear.y *= scale;
+  cmd_vel.angular.z *= scale;
+}
+
 void ControllerServer::updateGlobalPath()
 {
   if (action_server_->is_preempt_requested()) {
@@ -682,15 +762,29 @@ void ControllerServer::updateGlobalPath()
       action_server_->terminate_current();
       return;
     }
-    setPlannerPath(goal->path);
+    setPlannerPath(goal->path, goal->velocities);
   }
 }
 
+void ControllerServer::setCmdVelPipeline(std::shared_ptr<nav2_util::CmdVelPipeline> pipeline)
+{
+  cmd_vel_pipeline_ = pipeline;
+}
+
 void ControllerServer::publishVelocity(const geometry_msgs::msg::TwistStamped & velocity)
 {
-  auto cmd_vel = std::make_unique<geometry_msgs::msg::Twist>(velocity.twist);
+  cmd_vel_ = velocity.twist;
+  if (cmd_vel_pipeline_) {
+    const bool processed = cmd_vel_pipeline_->process(cmd_vel_);
+    RCLCPP_DEBUG(
+      get_logger(), "Command pipeline latency: %.3f ms (max %.3f ms)",
+      cmd_vel_pipeline_->getLatency() * 1e3, cmd_vel_pipeline_->getMaxLatency() * 1e3);
+    if (!processed) {
+      return;
+    }
+  }
   if (vel_publisher_->is_activated() && vel_publisher_->get_subscription_count() > 0) {
-    vel_publisher_->publish(std::move(cmd_vel));
+    vel_publisher_->publish(cmd_vel_);
   }
 }
 
@@ -705,7 +799,15 @@ void ControllerServer::publishZeroVelocity()
   velocity.twist.linear.z = 0;
   velocity.header.frame_id = costmap_ros_->getBaseFrameID();
   velocity.header.stamp = now();
-  publishVelocity(velocity);
+
+  // Stop commands bypass the command pipeline, as stages such as a velocity smoother
+  // would only decelerate them, and the stages resume from the stop
+  if (cmd_vel_pipeline_) {
+    cmd_vel_pipeline_->reset();
+  }
+  if (vel_publisher_->is_activated() && vel_publisher_->get_subscription_count() > 0) {
+    vel_publisher_->publish(velocity.twist);
+  }
 
   // Reset the state of the controllers after the task has ended
   ControllerMap::iterator it;
@@ -790,6 +892,8 @@ ControllerServer::dynamicParametersCallback(std::vector<rclcpp::Parameter> param
         min_theta_velocity_threshold_ = parameter.as_double();
       } else if (name == "failure_tolerance") {
         failure_tolerance_ = parameter.as_double();
+      } else if (name == "path_update_tolerance") {
+        path_update_tolerance_ = parameter.as_double();
       }
     }
 
@@ -0,0 +1,116 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "nav2_controller/controller_server.hpp"
+#include "nav2_util/cmd_vel_pipeline.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+using namespace std::chrono_literals;
+
+class ControllerShim : public nav2_controller::ControllerServer
+{
+public:
+  ControllerShim()
+  : nav2_controller::ControllerServer(rclcpp::NodeOptions())
+  {
+  }
+
+  // Since we cannot call configure/activate due to costmaps
+  // requiring TF, only the velocity publisher is created
+  void createVelocityPublisher()
+  {
+    vel_publisher_ = create_publisher<geometry_msgs::msg::Twist>("cmd_vel", 1);
+    vel_publisher_->on_activate();
+  }
+
+  void sendVelocity(double x)
+  {
+    geometry_msgs::msg::TwistStamped velocity;
+    velocity.twist.linear.x = x;
+    publishVelocity(velocity);
+  }
+
+  void sendStop() {publishZeroVelocity();}
+};
+
+class RclCppFixture
+{
+public:
+  RclCppFixture() {rclcpp::init(0, nullptr);}
+  ~RclCppFixture() {rclcpp::shutdown();}
+};
+RclCppFixture g_rclcppfixture;
+
+TEST(CmdVelPipelineTest, stopBypassesPipeline)
+{
+  auto controller = std::make_shared<ControllerShim>();
+  controller->createVelocityPublisher();
+
+  // A stage decelerating like a velocity smoother, by 0.1 m/s per command
+  auto pipeline = std::make_shared<nav2_util::CmdVelPipeline>();
+  double last_vel = 0.0;
+  unsigned int resets = 0;
+  pipeline->addStage(
+    "smoother", [&last_vel](geometry_msgs::msg::Twist & cmd) {
+      cmd.linear.x = std::clamp(cmd.linear.x, last_vel - 0.1, last_vel + 0.1);
+      last_vel = cmd.linear.x;
+      return true;
+    },
+    [&last_vel, &resets]() {
+      last_vel = 0.0;
+      resets++;
+    });
+  controller->setCmdVelPipeline(pipeline);
+
+  std::vector<double> linear_vels;
+  auto subscription = controller->create_subscription<geometry_msgs::msg::Twist>(
+    "cmd_vel", 10,
+    [&](geometry_msgs::msg::Twist::SharedPtr msg) {
+      linear_vels.push_back(msg->linear.x);
+    });
+  auto spin = [&](std::chrono::milliseconds duration) {
+      auto start = controller->now();
+      while (controller->now() - start < duration) {
+        rclcpp::spin_some(controller->get_node_base_interface());
+      }
+    };
+  spin(100ms);
+
+  // Commands go through the stages
+  for (unsigned int i = 0; i != 3; i++) {
+    controller->sendVelocity(0.5);
+    spin(10ms);
+  }
+  ASSERT_EQ(linear_vels.size(), 3u);
+  EXPECT_DOUBLE_EQ(linear_vels.back(), 0.3);
+
+  // A stop is published as is, not decelerated by the stages, which are reset
+  controller->sendStop();
+  spin(10ms);
+  ASSERT_EQ(linear_vels.size(), 4u);
+  EXPECT_EQ(linear_vels.back(), 0.0);
+  EXPECT_EQ(resets, 1u);
+
+  // And the next commands accelerate from the stop
+  controller->sendVelocity(0.5);
+  spin(10ms);
+  ASSERT_EQ(linear_vels.size(), 5u);
+  EXPECT_DOUBLE_EQ(linear_vels.back(), 0.1);
+}
@@ -0,0 +1,248 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "nav2_controller/controller_server.hpp"
+#include "nav2_core/controller.hpp"
+#include "nav2_core/goal_checker.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+// Controller recording the plans it is given
+class FakeController : public nav2_core::Controller
+{
+public:
+  void configure(
+    const rclcpp_lifecycle::LifecycleNode::WeakPtr &,
+    std::string, std::shared_ptr<tf2_ros::Buffer>,
+    std::shared_ptr<nav2_costmap_2d::Costmap2DROS>) override {}
+  void cleanup() override {}
+  void activate() override {}
+  void deactivate() override {}
+  void setSpeedLimit(const double &, const bool &) override {}
+
+  geometry_msgs::msg::TwistStamped computeVelocityCommands(
+    const geometry_msgs::msg::PoseStamped &, const geometry_msgs::msg::Twist &,
+    nav2_core::GoalChecker *) override
+  {
+    return geometry_msgs::msg::TwistStamped();
+  }
+
+  void setPlan(const nav_msgs::msg::Path & path) override
+  {
+    path_ = path;
+    first_changed_index_ = 0;
+    plans_set_++;
+  }
+
+  void updatePlan(const nav_msgs::msg::Path & path, size_t first_changed_index) override
+  {
+    path_ = path;
+    first_changed_index_ = first_changed_index;
+    plans_updated_++;
+  }
+
+  nav_msgs::msg::Path path_;
+  size_t first_changed_index_{0};
+  unsigned int plans_set_{0}, plans_updated_{0};
+};
+
+class FakeGoalChecker : public nav2_core::GoalChecker
+{
+public:
+  void initialize(
+    const rclcpp_lifecycle::LifecycleNode::WeakPtr &, const std::string &,
+    const std::shared_ptr<nav2_costmap_2d::Costmap2DROS>) override {}
+  void reset() override {}
+  bool isGoalReached(
+    const geometry_msgs::msg::Pose &, const geometry_msgs::msg::Pose &,
+    const geometry_msgs::msg::Twist &) override
+  {
+    return false;
+  }
+  bool getTolerances(geometry_msgs::msg::Pose &, geometry_msgs::msg::Twist &) override
+  {
+    return false;
+  }
+};
+
+class ControllerShim : public nav2_controller::ControllerServer
+{
+public:
+  ControllerShim()
+  : nav2_controller::ControllerServer(rclcpp::NodeOptions())
+  {
+  }
+
+  // Since we cannot call configure/activate due to costmaps
+  // requiring TF, the plugins are set directly
+  void setPlugins(std::shared_ptr<FakeController> controller)
+  {
+    controllers_["FollowPath"] = controller;
+    current_controller_ = "FollowPath";
+    goal_checkers_["goal_checker"] = std::make_shared<FakeGoalChecker>();
+    current_goal_checker_ = "goal_checker";
+    get_parameter("path_update_tolerance", path_update_tolerance_);
+  }
+
+  void setPath(
+    const nav_msgs::msg::Path & path,
+    const std::vector<double> & velocities = std::vector<double>())
+  {
+    setPlannerPath(path, velocities);
+  }
+
+  void setClosestPoseIndex(size_t idx) {closest_pose_idx_ = idx;}
+
+  const nav_msgs::msg::Path & getCurrentPath() {return current_path_;}
+
+  const std::vector<double> & getCurrentVelocities() {return current_velocities_;}
+
+  geometry_msgs::msg::Twist limit(double linear, double angular)
+  {
+    geometry_msgs::msg::Twist cmd_vel;
+    cmd_vel.linear.x = linear;
+    cmd_vel.angular.z = angular;
+    applyVelocityProfile(cmd_vel);
+    return cmd_vel;
+  }
+};
+
+class RclCppFixture
+{
+public:
+  RclCppFixture() {rclcpp::init(0, nullptr);}
+  ~RclCppFixture() {rclcpp::shutdown();}
+};
+RclCppFixture g_rclcppfixture;
+
+geometry_msgs::msg::PoseStamped makePose(double x, double y)
+{
+  geometry_msgs::msg::PoseStamped pose;
+  pose.pose.position.x = x;
+  pose.pose.position.y = y;
+  return pose;
+}
+
+TEST(PathUpdateTest, replanFromMidPath)
+{
+  auto server = std::make_shared<ControllerShim>();
+  auto controller = std::make_shared<FakeController>();
+  server->setPlugins(controller);
+
+  // A straight path of poses every 5 cm
+  nav_msgs::msg::Path path;
+  path.header.frame_id = "map";
+  for (unsigned int i = 0; i <= 100; i++) {
+    path.poses.push_back(makePose(0.05 * i, 0.0));
+  }
+  server->setPath(path);
+  EXPECT_EQ(controller->plans_set_, 1u);
+
+  // The robot went 2 m along it, slightly off its poses, and the replan from there follows
+  // the path for about 1.5 m, with poses spaced differently, then avoids an obstacle
+  server->setClosestPoseIndex(40);
+  nav_msgs::msg::Path replan;
+  replan.header.frame_id = "map";
+  replan.poses.push_back(makePose(2.02, 0.01));
+  for (unsigned int i = 1; i <= 21; i++) {
+    replan.poses.push_back(makePose(2.0 + 0.07 * i, 0.0));
+  }
+  for (unsigned int i = 1; i <= 15; i++) {
+    replan.poses.push_back(makePose(3.47 + 0.1 * i, 0.5));
+  }
+  server->setPath(replan);
+
+  // Only the poses past where it departs from the path are changed
+  EXPECT_EQ(controller->plans_set_, 1u);
+  EXPECT_EQ(controller->plans_updated_, 1u);
+  EXPECT_EQ(controller->first_changed_index_, 70u);
+  ASSERT_EQ(controller->path_.poses.size(), 70u + 15u);
+  for (unsigned int i = 0; i < 70; i++) {
+    EXPECT_EQ(controller->path_.poses[i], path.poses[i]);
+  }
+  EXPECT_EQ(controller->path_.poses[70], replan.poses[22]);
+  EXPECT_EQ(controller->path_.poses.back(), replan.poses.back());
+  EXPECT_EQ(server->getCurrentPath().poses.size(), controller->path_.poses.size());
+
+  // A replan from off the path is set from scratch
+  server->setClosestPoseIndex(45);
+  nav_msgs::msg::Path off_path = replan;
+  off_path.poses.front() = makePose(2.3, 0.4);
+  server->setPath(off_path);
+  EXPECT_EQ(controller->plans_set_, 2u);
+  EXPECT_EQ(controller->plans_updated_, 1u);
+  EXPECT_EQ(controller->path_, off_path);
+}
+
+TEST(PathUpdateTest, velocityProfile)
+{
+  auto server = std::make_shared<ControllerShim>();
+  auto controller = std::make_shared<FakeController>();
+  server->setPlugins(controller);
+
+  // A straight path with a stop halfway and at the goal
+  nav_msgs::msg::Path path;
+  path.header.frame_id = "map";
+  for (unsigned int i = 0; i <= 100; i++) {
+    path.poses.push_back(makePose(0.05 * i, 0.0));
+  }
+  std::vector<double> velocities(path.poses.size(), 0.3);
+  velocities[50] = 0.0;
+  velocities.back() = 0.0;
+  server->setPath(path, velocities);
+
+  // Commands are scaled down to the profile, keeping their curvature
+  server->setClosestPoseIndex(20);
+  auto cmd_vel = server->limit(0.5, 0.2);
+  EXPECT_NEAR(cmd_vel.linear.x, 0.3, 1e-9);
+  EXPECT_NEAR(cmd_vel.angular.z, 0.12, 1e-9);
+  cmd_vel = server->limit(0.2, 0.2);
+  EXPECT_EQ(cmd_vel.linear.x, 0.2);
+  EXPECT_EQ(cmd_vel.angular.z, 0.2);
+
+  // The robot leaves the stops of the profile, which are up to the controller
+  server->setClosestPoseIndex(50);
+  EXPECT_NEAR(server->limit(0.5, 0.0).linear.x, 0.3, 1e-9);
+  server->setClosestPoseIndex(100);
+  EXPECT_EQ(server->limit(0.5, 0.0).linear.x, 0.5);
+
+  // A replan spliced onto the path splices its profile
+  server->setClosestPoseIndex(40);
+  nav_msgs::msg::Path replan;
+  replan.header.frame_id = "map";
+  replan.poses.push_back(makePose(2.02, 0.01));
+  for (unsigned int i = 1; i <= 21; i++) {
+    replan.poses.push_back(makePose(2.0 + 0.07 * i, 0.0));
+  }
+  for (unsigned int i = 1; i <= 15; i++) {
+    replan.poses.push_back(makePose(3.47 + 0.1 * i, 0.5));
+  }
+  server->setPath(replan, std::vector<double>(replan.poses.size(), 0.2));
+  ASSERT_EQ(controller->first_changed_index_, 70u);
+  const auto & spliced = server->getCurrentVelocities();
+  ASSERT_EQ(spliced.size(), 70u + 15u);
+  EXPECT_EQ(spliced[50], 0.0);
+  EXPECT_EQ(spliced[69], 0.3);
+  EXPECT_EQ(spliced[70], 0.2);
+
+  // A profile not matching the path is ignored
+  server->setClosestPoseIndex(0);
+  server->setPath(path, std::vector<double>(3, 0.1));
+  EXPECT_TRUE(server->getCurrentVelocities().empty());
+  EXPECT_EQ(server->limit(0.5, 0.0).linear.x, 0.5);
+}
@@ -98,6 +98,20 @@ public:
    */
   virtual void setPlan(const nav_msgs::msg::Path & path) = 0;
 
+  /**
+   * @brief local updatePlan - Updates the global plan after a replan which followed the
+   * previous plan from the robot pose, spliced onto it so that the poses already followed
+   * are kept. Controllers able to reuse their processing of the unchanged poses can override
+   * it, it otherwise sets the plan from scratch.
+   * @param path The global plan
+   * @param first_changed_index Index of the first pose of path which differs from the
+   * previous plan, all the poses before it are unchanged
+   */
+  virtual void updatePlan(const nav_msgs::msg::Path & path, size_t /*first_changed_index*/)
+  {
+    setPlan(path);
+  }
+
   /**
    * @brief Controller computeVelocityCommands - calculates the best command given the current pose and velocity
    *
@@ -64,6 +64,14 @@ public:
    */
   virtual bool processAtWaypoint(
     const geometry_msgs::msg::PoseStamped & curr_pose, const int & curr_waypoint_index) = 0;
+
+  /**
+   * @brief Override this to return false if the robot does not need to stay at the waypoint
+   * for the task to complete, so that it can run while the robot drives to the next waypoint
+   *
+   * @return true if the robot should wait at the waypoint for the task to complete
+   */
+  virtual bool isBlocking() const {return true;}
 };
 }  // namespace nav2_core
 #endif  // NAV2_CORE__WAYPOINT_TASK_EXECUTOR_HPP_
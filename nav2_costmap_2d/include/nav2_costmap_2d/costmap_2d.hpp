@@ -47,6 +47,7 @@
 #include <vector>
 #include <queue>
 #include <mutex>
+#include <utility>
 #include "geometry_msgs/msg/point.hpp"
 #include "nav_msgs/msg/occupancy_grid.hpp"
 
@@ -320,6 +321,45 @@ public:
     const std::vector<MapLocation> & polygon,
     std::vector<MapLocation> & polygon_cells);
 
+  /**
+   * @brief  Rasterize a convex polygon row by row, into the cells of convexFillCells, and
+   * apply some action to the span of cells filling each row
+   * @param polygon The polygon in map coordinates to rasterize
+   * @param at The action to take... a functor given the index of the first cell of a span
+   * and the index past its last cell, which must not rasterize another polygon itself
+   */
+  template<class ActionType>
+  inline void convexFillSpans(const std::vector<MapLocation> & polygon, ActionType at)
+  {
+    // we need a minimum polygon of a triangle
+    if (polygon.size() < 3) {
+      return;
+    }
+
+    unsigned int min_y = polygon[0].y, max_y = polygon[0].y;
+    for (const MapLocation & point : polygon) {
+      min_y = std::min(min_y, point.y);
+      max_y = std::max(max_y, point.y);
+    }
+
+    // bound each row by the outline of the polygon, convex so that it fills them in between.
+    // Reused to avoid allocating on each call, per thread so that concurrent callers don't race
+    static thread_local std::vector<std::pair<unsigned int, unsigned int>> polygon_spans;
+    polygon_spans.assign(max_y - min_y + 1, std::make_pair(UINT_MAX, 0u));
+    PolygonRowSpans row_spans(size_x_, min_y, polygon_spans);
+    for (unsigned int i = 0; i < polygon.size(); ++i) {
+      const MapLocation & next = polygon[i + 1 < polygon.size() ? i + 1 : 0];
+      raytraceLine(row_spans, polygon[i].x, polygon[i].y, next.x, next.y);
+    }
+
+    for (unsigned int y = min_y; y <= max_y; ++y) {
+      const std::pair<unsigned int, unsigned int> & span = polygon_spans[y - min_y];
+      if (span.first <= span.second) {
+        at(y * size_x_ + span.first, y * size_x_ + span.second + 1);
+      }
+    }
+  }
+
   /**
    * @brief  Move the origin of the costmap to a new location.... keeping data when it can
    * @param  new_origin_x The x coordinate of the new origin
@@ -566,6 +606,31 @@ protected:
     const Costmap2D & costmap_;
     std::vector<MapLocation> & cells_;
   };
+
+  class PolygonRowSpans
+  {
+  public:
+    PolygonRowSpans(
+      unsigned int size_x, unsigned int min_y,
+      std::vector<std::pair<unsigned int, unsigned int>> & spans)
+    : size_x_(size_x), min_y_(min_y), spans_(spans)
+    {
+    }
+
+    // widen the span of the row to the cell
+    inline void operator()(unsigned int offset)
+    {
+      const unsigned int x = offset % size_x_;
+      std::pair<unsigned int, unsigned int> & span = spans_[offset / size_x_ - min_y_];
+      span.first = std::min(span.first, x);
+      span.second = std::max(span.second, x);
+    }
+
+  private:
+    unsigned int size_x_;
+    unsigned int min_y_;
+    std::vector<std::pair<unsigned int, unsigned int>> & spans_;
+  };
   // *INDENT-ON*
 };
 }  // namespace nav2_costmap_2d
@@ -40,11 +40,14 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "nav2_costmap_2d/costmap_filters/costmap_filter.hpp"
 
+#include "nav_msgs/msg/path.hpp"
 #include "nav2_msgs/msg/costmap_filter_info.hpp"
 #include "nav2_msgs/msg/speed_limit.hpp"
+#include "nav2_util/path_progress_tracker.hpp"
 
 namespace nav2_costmap_2d
 {
@@ -52,7 +55,9 @@ namespace nav2_costmap_2d
  * @class SpeedFilter
  * @brief Reads in a speed restriction mask and enables a robot to
  * dynamically adjust speed based on pose in map to slow in dangerous
- * areas. Done via absolute speed setting or percentage of maximum speed
+ * areas. Done via absolute speed setting or percentage of maximum speed.
+ * When a path topic and a lookahead distance are set, the speed limit of the
+ * zones the robot is about to enter along its path is published ahead of time
  */
 class SpeedFilter : public CostmapFilter
 {
@@ -86,6 +91,19 @@ public:
    */
   bool isActive();
 
+  /**
+   * @brief Calculate the speed limit at each pose of a path from the filter mask.
+   * Each path segment is rasterized over the mask, so that zones lying between
+   * two poses of a sparse path are not missed
+   * @param path Path to calculate the speed limits for
+   * @param speed_limits Output speed limit on the way to each pose from the previous one,
+   * in percent or in m/s as published by the filter. NO_SPEED_LIMIT out of speed zones
+   * @return True if the speed limits were calculated, false if there is no filter mask
+   * or the path could not be transformed to the mask frame
+   */
+  bool getSpeedLimitProfile(
+    const nav_msgs::msg::Path & path, std::vector<double> & speed_limits);
+
 private:
   /**
    * @brief Callback for the filter information
@@ -95,9 +113,33 @@ private:
    * @brief Callback for the filter mask
    */
   void maskCallback(const nav_msgs::msg::OccupancyGrid::SharedPtr msg);
+  /**
+   * @brief Callback for the path followed by the robot
+   */
+  void pathCallback(const nav_msgs::msg::Path::SharedPtr msg);
+
+  /**
+   * @brief Convert filter mask data to a speed limit
+   * @param data Filter mask data
+   * @param speed_limit Output speed limit, NO_SPEED_LIMIT for out of range values
+   * @return False if the data is unknown, which is invalid for this filter
+   */
+  bool maskDataToSpeedLimit(int8_t data, double & speed_limit) const;
+
+  /**
+   * @brief Get the most restrictive of two speed limits
+   */
+  static double mostRestrictive(double speed_limit_a, double speed_limit_b);
+
+  /**
+   * @brief Lower the speed limit to the ones of the zones ahead along the path
+   * @param pose Robot pose in the frame of the layer
+   */
+  void applyLookahead(const geometry_msgs::msg::Pose2D & pose);
 
   rclcpp::Subscription<nav2_msgs::msg::CostmapFilterInfo>::SharedPtr filter_info_sub_;
   rclcpp::Subscription<nav_msgs::msg::OccupancyGrid>::SharedPtr mask_sub_;
+  rclcpp::Subscription<nav_msgs::msg::Path>::SharedPtr path_sub_;
 
   rclcpp_lifecycle::LifecyclePublisher<nav2_msgs::msg::SpeedLimit>::SharedPtr speed_limit_pub_;
 
@@ -108,6 +150,14 @@ private:
   double base_, multiplier_;
   bool percentage_;
   double speed_limit_, speed_limit_prev_;
+
+  // Speed limits along the path, calculated once per path and filter mask
+  double lookahead_distance_;
+  nav_msgs::msg::Path::SharedPtr path_;
+  std::vector<double> path_speed_limits_;
+  std::vector<double> path_length_;
+  bool path_speed_limits_valid_;
+  nav2_util::PathProgressTracker path_progress_tracker_;
 };
 
 }  // namespace nav2_costmap_2d
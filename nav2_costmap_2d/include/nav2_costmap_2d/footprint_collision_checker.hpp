@@ -51,11 +51,23 @@ public:
   /**
    * @brief Find the footprint cost in oriented footprint
    */
-  double footprintCost(const Footprint footprint);
+  double footprintCost(const Footprint & footprint);
   /**
    * @brief Find the footprint cost a a post with an unoriented footprint
    */
-  double footprintCostAtPose(double x, double y, double theta, const Footprint footprint);
+  double footprintCostAtPose(double x, double y, double theta, const Footprint & footprint);
+  /**
+   * @brief Find the footprint costs at a sequence of poses with an unoriented footprint,
+   * stopping at the first pose in lethal collision. The footprint is oriented in place
+   * for each pose, without allocating.
+   * @param poses Poses to check, in order
+   * @param footprint Unoriented footprint
+   * @param costs Filled with the footprint cost of each pose checked
+   * @return Index of the first pose in lethal collision, poses.size() if none
+   */
+  size_t footprintCostsAtPoses(
+    const std::vector<geometry_msgs::msg::Pose2D> & poses, const Footprint & footprint,
+    std::vector<double> & costs);
   /**
    * @brief Get the cost for a line segment
    */
@@ -82,6 +94,7 @@ public:
 
 protected:
   CostmapT costmap_;
+  Footprint oriented_footprint_;
 };
 
 }  // namespace nav2_costmap_2d
@@ -38,7 +38,7 @@
 #define NAV2_COSTMAP_2D__OBSERVATION_BUFFER_HPP_
 
 #include <vector>
-#include <list>
+#include <memory>
 #include <string>
 
 #include "tf2_geometry_msgs/tf2_geometry_msgs.hpp"
@@ -47,6 +47,7 @@
 #include "tf2_sensor_msgs/tf2_sensor_msgs.hpp"
 #include "sensor_msgs/msg/point_cloud2.hpp"
 #include "nav2_costmap_2d/observation.hpp"
+#include "nav2_costmap_2d/observation_voxel_filter.hpp"
 #include "nav2_util/lifecycle_node.hpp"
 
 
@@ -74,6 +75,7 @@ public:
    * @param  global_frame The frame to transform PointClouds into
    * @param  sensor_frame The frame of the origin of the sensor, can be left blank to be read from the messages
    * @param  tf_tolerance The amount of time to wait for a transform to be available when setting a new global frame
+   * @param  voxel_filter_resolution Size of the voxels the clouds are reduced to one point per, 0 to keep every point
    */
   ObservationBuffer(
     const nav2_util::LifecycleNode::WeakPtr & parent,
@@ -85,7 +87,8 @@ public:
     double raytrace_max_range, double raytrace_min_range, tf2_ros::Buffer & tf2_buffer,
     std::string global_frame,
     std::string sensor_frame,
-    tf2::Duration tf_tolerance);
+    tf2::Duration tf_tolerance,
+    double voxel_filter_resolution = 0.0);
 
   /**
    * @brief  Destructor... cleans up
@@ -96,14 +99,22 @@ public:
    * @brief  Transforms a PointCloud to the global frame and buffers it
    * <b>Note: The burden is on the user to make sure the transform is available... ie they should use a MessageNotifier</b>
    * @param  cloud The cloud to be buffered
+   * @return False if the cloud could not be transformed and was dropped
    */
-  void bufferCloud(const sensor_msgs::msg::PointCloud2 & cloud);
+  bool bufferCloud(const sensor_msgs::msg::PointCloud2 & cloud);
 
   /**
-   * @brief  Pushes copies of all current observations onto the end of the vector passed in
+   * @brief  Get the most recently buffered observation, valid while the buffer is locked
+   * @return The observation, nullptr if the buffer holds none
+   */
+  const Observation * getLatestObservation() const;
+
+  /**
+   * @brief  Pushes all current observations onto the end of the vector passed in, newest first.
+   * They are shared rather than copied, and their storage is only reused once released
    * @param  observations The vector to be filled
    */
-  void getObservations(std::vector<Observation> & observations);
+  void getObservations(std::vector<std::shared_ptr<const Observation>> & observations);
 
   /**
    * @brief  Check if the observation buffer is being update at its expected rate
@@ -132,12 +143,33 @@ public:
    */
   void resetLastUpdated();
 
+  /**
+   * @brief  Align the voxels the clouds are reduced to with the cells of a costmap
+   * @param  origin_x X origin of the costmap, in the global frame
+   * @param  origin_y Y origin of the costmap, in the global frame
+   * @param  resolution Resolution of the costmap
+   */
+  void setVoxelGrid(double origin_x, double origin_y, double resolution);
+
 private:
   /**
-   * @brief  Removes any stale observations from the buffer list
+   * @brief  Removes any stale observations from the buffer
    */
   void purgeStaleObservations();
 
+  /**
+   * @brief  Doubles the number of observation slots, keeping the buffered observations
+   */
+  void growStorage();
+
+  /**
+   * @brief  Get the slot of the i-th newest observation
+   */
+  inline size_t slot(const size_t & i) const
+  {
+    return (newest_ + observations_.size() - i) % observations_.size();
+  }
+
   rclcpp::Clock::SharedPtr clock_;
   rclcpp::Logger logger_{rclcpp::get_logger("nav2_costmap_2d")};
   tf2_ros::Buffer & tf2_buffer_;
@@ -146,12 +178,16 @@ private:
   rclcpp::Time last_updated_;
   std::string global_frame_;
   std::string sensor_frame_;
-  std::list<Observation> observation_list_;
+  /// @brief Ring of observation slots, holding num_observations_ up to the newest_ one
+  std::vector<std::shared_ptr<Observation>> observations_;
+  size_t newest_;
+  size_t num_observations_;
   std::string topic_name_;
   double min_obstacle_height_, max_obstacle_height_;
   std::recursive_mutex lock_;  ///< @brief A lock for accessing data in callbacks safely
   double obstacle_max_range_, obstacle_min_range_, raytrace_max_range_, raytrace_min_range_;
   tf2::Duration tf_tolerance_;
+  std::unique_ptr<ObservationVoxelFilter> voxel_filter_;
 };
 }  // namespace nav2_costmap_2d
 #endif  // NAV2_COSTMAP_2D__OBSERVATION_BUFFER_HPP_
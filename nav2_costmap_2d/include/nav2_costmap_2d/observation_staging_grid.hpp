@@ -0,0 +1,127 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NAV2_COSTMAP_2D__OBSERVATION_STAGING_GRID_HPP_
+#define NAV2_COSTMAP_2D__OBSERVATION_STAGING_GRID_HPP_
+
+#include "nav2_costmap_2d/costmap_2d.hpp"
+#include "nav2_costmap_2d/observation.hpp"
+
+namespace nav2_costmap_2d
+{
+
+/**
+ * @class ObservationStagingGrid
+ * @brief Grid of the cells cleared and marked by the observations of a source since they were
+ * last merged into the costmap of a layer.
+ *
+ * Observations are raytraced and marked into it on the thread receiving them, each cell
+ * being NO_INFORMATION while untouched, FREE_SPACE once cleared and LETHAL_OBSTACLE once
+ * marked. The layer then only merges the staged cells on update. Use getMutex() to access it
+ * from several threads.
+ */
+class ObservationStagingGrid : public Costmap2D
+{
+public:
+  /**
+   * @brief A constructor for nav2_costmap_2d::ObservationStagingGrid
+   * @param marking Whether the observations of the source mark obstacles
+   * @param clearing Whether the observations of the source clear space
+   */
+  ObservationStagingGrid(const bool & marking, const bool & clearing);
+
+  /**
+   * @brief Follow the geometry of the costmap merged into. Staged cells are moved along with
+   * a new origin, and dropped if the size or resolution changed
+   * @param costmap Costmap to match
+   */
+  void matchGeometry(const Costmap2D & costmap);
+
+  /**
+   * @brief Set the heights of the points used for marking
+   * @param min_obstacle_height Minimum height
+   * @param max_obstacle_height Maximum height
+   */
+  void setObstacleHeights(const double & min_obstacle_height, const double & max_obstacle_height);
+
+  /**
+   * @brief Raytrace and mark an observation, following its ranges and the source settings
+   * @param observation Observation in the costmap frame
+   * @return False if the grid is not sized yet or its origin is off the grid, so that it
+   * could not be raytraced
+   */
+  bool stage(const Observation & observation);
+
+  /**
+   * @brief Write the staged free cells into a costmap of the same geometry
+   * @param costmap Costmap to update
+   */
+  void mergeClearing(Costmap2D & costmap) const;
+
+  /**
+   * @brief Write the staged obstacle cells into a costmap of the same geometry
+   * @param costmap Costmap to update
+   */
+  void mergeMarking(Costmap2D & costmap) const;
+
+  /**
+   * @brief Expand bounds to the area touched by the staged observations
+   * @param min_x X min world coord of the bounds
+   * @param min_y Y min world coord of the bounds
+   * @param max_x X max world coord of the bounds
+   * @param max_y Y max world coord of the bounds
+   */
+  void expandBounds(double * min_x, double * min_y, double * max_x, double * max_y) const;
+
+  /**
+   * @brief Drop the staged cells, once merged
+   */
+  void clearStaged();
+
+  /**
+   * @brief Whether no cell is staged
+   */
+  bool empty() const {return min_cell_x_ > max_cell_x_;}
+
+  /**
+   * @brief Whether the geometry of a costmap was matched, so that observations can be staged
+   */
+  bool isSized() const {return size_x_ != 0 && size_y_ != 0;}
+
+protected:
+  /**
+   * @brief Expand the touched area to a world point
+   */
+  void touch(const double & wx, const double & wy);
+
+  /**
+   * @brief Expand the staged cell window to a cell
+   */
+  void touchCell(const unsigned int & mx, const unsigned int & my);
+
+  /**
+   * @brief Write the staged cells of a value into a costmap
+   */
+  void merge(Costmap2D & costmap, const unsigned char & value) const;
+
+  bool marking_, clearing_;
+  double min_obstacle_height_, max_obstacle_height_;
+  // window of the staged cells and world bounds of the area they touched
+  int min_cell_x_, min_cell_y_, max_cell_x_, max_cell_y_;
+  double min_x_, min_y_, max_x_, max_y_;
+};
+
+}  // namespace nav2_costmap_2d
+
+#endif  // NAV2_COSTMAP_2D__OBSERVATION_STAGING_GRID_HPP_
@@ -0,0 +1,87 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NAV2_COSTMAP_2D__OBSERVATION_VOXEL_FILTER_HPP_
+#define NAV2_COSTMAP_2D__OBSERVATION_VOXEL_FILTER_HPP_
+
+#include <unordered_map>
+#include <vector>
+
+#include "geometry_msgs/msg/point.hpp"
+#include "sensor_msgs/msg/point_cloud2.hpp"
+
+namespace nav2_costmap_2d
+{
+
+/**
+ * @class ObservationVoxelFilter
+ * @brief Reduces an observation cloud to the nearest and farthest points of each voxel, so
+ * that marking and raytracing it scales with the observed area rather than the sensor density.
+ *
+ * Voxels are aligned with the costmap cells, so that no voxel straddles two of them. The
+ * nearest point still marks within the obstacle range, and the farthest one lets clearing
+ * raytrace to the end of the observed space. Points are hashed by voxel in a single pass
+ * and the cloud is compacted in place.
+ */
+class ObservationVoxelFilter
+{
+public:
+  /**
+   * @brief A constructor for nav2_costmap_2d::ObservationVoxelFilter
+   * @param resolution Size of the voxels, in the cloud units
+   */
+  explicit ObservationVoxelFilter(const double & resolution);
+
+  /**
+   * @brief Align the voxels with the cells of a costmap
+   * @param origin_x X origin of the costmap, in the cloud frame
+   * @param origin_y Y origin of the costmap, in the cloud frame
+   * @param cell_size Resolution of the costmap, the voxels are split to fit in its cells
+   */
+  void setGrid(const double & origin_x, const double & origin_y, const double & cell_size);
+
+  /**
+   * @brief Filters a cloud in place, left as is until the grid is set
+   * @param origin Origin of the sensor, in the cloud frame
+   * @param cloud Cloud with x, y and z float32 fields
+   */
+  void filter(const geometry_msgs::msg::Point & origin, sensor_msgs::msg::PointCloud2 & cloud);
+
+  /**
+   * @brief Get the size of the voxels
+   * @return Resolution
+   */
+  double getResolution() const {return resolution_;}
+
+protected:
+  // indices of the nearest and farthest points kept for a voxel
+  struct Extremes
+  {
+    uint32_t nearest;
+    uint32_t farthest;
+  };
+
+  double resolution_;
+  double origin_x_{0.0};
+  double origin_y_{0.0};
+  // horizontal size of the voxels, a fraction of the costmap cells or 0 until the grid is set
+  double cell_resolution_{0.0};
+  // voxel key to the points kept for it, reused across clouds
+  std::unordered_map<uint64_t, Extremes> voxels_;
+  std::vector<float> sq_distances_;
+};
+
+}  // namespace nav2_costmap_2d
+
+#endif  // NAV2_COSTMAP_2D__OBSERVATION_VOXEL_FILTER_HPP_
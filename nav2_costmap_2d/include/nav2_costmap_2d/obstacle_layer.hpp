@@ -56,6 +56,7 @@
 #include "nav2_costmap_2d/costmap_layer.hpp"
 #include "nav2_costmap_2d/layered_costmap.hpp"
 #include "nav2_costmap_2d/observation_buffer.hpp"
+#include "nav2_costmap_2d/observation_staging_grid.hpp"
 #include "nav2_costmap_2d/footprint.hpp"
 
 namespace nav2_costmap_2d
@@ -126,6 +127,11 @@ public:
    */
   virtual void reset();
 
+  /**
+   * @brief Match the size of the master costmap, and align the observation voxels with it
+   */
+  virtual void matchSize();
+
   /**
    * @brief If clearing operations should be processed on this layer or not
    */
@@ -175,13 +181,40 @@ public:
   void clearStaticObservations(bool marking, bool clearing);
 
 protected:
+  /**
+   * @brief  Buffer a cloud and, when processing observations asynchronously, stage it into
+   * the grid of its source
+   * @param cloud The cloud to buffer
+   * @param buffer A pointer to the observation buffer to update
+   */
+  void bufferObservation(
+    const sensor_msgs::msg::PointCloud2 & cloud,
+    const std::shared_ptr<nav2_costmap_2d::ObservationBuffer> & buffer);
+
+  /**
+   * @brief  Merge the observations staged since the last update, clearing before marking
+   * @param min_x
+   * @param min_y
+   * @param max_x
+   * @param max_y
+   * @return True if all the observation buffers are current, false otherwise
+   */
+  bool mergeStagedObservations(double * min_x, double * min_y, double * max_x, double * max_y);
+
+  /**
+   * @brief  Size the staging grid of a source on the first update, staging the observations
+   * it buffered until then. Called with the buffer of the source locked
+   * @param i Index of the source in the observation buffers
+   */
+  void stageBufferedObservations(const unsigned int & i);
+
   /**
    * @brief  Get the observations used to mark space
    * @param marking_observations A reference to a vector that will be populated with the observations
    * @return True if all the observation buffers are current, false otherwise
    */
   bool getMarkingObservations(
-    std::vector<nav2_costmap_2d::Observation> & marking_observations) const;
+    std::vector<std::shared_ptr<const nav2_costmap_2d::Observation>> & marking_observations) const;
 
   /**
    * @brief  Get the observations used to clear space
@@ -189,7 +222,8 @@ protected:
    * @return True if all the observation buffers are current, false otherwise
    */
   bool getClearingObservations(
-    std::vector<nav2_costmap_2d::Observation> & clearing_observations) const;
+    std::vector<std::shared_ptr<const nav2_costmap_2d::Observation>> & clearing_observations)
+  const;
 
   /**
    * @brief  Clear freespace based on one observation
@@ -242,13 +276,17 @@ protected:
   std::vector<std::shared_ptr<nav2_costmap_2d::ObservationBuffer>> marking_buffers_;
   /// @brief Used to store observation buffers used for clearing obstacles
   std::vector<std::shared_ptr<nav2_costmap_2d::ObservationBuffer>> clearing_buffers_;
+  /// @brief Whether observations are raytraced and marked on the threads receiving them
+  bool async_observation_processing_{false};
+  /// @brief Used to stage the observations of each buffer until the next update
+  std::vector<std::shared_ptr<nav2_costmap_2d::ObservationStagingGrid>> staging_grids_;
 
   /// @brief Dynamic parameters handler
   rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr dyn_params_handler_;
 
   // Used only for testing purposes
-  std::vector<nav2_costmap_2d::Observation> static_clearing_observations_;
-  std::vector<nav2_costmap_2d::Observation> static_marking_observations_;
+  std::vector<std::shared_ptr<const nav2_costmap_2d::Observation>> static_clearing_observations_;
+  std::vector<std::shared_ptr<const nav2_costmap_2d::Observation>> static_marking_observations_;
 
   bool rolling_window_;
   bool was_reset_;
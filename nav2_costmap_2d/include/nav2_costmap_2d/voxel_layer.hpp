@@ -53,6 +53,7 @@
 #include <sensor_msgs/msg/point_cloud2.hpp>
 #include <nav2_costmap_2d/obstacle_layer.hpp>
 #include <nav2_voxel_grid/voxel_grid.hpp>
+#include <nav2_voxel_grid/sparse_voxel_grid.hpp>
 
 namespace nav2_costmap_2d
 {
@@ -68,7 +69,7 @@ public:
    * @brief Voxel Layer constructor
    */
   VoxelLayer()
-  : voxel_grid_(0, 0, 0)
+  : voxel_grid_(0, 0, 0), sparse_voxel_grid_(0, 0, 0)
   {
     costmap_ = NULL;  // this is the unsigned char* member of parent class's parent class Costmap2D
   }
@@ -145,6 +146,9 @@ protected:
   bool publish_voxel_;
   rclcpp_lifecycle::LifecyclePublisher<nav2_msgs::msg::VoxelGrid>::SharedPtr voxel_pub_;
   nav2_voxel_grid::VoxelGrid voxel_grid_;
+  // Used instead of voxel_grid_ when use_sparse_voxel_grid is set, without a z_voxels limit
+  bool use_sparse_voxel_grid_;
+  nav2_voxel_grid::SparseVoxelGrid sparse_voxel_grid_;
   double z_resolution_, origin_z_;
   int unknown_threshold_, mark_threshold_, size_z_;
   rclcpp_lifecycle::LifecyclePublisher<sensor_msgs::msg::PointCloud2>::SharedPtr
@@ -37,11 +37,16 @@
 
 #include "nav2_costmap_2d/costmap_filters/speed_filter.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <utility>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "tf2_geometry_msgs/tf2_geometry_msgs.hpp"
+#include "nav2_util/geometry_utils.hpp"
+#include "nav2_util/line_iterator.hpp"
 #include "nav2_costmap_2d/costmap_filters/filter_values.hpp"
 
 namespace nav2_costmap_2d
@@ -50,7 +55,8 @@ namespace nav2_costmap_2d
 SpeedFilter::SpeedFilter()
 : filter_info_sub_(nullptr), mask_sub_(nullptr),
   speed_limit_pub_(nullptr), filter_mask_(nullptr), global_frame_(""),
-  speed_limit_(NO_SPEED_LIMIT), speed_limit_prev_(NO_SPEED_LIMIT)
+  speed_limit_(NO_SPEED_LIMIT), speed_limit_prev_(NO_SPEED_LIMIT),
+  lookahead_distance_(0.0), path_(nullptr), path_speed_limits_valid_(false)
 {
 }
 
@@ -69,6 +75,14 @@ void SpeedFilter::initializeFilter(
   declareParameter("speed_limit_topic", rclcpp::ParameterValue("speed_limit"));
   node->get_parameter(name_ + "." + "speed_limit_topic", speed_limit_topic);
 
+  // Declare lookahead parameters: the speed limit of the zones ahead along the path
+  // of the robot is applied lookahead_distance before entering them
+  std::string path_topic;
+  declareParameter("path_topic", rclcpp::ParameterValue(""));
+  node->get_parameter(name_ + "." + "path_topic", path_topic);
+  declareParameter("lookahead_distance", rclcpp::ParameterValue(0.0));
+  node->get_parameter(name_ + "." + "lookahead_distance", lookahead_distance_);
+
   filter_info_topic_ = filter_info_topic;
   // Setting new costmap filter info subscriber
   RCLCPP_INFO(
@@ -87,6 +101,17 @@ void SpeedFilter::initializeFilter(
     speed_limit_topic, rclcpp::QoS(10));
   speed_limit_pub_->on_activate();
 
+  if (!path_topic.empty() && lookahead_distance_ > 0.0) {
+    RCLCPP_INFO(
+      logger_,
+      "SpeedFilter: Subscribing to \"%s\" topic for path, "
+      "looking %f m ahead for speed limits...",
+      path_topic.c_str(), lookahead_distance_);
+    path_sub_ = node->create_subscription<nav_msgs::msg::Path>(
+      path_topic, rclcpp::QoS(rclcpp::KeepLast(1)),
+      std::bind(&SpeedFilter::pathCallback, this, std::placeholders::_1));
+  }
+
   // Reset speed conversion states
   base_ = BASE_DEFAULT;
   multiplier_ = MULTIPLIER_DEFAULT;
@@ -140,6 +165,7 @@ void SpeedFilter::filterInfoCallback(
   }
 
   mask_topic_ = msg->filter_mask_topic;
+  path_speed_limits_valid_ = false;
 
   // Setting new filter mask subscriber
   RCLCPP_INFO(
@@ -169,6 +195,160 @@ void SpeedFilter::maskCallback(
   }
 
   filter_mask_ = msg;
+  path_speed_limits_valid_ = false;
+}
+
+void SpeedFilter::pathCallback(
+  const nav_msgs::msg::Path::SharedPtr msg)
+{
+  std::lock_guard<CostmapFilter::mutex_t> guard(*getMutex());
+
+  path_ = msg;
+  path_speed_limits_valid_ = false;
+}
+
+bool SpeedFilter::maskDataToSpeedLimit(int8_t data, double & speed_limit) const
+{
+  if (data == SPEED_MASK_UNKNOWN) {
+    return false;
+  }
+
+  if (data == SPEED_MASK_NO_LIMIT) {
+    speed_limit = NO_SPEED_LIMIT;
+    return true;
+  }
+
+  speed_limit = data * multiplier_ + base_;
+  if (speed_limit < 0.0 || (percentage_ && speed_limit > 100.0)) {
+    speed_limit = NO_SPEED_LIMIT;
+  }
+  return true;
+}
+
+double SpeedFilter::mostRestrictive(double speed_limit_a, double speed_limit_b)
+{
+  if (speed_limit_a == NO_SPEED_LIMIT) {
+    return speed_limit_b;
+  }
+  if (speed_limit_b == NO_SPEED_LIMIT) {
+    return speed_limit_a;
+  }
+  return std::min(speed_limit_a, speed_limit_b);
+}
+
+bool SpeedFilter::getSpeedLimitProfile(
+  const nav_msgs::msg::Path & path, std::vector<double> & speed_limits)
+{
+  std::lock_guard<CostmapFilter::mutex_t> guard(*getMutex());
+
+  speed_limits.clear();
+  if (!filter_mask_) {
+    return false;
+  }
+
+  // Looking up the transform once for the whole path rather than for each pose
+  const std::string & mask_frame = filter_mask_->header.frame_id;
+  const bool transform_needed = path.header.frame_id != mask_frame;
+  geometry_msgs::msg::TransformStamped transform;
+  if (transform_needed) {
+    try {
+      transform = tf_->lookupTransform(
+        mask_frame, path.header.frame_id, tf2::TimePointZero, transform_tolerance_);
+    } catch (tf2::TransformException & ex) {
+      RCLCPP_ERROR(
+        logger_,
+        "SpeedFilter: failed to get path frame (%s) "
+        "transformation to mask frame (%s) with error: %s",
+        path.header.frame_id.c_str(), mask_frame.c_str(), ex.what());
+      return false;
+    }
+  }
+
+  const double origin_x = filter_mask_->info.origin.position.x;
+  const double origin_y = filter_mask_->info.origin.position.y;
+  const double resolution = filter_mask_->info.resolution;
+  const int size_x = filter_mask_->info.width;
+  const int size_y = filter_mask_->info.height;
+
+  auto cellSpeedLimit = [&](int mx, int my) {
+      double speed_limit = NO_SPEED_LIMIT;
+      if (mx < 0 || my < 0 || mx >= size_x || my >= size_y ||
+        !maskDataToSpeedLimit(getMaskData(filter_mask_, mx, my), speed_limit))
+      {
+        // Out of mask and unknown cells set no speed limit, as in process()
+        return NO_SPEED_LIMIT;
+      }
+      return speed_limit;
+    };
+
+  speed_limits.reserve(path.poses.size());
+  int prev_mx = 0, prev_my = 0;
+  for (size_t i = 0; i < path.poses.size(); ++i) {
+    geometry_msgs::msg::Point point = path.poses[i].pose.position;
+    if (transform_needed) {
+      tf2::doTransform(path.poses[i].pose.position, point, transform);
+    }
+    const int mx = static_cast<int>(std::floor((point.x - origin_x) / resolution));
+    const int my = static_cast<int>(std::floor((point.y - origin_y) / resolution));
+    if (i == 0) {
+      prev_mx = mx;
+      prev_my = my;
+    }
+
+    // Most restrictive speed limit over the cells crossed from the previous pose
+    double speed_limit = NO_SPEED_LIMIT;
+    for (nav2_util::LineIterator line(prev_mx, prev_my, mx, my); line.isValid();
+      line.advance())
+    {
+      speed_limit = mostRestrictive(speed_limit, cellSpeedLimit(line.getX(), line.getY()));
+    }
+    speed_limits.push_back(speed_limit);
+
+    prev_mx = mx;
+    prev_my = my;
+  }
+
+  return true;
+}
+
+void SpeedFilter::applyLookahead(const geometry_msgs::msg::Pose2D & pose)
+{
+  if (!path_ || path_->poses.empty()) {
+    return;
+  }
+
+  if (!path_speed_limits_valid_) {
+    if (!getSpeedLimitProfile(*path_, path_speed_limits_)) {
+      return;
+    }
+    path_length_.resize(path_->poses.size());
+    path_length_[0] = 0.0;
+    for (size_t i = 1; i < path_->poses.size(); ++i) {
+      path_length_[i] = path_length_[i - 1] + nav2_util::geometry_utils::euclidean_distance(
+        path_->poses[i - 1].pose, path_->poses[i].pose);
+    }
+    path_progress_tracker_.setPath(path_);
+    path_speed_limits_valid_ = true;
+  }
+
+  geometry_msgs::msg::Pose2D path_pose;  // robot coordinates in path frame
+  if (!transformPose(global_frame_, pose, path_->header.frame_id, path_pose)) {
+    return;
+  }
+  geometry_msgs::msg::PoseStamped robot_pose;
+  robot_pose.header.frame_id = path_->header.frame_id;
+  robot_pose.pose.position.x = path_pose.x;
+  robot_pose.pose.position.y = path_pose.y;
+  path_progress_tracker_.update(robot_pose);
+
+  // Path segments starting within lookahead_distance_ ahead of the robot
+  const size_t closest = path_progress_tracker_.getClosestIndex();
+  for (size_t i = closest + 1; i < path_speed_limits_.size(); ++i) {
+    if (path_length_[i - 1] - path_length_[closest] > lookahead_distance_) {
+      break;
+    }
+    speed_limit_ = mostRestrictive(speed_limit_, path_speed_limits_[i]);
+  }
 }
 
 void SpeedFilter::process(
@@ -239,6 +419,10 @@ void SpeedFilter::process(
     }
   }
 
+  if (path_sub_) {
+    applyLookahead(pose);
+  }
+
   if (speed_limit_ != speed_limit_prev_) {
     if (speed_limit_ != NO_SPEED_LIMIT) {
       RCLCPP_DEBUG(logger_, "SpeedFilter: Speed limit is set to %f", speed_limit_);
@@ -265,6 +449,9 @@ void SpeedFilter::resetFilter()
 
   filter_info_sub_.reset();
   mask_sub_.reset();
+  path_sub_.reset();
+  path_.reset();
+  path_progress_tracker_.reset();
   if (speed_limit_pub_) {
     speed_limit_pub_->on_deactivate();
     speed_limit_pub_.reset();
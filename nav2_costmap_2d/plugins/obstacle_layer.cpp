@@ -82,6 +82,7 @@ void ObstacleLayer::onInitialize()
   declareParameter("max_obstacle_height", rclcpp::ParameterValue(2.0));
   declareParameter("combination_method", rclcpp::ParameterValue(1));
   declareParameter("observation_sources", rclcpp::ParameterValue(std::string("")));
+  declareParameter("async_observation_processing", rclcpp::ParameterValue(false));
 
   auto node = node_.lock();
   if (!node) {
@@ -95,6 +96,9 @@ void ObstacleLayer::onInitialize()
   node->get_parameter("track_unknown_space", track_unknown_space);
   node->get_parameter("transform_tolerance", transform_tolerance);
   node->get_parameter(name_ + "." + "observation_sources", topics_string);
+  node->get_parameter(
+    name_ + "." + "async_observation_processing",
+    async_observation_processing_);
 
   int combination_method_param{};
   node->get_parameter(name_ + "." + "combination_method", combination_method_param);
@@ -151,6 +155,7 @@ void ObstacleLayer::onInitialize()
     declareParameter(source + "." + "obstacle_min_range", rclcpp::ParameterValue(0.0));
     declareParameter(source + "." + "raytrace_max_range", rclcpp::ParameterValue(3.0));
     declareParameter(source + "." + "raytrace_min_range", rclcpp::ParameterValue(0.0));
+    declareParameter(source + "." + "voxel_filter_resolution", rclcpp::ParameterValue(0.0));
 
     node->get_parameter(name_ + "." + source + "." + "topic", topic);
     node->get_parameter(name_ + "." + source + "." + "sensor_frame", sensor_frame);
@@ -185,6 +190,11 @@ void ObstacleLayer::onInitialize()
     node->get_parameter(name_ + "." + source + "." + "raytrace_min_range", raytrace_min_range);
     node->get_parameter(name_ + "." + source + "." + "raytrace_max_range", raytrace_max_range);
 
+    // get the size of the voxels the clouds are reduced to, 0 to keep every point
+    double voxel_filter_resolution;
+    node->get_parameter(
+      name_ + "." + source + "." + "voxel_filter_resolution",
+      voxel_filter_resolution);
 
     RCLCPP_DEBUG(
       logger_,
@@ -202,7 +212,9 @@ void ObstacleLayer::onInitialize()
           max_obstacle_height, obstacle_max_range, obstacle_min_range, raytrace_max_range,
           raytrace_min_range, *tf_,
           global_frame_,
-          sensor_frame, tf2::durationFromSec(transform_tolerance))));
+          sensor_frame, tf2::durationFromSec(transform_tolerance),
+          voxel_filter_resolution)));
+    observation_buffers_.back()->setVoxelGrid(getOriginX(), getOriginY(), getResolution());
 
     // check if we'll add this buffer to our marking observation buffers
     if (marking) {
@@ -214,6 +226,9 @@ void ObstacleLayer::onInitialize()
       clearing_buffers_.push_back(observation_buffers_.back());
     }
 
+    // and stage its observations on arrival if requested
+    staging_grids_.push_back(std::make_shared<ObservationStagingGrid>(marking, clearing));
+
     RCLCPP_DEBUG(
       logger_,
       "Created an observation buffer for source %s, topic %s, global frame: %s, "
@@ -352,9 +367,7 @@ ObstacleLayer::laserScanCallback(
   }
 
   // buffer the point cloud
-  buffer->lock();
-  buffer->bufferCloud(cloud);
-  buffer->unlock();
+  bufferObservation(cloud, buffer);
 }
 
 void
@@ -395,9 +408,7 @@ ObstacleLayer::laserScanValidInfCallback(
   }
 
   // buffer the point cloud
-  buffer->lock();
-  buffer->bufferCloud(cloud);
-  buffer->unlock();
+  bufferObservation(cloud, buffer);
 }
 
 void
@@ -406,8 +417,32 @@ ObstacleLayer::pointCloud2Callback(
   const std::shared_ptr<ObservationBuffer> & buffer)
 {
   // buffer the point cloud
+  bufferObservation(*message, buffer);
+}
+
+void
+ObstacleLayer::bufferObservation(
+  const sensor_msgs::msg::PointCloud2 & cloud,
+  const std::shared_ptr<ObservationBuffer> & buffer)
+{
   buffer->lock();
-  buffer->bufferCloud(*message);
+  const bool buffered = buffer->bufferCloud(cloud);
+  const Observation * observation = buffer->getLatestObservation();
+  for (unsigned int i = 0; i < observation_buffers_.size(); ++i) {
+    if (!buffered || !async_observation_processing_ || observation_buffers_[i] != buffer) {
+      continue;
+    }
+
+    // staged under the buffer lock, so that the latest observation need not be copied.
+    // Until the first update sizes the grid, it is left in the buffer to be staged then
+    std::lock_guard<Costmap2D::mutex_t> guard(*staging_grids_[i]->getMutex());
+    if (staging_grids_[i]->isSized() && !staging_grids_[i]->stage(*observation)) {
+      RCLCPP_WARN(
+        logger_,
+        "Sensor origin at (%.2f, %.2f) is out of map bounds. The costmap cannot raytrace for it.",
+        observation->origin_.x, observation->origin_.y);
+    }
+  }
   buffer->unlock();
 }
 
@@ -426,27 +461,32 @@ ObstacleLayer::updateBounds(
   useExtraBounds(min_x, min_y, max_x, max_y);
 
   bool current = true;
-  std::vector<Observation> observations, clearing_observations;
+  std::vector<std::shared_ptr<const Observation>> observations, clearing_observations;
 
-  // get the marking observations
-  current = current && getMarkingObservations(observations);
+  if (async_observation_processing_) {
+    // the buffered observations were already staged, only the static ones are left
+    current = mergeStagedObservations(min_x, min_y, max_x, max_y);
+    observations = static_marking_observations_;
+    clearing_observations = static_clearing_observations_;
+  } else {
+    // get the marking observations
+    current = current && getMarkingObservations(observations);
 
-  // get the clearing observations
-  current = current && getClearingObservations(clearing_observations);
+    // get the clearing observations
+    current = current && getClearingObservations(clearing_observations);
+  }
 
   // update the global current status
   current_ = current;
 
   // raytrace freespace
   for (unsigned int i = 0; i < clearing_observations.size(); ++i) {
-    raytraceFreespace(clearing_observations[i], min_x, min_y, max_x, max_y);
+    raytraceFreespace(*clearing_observations[i], min_x, min_y, max_x, max_y);
   }
 
   // place the new obstacles into a priority queue... each with a priority of zero to begin with
-  for (std::vector<Observation>::const_iterator it = observations.begin();
-    it != observations.end(); ++it)
-  {
-    const Observation & obs = *it;
+  for (const auto & observation : observations) {
+    const Observation & obs = *observation;
 
     const sensor_msgs::msg::PointCloud2 & cloud = *(obs.cloud_);
 
@@ -557,16 +597,77 @@ ObstacleLayer::updateCosts(
   }
 }
 
+bool
+ObstacleLayer::mergeStagedObservations(
+  double * min_x, double * min_y, double * max_x, double * max_y)
+{
+  bool current = true;
+  for (unsigned int i = 0; i < observation_buffers_.size(); ++i) {
+    observation_buffers_[i]->lock();
+    current = observation_buffers_[i]->isCurrent() && current;
+    stageBufferedObservations(i);
+    observation_buffers_[i]->unlock();
+  }
+
+  // hold every grid so that marks of one source are not cleared by a later one
+  std::vector<std::unique_lock<Costmap2D::mutex_t>> guards;
+  guards.reserve(staging_grids_.size());
+  for (auto & grid : staging_grids_) {
+    guards.emplace_back(*grid->getMutex());
+    grid->matchGeometry(*this);
+    grid->setObstacleHeights(min_obstacle_height_, max_obstacle_height_);
+  }
+
+  for (auto & grid : staging_grids_) {
+    grid->mergeClearing(*this);
+  }
+  for (auto & grid : staging_grids_) {
+    grid->mergeMarking(*this);
+    grid->expandBounds(min_x, min_y, max_x, max_y);
+    grid->clearStaged();
+  }
+  return current;
+}
+
+void
+ObstacleLayer::stageBufferedObservations(const unsigned int & i)
+{
+  auto & grid = staging_grids_[i];
+  std::lock_guard<Costmap2D::mutex_t> guard(*grid->getMutex());
+  if (grid->isSized()) {
+    return;
+  }
+  grid->matchGeometry(*this);
+  if (!grid->isSized()) {
+    return;
+  }
+  grid->setObstacleHeights(min_obstacle_height_, max_obstacle_height_);
+
+  // the observations received before the grid was sized, oldest first
+  std::vector<std::shared_ptr<const Observation>> observations;
+  observation_buffers_[i]->getObservations(observations);
+  for (auto it = observations.rbegin(); it != observations.rend(); ++it) {
+    if (!grid->stage(**it)) {
+      RCLCPP_WARN(
+        logger_,
+        "Sensor origin at (%.2f, %.2f) is out of map bounds. The costmap cannot raytrace for it.",
+        (*it)->origin_.x, (*it)->origin_.y);
+    }
+  }
+}
+
 void
 ObstacleLayer::addStaticObservation(
   nav2_costmap_2d::Observation & obs,
   bool marking, bool clearing)
 {
+  // copied once, then shared with every update as the buffered ones
+  auto observation = std::make_shared<const Observation>(obs);
   if (marking) {
-    static_marking_observations_.push_back(obs);
+    static_marking_observations_.push_back(observation);
   }
   if (clearing) {
-    static_clearing_observations_.push_back(obs);
+    static_clearing_observations_.push_back(observation);
   }
 }
 
@@ -582,7 +683,8 @@ ObstacleLayer::clearStaticObservations(bool marking, bool clearing)
 }
 
 bool
-ObstacleLayer::getMarkingObservations(std::vector<Observation> & marking_observations) const
+ObstacleLayer::getMarkingObservations(
+  std::vector<std::shared_ptr<const Observation>> & marking_observations) const
 {
   bool current = true;
   // get the marking observations
@@ -599,7 +701,8 @@ ObstacleLayer::getMarkingObservations(std::vector<Observation> & marking_observa
 }
 
 bool
-ObstacleLayer::getClearingObservations(std::vector<Observation> & clearing_observations) const
+ObstacleLayer::getClearingObservations(
+  std::vector<std::shared_ptr<const Observation>> & clearing_observations) const
 {
   bool current = true;
   // get the clearing observations
@@ -751,11 +854,26 @@ void
 ObstacleLayer::reset()
 {
   resetMaps();
+  for (auto & grid : staging_grids_) {
+    std::lock_guard<Costmap2D::mutex_t> guard(*grid->getMutex());
+    grid->clearStaged();
+  }
   resetBuffersLastUpdated();
   current_ = false;
   was_reset_ = true;
 }
 
+void
+ObstacleLayer::matchSize()
+{
+  CostmapLayer::matchSize();
+  for (auto & buffer : observation_buffers_) {
+    buffer->lock();
+    buffer->setVoxelGrid(getOriginX(), getOriginY(), getResolution());
+    buffer->unlock();
+  }
+}
+
 void
 ObstacleLayer::resetBuffersLastUpdated()
 {
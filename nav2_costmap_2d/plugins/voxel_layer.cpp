@@ -72,6 +72,7 @@ void VoxelLayer::onInitialize()
   declareParameter("mark_threshold", rclcpp::ParameterValue(0));
   declareParameter("combination_method", rclcpp::ParameterValue(1));
   declareParameter("publish_voxel_map", rclcpp::ParameterValue(false));
+  declareParameter("use_sparse_voxel_grid", rclcpp::ParameterValue(false));
 
   auto node = node_.lock();
   if (!node) {
@@ -87,6 +88,20 @@ void VoxelLayer::onInitialize()
   node->get_parameter(name_ + "." + "unknown_threshold", unknown_threshold_);
   node->get_parameter(name_ + "." + "mark_threshold", mark_threshold_);
   node->get_parameter(name_ + "." + "publish_voxel_map", publish_voxel_);
+  node->get_parameter(name_ + "." + "use_sparse_voxel_grid", use_sparse_voxel_grid_);
+
+  if (!use_sparse_voxel_grid_ && size_z_ > VOXEL_BITS) {
+    RCLCPP_WARN(
+      logger_, "z_voxels of %d is more than the %d levels of the voxel grid, "
+      "set use_sparse_voxel_grid to use them all", size_z_, VOXEL_BITS);
+  }
+
+  // observations are raytraced in 3D on update, there is no 2D staging for them
+  if (async_observation_processing_) {
+    RCLCPP_WARN(
+      logger_, "async_observation_processing is not supported by the voxel layer, ignoring it");
+    async_observation_processing_ = false;
+  }
 
   int combination_method_param{};
   node->get_parameter(name_ + "." + "combination_method", combination_method_param);
@@ -104,7 +119,10 @@ void VoxelLayer::onInitialize()
     "clearing_endpoints", custom_qos);
   clearing_endpoints_pub_->on_activate();
 
-  unknown_threshold_ += (VOXEL_BITS - size_z_);
+  if (!use_sparse_voxel_grid_) {
+    // the dense grid counts its unused levels as unknown
+    unknown_threshold_ += (VOXEL_BITS - size_z_);
+  }
   matchSize();
 
   // Add callback for dynamic parameters
@@ -123,6 +141,11 @@ void VoxelLayer::matchSize()
 {
   std::lock_guard<Costmap2D::mutex_t> guard(*getMutex());
   ObstacleLayer::matchSize();
+  if (use_sparse_voxel_grid_) {
+    sparse_voxel_grid_.resize(size_x_, size_y_, size_z_);
+    assert(sparse_voxel_grid_.sizeX() == size_x_ && sparse_voxel_grid_.sizeY() == size_y_);
+    return;
+  }
   voxel_grid_.resize(size_x_, size_y_, size_z_);
   assert(voxel_grid_.sizeX() == size_x_ && voxel_grid_.sizeY() == size_y_);
 }
@@ -141,7 +164,11 @@ void VoxelLayer::resetMaps()
   // resetMaps so this goes to the next layer down Costmap2DLayer which also
   // doesn't implement this, so it actually goes all the way to Costmap2D
   ObstacleLayer::resetMaps();
-  voxel_grid_.reset();
+  if (use_sparse_voxel_grid_) {
+    sparse_voxel_grid_.reset();
+  } else {
+    voxel_grid_.reset();
+  }
 }
 
 void VoxelLayer::updateBounds(
@@ -159,7 +186,7 @@ void VoxelLayer::updateBounds(
   useExtraBounds(min_x, min_y, max_x, max_y);
 
   bool current = true;
-  std::vector<Observation> observations, clearing_observations;
+  std::vector<std::shared_ptr<const Observation>> observations, clearing_observations;
 
   // get the marking observations
   current = getMarkingObservations(observations) && current;
@@ -172,14 +199,12 @@ void VoxelLayer::updateBounds(
 
   // raytrace freespace
   for (unsigned int i = 0; i < clearing_observations.size(); ++i) {
-    raytraceFreespace(clearing_observations[i], min_x, min_y, max_x, max_y);
+    raytraceFreespace(*clearing_observations[i], min_x, min_y, max_x, max_y);
   }
 
   // place the new obstacles into a priority queue... each with a priority of zero to begin with
-  for (std::vector<Observation>::const_iterator it = observations.begin(); it != observations.end();
-    ++it)
-  {
-    const Observation & obs = *it;
+  for (const auto & observation : observations) {
+    const Observation & obs = *observation;
 
     const sensor_msgs::msg::PointCloud2 & cloud = *(obs.cloud_);
 
@@ -222,7 +247,10 @@ void VoxelLayer::updateBounds(
       }
 
       // mark the cell in the voxel grid and check if we should also mark it in the costmap
-      if (voxel_grid_.markVoxelInMap(mx, my, mz, mark_threshold_)) {
+      const bool mark_cell = use_sparse_voxel_grid_ ?
+        sparse_voxel_grid_.markVoxelInMap(mx, my, mz, mark_threshold_) :
+        voxel_grid_.markVoxelInMap(mx, my, mz, mark_threshold_);
+      if (mark_cell) {
         unsigned int index = getIndex(mx, my);
 
         costmap_[index] = LETHAL_OBSTACLE;
@@ -235,12 +263,21 @@ void VoxelLayer::updateBounds(
 
   if (publish_voxel_) {
     auto grid_msg = std::make_unique<nav2_msgs::msg::VoxelGrid>();
-    unsigned int size = voxel_grid_.sizeX() * voxel_grid_.sizeY();
-    grid_msg->size_x = voxel_grid_.sizeX();
-    grid_msg->size_y = voxel_grid_.sizeY();
-    grid_msg->size_z = voxel_grid_.sizeZ();
-    grid_msg->data.resize(size);
-    memcpy(&grid_msg->data[0], voxel_grid_.getData(), size * sizeof(unsigned int));
+    if (use_sparse_voxel_grid_) {
+      // the message packs a column in 32 bits, so only holds the lowest 16 levels
+      grid_msg->size_x = sparse_voxel_grid_.sizeX();
+      grid_msg->size_y = sparse_voxel_grid_.sizeY();
+      grid_msg->size_z = std::min<unsigned int>(sparse_voxel_grid_.sizeZ(), VOXEL_BITS);
+      grid_msg->data.resize(grid_msg->size_x * grid_msg->size_y);
+      sparse_voxel_grid_.getDenseData(&grid_msg->data[0]);
+    } else {
+      unsigned int size = voxel_grid_.sizeX() * voxel_grid_.sizeY();
+      grid_msg->size_x = voxel_grid_.sizeX();
+      grid_msg->size_y = voxel_grid_.sizeY();
+      grid_msg->size_z = voxel_grid_.sizeZ();
+      grid_msg->data.resize(size);
+      memcpy(&grid_msg->data[0], voxel_grid_.getData(), size * sizeof(unsigned int));
+    }
 
     grid_msg->origin.x = origin_x_;
     grid_msg->origin.y = origin_y_;
@@ -378,11 +415,19 @@ void VoxelLayer::raytraceFreespace(
 
 
       // voxel_grid_.markVoxelLine(sensor_x, sensor_y, sensor_z, point_x, point_y, point_z);
-      voxel_grid_.clearVoxelLineInMap(
-        sensor_x, sensor_y, sensor_z, point_x, point_y, point_z,
-        costmap_,
-        unknown_threshold_, mark_threshold_, FREE_SPACE, NO_INFORMATION,
-        cell_raytrace_max_range, cell_raytrace_min_range);
+      if (use_sparse_voxel_grid_) {
+        sparse_voxel_grid_.clearVoxelLineInMap(
+          sensor_x, sensor_y, sensor_z, point_x, point_y, point_z,
+          costmap_,
+          unknown_threshold_, mark_threshold_, FREE_SPACE, NO_INFORMATION,
+          cell_raytrace_max_range, cell_raytrace_min_range);
+      } else {
+        voxel_grid_.clearVoxelLineInMap(
+          sensor_x, sensor_y, sensor_z, point_x, point_y, point_z,
+          costmap_,
+          unknown_threshold_, mark_threshold_, FREE_SPACE, NO_INFORMATION,
+          cell_raytrace_max_range, cell_raytrace_min_range);
+      }
 
       updateRaytraceBounds(
         ox, oy, wpx, wpy, clearing_observation.raytrace_max_range_,
@@ -439,14 +484,28 @@ void VoxelLayer::updateOrigin(double new_origin_x, double new_origin_y)
 
   // we need a map to store the obstacles in the window temporarily
   unsigned char * local_map = new unsigned char[cell_size_x * cell_size_y];
-  unsigned int * local_voxel_map = new unsigned int[cell_size_x * cell_size_y];
-  unsigned int * voxel_map = voxel_grid_.getData();
 
   // copy the local window in the costmap to the local map
   copyMapRegion(
     costmap_, lower_left_x, lower_left_y, size_x_, local_map, 0, 0, cell_size_x,
     cell_size_x,
     cell_size_y);
+
+  if (use_sparse_voxel_grid_) {
+    // the sparse grid moves its own window, only dropping the voxels which left it
+    ObstacleLayer::resetMaps();
+    sparse_voxel_grid_.updateOrigin(cell_ox, cell_oy);
+    origin_x_ = new_grid_ox;
+    origin_y_ = new_grid_oy;
+    copyMapRegion(
+      local_map, 0, 0, cell_size_x, costmap_, lower_left_x - cell_ox, lower_left_y - cell_oy,
+      size_x_, cell_size_x, cell_size_y);
+    delete[] local_map;
+    return;
+  }
+
+  unsigned int * local_voxel_map = new unsigned int[cell_size_x * cell_size_y];
+  unsigned int * voxel_map = voxel_grid_.getData();
   copyMapRegion(
     voxel_map, lower_left_x, lower_left_y, size_x_, local_voxel_map, 0, 0, cell_size_x,
     cell_size_x,
@@ -514,6 +573,11 @@ VoxelLayer::dynamicParametersCallback(
           logger_, "publish voxel map is not a dynamic parameter "
           "cannot be changed while running. Rejecting parameter update.");
         continue;
+      } else if (param_name == name_ + "." + "use_sparse_voxel_grid") {
+        RCLCPP_WARN(
+          logger_, "use sparse voxel grid is not a dynamic parameter "
+          "cannot be changed while running. Rejecting parameter update.");
+        continue;
       }
 
     } else if (param_type == ParameterType::PARAMETER_INTEGER) {
@@ -521,7 +585,10 @@ VoxelLayer::dynamicParametersCallback(
         size_z_ = parameter.as_int();
         resize_map_needed = true;
       } else if (param_name == name_ + "." + "unknown_threshold") {
-        unknown_threshold_ = parameter.as_int() + (VOXEL_BITS - size_z_);
+        unknown_threshold_ = parameter.as_int();
+        if (!use_sparse_voxel_grid_) {
+          unknown_threshold_ += (VOXEL_BITS - size_z_);
+        }
       } else if (param_name == name_ + "." + "mark_threshold") {
         mark_threshold_ = parameter.as_int();
       } else if (param_name == name_ + "." + "combination_method") {
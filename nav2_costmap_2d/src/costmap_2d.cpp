@@ -388,27 +388,21 @@ bool Costmap2D::setConvexPolygonCost(
   unsigned char cost_value)
 {
   // we assume the polygon is given in the global_frame...
-  // we need to transform it to map coordinates
-  std::vector<MapLocation> map_polygon;
+  // we need to transform it to map coordinates, reusing a buffer of the calling thread
+  static thread_local std::vector<MapLocation> map_polygon;
+  map_polygon.resize(polygon.size());
   for (unsigned int i = 0; i < polygon.size(); ++i) {
-    MapLocation loc;
-    if (!worldToMap(polygon[i].x, polygon[i].y, loc.x, loc.y)) {
+    if (!worldToMap(polygon[i].x, polygon[i].y, map_polygon[i].x, map_polygon[i].y)) {
       // ("Polygon lies outside map bounds, so we can't fill it");
       return false;
     }
-    map_polygon.push_back(loc);
   }
 
-  std::vector<MapLocation> polygon_cells;
-
-  // get the cells that fill the polygon
-  convexFillCells(map_polygon, polygon_cells);
-
-  // set the cost of those cells
-  for (unsigned int i = 0; i < polygon_cells.size(); ++i) {
-    unsigned int index = getIndex(polygon_cells[i].x, polygon_cells[i].y);
-    costmap_[index] = cost_value;
-  }
+  // set the cost of the cells that fill the polygon, a row at a time
+  convexFillSpans(
+    map_polygon, [this, cost_value](unsigned int begin, unsigned int end) {
+      std::fill(costmap_ + begin, costmap_ + end, cost_value);
+    });
   return true;
 }
 
@@ -433,69 +427,15 @@ void Costmap2D::convexFillCells(
   const std::vector<MapLocation> & polygon,
   std::vector<MapLocation> & polygon_cells)
 {
-  // we need a minimum polygon of a triangle
-  if (polygon.size() < 3) {
-    return;
-  }
-
-  // first get the cells that make up the outline of the polygon
-  polygonOutlineCells(polygon, polygon_cells);
-
-  // quick bubble sort to sort points by x
-  MapLocation swap;
-  unsigned int i = 0;
-  while (i < polygon_cells.size() - 1) {
-    if (polygon_cells[i].x > polygon_cells[i + 1].x) {
-      swap = polygon_cells[i];
-      polygon_cells[i] = polygon_cells[i + 1];
-      polygon_cells[i + 1] = swap;
-
-      if (i > 0) {
-        --i;
-      }
-    } else {
-      ++i;
-    }
-  }
-
-  i = 0;
-  MapLocation min_pt;
-  MapLocation max_pt;
-  unsigned int min_x = polygon_cells[0].x;
-  unsigned int max_x = polygon_cells[polygon_cells.size() - 1].x;
-
-  // walk through each column and mark cells inside the polygon
-  for (unsigned int x = min_x; x <= max_x; ++x) {
-    if (i >= polygon_cells.size() - 1) {
-      break;
-    }
-
-    if (polygon_cells[i].y < polygon_cells[i + 1].y) {
-      min_pt = polygon_cells[i];
-      max_pt = polygon_cells[i + 1];
-    } else {
-      min_pt = polygon_cells[i + 1];
-      max_pt = polygon_cells[i];
-    }
-
-    i += 2;
-    while (i < polygon_cells.size() && polygon_cells[i].x == x) {
-      if (polygon_cells[i].y < min_pt.y) {
-        min_pt = polygon_cells[i];
-      } else if (polygon_cells[i].y > max_pt.y) {
-        max_pt = polygon_cells[i];
+  // get the cells that fill the polygon, row by row
+  convexFillSpans(
+    polygon, [this, &polygon_cells](unsigned int begin, unsigned int end) {
+      MapLocation loc;
+      indexToCells(begin, loc.x, loc.y);
+      for (; begin != end; ++begin, ++loc.x) {
+        polygon_cells.push_back(loc);
       }
-      ++i;
-    }
-
-    MapLocation pt;
-    // loop though cells in the column
-    for (unsigned int y = min_pt.y; y <= max_pt.y; ++y) {
-      pt.x = x;
-      pt.y = y;
-      polygon_cells.push_back(pt);
-    }
-  }
+    });
 }
 
 unsigned int Costmap2D::getSizeInCellsX() const
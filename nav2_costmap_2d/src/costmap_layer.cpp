@@ -43,6 +43,55 @@
 namespace nav2_costmap_2d
 {
 
+namespace
+{
+
+// Branch-free kernels merging a row of a layer into the master grid. Each cell is a select
+// on byte values, so that the compiler vectorizes the rows into byte-wise max and blends.
+
+inline void maxRow(unsigned char * master, const unsigned char * layer, int size)
+{
+  for (int i = 0; i < size; ++i) {
+    // unknown master cells lose to any known cost
+    const unsigned char old_cost = master[i];
+    const unsigned char known_cost = old_cost == NO_INFORMATION ? 0 : old_cost;
+    master[i] = layer[i] == NO_INFORMATION ? old_cost : std::max(known_cost, layer[i]);
+  }
+}
+
+inline void maxWithoutUnknownOverwriteRow(
+  unsigned char * master, const unsigned char * layer, int size)
+{
+  for (int i = 0; i < size; ++i) {
+    // unknown master cells are kept, as is everything when the layer is unknown
+    const unsigned char old_cost = master[i];
+    const unsigned char cost = layer[i] == NO_INFORMATION ? 0 : layer[i];
+    master[i] = old_cost == NO_INFORMATION ? old_cost : std::max(old_cost, cost);
+  }
+}
+
+inline void overwriteRow(unsigned char * master, const unsigned char * layer, int size)
+{
+  for (int i = 0; i < size; ++i) {
+    master[i] = layer[i] == NO_INFORMATION ? master[i] : layer[i];
+  }
+}
+
+inline void additionRow(unsigned char * master, const unsigned char * layer, int size)
+{
+  for (int i = 0; i < size; ++i) {
+    // sums saturate below the inscribed cost
+    const unsigned char old_cost = master[i];
+    const unsigned int sum = old_cost + layer[i];
+    const unsigned char added =
+      sum >= INSCRIBED_INFLATED_OBSTACLE ? INSCRIBED_INFLATED_OBSTACLE - 1 : sum;
+    const unsigned char cost = old_cost == NO_INFORMATION ? layer[i] : added;
+    master[i] = layer[i] == NO_INFORMATION ? old_cost : cost;
+  }
+}
+
+}  // namespace
+
 void CostmapLayer::touch(
   double x, double y, double * min_x, double * min_y, double * max_x,
   double * max_y)
@@ -121,18 +170,7 @@ void CostmapLayer::updateWithMax(
 
   for (int j = min_j; j < max_j; j++) {
     unsigned int it = j * span + min_i;
-    for (int i = min_i; i < max_i; i++) {
-      if (costmap_[it] == NO_INFORMATION) {
-        it++;
-        continue;
-      }
-
-      unsigned char old_cost = master_array[it];
-      if (old_cost == NO_INFORMATION || old_cost < costmap_[it]) {
-        master_array[it] = costmap_[it];
-      }
-      it++;
-    }
+    maxRow(master_array + it, costmap_ + it, max_i - min_i);
   }
 }
 
@@ -150,18 +188,7 @@ void CostmapLayer::updateWithMaxWithoutUnknownOverwrite(
 
   for (int j = min_j; j < max_j; j++) {
     unsigned int it = j * span + min_i;
-    for (int i = min_i; i < max_i; i++) {
-      if (costmap_[it] == NO_INFORMATION) {
-        it++;
-        continue;
-      }
-
-      unsigned char old_cost = master_array[it];
-      if (old_cost != NO_INFORMATION && old_cost < costmap_[it]) {
-        master_array[it] = costmap_[it];
-      }
-      it++;
-    }
+    maxWithoutUnknownOverwriteRow(master_array + it, costmap_ + it, max_i - min_i);
   }
 }
 
@@ -184,10 +211,7 @@ void CostmapLayer::updateWithTrueOverwrite(
 
   for (int j = min_j; j < max_j; j++) {
     unsigned int it = span * j + min_i;
-    for (int i = min_i; i < max_i; i++) {
-      master[it] = costmap_[it];
-      it++;
-    }
+    std::copy(costmap_ + it, costmap_ + it + std::max(max_i - min_i, 0), master + it);
   }
 }
 
@@ -203,12 +227,7 @@ void CostmapLayer::updateWithOverwrite(
 
   for (int j = min_j; j < max_j; j++) {
     unsigned int it = span * j + min_i;
-    for (int i = min_i; i < max_i; i++) {
-      if (costmap_[it] != NO_INFORMATION) {
-        master[it] = costmap_[it];
-      }
-      it++;
-    }
+    overwriteRow(master + it, costmap_ + it, max_i - min_i);
   }
 }
 
@@ -224,25 +243,7 @@ void CostmapLayer::updateWithAddition(
 
   for (int j = min_j; j < max_j; j++) {
     unsigned int it = j * span + min_i;
-    for (int i = min_i; i < max_i; i++) {
-      if (costmap_[it] == NO_INFORMATION) {
-        it++;
-        continue;
-      }
-
-      unsigned char old_cost = master_array[it];
-      if (old_cost == NO_INFORMATION) {
-        master_array[it] = costmap_[it];
-      } else {
-        int sum = old_cost + costmap_[it];
-        if (sum >= nav2_costmap_2d::INSCRIBED_INFLATED_OBSTACLE) {
-          master_array[it] = nav2_costmap_2d::INSCRIBED_INFLATED_OBSTACLE - 1;
-        } else {
-          master_array[it] = sum;
-        }
-      }
-      it++;
-    }
+    additionRow(master_array + it, costmap_ + it, max_i - min_i);
   }
 }
 
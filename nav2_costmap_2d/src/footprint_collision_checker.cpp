@@ -45,7 +45,7 @@ FootprintCollisionChecker<CostmapT>::FootprintCollisionChecker(
 }
 
 template<typename CostmapT>
-double FootprintCollisionChecker<CostmapT>::footprintCost(const Footprint footprint)
+double FootprintCollisionChecker<CostmapT>::footprintCost(const Footprint & footprint)
 {
   // now we really have to lay down the footprint in the costmap_ grid
   unsigned int x0, x1, y0, y1;
@@ -127,7 +127,7 @@ void FootprintCollisionChecker<CostmapT>::setCostmap(CostmapT costmap)
 
 template<typename CostmapT>
 double FootprintCollisionChecker<CostmapT>::footprintCostAtPose(
-  double x, double y, double theta, const Footprint footprint)
+  double x, double y, double theta, const Footprint & footprint)
 {
   double cos_th = cos(theta);
   double sin_th = sin(theta);
@@ -142,6 +142,31 @@ double FootprintCollisionChecker<CostmapT>::footprintCostAtPose(
   return footprintCost(oriented_footprint);
 }
 
+template<typename CostmapT>
+size_t FootprintCollisionChecker<CostmapT>::footprintCostsAtPoses(
+  const std::vector<geometry_msgs::msg::Pose2D> & poses, const Footprint & footprint,
+  std::vector<double> & costs)
+{
+  costs.clear();
+  costs.reserve(poses.size());
+  oriented_footprint_.resize(footprint.size());
+  for (size_t i = 0; i < poses.size(); ++i) {
+    const double cos_th = cos(poses[i].theta);
+    const double sin_th = sin(poses[i].theta);
+    for (size_t j = 0; j < footprint.size(); ++j) {
+      oriented_footprint_[j].x = poses[i].x + (footprint[j].x * cos_th - footprint[j].y * sin_th);
+      oriented_footprint_[j].y = poses[i].y + (footprint[j].x * sin_th + footprint[j].y * cos_th);
+    }
+
+    costs.push_back(footprintCost(oriented_footprint_));
+    if (costs.back() == static_cast<double>(LETHAL_OBSTACLE)) {
+      return i;
+    }
+  }
+
+  return poses.size();
+}
+
 // declare our valid template parameters
 template class FootprintCollisionChecker<std::shared_ptr<nav2_costmap_2d::Costmap2D>>;
 template class FootprintCollisionChecker<nav2_costmap_2d::Costmap2D *>;
@@ -37,7 +37,7 @@
 #include "nav2_costmap_2d/observation_buffer.hpp"
 
 #include <algorithm>
-#include <list>
+#include <memory>
 #include <string>
 #include <vector>
 #include <chrono>
@@ -58,12 +58,16 @@ ObservationBuffer::ObservationBuffer(
   double raytrace_max_range, double raytrace_min_range, tf2_ros::Buffer & tf2_buffer,
   std::string global_frame,
   std::string sensor_frame,
-  tf2::Duration tf_tolerance)
+  tf2::Duration tf_tolerance,
+  double voxel_filter_resolution)
 : tf2_buffer_(tf2_buffer),
   observation_keep_time_(rclcpp::Duration::from_seconds(observation_keep_time)),
   expected_update_rate_(rclcpp::Duration::from_seconds(expected_update_rate)),
   global_frame_(global_frame),
   sensor_frame_(sensor_frame),
+  observations_(2),
+  newest_(1),
+  num_observations_(0),
   topic_name_(topic_name),
   min_obstacle_height_(min_obstacle_height), max_obstacle_height_(max_obstacle_height),
   obstacle_max_range_(obstacle_max_range), obstacle_min_range_(obstacle_min_range),
@@ -74,18 +78,28 @@ ObservationBuffer::ObservationBuffer(
   clock_ = node->get_clock();
   logger_ = node->get_logger();
   last_updated_ = node->now();
+  if (voxel_filter_resolution > 0.0) {
+    voxel_filter_ = std::make_unique<ObservationVoxelFilter>(voxel_filter_resolution);
+  }
 }
 
 ObservationBuffer::~ObservationBuffer()
 {
 }
 
-void ObservationBuffer::bufferCloud(const sensor_msgs::msg::PointCloud2 & cloud)
+bool ObservationBuffer::bufferCloud(const sensor_msgs::msg::PointCloud2 & cloud)
 {
   geometry_msgs::msg::PointStamped global_origin;
 
-  // create a new observation on the list to be populated
-  observation_list_.push_front(Observation());
+  // populate the slot after the newest observation, reusing its storage if released
+  if (num_observations_ == observations_.size()) {
+    growStorage();
+  }
+  const size_t next = (newest_ + 1) % observations_.size();
+  std::shared_ptr<Observation> & observation = observations_[next];
+  if (!observation || observation.use_count() > 1) {
+    observation = std::make_shared<Observation>();
+  }
 
   // check whether the origin frame has been set explicitly
   // or whether we should get it from the cloud
@@ -101,14 +115,14 @@ void ObservationBuffer::bufferCloud(const sensor_msgs::msg::PointCloud2 & cloud)
     local_origin.point.y = 0;
     local_origin.point.z = 0;
     tf2_buffer_.transform(local_origin, global_origin, global_frame_, tf_tolerance_);
-    tf2::convert(global_origin.point, observation_list_.front().origin_);
+    tf2::convert(global_origin.point, observation->origin_);
 
     // make sure to pass on the raytrace/obstacle range
     // of the observation buffer to the observations
-    observation_list_.front().raytrace_max_range_ = raytrace_max_range_;
-    observation_list_.front().raytrace_min_range_ = raytrace_min_range_;
-    observation_list_.front().obstacle_max_range_ = obstacle_max_range_;
-    observation_list_.front().obstacle_min_range_ = obstacle_min_range_;
+    observation->raytrace_max_range_ = raytrace_max_range_;
+    observation->raytrace_min_range_ = raytrace_min_range_;
+    observation->obstacle_max_range_ = obstacle_max_range_;
+    observation->obstacle_min_range_ = obstacle_min_range_;
 
     sensor_msgs::msg::PointCloud2 global_frame_cloud;
 
@@ -118,7 +132,7 @@ void ObservationBuffer::bufferCloud(const sensor_msgs::msg::PointCloud2 & cloud)
 
     // now we need to remove observations from the cloud that are below
     // or above our height thresholds
-    sensor_msgs::msg::PointCloud2 & observation_cloud = *(observation_list_.front().cloud_);
+    sensor_msgs::msg::PointCloud2 & observation_cloud = *(observation->cloud_);
     observation_cloud.height = global_frame_cloud.height;
     observation_cloud.width = global_frame_cloud.width;
     observation_cloud.fields = global_frame_cloud.fields;
@@ -151,64 +165,83 @@ void ObservationBuffer::bufferCloud(const sensor_msgs::msg::PointCloud2 & cloud)
 
     // resize the cloud for the number of legal points
     modifier.resize(point_count);
+
+    // and keep one point per voxel if requested
+    if (voxel_filter_) {
+      voxel_filter_->filter(observation->origin_, observation_cloud);
+    }
     observation_cloud.header.stamp = cloud.header.stamp;
     observation_cloud.header.frame_id = global_frame_cloud.header.frame_id;
   } catch (tf2::TransformException & ex) {
-    // if an exception occurs, we need to remove the empty observation from the list
-    observation_list_.pop_front();
+    // if an exception occurs, the slot is left out of the buffer
     RCLCPP_ERROR(
       logger_,
       "TF Exception that should never happen for sensor frame: %s, cloud frame: %s, %s",
       sensor_frame_.c_str(),
       cloud.header.frame_id.c_str(), ex.what());
-    return;
+    return false;
   }
 
-  // if the update was successful, we want to update the last updated time
+  // if the update was successful, the slot becomes the newest observation
+  newest_ = next;
+  ++num_observations_;
+
+  // and we want to update the last updated time
   last_updated_ = clock_->now();
 
   // we'll also remove any stale observations from the list
   purgeStaleObservations();
+  return true;
 }
 
-// returns a copy of the observations
-void ObservationBuffer::getObservations(std::vector<Observation> & observations)
+const Observation * ObservationBuffer::getLatestObservation() const
+{
+  if (num_observations_ == 0) {
+    return nullptr;
+  }
+  return observations_[newest_].get();
+}
+
+// shares the current observations
+void ObservationBuffer::getObservations(
+  std::vector<std::shared_ptr<const Observation>> & observations)
 {
   // first... let's make sure that we don't have any stale observations
   purgeStaleObservations();
 
-  // now we'll just copy the observations for the caller
-  std::list<Observation>::iterator obs_it;
-  for (obs_it = observation_list_.begin(); obs_it != observation_list_.end(); ++obs_it) {
-    observations.push_back(*obs_it);
+  // now we'll just share the observations with the caller
+  for (size_t i = 0; i < num_observations_; ++i) {
+    observations.push_back(observations_[slot(i)]);
   }
 }
 
 void ObservationBuffer::purgeStaleObservations()
 {
-  if (!observation_list_.empty()) {
-    std::list<Observation>::iterator obs_it = observation_list_.begin();
-    // if we're keeping observations for no time... then we'll only keep one observation
-    if (observation_keep_time_ == rclcpp::Duration(0.0s)) {
-      observation_list_.erase(++obs_it, observation_list_.end());
-      return;
-    }
+  // if we're keeping observations for no time... then we'll only keep one observation
+  if (observation_keep_time_ == rclcpp::Duration(0.0s)) {
+    num_observations_ = std::min<size_t>(num_observations_, 1);
+    return;
+  }
 
-    // otherwise... we'll have to loop through the observations to see which ones are stale
-    for (obs_it = observation_list_.begin(); obs_it != observation_list_.end(); ++obs_it) {
-      Observation & obs = *obs_it;
-      // check if the observation is out of date... and if it is,
-      // remove it and those that follow from the list
-      if ((clock_->now() - obs.cloud_->header.stamp) >
-        observation_keep_time_)
-      {
-        observation_list_.erase(obs_it, observation_list_.end());
-        return;
-      }
-    }
+  // otherwise... observations are buffered in time, so the stale ones are the oldest
+  while (num_observations_ > 0 &&
+    (clock_->now() - observations_[slot(num_observations_ - 1)]->cloud_->header.stamp) >
+    observation_keep_time_)
+  {
+    --num_observations_;
   }
 }
 
+void ObservationBuffer::growStorage()
+{
+  std::vector<std::shared_ptr<Observation>> observations(2 * observations_.size());
+  for (size_t i = 0; i < num_observations_; ++i) {
+    observations[num_observations_ - 1 - i] = std::move(observations_[slot(i)]);
+  }
+  observations_.swap(observations);
+  newest_ = (num_observations_ + observations_.size() - 1) % observations_.size();
+}
+
 bool ObservationBuffer::isCurrent() const
 {
   if (expected_update_rate_ == rclcpp::Duration(0.0s)) {
@@ -233,4 +266,12 @@ void ObservationBuffer::resetLastUpdated()
 {
   last_updated_ = clock_->now();
 }
+
+void ObservationBuffer::setVoxelGrid(double origin_x, double origin_y, double resolution)
+{
+  if (voxel_filter_) {
+    voxel_filter_->setGrid(origin_x, origin_y, resolution);
+  }
+}
+
 }  // namespace nav2_costmap_2d
@@ -0,0 +1,256 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "nav2_costmap_2d/observation_staging_grid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "nav2_costmap_2d/cost_values.hpp"
+#include "sensor_msgs/point_cloud2_iterator.hpp"
+
+namespace nav2_costmap_2d
+{
+
+ObservationStagingGrid::ObservationStagingGrid(const bool & marking, const bool & clearing)
+: Costmap2D(0, 0, 0.0, 0.0, 0.0, NO_INFORMATION),
+  marking_(marking), clearing_(clearing),
+  min_obstacle_height_(0.0), max_obstacle_height_(0.0)
+{
+  clearStaged();
+}
+
+void ObservationStagingGrid::matchGeometry(const Costmap2D & costmap)
+{
+  if (size_x_ != costmap.getSizeInCellsX() || size_y_ != costmap.getSizeInCellsY() ||
+    resolution_ != costmap.getResolution())
+  {
+    resizeMap(
+      costmap.getSizeInCellsX(), costmap.getSizeInCellsY(), costmap.getResolution(),
+      costmap.getOriginX(), costmap.getOriginY());
+    clearStaged();
+    return;
+  }
+
+  const double dx = costmap.getOriginX() - origin_x_;
+  const double dy = costmap.getOriginY() - origin_y_;
+  if (dx == 0.0 && dy == 0.0) {
+    return;
+  }
+
+  // Both origins are on the same grid, half a cell away from the target keeps updateOrigin
+  // from truncating the shift to the cell below
+  const int cell_ox = static_cast<int>(std::lround(dx / resolution_));
+  const int cell_oy = static_cast<int>(std::lround(dy / resolution_));
+  updateOrigin(
+    costmap.getOriginX() + std::copysign(0.5 * resolution_, dx),
+    costmap.getOriginY() + std::copysign(0.5 * resolution_, dy));
+  origin_x_ = costmap.getOriginX();
+  origin_y_ = costmap.getOriginY();
+
+  if (!empty()) {
+    min_cell_x_ = std::max(min_cell_x_ - cell_ox, 0);
+    min_cell_y_ = std::max(min_cell_y_ - cell_oy, 0);
+    max_cell_x_ = std::min(max_cell_x_ - cell_ox, static_cast<int>(size_x_) - 1);
+    max_cell_y_ = std::min(max_cell_y_ - cell_oy, static_cast<int>(size_y_) - 1);
+    if (min_cell_x_ > max_cell_x_ || min_cell_y_ > max_cell_y_) {
+      clearStaged();
+    }
+  }
+}
+
+void ObservationStagingGrid::setObstacleHeights(
+  const double & min_obstacle_height, const double & max_obstacle_height)
+{
+  min_obstacle_height_ = min_obstacle_height;
+  max_obstacle_height_ = max_obstacle_height;
+}
+
+bool ObservationStagingGrid::stage(const Observation & observation)
+{
+  // nothing to stage into until the geometry of the costmap is known
+  if (!isSized()) {
+    return false;
+  }
+
+  const sensor_msgs::msg::PointCloud2 & cloud = *(observation.cloud_);
+  const double ox = observation.origin_.x;
+  const double oy = observation.origin_.y;
+  bool raytraced = true;
+
+  // clear space first, as the layer does for the observations of an update
+  unsigned int x0, y0;
+  if (clearing_ && !worldToMap(ox, oy, x0, y0)) {
+    raytraced = false;
+  } else if (clearing_) {
+    const double map_end_x = origin_x_ + size_x_ * resolution_;
+    const double map_end_y = origin_y_ + size_y_ * resolution_;
+    const unsigned int cell_raytrace_max_range = cellDistance(observation.raytrace_max_range_);
+    const unsigned int cell_raytrace_min_range = cellDistance(observation.raytrace_min_range_);
+    MarkCell marker(costmap_, FREE_SPACE);
+    touch(ox, oy);
+    touchCell(x0, y0);
+
+    sensor_msgs::PointCloud2ConstIterator<float> iter_x(cloud, "x");
+    sensor_msgs::PointCloud2ConstIterator<float> iter_y(cloud, "y");
+    for (; iter_x != iter_x.end(); ++iter_x, ++iter_y) {
+      double wx = *iter_x;
+      double wy = *iter_y;
+
+      // scale the ray to the map, as ObstacleLayer::raytraceFreespace
+      const double a = wx - ox;
+      const double b = wy - oy;
+      if (wx < origin_x_) {
+        const double t = (origin_x_ - ox) / a;
+        wx = origin_x_;
+        wy = oy + b * t;
+      }
+      if (wy < origin_y_) {
+        const double t = (origin_y_ - oy) / b;
+        wx = ox + a * t;
+        wy = origin_y_;
+      }
+      if (wx > map_end_x) {
+        const double t = (map_end_x - ox) / a;
+        wx = map_end_x - .001;
+        wy = oy + b * t;
+      }
+      if (wy > map_end_y) {
+        const double t = (map_end_y - oy) / b;
+        wx = ox + a * t;
+        wy = map_end_y - .001;
+      }
+
+      unsigned int x1, y1;
+      if (!worldToMap(wx, wy, x1, y1)) {
+        continue;
+      }
+
+      raytraceLine(marker, x0, y0, x1, y1, cell_raytrace_max_range, cell_raytrace_min_range);
+      touchCell(x1, y1);
+
+      const double full_distance = hypot(wx - ox, wy - oy);
+      if (full_distance >= observation.raytrace_min_range_) {
+        const double scale = std::min(1.0, observation.raytrace_max_range_ / full_distance);
+        touch(ox + (wx - ox) * scale, oy + (wy - oy) * scale);
+      }
+    }
+  }
+
+  if (!marking_) {
+    return raytraced;
+  }
+
+  const double sq_obstacle_max_range =
+    observation.obstacle_max_range_ * observation.obstacle_max_range_;
+  const double sq_obstacle_min_range =
+    observation.obstacle_min_range_ * observation.obstacle_min_range_;
+  sensor_msgs::PointCloud2ConstIterator<float> iter_x(cloud, "x");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_y(cloud, "y");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_z(cloud, "z");
+  for (; iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
+    const double px = *iter_x, py = *iter_y, pz = *iter_z;
+    if (pz < min_obstacle_height_ || pz > max_obstacle_height_) {
+      continue;
+    }
+
+    const double sq_dist =
+      (px - observation.origin_.x) * (px - observation.origin_.x) +
+      (py - observation.origin_.y) * (py - observation.origin_.y) +
+      (pz - observation.origin_.z) * (pz - observation.origin_.z);
+    if (sq_dist >= sq_obstacle_max_range || sq_dist < sq_obstacle_min_range) {
+      continue;
+    }
+
+    unsigned int mx, my;
+    if (!worldToMap(px, py, mx, my)) {
+      continue;
+    }
+
+    costmap_[getIndex(mx, my)] = LETHAL_OBSTACLE;
+    touchCell(mx, my);
+    touch(px, py);
+  }
+
+  return raytraced;
+}
+
+void ObservationStagingGrid::mergeClearing(Costmap2D & costmap) const
+{
+  merge(costmap, FREE_SPACE);
+}
+
+void ObservationStagingGrid::mergeMarking(Costmap2D & costmap) const
+{
+  merge(costmap, LETHAL_OBSTACLE);
+}
+
+void ObservationStagingGrid::merge(Costmap2D & costmap, const unsigned char & value) const
+{
+  if (empty()) {
+    return;
+  }
+
+  unsigned char * master = costmap.getCharMap();
+  for (int j = min_cell_y_; j <= max_cell_y_; j++) {
+    const unsigned int row = j * size_x_;
+    for (int i = min_cell_x_; i <= max_cell_x_; i++) {
+      if (costmap_[row + i] == value) {
+        master[row + i] = value;
+      }
+    }
+  }
+}
+
+void ObservationStagingGrid::expandBounds(
+  double * min_x, double * min_y, double * max_x, double * max_y) const
+{
+  if (min_x_ > max_x_) {
+    return;
+  }
+  *min_x = std::min(min_x_, *min_x);
+  *min_y = std::min(min_y_, *min_y);
+  *max_x = std::max(max_x_, *max_x);
+  *max_y = std::max(max_y_, *max_y);
+}
+
+void ObservationStagingGrid::clearStaged()
+{
+  if (!empty() && costmap_) {
+    resetMap(min_cell_x_, min_cell_y_, max_cell_x_ + 1, max_cell_y_ + 1);
+  }
+  min_cell_x_ = min_cell_y_ = std::numeric_limits<int>::max();
+  max_cell_x_ = max_cell_y_ = std::numeric_limits<int>::min();
+  min_x_ = min_y_ = std::numeric_limits<double>::max();
+  max_x_ = max_y_ = std::numeric_limits<double>::lowest();
+}
+
+void ObservationStagingGrid::touch(const double & wx, const double & wy)
+{
+  min_x_ = std::min(wx, min_x_);
+  min_y_ = std::min(wy, min_y_);
+  max_x_ = std::max(wx, max_x_);
+  max_y_ = std::max(wy, max_y_);
+}
+
+void ObservationStagingGrid::touchCell(const unsigned int & mx, const unsigned int & my)
+{
+  min_cell_x_ = std::min(static_cast<int>(mx), min_cell_x_);
+  min_cell_y_ = std::min(static_cast<int>(my), min_cell_y_);
+  max_cell_x_ = std::max(static_cast<int>(mx), max_cell_x_);
+  max_cell_y_ = std::max(static_cast<int>(my), max_cell_y_);
+}
+
+}  // namespace nav2_costmap_2d
@@ -0,0 +1,115 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "nav2_costmap_2d/observation_voxel_filter.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "sensor_msgs/point_cloud2_iterator.hpp"
+
+namespace nav2_costmap_2d
+{
+
+ObservationVoxelFilter::ObservationVoxelFilter(const double & resolution)
+: resolution_(resolution)
+{
+}
+
+void ObservationVoxelFilter::setGrid(
+  const double & origin_x, const double & origin_y, const double & cell_size)
+{
+  origin_x_ = origin_x;
+  origin_y_ = origin_y;
+  if (cell_size <= 0.0 || resolution_ <= 0.0) {
+    cell_resolution_ = 0.0;
+    return;
+  }
+
+  // the largest fraction of a cell no bigger than the requested voxels
+  cell_resolution_ = cell_size / std::ceil(cell_size / resolution_ - 1e-6);
+}
+
+void ObservationVoxelFilter::filter(
+  const geometry_msgs::msg::Point & origin, sensor_msgs::msg::PointCloud2 & cloud)
+{
+  const uint32_t num_points = cloud.width * cloud.height;
+  if (num_points == 0 || resolution_ <= 0.0 || cell_resolution_ <= 0.0) {
+    return;
+  }
+
+  voxels_.clear();
+  voxels_.reserve(num_points);
+  sq_distances_.resize(num_points);
+  const double inv_cell_resolution = 1.0 / cell_resolution_;
+  const double inv_resolution = 1.0 / resolution_;
+  const uint32_t point_step = cloud.point_step;
+  unsigned char * data = cloud.data.data();
+
+  sensor_msgs::PointCloud2ConstIterator<float> iter_x(cloud, "x");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_y(cloud, "y");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_z(cloud, "z");
+  // 21 bits per axis, enough for a million voxels around the origin
+  const auto voxel = [](const double & value, const double & inv_size) {
+      return static_cast<uint64_t>(
+        static_cast<int64_t>(std::floor(value * inv_size)) & 0x1FFFFF);
+    };
+  constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+
+  uint32_t num_kept = 0;
+  for (uint32_t i = 0; i != num_points; ++i, ++iter_x, ++iter_y, ++iter_z) {
+    const uint64_t key = (voxel(*iter_x - origin_x_, inv_cell_resolution) << 42) |
+      (voxel(*iter_y - origin_y_, inv_cell_resolution) << 21) |
+      voxel(*iter_z, inv_resolution);
+
+    const float dx = *iter_x - origin.x;
+    const float dy = *iter_y - origin.y;
+    const float dz = *iter_z - origin.z;
+    const float sq_dist = dx * dx + dy * dy + dz * dz;
+
+    auto result = voxels_.emplace(key, Extremes{num_kept, none});
+    Extremes & extremes = result.first->second;
+    uint32_t slot;
+    if (result.second) {
+      slot = num_kept++;
+    } else if (extremes.farthest == none) {
+      // the second point of the voxel gets its own slot
+      slot = num_kept++;
+      if (sq_dist < sq_distances_[extremes.nearest]) {
+        extremes.farthest = extremes.nearest;
+        extremes.nearest = slot;
+      } else {
+        extremes.farthest = slot;
+      }
+    } else if (sq_dist < sq_distances_[extremes.nearest]) {
+      slot = extremes.nearest;
+    } else if (sq_dist > sq_distances_[extremes.farthest]) {
+      slot = extremes.farthest;
+    } else {
+      continue;
+    }
+
+    // slots are never after the point, so the cloud is compacted in place
+    sq_distances_[slot] = sq_dist;
+    if (slot != i) {
+      std::memcpy(data + slot * point_step, data + i * point_step, point_step);
+    }
+  }
+
+  sensor_msgs::PointCloud2Modifier modifier(cloud);
+  modifier.resize(num_kept);
+}
+
+}  // namespace nav2_costmap_2d
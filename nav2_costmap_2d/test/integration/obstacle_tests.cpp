@@ -625,3 +625,90 @@ TEST_F(TestNodeWithoutUnknownOverwrite, testMaxWithoutUnknownOverwriteCombinatio
 
   ASSERT_EQ(unknown_count, 100);
 }
+
+class ObstacleLayerShim : public nav2_costmap_2d::ObstacleLayer
+{
+public:
+  void bufferCloud(const sensor_msgs::msg::PointCloud2 & cloud)
+  {
+    bufferObservation(cloud, observation_buffers_.front());
+  }
+};
+
+class TestNodeWithAsyncProcessing : public ::testing::Test
+{
+public:
+  TestNodeWithAsyncProcessing()
+  {
+    node_ = std::make_shared<TestLifecycleNode>("obstacle_async_test_node");
+    node_->declare_parameter("track_unknown_space", rclcpp::ParameterValue(true));
+    node_->declare_parameter("lethal_cost_threshold", rclcpp::ParameterValue(100));
+    node_->declare_parameter("trinary_costmap", rclcpp::ParameterValue(true));
+    node_->declare_parameter("transform_tolerance", rclcpp::ParameterValue(0.3));
+    node_->declare_parameter(
+      "obstacles.async_observation_processing", rclcpp::ParameterValue(true));
+    node_->declare_parameter(
+      "obstacles.observation_sources", rclcpp::ParameterValue(std::string("cloud")));
+    node_->declare_parameter(
+      "obstacles.cloud.data_type", rclcpp::ParameterValue(std::string("PointCloud2")));
+    node_->declare_parameter("obstacles.cloud.max_obstacle_height", rclcpp::ParameterValue(MAX_Z));
+    node_->declare_parameter("obstacles.cloud.obstacle_max_range", rclcpp::ParameterValue(100.0));
+    node_->declare_parameter(
+      "obstacles.cloud.observation_persistence", rclcpp::ParameterValue(100.0));
+  }
+
+  ~TestNodeWithAsyncProcessing() {}
+
+  sensor_msgs::msg::PointCloud2 makeCloud(double x, double y)
+  {
+    sensor_msgs::msg::PointCloud2 cloud;
+    cloud.header.frame_id = "base_link";
+    cloud.header.stamp = node_->now();
+    sensor_msgs::PointCloud2Modifier modifier(cloud);
+    modifier.setPointCloud2FieldsByString(1, "xyz");
+    modifier.resize(1);
+    sensor_msgs::PointCloud2Iterator<float> iter_x(cloud, "x");
+    sensor_msgs::PointCloud2Iterator<float> iter_y(cloud, "y");
+    sensor_msgs::PointCloud2Iterator<float> iter_z(cloud, "z");
+    *iter_x = x;
+    *iter_y = y;
+    *iter_z = MAX_Z / 2;
+    return cloud;
+  }
+
+protected:
+  std::shared_ptr<TestLifecycleNode> node_;
+};
+
+/**
+ * Test that the observations staged on arrival are merged, including the ones received
+ * before the first update sized the staging grids.
+ */
+TEST_F(TestNodeWithAsyncProcessing, testObservationsBeforeFirstUpdate) {
+  tf2_ros::Buffer tf(node_->get_clock());
+  geometry_msgs::msg::TransformStamped transform;
+  transform.header.stamp = node_->now();
+  transform.header.frame_id = "frame";
+  transform.child_frame_id = "base_link";
+  tf.setTransform(transform, "default_authority", true);
+
+  nav2_costmap_2d::LayeredCostmap layers("frame", false, true);
+  layers.resizeMap(10, 10, 1, 0, 0);
+
+  auto olayer = std::make_shared<ObstacleLayerShim>();
+  olayer->initialize(&layers, "obstacles", &tf, node_, nullptr);
+  layers.addPlugin(std::shared_ptr<nav2_costmap_2d::Layer>(olayer));
+
+  // received before the first update
+  olayer->bufferCloud(makeCloud(5.5, 5.5));
+  layers.updateMap(0, 0, 0);
+  nav2_costmap_2d::Costmap2D * costmap = layers.getCostmap();
+  ASSERT_EQ(costmap->getCost(5, 5), nav2_costmap_2d::LETHAL_OBSTACLE);
+  ASSERT_EQ(countValues(*costmap, nav2_costmap_2d::LETHAL_OBSTACLE), 1u);
+
+  // received once the grids are sized, only the new one is staged
+  olayer->bufferCloud(makeCloud(2.5, 7.5));
+  layers.updateMap(0, 0, 0);
+  ASSERT_EQ(costmap->getCost(2, 7), nav2_costmap_2d::LETHAL_OBSTACLE);
+  ASSERT_EQ(countValues(*costmap, nav2_costmap_2d::LETHAL_OBSTACLE), 2u);
+}
@@ -0,0 +1,130 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "nav2_costmap_2d/costmap_2d.hpp"
+#include "nav2_costmap_2d/cost_values.hpp"
+
+using nav2_costmap_2d::Costmap2D;
+using nav2_costmap_2d::MapLocation;
+
+std::vector<geometry_msgs::msg::Point> makePolygon(const std::vector<std::vector<double>> & points)
+{
+  std::vector<geometry_msgs::msg::Point> polygon;
+  for (const auto & point : points) {
+    geometry_msgs::msg::Point p;
+    p.x = point[0];
+    p.y = point[1];
+    polygon.push_back(p);
+  }
+  return polygon;
+}
+
+unsigned int countCells(const Costmap2D & costmap, unsigned char value)
+{
+  unsigned int count = 0;
+  for (unsigned int j = 0; j < costmap.getSizeInCellsY(); j++) {
+    for (unsigned int i = 0; i < costmap.getSizeInCellsX(); i++) {
+      count += costmap.getCost(i, j) == value;
+    }
+  }
+  return count;
+}
+
+TEST(ConvexFill, rectangle)
+{
+  Costmap2D costmap(10, 10, 1.0, 0.0, 0.0, nav2_costmap_2d::NO_INFORMATION);
+  ASSERT_TRUE(
+    costmap.setConvexPolygonCost(
+      makePolygon({{2.5, 2.5}, {5.5, 2.5}, {5.5, 4.5}, {2.5, 4.5}}),
+      nav2_costmap_2d::FREE_SPACE));
+
+  EXPECT_EQ(countCells(costmap, nav2_costmap_2d::FREE_SPACE), 12u);
+  for (unsigned int j = 2; j <= 4; j++) {
+    for (unsigned int i = 2; i <= 5; i++) {
+      EXPECT_EQ(costmap.getCost(i, j), nav2_costmap_2d::FREE_SPACE);
+    }
+  }
+}
+
+TEST(ConvexFill, triangle)
+{
+  Costmap2D costmap(10, 10, 1.0, 0.0, 0.0, nav2_costmap_2d::NO_INFORMATION);
+  ASSERT_TRUE(
+    costmap.setConvexPolygonCost(
+      makePolygon({{0.5, 0.5}, {6.5, 0.5}, {0.5, 6.5}}), nav2_costmap_2d::LETHAL_OBSTACLE));
+
+  // the hypotenuse is a diagonal of cells
+  for (unsigned int j = 0; j < 10; j++) {
+    for (unsigned int i = 0; i < 10; i++) {
+      EXPECT_EQ(
+        costmap.getCost(i, j),
+        i + j <= 6 ? nav2_costmap_2d::LETHAL_OBSTACLE : nav2_costmap_2d::NO_INFORMATION);
+    }
+  }
+
+  // and the same cells are listed, once each
+  std::vector<MapLocation> polygon = {{0, 0}, {6, 0}, {0, 6}}, cells;
+  costmap.convexFillCells(polygon, cells);
+  EXPECT_EQ(cells.size(), 28u);
+  for (const auto & cell : cells) {
+    EXPECT_EQ(costmap.getCost(cell.x, cell.y), nav2_costmap_2d::LETHAL_OBSTACLE);
+  }
+}
+
+TEST(ConvexFill, invalidPolygons)
+{
+  Costmap2D costmap(10, 10, 1.0, 0.0, 0.0, nav2_costmap_2d::NO_INFORMATION);
+
+  // off the map
+  EXPECT_FALSE(
+    costmap.setConvexPolygonCost(
+      makePolygon({{2.5, 2.5}, {12.5, 2.5}, {2.5, 4.5}}), nav2_costmap_2d::FREE_SPACE));
+  // less than a triangle
+  EXPECT_TRUE(
+    costmap.setConvexPolygonCost(
+      makePolygon({{2.5, 2.5}, {5.5, 2.5}}), nav2_costmap_2d::FREE_SPACE));
+  EXPECT_EQ(countCells(costmap, nav2_costmap_2d::FREE_SPACE), 0u);
+}
+
+TEST(ConvexFill, concurrentCallers)
+{
+  Costmap2D costmap(100, 100, 1.0, 0.0, 0.0, nav2_costmap_2d::NO_INFORMATION);
+
+  // polygons of different heights, filled from several threads of the same costmap
+  auto fill = [&costmap](unsigned int size, unsigned int * failures) {
+      std::vector<MapLocation> polygon = {{0, 0}, {size, 0}, {size, size}, {0, size}}, cells;
+      for (unsigned int i = 0; i < 1000; i++) {
+        cells.clear();
+        costmap.convexFillCells(polygon, cells);
+        *failures += cells.size() != (size + 1) * (size + 1);
+      }
+    };
+
+  unsigned int failures[4] = {0, 0, 0, 0};
+  std::vector<std::thread> threads;
+  for (unsigned int i = 0; i < 4; i++) {
+    threads.emplace_back(fill, 10 + 20 * i, &failures[i]);
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  for (unsigned int i = 0; i < 4; i++) {
+    EXPECT_EQ(failures[i], 0u);
+  }
+}
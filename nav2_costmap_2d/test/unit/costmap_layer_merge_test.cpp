@@ -0,0 +1,164 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "nav2_costmap_2d/costmap_layer.hpp"
+#include "nav2_costmap_2d/cost_values.hpp"
+
+using nav2_costmap_2d::Costmap2D;
+using nav2_costmap_2d::NO_INFORMATION;
+using nav2_costmap_2d::INSCRIBED_INFLATED_OBSTACLE;
+
+class RclCppFixture
+{
+public:
+  RclCppFixture() {rclcpp::init(0, nullptr);}
+  ~RclCppFixture() {rclcpp::shutdown();}
+};
+RclCppFixture g_rclcppfixture;
+
+class MergeLayer : public nav2_costmap_2d::CostmapLayer
+{
+public:
+  MergeLayer(unsigned int size_x, unsigned int size_y)
+  {
+    enabled_ = true;
+    resizeMap(size_x, size_y, 1.0, 0.0, 0.0);
+  }
+
+  void reset() {}
+  void updateBounds(double, double, double, double *, double *, double *, double *) {}
+  void updateCosts(Costmap2D &, int, int, int, int) {}
+  bool isClearable() {return false;}
+
+  using CostmapLayer::updateWithTrueOverwrite;
+  using CostmapLayer::updateWithOverwrite;
+  using CostmapLayer::updateWithMax;
+  using CostmapLayer::updateWithMaxWithoutUnknownOverwrite;
+  using CostmapLayer::updateWithAddition;
+};
+
+// the per cell merges the kernels must match, bit for bit
+unsigned char trueOverwrite(unsigned char, unsigned char cost)
+{
+  return cost;
+}
+
+unsigned char overwrite(unsigned char old_cost, unsigned char cost)
+{
+  return cost != NO_INFORMATION ? cost : old_cost;
+}
+
+unsigned char max(unsigned char old_cost, unsigned char cost)
+{
+  if (cost == NO_INFORMATION) {
+    return old_cost;
+  }
+  return old_cost == NO_INFORMATION || old_cost < cost ? cost : old_cost;
+}
+
+unsigned char maxWithoutUnknownOverwrite(unsigned char old_cost, unsigned char cost)
+{
+  if (cost == NO_INFORMATION) {
+    return old_cost;
+  }
+  return old_cost != NO_INFORMATION && old_cost < cost ? cost : old_cost;
+}
+
+unsigned char addition(unsigned char old_cost, unsigned char cost)
+{
+  if (cost == NO_INFORMATION) {
+    return old_cost;
+  }
+  if (old_cost == NO_INFORMATION) {
+    return cost;
+  }
+  int sum = old_cost + cost;
+  return sum >= INSCRIBED_INFLATED_OBSTACLE ? INSCRIBED_INFLATED_OBSTACLE - 1 : sum;
+}
+
+using Merge = std::function<void (MergeLayer &, Costmap2D &, int, int, int, int)>;
+using Reference = std::function<unsigned char(unsigned char, unsigned char)>;
+
+void checkMerge(const Merge & merge, const Reference & reference)
+{
+  const unsigned int size_x = 67, size_y = 23;
+  std::mt19937 gen(42);
+  // biased towards the special costs
+  std::uniform_int_distribution<int> value(0, 300);
+  const auto cost = [&]() {
+      const int v = value(gen);
+      return static_cast<unsigned char>(v > 255 ? 250 + (v % 6) : v);
+    };
+
+  for (unsigned int trial = 0; trial < 25; trial++) {
+    MergeLayer layer(size_x, size_y);
+    Costmap2D master(size_x, size_y, 1.0, 0.0, 0.0, NO_INFORMATION);
+    unsigned char * layer_array = layer.getCharMap();
+    unsigned char * master_array = master.getCharMap();
+    for (unsigned int i = 0; i < size_x * size_y; i++) {
+      layer_array[i] = cost();
+      master_array[i] = cost();
+    }
+    const std::vector<unsigned char> before(master_array, master_array + size_x * size_y);
+
+    // windows of any width, including unaligned and empty ones
+    const int min_i = trial, min_j = trial % 5;
+    const int max_i = size_x - 2 * trial, max_j = size_y - trial % 3;
+    merge(layer, master, min_i, min_j, max_i, max_j);
+
+    for (unsigned int j = 0; j < size_y; j++) {
+      for (unsigned int i = 0; i < size_x; i++) {
+        const unsigned int index = j * size_x + i;
+        const bool inside = static_cast<int>(i) >= min_i && static_cast<int>(i) < max_i &&
+          static_cast<int>(j) >= min_j && static_cast<int>(j) < max_j;
+        const unsigned char expected =
+          inside ? reference(before[index], layer_array[index]) : before[index];
+        ASSERT_EQ(master_array[index], expected) << "cell " << i << ", " << j;
+      }
+    }
+  }
+}
+
+TEST(CostmapLayerMerge, trueOverwrite)
+{
+  checkMerge(std::mem_fn(&MergeLayer::updateWithTrueOverwrite), trueOverwrite);
+}
+
+TEST(CostmapLayerMerge, overwrite)
+{
+  checkMerge(std::mem_fn(&MergeLayer::updateWithOverwrite), overwrite);
+}
+
+TEST(CostmapLayerMerge, max)
+{
+  checkMerge(std::mem_fn(&MergeLayer::updateWithMax), max);
+}
+
+TEST(CostmapLayerMerge, maxWithoutUnknownOverwrite)
+{
+  checkMerge(
+    std::mem_fn(&MergeLayer::updateWithMaxWithoutUnknownOverwrite), maxWithoutUnknownOverwrite);
+}
+
+TEST(CostmapLayerMerge, addition)
+{
+  checkMerge(std::mem_fn(&MergeLayer::updateWithAddition), addition);
+}
@@ -158,6 +158,64 @@ TEST(collision_footprint, test_point_and_line_cost)
   EXPECT_NEAR(right_value, 254.0, 0.001);
 }
 
+TEST(collision_footprint, test_footprint_costs_at_poses)
+{
+  std::shared_ptr<nav2_costmap_2d::Costmap2D> costmap_ =
+    std::make_shared<nav2_costmap_2d::Costmap2D>(100, 100, 0.10000, 0, 0.0, 0.0);
+
+  // A wall of cost 100 on column 35 and a lethal one on column 70
+  for (unsigned int j = 0; j != 100; ++j) {
+    costmap_->setCost(35, j, 100);
+    costmap_->setCost(70, j, 254);
+  }
+
+  geometry_msgs::msg::Point p1;
+  p1.x = -1.0;
+  p1.y = 1.0;
+  geometry_msgs::msg::Point p2;
+  p2.x = 1.0;
+  p2.y = 1.0;
+  geometry_msgs::msg::Point p3;
+  p3.x = 1.0;
+  p3.y = -1.0;
+  geometry_msgs::msg::Point p4;
+  p4.x = -1.0;
+  p4.y = -1.0;
+
+  nav2_costmap_2d::Footprint footprint = {p1, p2, p3, p4};
+
+  nav2_costmap_2d::FootprintCollisionChecker<std::shared_ptr<nav2_costmap_2d::Costmap2D>>
+  collision_checker(costmap_);
+
+  // Moving right between the walls, rotated on the way: the footprint crosses
+  // the first wall at the first two poses and the second one at the fifth
+  std::vector<geometry_msgs::msg::Pose2D> poses(6);
+  for (unsigned int i = 0; i != poses.size(); ++i) {
+    poses[i].x = 4.05 + 0.5 * i;
+    poses[i].y = 5.05;
+    poses[i].theta = 0.1 * i;
+  }
+
+  std::vector<double> costs;
+  EXPECT_EQ(collision_checker.footprintCostsAtPoses(poses, footprint, costs), 4u);
+  ASSERT_EQ(costs.size(), 5u);
+  for (unsigned int i = 0; i != costs.size(); ++i) {
+    EXPECT_NEAR(
+      costs[i],
+      collision_checker.footprintCostAtPose(poses[i].x, poses[i].y, poses[i].theta, footprint),
+      0.001);
+  }
+  EXPECT_NEAR(costs[0], 100.0, 0.001);
+  EXPECT_NEAR(costs[1], 100.0, 0.001);
+  EXPECT_NEAR(costs[2], 0.0, 0.001);
+  EXPECT_NEAR(costs[4], 254.0, 0.001);
+
+  // No collision checks all the poses
+  poses.resize(3);
+  EXPECT_EQ(collision_checker.footprintCostsAtPoses(poses, footprint, costs), 3u);
+  EXPECT_EQ(costs.size(), 3u);
+}
+
 TEST(collision_footprint, not_enough_points)
 {
   geometry_msgs::msg::Point p1;
@@ -0,0 +1,141 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "tf2_ros/buffer.h"
+#include "sensor_msgs/point_cloud2_iterator.hpp"
+#include "nav2_util/lifecycle_node.hpp"
+#include "nav2_costmap_2d/observation_buffer.hpp"
+
+using nav2_costmap_2d::Observation;
+using nav2_costmap_2d::ObservationBuffer;
+
+class RclCppFixture
+{
+public:
+  RclCppFixture() {rclcpp::init(0, nullptr);}
+  ~RclCppFixture() {rclcpp::shutdown();}
+};
+RclCppFixture g_rclcppfixture;
+
+class ObservationBufferTest : public ::testing::Test
+{
+public:
+  ObservationBufferTest()
+  {
+    node_ = std::make_shared<nav2_util::LifecycleNode>("observation_buffer_test");
+    tf_ = std::make_shared<tf2_ros::Buffer>(node_->get_clock());
+
+    geometry_msgs::msg::TransformStamped transform;
+    transform.header.frame_id = "map";
+    transform.child_frame_id = "base_link";
+    transform.transform.rotation.w = 1.0;
+    tf_->setTransform(transform, "observation_buffer_test", true);
+  }
+
+  std::shared_ptr<ObservationBuffer> makeBuffer(double observation_keep_time)
+  {
+    return std::make_shared<ObservationBuffer>(
+      node_, "cloud", observation_keep_time, 0.0, 0.0, 2.0, 2.5, 0.0, 3.0, 0.0,
+      *tf_, "map", "", tf2::durationFromSec(0.0));
+  }
+
+  // a cloud of size points at x, stamped age seconds ago
+  sensor_msgs::msg::PointCloud2 makeCloud(unsigned int size, float x, double age = 0.0)
+  {
+    sensor_msgs::msg::PointCloud2 cloud;
+    cloud.header.frame_id = "base_link";
+    cloud.header.stamp = node_->now() - rclcpp::Duration::from_seconds(age);
+    sensor_msgs::PointCloud2Modifier modifier(cloud);
+    modifier.setPointCloud2FieldsByString(1, "xyz");
+    modifier.resize(size);
+    sensor_msgs::PointCloud2Iterator<float> iter_x(cloud, "x");
+    sensor_msgs::PointCloud2Iterator<float> iter_z(cloud, "z");
+    for (; iter_x != iter_x.end(); ++iter_x, ++iter_z) {
+      *iter_x = x;
+      *iter_z = 1.0f;
+    }
+    return cloud;
+  }
+
+  static float firstX(const Observation & observation)
+  {
+    return *sensor_msgs::PointCloud2ConstIterator<float>(*observation.cloud_, "x");
+  }
+
+protected:
+  nav2_util::LifecycleNode::SharedPtr node_;
+  std::shared_ptr<tf2_ros::Buffer> tf_;
+};
+
+TEST_F(ObservationBufferTest, keepsLatest)
+{
+  auto buffer = makeBuffer(0.0);
+  std::vector<std::shared_ptr<const Observation>> observations;
+  buffer->getObservations(observations);
+  EXPECT_TRUE(observations.empty());
+  EXPECT_EQ(buffer->getLatestObservation(), nullptr);
+
+  for (unsigned int i = 1; i <= 3; i++) {
+    ASSERT_TRUE(buffer->bufferCloud(makeCloud(i, static_cast<float>(i))));
+  }
+  buffer->getObservations(observations);
+  ASSERT_EQ(observations.size(), 1u);
+  EXPECT_EQ(observations[0]->cloud_->width, 3u);
+  EXPECT_EQ(observations[0].get(), buffer->getLatestObservation());
+
+  // an observation still shared is not overwritten by the next ones
+  for (unsigned int i = 4; i <= 6; i++) {
+    ASSERT_TRUE(buffer->bufferCloud(makeCloud(i, static_cast<float>(i))));
+  }
+  EXPECT_EQ(observations[0]->cloud_->width, 3u);
+  EXPECT_FLOAT_EQ(firstX(*observations[0]), 3.0f);
+
+  observations.clear();
+  buffer->getObservations(observations);
+  ASSERT_EQ(observations.size(), 1u);
+  EXPECT_EQ(observations[0]->cloud_->width, 6u);
+  EXPECT_FLOAT_EQ(firstX(*observations[0]), 6.0f);
+
+  // clouds that cannot be transformed are dropped
+  auto cloud = makeCloud(7, 7.0f);
+  cloud.header.frame_id = "unknown";
+  EXPECT_FALSE(buffer->bufferCloud(cloud));
+  EXPECT_FLOAT_EQ(firstX(*buffer->getLatestObservation()), 6.0f);
+}
+
+TEST_F(ObservationBufferTest, expiresOldest)
+{
+  auto buffer = makeBuffer(1.0);
+
+  // stale observations are dropped as soon as newer ones are buffered
+  for (unsigned int i = 0; i < 5; i++) {
+    ASSERT_TRUE(buffer->bufferCloud(makeCloud(1, static_cast<float>(i), 2.0)));
+  }
+  for (unsigned int i = 0; i < 20; i++) {
+    ASSERT_TRUE(buffer->bufferCloud(makeCloud(1, static_cast<float>(10 + i))));
+  }
+
+  std::vector<std::shared_ptr<const Observation>> observations;
+  buffer->getObservations(observations);
+  ASSERT_EQ(observations.size(), 20u);
+  for (unsigned int i = 0; i < 20; i++) {
+    EXPECT_FLOAT_EQ(firstX(*observations[i]), static_cast<float>(29 - i));
+  }
+}
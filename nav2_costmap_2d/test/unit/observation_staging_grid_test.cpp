@@ -0,0 +1,141 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sensor_msgs/point_cloud2_iterator.hpp"
+#include "nav2_costmap_2d/cost_values.hpp"
+#include "nav2_costmap_2d/observation_staging_grid.hpp"
+
+using nav2_costmap_2d::Costmap2D;
+using nav2_costmap_2d::Observation;
+using nav2_costmap_2d::ObservationStagingGrid;
+
+Observation makeObservation(double ox, double oy, const std::vector<std::array<float, 3>> & points)
+{
+  sensor_msgs::msg::PointCloud2 cloud;
+  sensor_msgs::PointCloud2Modifier modifier(cloud);
+  modifier.setPointCloud2FieldsByString(1, "xyz");
+  modifier.resize(points.size());
+  sensor_msgs::PointCloud2Iterator<float> iter_x(cloud, "x");
+  sensor_msgs::PointCloud2Iterator<float> iter_y(cloud, "y");
+  sensor_msgs::PointCloud2Iterator<float> iter_z(cloud, "z");
+  for (const auto & point : points) {
+    *iter_x = point[0];
+    *iter_y = point[1];
+    *iter_z = point[2];
+    ++iter_x, ++iter_y, ++iter_z;
+  }
+
+  geometry_msgs::msg::Point origin;
+  origin.x = ox;
+  origin.y = oy;
+  return Observation(origin, cloud, 10.0, 0.0, 10.0, 0.0);
+}
+
+TEST(ObservationStagingGrid, marksWinOverClearing)
+{
+  Costmap2D costmap(10, 10, 1.0, 0.0, 0.0, nav2_costmap_2d::NO_INFORMATION);
+  ObservationStagingGrid clearing_grid(true, true), marking_grid(true, false);
+  for (auto grid : {&clearing_grid, &marking_grid}) {
+    grid->matchGeometry(costmap);
+    grid->setObstacleHeights(0.0, 2.0);
+    EXPECT_TRUE(grid->empty());
+  }
+
+  // nothing staged before the geometry is known, the caller keeps it to stage it later
+  ObservationStagingGrid unsized_grid(true, true);
+  EXPECT_FALSE(unsized_grid.isSized());
+  EXPECT_FALSE(unsized_grid.stage(makeObservation(0.5, 5.5, {{6.5f, 5.5f, 0.5f}})));
+  EXPECT_TRUE(unsized_grid.empty());
+
+  EXPECT_TRUE(clearing_grid.stage(makeObservation(0.5, 5.5, {{6.5f, 5.5f, 0.5f}})));
+  EXPECT_TRUE(marking_grid.stage(makeObservation(0.5, 5.5, {{3.5f, 5.5f, 0.5f}})));
+  // too high to be marked
+  EXPECT_TRUE(marking_grid.stage(makeObservation(0.5, 5.5, {{1.5f, 2.5f, 3.0f}})));
+  EXPECT_FALSE(clearing_grid.empty());
+  EXPECT_FALSE(clearing_grid.stage(makeObservation(-1.0, 5.5, {{6.5f, 5.5f, 0.5f}})));
+
+  for (auto grid : {&clearing_grid, &marking_grid}) {
+    grid->mergeClearing(costmap);
+  }
+  double min_x = std::numeric_limits<double>::max(), min_y = min_x;
+  double max_x = std::numeric_limits<double>::lowest(), max_y = max_x;
+  for (auto grid : {&clearing_grid, &marking_grid}) {
+    grid->mergeMarking(costmap);
+    grid->expandBounds(&min_x, &min_y, &max_x, &max_y);
+    grid->clearStaged();
+    EXPECT_TRUE(grid->empty());
+  }
+
+  for (unsigned int i = 0; i < 6; i++) {
+    EXPECT_EQ(
+      costmap.getCost(i, 5),
+      i == 3 ? nav2_costmap_2d::LETHAL_OBSTACLE : nav2_costmap_2d::FREE_SPACE);
+  }
+  EXPECT_EQ(costmap.getCost(6, 5), nav2_costmap_2d::LETHAL_OBSTACLE);
+  EXPECT_EQ(costmap.getCost(7, 5), nav2_costmap_2d::NO_INFORMATION);
+  EXPECT_EQ(costmap.getCost(1, 2), nav2_costmap_2d::NO_INFORMATION);
+  EXPECT_DOUBLE_EQ(min_x, 0.5);
+  EXPECT_DOUBLE_EQ(max_x, 6.5);
+  EXPECT_DOUBLE_EQ(min_y, 5.5);
+  EXPECT_DOUBLE_EQ(max_y, 5.5);
+
+  // once cleared, nothing is merged again
+  Costmap2D untouched(10, 10, 1.0, 0.0, 0.0, nav2_costmap_2d::NO_INFORMATION);
+  clearing_grid.mergeClearing(untouched);
+  clearing_grid.mergeMarking(untouched);
+  for (unsigned int i = 0; i < 10; i++) {
+    EXPECT_EQ(untouched.getCost(i, 5), nav2_costmap_2d::NO_INFORMATION);
+  }
+}
+
+TEST(ObservationStagingGrid, followsCostmapOrigin)
+{
+  Costmap2D costmap(10, 10, 0.5, 0.0, 0.0, nav2_costmap_2d::NO_INFORMATION);
+  ObservationStagingGrid grid(true, false);
+  grid.matchGeometry(costmap);
+  grid.setObstacleHeights(0.0, 2.0);
+  EXPECT_TRUE(
+    grid.stage(makeObservation(0.25, 0.25, {{3.25f, 2.75f, 0.5f}, {0.25f, 4.75f, 0.5f}})));
+
+  // the rolling costmap moved on update, the first mark moves from (6, 5) to (4, 5) and the
+  // second one is now off the window
+  costmap.updateOrigin(1.0, 0.0);
+  grid.matchGeometry(costmap);
+  EXPECT_DOUBLE_EQ(grid.getOriginX(), 1.0);
+  grid.mergeMarking(costmap);
+  for (unsigned int j = 0; j < 10; j++) {
+    for (unsigned int i = 0; i < 10; i++) {
+      EXPECT_EQ(
+        costmap.getCost(i, j),
+        i == 4 && j == 5 ? nav2_costmap_2d::LETHAL_OBSTACLE : nav2_costmap_2d::NO_INFORMATION);
+    }
+  }
+
+  // and back the other way
+  Costmap2D shifted(10, 10, 0.5, -1.0, -0.5, nav2_costmap_2d::NO_INFORMATION);
+  grid.matchGeometry(shifted);
+  grid.mergeMarking(shifted);
+  EXPECT_EQ(shifted.getCost(8, 6), nav2_costmap_2d::LETHAL_OBSTACLE);
+
+  // a new size drops what was staged
+  Costmap2D resized(20, 20, 0.5, -1.0, -0.5, nav2_costmap_2d::NO_INFORMATION);
+  grid.matchGeometry(resized);
+  EXPECT_TRUE(grid.empty());
+  EXPECT_EQ(grid.getSizeInCellsX(), 20u);
+}
@@ -0,0 +1,150 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sensor_msgs/point_cloud2_iterator.hpp"
+#include "nav2_costmap_2d/observation_voxel_filter.hpp"
+
+using nav2_costmap_2d::ObservationVoxelFilter;
+
+sensor_msgs::msg::PointCloud2 makeCloud(const std::vector<std::array<float, 3>> & points)
+{
+  sensor_msgs::msg::PointCloud2 cloud;
+  sensor_msgs::PointCloud2Modifier modifier(cloud);
+  modifier.setPointCloud2FieldsByString(1, "xyz");
+  modifier.resize(points.size());
+  sensor_msgs::PointCloud2Iterator<float> iter_x(cloud, "x");
+  sensor_msgs::PointCloud2Iterator<float> iter_y(cloud, "y");
+  sensor_msgs::PointCloud2Iterator<float> iter_z(cloud, "z");
+  for (const auto & point : points) {
+    *iter_x = point[0];
+    *iter_y = point[1];
+    *iter_z = point[2];
+    ++iter_x, ++iter_y, ++iter_z;
+  }
+  return cloud;
+}
+
+std::vector<std::array<float, 3>> getPoints(const sensor_msgs::msg::PointCloud2 & cloud)
+{
+  std::vector<std::array<float, 3>> points;
+  sensor_msgs::PointCloud2ConstIterator<float> iter_x(cloud, "x");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_y(cloud, "y");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_z(cloud, "z");
+  for (; iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
+    points.push_back({*iter_x, *iter_y, *iter_z});
+  }
+  return points;
+}
+
+TEST(ObservationVoxelFilter, extremesPerVoxel)
+{
+  ObservationVoxelFilter filter(0.1);
+  EXPECT_EQ(filter.getResolution(), 0.1);
+  filter.setGrid(0.0, 0.0, 0.1);
+  geometry_msgs::msg::Point origin;
+
+  // the first three points share a voxel, the nearest and farthest from the origin are kept
+  auto cloud = makeCloud(
+    {{1.02f, 0.51f, 0.2f}, {1.08f, 0.59f, 0.25f}, {1.05f, 0.55f, 0.22f},
+      {2.0f, 0.5f, 0.2f}, {-1.05f, -0.55f, 0.22f}, {-1.01f, -0.51f, 0.21f}});
+  filter.filter(origin, cloud);
+
+  auto points = getPoints(cloud);
+  ASSERT_EQ(points.size(), 5u);
+  EXPECT_EQ(cloud.width * cloud.height, 5u);
+  EXPECT_EQ(points[0], (std::array<float, 3>{1.02f, 0.51f, 0.2f}));
+  EXPECT_EQ(points[1], (std::array<float, 3>{1.08f, 0.59f, 0.25f}));
+  EXPECT_EQ(points[2], (std::array<float, 3>{2.0f, 0.5f, 0.2f}));
+  EXPECT_EQ(points[3], (std::array<float, 3>{-1.05f, -0.55f, 0.22f}));
+  EXPECT_EQ(points[4], (std::array<float, 3>{-1.01f, -0.51f, 0.21f}));
+
+  // the extremes depend on the origin of the sensor
+  origin.x = 2.0;
+  origin.y = 1.0;
+  cloud = makeCloud(
+    {{1.08f, 0.59f, 0.2f}, {1.05f, 0.55f, 0.2f}, {1.01f, 0.51f, 0.2f}, {1.09f, 0.58f, 0.2f}});
+  filter.filter(origin, cloud);
+  points = getPoints(cloud);
+  ASSERT_EQ(points.size(), 2u);
+  EXPECT_EQ(points[0], (std::array<float, 3>{1.09f, 0.58f, 0.2f}));
+  EXPECT_EQ(points[1], (std::array<float, 3>{1.01f, 0.51f, 0.2f}));
+}
+
+TEST(ObservationVoxelFilter, offsetGrid)
+{
+  // costmap cells start at 0.05, voxels keyed from 0 would straddle two of them
+  ObservationVoxelFilter filter(0.1);
+  filter.setGrid(0.05, -0.05, 0.1);
+  auto cloud = makeCloud(
+    {{0.06f, 0.0f, 0.0f}, {0.09f, 0.0f, 0.0f}, {0.11f, 0.0f, 0.0f}, {0.14f, 0.0f, 0.0f},
+      {0.16f, 0.0f, 0.0f}, {0.04f, 0.0f, 0.0f}});
+  filter.filter(geometry_msgs::msg::Point(), cloud);
+
+  // one voxel per cell, so every cell with points is still marked
+  auto points = getPoints(cloud);
+  ASSERT_EQ(points.size(), 4u);
+  EXPECT_EQ(points[0], (std::array<float, 3>{0.06f, 0.0f, 0.0f}));
+  EXPECT_EQ(points[1], (std::array<float, 3>{0.14f, 0.0f, 0.0f}));
+  EXPECT_EQ(points[2], (std::array<float, 3>{0.16f, 0.0f, 0.0f}));
+  EXPECT_EQ(points[3], (std::array<float, 3>{0.04f, 0.0f, 0.0f}));
+
+  // voxels larger than the cells are shrunk to them
+  ObservationVoxelFilter coarse_filter(0.25);
+  coarse_filter.setGrid(0.05, 0.05, 0.1);
+  cloud = makeCloud({{0.06f, 0.1f, 0.0f}, {0.16f, 0.1f, 0.0f}, {0.26f, 0.1f, 0.0f}});
+  coarse_filter.filter(geometry_msgs::msg::Point(), cloud);
+  EXPECT_EQ(getPoints(cloud).size(), 3u);
+
+  // and smaller ones to the largest fraction of a cell that fits them
+  ObservationVoxelFilter fine_filter(0.04);
+  fine_filter.setGrid(0.05, 0.05, 0.1);
+  cloud = makeCloud(
+    {{0.051f, 0.1f, 0.0f}, {0.06f, 0.1f, 0.0f}, {0.08f, 0.1f, 0.0f}, {0.0849f, 0.1f, 0.0f},
+      {0.149f, 0.1f, 0.0f}});
+  fine_filter.filter(geometry_msgs::msg::Point(), cloud);
+  EXPECT_EQ(getPoints(cloud).size(), 4u);
+}
+
+TEST(ObservationVoxelFilter, denseCloud)
+{
+  // a 1 m square wall sampled every 5 mm reduces to two points per 5 cm voxel
+  std::vector<std::array<float, 3>> wall;
+  for (unsigned int i = 0; i != 200; i++) {
+    for (unsigned int j = 0; j != 200; j++) {
+      wall.push_back({2.0f, 0.0025f + 0.005f * i, 0.0025f + 0.005f * j});
+    }
+  }
+  auto cloud = makeCloud(wall);
+  ObservationVoxelFilter filter(0.05);
+  filter.setGrid(0.0, 0.0, 0.05);
+  filter.filter(geometry_msgs::msg::Point(), cloud);
+  EXPECT_EQ(getPoints(cloud).size(), 800u);
+
+  // without a grid, the cloud is left as is
+  cloud = makeCloud(wall);
+  ObservationVoxelFilter no_grid(0.05);
+  no_grid.filter(geometry_msgs::msg::Point(), cloud);
+  EXPECT_EQ(getPoints(cloud).size(), wall.size());
+
+  // and so it is without a resolution
+  cloud = makeCloud(wall);
+  ObservationVoxelFilter no_filter(0.0);
+  no_filter.setGrid(0.0, 0.0, 0.05);
+  no_filter.filter(geometry_msgs::msg::Point(), cloud);
+  EXPECT_EQ(getPoints(cloud).size(), wall.size());
+}
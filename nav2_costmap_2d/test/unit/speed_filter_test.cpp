@@ -30,6 +30,7 @@
 #include "nav2_util/occ_grid_values.hpp"
 #include "nav2_costmap_2d/cost_values.hpp"
 #include "nav_msgs/msg/occupancy_grid.hpp"
+#include "nav_msgs/msg/path.hpp"
 #include "nav2_msgs/msg/costmap_filter_info.hpp"
 #include "nav2_msgs/msg/speed_limit.hpp"
 #include "nav2_costmap_2d/costmap_2d.hpp"
@@ -42,6 +43,7 @@ static const char FILTER_NAME[]{"speed_filter"};
 static const char INFO_TOPIC[]{"costmap_filter_info"};
 static const char MASK_TOPIC[]{"mask"};
 static const char SPEED_LIMIT_TOPIC[]{"speed_limit"};
+static const char PATH_TOPIC[]{"plan"};
 
 static const double NO_TRANSLATION = 0.0;
 static const double TRANSLATION_X = 1.0;
@@ -101,6 +103,27 @@ private:
   rclcpp::Publisher<nav_msgs::msg::OccupancyGrid>::SharedPtr publisher_;
 };  // MaskPublisher
 
+class PathPublisher : public rclcpp::Node
+{
+public:
+  explicit PathPublisher(const nav_msgs::msg::Path & path)
+  : Node("path_pub")
+  {
+    publisher_ = this->create_publisher<nav_msgs::msg::Path>(
+      PATH_TOPIC, rclcpp::QoS(rclcpp::KeepLast(1)).transient_local().reliable());
+
+    publisher_->publish(path);
+  }
+
+  ~PathPublisher()
+  {
+    publisher_.reset();
+  }
+
+private:
+  rclcpp::Publisher<nav_msgs::msg::Path>::SharedPtr publisher_;
+};  // PathPublisher
+
 class SpeedLimitSubscriber : public rclcpp::Node
 {
 public:
@@ -211,7 +234,8 @@ protected:
   void publishMaps(uint8_t type, double base, double multiplier);
   void rePublishInfo(uint8_t type, double base, double multiplier);
   void rePublishMask();
-  bool createSpeedFilter(const std::string & global_frame);
+  bool createSpeedFilter(const std::string & global_frame, double lookahead_distance = 0.0);
+  void publishPath(const nav_msgs::msg::Path & path);
   void createTFBroadcaster(const std::string & mask_frame, const std::string & global_frame);
   void publishTransform();
 
@@ -224,6 +248,7 @@ protected:
     double tr_x, double tr_y);
   void testOutOfMask(uint8_t type, double base, double multiplier);
   void testIncorrectLimits(uint8_t type, double base, double multiplier);
+  void testLookahead();
 
   void reset();
 
@@ -254,6 +279,7 @@ private:
 
   std::shared_ptr<InfoPublisher> info_publisher_;
   std::shared_ptr<MaskPublisher> mask_publisher_;
+  std::shared_ptr<PathPublisher> path_publisher_;
   std::shared_ptr<SpeedLimitSubscriber> speed_limit_subscriber_;
 };
 
@@ -339,7 +365,7 @@ void TestNode::waitSome(const std::chrono::nanoseconds & duration)
   }
 }
 
-bool TestNode::createSpeedFilter(const std::string & global_frame)
+bool TestNode::createSpeedFilter(const std::string & global_frame, double lookahead_distance)
 {
   node_ = std::make_shared<nav2_util::LifecycleNode>("test_node");
   tf_buffer_ = std::make_shared<tf2_ros::Buffer>(node_->get_clock());
@@ -360,6 +386,13 @@ bool TestNode::createSpeedFilter(const std::string & global_frame)
     std::string(FILTER_NAME) + ".speed_limit_topic", rclcpp::ParameterValue(SPEED_LIMIT_TOPIC));
   node_->set_parameter(
     rclcpp::Parameter(std::string(FILTER_NAME) + ".speed_limit_topic", SPEED_LIMIT_TOPIC));
+  if (lookahead_distance > 0.0) {
+    node_->declare_parameter(
+      std::string(FILTER_NAME) + ".path_topic", rclcpp::ParameterValue(PATH_TOPIC));
+    node_->declare_parameter(
+      std::string(FILTER_NAME) + ".lookahead_distance",
+      rclcpp::ParameterValue(lookahead_distance));
+  }
 
   speed_filter_ = std::make_shared<nav2_costmap_2d::SpeedFilter>();
   speed_filter_->initialize(&layers, FILTER_NAME, tf_buffer_.get(), node_, nullptr);
@@ -380,6 +413,13 @@ bool TestNode::createSpeedFilter(const std::string & global_frame)
   return true;
 }
 
+void TestNode::publishPath(const nav_msgs::msg::Path & path)
+{
+  path_publisher_ = std::make_shared<PathPublisher>(path);
+  // Allow path subscriber to receive the path
+  waitSome(100ms);
+}
+
 void TestNode::createTFBroadcaster(const std::string & mask_frame, const std::string & global_frame)
 {
   tf_broadcaster_ = std::make_shared<tf2_ros::TransformBroadcaster>(node_);
@@ -617,12 +657,57 @@ void TestNode::testIncorrectLimits(uint8_t type, double base, double multiplier)
   }
 }
 
+static nav_msgs::msg::Path makePath(const std::vector<std::tuple<double, double>> & points)
+{
+  nav_msgs::msg::Path path;
+  path.header.frame_id = "map";
+  for (const auto & point : points) {
+    geometry_msgs::msg::PoseStamped pose;
+    pose.header.frame_id = "map";
+    pose.pose.position.x = std::get<0>(point);
+    pose.pose.position.y = std::get<1>(point);
+    pose.pose.orientation.w = 1.0;
+    path.poses.push_back(pose);
+  }
+  return path;
+}
+
+void TestNode::testLookahead()
+{
+  const int min_i = 0;
+  const int min_j = 0;
+  const int max_i = width_ + 4;
+  const int max_j = height_ + 4;
+
+  geometry_msgs::msg::Pose2D pose;
+  nav2_msgs::msg::SpeedLimit::SharedPtr speed_limit;
+
+  // Along the data = 0 row, then up the last column through data = 10, 20, ...
+  publishPath(makePath({{1.5, 0.5}, {5.5, 0.5}, {9.5, 0.5}, {9.5, 3.5}}));
+
+  // data = 0, and no speed zone within lookahead distance
+  pose.x = 2.5;
+  pose.y = 0.5;
+  speed_filter_->process(*master_grid_, min_i, min_j, max_i, max_j, pose);
+  speed_limit = getSpeedLimit();
+  ASSERT_TRUE(speed_limit == nullptr);
+
+  // data = 0, but the data = 10 zone is within lookahead distance
+  pose.x = 6.5;
+  pose.y = 0.5;
+  speed_filter_->process(*master_grid_, min_i, min_j, max_i, max_j, pose);
+  speed_limit = waitSpeedLimit();
+  ASSERT_TRUE(speed_limit != nullptr);
+  verifySpeedLimit(nav2_costmap_2d::SPEED_FILTER_PERCENT, 0.0, 1.0, 9, 1, speed_limit);
+}
+
 void TestNode::reset()
 {
   mask_.reset();
   master_grid_.reset();
   info_publisher_.reset();
   mask_publisher_.reset();
+  path_publisher_.reset();
   speed_limit_subscriber_.reset();
   speed_filter_.reset();
   node_.reset();
@@ -773,6 +858,44 @@ TEST_F(TestNode, testDifferentFrame)
   reset();
 }
 
+TEST_F(TestNode, testSpeedLimitProfile)
+{
+  // Initilize test system
+  createMaps("map");
+  publishMaps(nav2_costmap_2d::SPEED_FILTER_PERCENT, 0.0, 1.0);
+  EXPECT_TRUE(createSpeedFilter("map"));
+
+  // Sparse path: each segment is rasterized over the mask cells it crosses
+  std::vector<double> speed_limits;
+  EXPECT_TRUE(
+    speed_filter_->getSpeedLimitProfile(
+      makePath({{2.5, 0.5}, {9.5, 0.5}, {9.5, 3.5}, {9.5, 6.5}}), speed_limits));
+  ASSERT_EQ(speed_limits.size(), 4u);
+  EXPECT_EQ(speed_limits[0], nav2_costmap_2d::NO_SPEED_LIMIT);
+  EXPECT_EQ(speed_limits[1], nav2_costmap_2d::NO_SPEED_LIMIT);
+  EXPECT_NEAR(speed_limits[2], 10.0, EPSILON);
+  EXPECT_NEAR(speed_limits[3], 30.0, EPSILON);
+
+  // Clean-up
+  speed_filter_->resetFilter();
+  reset();
+}
+
+TEST_F(TestNode, testLookahead)
+{
+  // Initilize test system
+  createMaps("map");
+  publishMaps(nav2_costmap_2d::SPEED_FILTER_PERCENT, 0.0, 1.0);
+  EXPECT_TRUE(createSpeedFilter("map", 5.0));
+
+  // Test SpeedFilter
+  testLookahead();
+
+  // Clean-up
+  speed_filter_->resetFilter();
+  reset();
+}
+
 int main(int argc, char ** argv)
 {
   // Initialize the system
@@ -94,6 +94,13 @@ public:
    */
   void setPlan(const nav_msgs::msg::Path & path) override;
 
+  /**
+   * @brief nav2_core updatePlan - Updates the global plan, converting only the changed poses
+   * @param path The global plan
+   * @param first_changed_index Index of the first pose differing from the previous plan
+   */
+  void updatePlan(const nav_msgs::msg::Path & path, size_t first_changed_index) override;
+
   /**
    * @brief nav2_core computeVelocityCommands - calculates the best command given the current pose and velocity
    *
@@ -196,6 +203,7 @@ protected:
   virtual nav_2d_msgs::msg::Path2D transformGlobalPlan(
     const nav_2d_msgs::msg::Pose2DStamped & pose);
   nav_2d_msgs::msg::Path2D global_plan_;  ///< Saved Global Plan
+  size_t pruned_poses_{0};  ///< Number of poses pruned from the start of the saved global plan
   bool prune_plan_;
   double prune_distance_;
   bool debug_trajectory_details_;
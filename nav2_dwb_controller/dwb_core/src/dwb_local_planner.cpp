@@ -246,6 +246,32 @@ DWBLocalPlanner::setPlan(const nav_msgs::msg::Path & path)
 
   pub_->publishGlobalPlan(path2d);
   global_plan_ = path2d;
+  pruned_poses_ = 0;
+}
+
+void
+DWBLocalPlanner::updatePlan(const nav_msgs::msg::Path & path, size_t first_changed_index)
+{
+  // Resume from the pruned plan if the replan only changed poses ahead of it
+  if (first_changed_index < pruned_poses_ ||
+    first_changed_index > pruned_poses_ + global_plan_.poses.size())
+  {
+    setPlan(path);
+    return;
+  }
+
+  for (TrajectoryCritic::Ptr & critic : critics_) {
+    critic->reset();
+  }
+
+  traj_generator_->reset();
+
+  global_plan_.header = path.header;
+  global_plan_.poses.resize(first_changed_index - pruned_poses_);
+  for (size_t idx = first_changed_index; idx < path.poses.size(); ++idx) {
+    global_plan_.poses.push_back(nav_2d_utils::poseToPose2D(path.poses[idx].pose));
+  }
+  pub_->publishGlobalPlan(global_plan_);
 }
 
 geometry_msgs::msg::TwistStamped
@@ -555,6 +581,7 @@ DWBLocalPlanner::transformGlobalPlan(
   // Remove the portion of the global plan that we've already passed so we don't
   // process it on the next iteration.
   if (prune_plan_) {
+    pruned_poses_ += std::distance(begin(global_plan_.poses), transformation_begin);
     global_plan_.poses.erase(begin(global_plan_.poses), transformation_begin);
     pub_->publishGlobalPlan(global_plan_);
   }
@@ -94,6 +94,13 @@ public:
     */
   void setPlan(const nav_msgs::msg::Path & path) override;
 
+  /**
+    * @brief Update the reference path to track after a replan
+    * @param path Path to track
+    * @param first_changed_index Index of the first pose differing from the previous path
+    */
+  void updatePlan(const nav_msgs::msg::Path & path, size_t first_changed_index) override;
+
   /**
     * @brief Set new speed limit from callback
     * @param speed_limit Speed limit to use
@@ -76,6 +76,14 @@ public:
     */
   void setPath(const nav_msgs::msg::Path & plan);
 
+  /**
+    * @brief Update the reference path after a replan, keeping the pruned progress
+    * along the poses which did not change
+    * @param Plan Path to use
+    * @param first_changed_index Index of the first pose differing from the previous path
+    */
+  void updatePath(const nav_msgs::msg::Path & plan, size_t first_changed_index);
+
   /**
     * @brief Get reference path
     * @return Path
@@ -155,6 +163,7 @@ protected:
   float inversion_yaw_tolerance{0.4};
   bool enforce_path_inversion_{false};
   unsigned int inversion_locale_{0u};
+  size_t pruned_poses_{0u};
 };
 }  // namespace mppi
 
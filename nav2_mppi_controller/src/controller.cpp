@@ -114,6 +114,11 @@ void MPPIController::setPlan(const nav_msgs::msg::Path & path)
   path_handler_.setPath(path);
 }
 
+void MPPIController::updatePlan(const nav_msgs::msg::Path & path, size_t first_changed_index)
+{
+  path_handler_.updatePath(path, first_changed_index);
+}
+
 void MPPIController::setSpeedLimit(const double & speed_limit, const bool & percentage)
 {
   optimizer_.setSpeedLimit(speed_limit, percentage);
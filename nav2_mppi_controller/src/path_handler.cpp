@@ -125,6 +125,7 @@ nav_msgs::msg::Path PathHandler::transformPath(
     transformToGlobalPlanFrame(robot_pose);
   auto [transformed_plan, lower_bound] = getGlobalPlanConsideringBoundsInCostmapFrame(global_pose);
 
+  pruned_poses_ += std::distance(global_plan_up_to_inversion_.poses.begin(), lower_bound);
   prunePlan(global_plan_up_to_inversion_, lower_bound);
 
   if (enforce_path_inversion_ && inversion_locale_ != 0u) {
@@ -173,12 +174,36 @@ double PathHandler::getMaxCostmapDist()
 void PathHandler::setPath(const nav_msgs::msg::Path & plan)
 {
   global_plan_ = plan;
+  pruned_poses_ = 0u;
   global_plan_up_to_inversion_ = global_plan_;
   if (enforce_path_inversion_) {
     inversion_locale_ = utils::removePosesAfterFirstInversion(global_plan_up_to_inversion_);
   }
 }
 
+void PathHandler::updatePath(const nav_msgs::msg::Path & plan, size_t first_changed_index)
+{
+  // The poses already pruned must be part of the unchanged ones to resume from them,
+  // inversions are searched on the whole path so their handling starts over as well
+  if (enforce_path_inversion_ || first_changed_index < pruned_poses_ ||
+    first_changed_index > global_plan_.poses.size())
+  {
+    setPath(plan);
+    return;
+  }
+
+  global_plan_.header = plan.header;
+  global_plan_.poses.resize(first_changed_index);
+  global_plan_.poses.insert(
+    global_plan_.poses.end(), plan.poses.begin() + first_changed_index, plan.poses.end());
+
+  global_plan_up_to_inversion_.header = plan.header;
+  global_plan_up_to_inversion_.poses.resize(first_changed_index - pruned_poses_);
+  global_plan_up_to_inversion_.poses.insert(
+    global_plan_up_to_inversion_.poses.end(),
+    plan.poses.begin() + first_changed_index, plan.poses.end());
+}
+
 nav_msgs::msg::Path & PathHandler::getPath() {return global_plan_;}
 
 void PathHandler::prunePlan(nav_msgs::msg::Path & plan, const PathIterator end)
@@ -81,6 +81,12 @@ public:
   {
     return global_plan_up_to_inversion_;
   }
+
+  void pruneProgressWrapper(size_t poses)
+  {
+    pruned_poses_ += poses;
+    prunePlan(global_plan_up_to_inversion_, global_plan_up_to_inversion_.poses.begin() + poses);
+  }
 };
 
 TEST(PathHandlerTests, GetAndPrunePath)
@@ -102,6 +108,40 @@ TEST(PathHandlerTests, GetAndPrunePath)
   EXPECT_EQ(rtn2_path.poses.size(), 6u);
 }
 
+TEST(PathHandlerTests, UpdatePath)
+{
+  nav_msgs::msg::Path path;
+  PathHandlerWrapper handler;
+
+  path.header.frame_id = "fkframe";
+  path.poses.resize(50);
+  for (unsigned int i = 0; i != path.poses.size(); i++) {
+    path.poses[i].pose.position.x = i;
+  }
+
+  handler.setPath(path);
+  handler.pruneProgressWrapper(10);
+
+  // Replan after the robot progress keeps it
+  nav_msgs::msg::Path replanned_path = path;
+  replanned_path.poses.resize(40);
+  for (unsigned int i = 20; i != replanned_path.poses.size(); i++) {
+    replanned_path.poses[i].pose.position.y = 1.0;
+  }
+  handler.updatePath(replanned_path, 20);
+  EXPECT_EQ(handler.getPath().poses, replanned_path.poses);
+  auto & inverted_path = handler.getInvertedPath();
+  EXPECT_EQ(inverted_path.poses.size(), 30u);
+  EXPECT_EQ(inverted_path.poses.front().pose.position.x, 10.0);
+  EXPECT_EQ(inverted_path.poses.back().pose.position.y, 1.0);
+
+  // Replan of the poses already passed starts over
+  handler.pruneProgressWrapper(5);
+  handler.updatePath(path, 12);
+  EXPECT_EQ(handler.getPath().poses, path.poses);
+  EXPECT_EQ(handler.getInvertedPath().poses.size(), 50u);
+}
+
 TEST(PathHandlerTests, TestBounds)
 {
   PathHandlerWrapper handler;
@@ -90,6 +90,18 @@ public:
   double costAtPose(const double & x, const double & y);
 
 protected:
+  /**
+   * @brief Whether a footprint cost is a collision
+   * @param footprint_cost Cost of the footprint
+   * @return Whether in collision
+   */
+  bool isCollisionCost(const double & footprint_cost);
+
+  /**
+   * @brief Warn, throttled, that poses to check are off the costmap
+   */
+  void warnCostmapTooSmall();
+
   rclcpp::Logger logger_ {rclcpp::get_logger("RPPCollisionChecker")};
   std::shared_ptr<nav2_costmap_2d::Costmap2DROS> costmap_ros_;
   nav2_costmap_2d::Costmap2D * costmap_;
@@ -98,6 +110,10 @@ protected:
   Parameters * params_;
   std::shared_ptr<rclcpp_lifecycle::LifecyclePublisher<nav_msgs::msg::Path>> carrot_arc_pub_;
   rclcpp::Clock::SharedPtr clock_;
+  // Forward simulated poses on the costmap, with their number of poses in the arc
+  std::vector<geometry_msgs::msg::Pose2D> projected_poses_;
+  std::vector<size_t> projected_arc_ids_;
+  std::vector<double> projected_costs_;
 };
 
 }  // namespace nav2_regulated_pure_pursuit_controller
@@ -0,0 +1,81 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NAV2_REGULATED_PURE_PURSUIT_CONTROLLER__PATH_PROFILE_HPP_
+#define NAV2_REGULATED_PURE_PURSUIT_CONTROLLER__PATH_PROFILE_HPP_
+
+#include <vector>
+
+#include "nav_msgs/msg/path.hpp"
+
+namespace nav2_regulated_pure_pursuit_controller
+{
+
+/**
+ * @class nav2_regulated_pure_pursuit_controller::PathProfile
+ * @brief Distances along a path transformed in the robot base frame, computed in a
+ * single pass once per control cycle so the lookahead, cusp and approach queries
+ * don't each walk the path again
+ */
+class PathProfile
+{
+public:
+  /**
+   * @brief Constructor for nav2_regulated_pure_pursuit_controller::PathProfile
+   */
+  PathProfile() = default;
+
+  /**
+   * @brief Compute the profile of a path, reusing the memory of the previous one
+   * @param path Path in the robot base frame, the robot being at the origin
+   */
+  void update(const nav_msgs::msg::Path & path);
+
+  /**
+   * @brief Find the first pose at least a distance away from the robot, in O(log n)
+   * @param dist Distance from the robot
+   * @return Index of the pose, the number of poses if none is far enough
+   */
+  size_t findFirstPoseBeyond(const double & dist) const;
+
+  /**
+   * @brief Get the length of the path, integrated along its poses
+   * @return Path length
+   */
+  double getPathLength() const {return path_length_;}
+
+  /**
+   * @brief Get the distance from the robot to the first cusp of the path
+   * @return Cusp distance, the largest double if the path has no cusp
+   */
+  double getCuspDistance() const {return cusp_distance_;}
+
+  /**
+   * @brief Get the distance from the robot to the last pose of the path
+   * @return Goal distance
+   */
+  double getGoalDistance() const {return goal_distance_;}
+
+protected:
+  // Farthest distance from the robot of the poses up to each index. It is sorted, and
+  // its first element at least a distance is the first pose at least that distance away.
+  std::vector<double> max_distances_;
+  double path_length_{0.0};
+  double cusp_distance_{0.0};
+  double goal_distance_{0.0};
+};
+
+}  // namespace nav2_regulated_pure_pursuit_controller
+
+#endif  // NAV2_REGULATED_PURE_PURSUIT_CONTROLLER__PATH_PROFILE_HPP_
@@ -28,6 +28,7 @@
 #include "pluginlib/class_list_macros.hpp"
 #include "geometry_msgs/msg/pose2_d.hpp"
 #include "nav2_regulated_pure_pursuit_controller/path_handler.hpp"
+#include "nav2_regulated_pure_pursuit_controller/path_profile.hpp"
 #include "nav2_regulated_pure_pursuit_controller/collision_checker.hpp"
 #include "nav2_regulated_pure_pursuit_controller/parameter_handler.hpp"
 #include "nav2_regulated_pure_pursuit_controller/regulation_functions.hpp"
@@ -161,10 +162,11 @@ protected:
    * @param curvature curvature of path
    * @param speed Speed of robot
    * @param pose_cost cost at this pose
+   * @param path_profile Profile of the transformed path
    */
   void applyConstraints(
     const double & curvature, const geometry_msgs::msg::Twist & speed,
-    const double & pose_cost, const nav_msgs::msg::Path & path,
+    const double & pose_cost, const PathProfile & path_profile,
     double & linear_vel, double & sign);
 
   /**
@@ -189,6 +191,16 @@ protected:
    */
   geometry_msgs::msg::PoseStamped getLookAheadPoint(const double &, const nav_msgs::msg::Path &);
 
+  /**
+   * @brief Get lookahead point, searching the profile of the path
+   * @param lookahead_dist Optimal lookahead distance
+   * @param path Current global path
+   * @param path_profile Profile of the path
+   * @return Lookahead point
+   */
+  geometry_msgs::msg::PoseStamped getLookAheadPoint(
+    const double &, const nav_msgs::msg::Path &, const PathProfile &);
+
   /**
    * @brief checks for the cusp position
    * @param pose Pose input to determine the cusp position
@@ -206,6 +218,7 @@ protected:
   Parameters * params_;
   double goal_dist_tol_;
   double control_duration_;
+  PathProfile path_profile_;
 
   std::shared_ptr<rclcpp_lifecycle::LifecyclePublisher<nav_msgs::msg::Path>> global_path_pub_;
   std::shared_ptr<rclcpp_lifecycle::LifecyclePublisher<geometry_msgs::msg::PointStamped>>
@@ -84,6 +84,29 @@ inline double costConstraint(
   return raw_linear_vel;
 }
 
+/**
+ * @brief Compute the scale factor to apply for linear velocity regulation on approach to goal
+ * @param remaining_distance Length of the path left to the goal
+ * @param goal_distance Euclidean distance from the robot to the goal
+ * @param approach_velocity_scaling_dist Minimum distance away to which to apply the heuristic
+ * @return A scale from 0.0-1.0 of the distance to goal scaled by minimum distance
+ */
+inline double approachVelocityScalingFactor(
+  const double remaining_distance,
+  const double goal_distance,
+  const double approach_velocity_scaling_dist)
+{
+  // Waiting to apply the threshold based on integrated distance ensures we don't
+  // erroneously apply approach scaling on curvy paths that are contained in a large local costmap.
+  if (remaining_distance < approach_velocity_scaling_dist) {
+    // Here we will use a regular euclidean distance from the robot frame (origin)
+    // to get smooth scaling, regardless of path density.
+    return goal_distance / approach_velocity_scaling_dist;
+  } else {
+    return 1.0;
+  }
+}
+
 /**
  * @brief Compute the scale factor to apply for linear velocity regulation on approach to goal
  * @param transformed_path Path to use to calculate distances to goal
@@ -96,14 +119,12 @@ inline double approachVelocityScalingFactor(
 {
   using namespace nav2_util::geometry_utils;  // NOLINT
 
-  // Waiting to apply the threshold based on integrated distance ensures we don't
-  // erroneously apply approach scaling on curvy paths that are contained in a large local costmap.
   const double remaining_distance = calculate_path_length(transformed_path);
   if (remaining_distance < approach_velocity_scaling_dist) {
     auto & last = transformed_path.poses.back();
-    // Here we will use a regular euclidean distance from the robot frame (origin)
-    // to get smooth scaling, regardless of path density.
-    return std::hypot(last.pose.position.x, last.pose.position.y) / approach_velocity_scaling_dist;
+    return approachVelocityScalingFactor(
+      remaining_distance, std::hypot(last.pose.position.x, last.pose.position.y),
+      approach_velocity_scaling_dist);
   } else {
     return 1.0;
   }
@@ -112,18 +133,15 @@ inline double approachVelocityScalingFactor(
 /**
  * @brief Velocity on approach to goal heuristic regulation term
  * @param constrained_linear_vel Linear velocity already constrained by heuristics
- * @param path The path plan in the robot base frame coordinates
+ * @param velocity_scaling Approach scale factor, see approachVelocityScalingFactor
  * @param min_approach_velocity Minimum velocity to use on approach to goal
- * @param approach_velocity_scaling_dist Distance away from goal to start applying this heuristic
  * @return Velocity after regulation via approach to goal slow-down
  */
 inline double approachVelocityConstraint(
   const double constrained_linear_vel,
-  const nav_msgs::msg::Path & path,
-  const double min_approach_velocity,
-  const double approach_velocity_scaling_dist)
+  const double velocity_scaling,
+  const double min_approach_velocity)
 {
-  double velocity_scaling = approachVelocityScalingFactor(path, approach_velocity_scaling_dist);
   double approach_vel = constrained_linear_vel * velocity_scaling;
 
   if (approach_vel < min_approach_velocity) {
@@ -133,6 +151,25 @@ inline double approachVelocityConstraint(
   return std::min(constrained_linear_vel, approach_vel);
 }
 
+/**
+ * @brief Velocity on approach to goal heuristic regulation term
+ * @param constrained_linear_vel Linear velocity already constrained by heuristics
+ * @param path The path plan in the robot base frame coordinates
+ * @param min_approach_velocity Minimum velocity to use on approach to goal
+ * @param approach_velocity_scaling_dist Distance away from goal to start applying this heuristic
+ * @return Velocity after regulation via approach to goal slow-down
+ */
+inline double approachVelocityConstraint(
+  const double constrained_linear_vel,
+  const nav_msgs::msg::Path & path,
+  const double min_approach_velocity,
+  const double approach_velocity_scaling_dist)
+{
+  return approachVelocityConstraint(
+    constrained_linear_vel, approachVelocityScalingFactor(path, approach_velocity_scaling_dist),
+    min_approach_velocity);
+}
+
 }  // namespace heuristics
 
 }  // namespace nav2_regulated_pure_pursuit_controller
@@ -91,7 +91,9 @@ bool CollisionChecker::isCollisionImminent(
   curr_pose.y = robot_pose.pose.position.y;
   curr_pose.theta = tf2::getYaw(robot_pose.pose.orientation);
 
-  // only forward simulate within time requested
+  // only forward simulate within time requested, then check all the poses in one batch
+  projected_poses_.clear();
+  projected_arc_ids_.clear();
   int i = 1;
   while (i * projection_time < params_->max_allowed_time_to_collision_up_to_carrot) {
     i++;
@@ -112,8 +114,22 @@ bool CollisionChecker::isCollisionImminent(
     pose_msg.pose.position.z = 0.01;
     arc_pts_msg.poses.push_back(pose_msg);
 
-    // check for collision at the projected pose
-    if (inCollision(curr_pose.x, curr_pose.y, curr_pose.theta)) {
+    // poses off the costmap cannot be checked
+    unsigned int mx, my;
+    if (!costmap_->worldToMap(curr_pose.x, curr_pose.y, mx, my)) {
+      warnCostmapTooSmall();
+      continue;
+    }
+    projected_poses_.push_back(curr_pose);
+    projected_arc_ids_.push_back(arc_pts_msg.poses.size());
+  }
+
+  footprint_collision_checker_->footprintCostsAtPoses(
+    projected_poses_, costmap_ros_->getRobotFootprint(), projected_costs_);
+  for (size_t j = 0; j < projected_costs_.size(); ++j) {
+    if (isCollisionCost(projected_costs_[j])) {
+      // visualize the arc up to the pose in collision
+      arc_pts_msg.poses.resize(projected_arc_ids_[j]);
       carrot_arc_pub_->publish(arc_pts_msg);
       return true;
     }
@@ -132,16 +148,17 @@ bool CollisionChecker::inCollision(
   unsigned int mx, my;
 
   if (!costmap_->worldToMap(x, y, mx, my)) {
-    RCLCPP_WARN_THROTTLE(
-      logger_, *(clock_), 30000,
-      "The dimensions of the costmap is too small to successfully check for "
-      "collisions as far ahead as requested. Proceed at your own risk, slow the robot, or "
-      "increase your costmap size.");
+    warnCostmapTooSmall();
     return false;
   }
 
-  double footprint_cost = footprint_collision_checker_->footprintCostAtPose(
-    x, y, theta, costmap_ros_->getRobotFootprint());
+  return isCollisionCost(
+    footprint_collision_checker_->footprintCostAtPose(
+      x, y, theta, costmap_ros_->getRobotFootprint()));
+}
+
+bool CollisionChecker::isCollisionCost(const double & footprint_cost)
+{
   if (footprint_cost == static_cast<double>(NO_INFORMATION) &&
     costmap_ros_->getLayeredCostmap()->isTrackingUnknown())
   {
@@ -152,6 +169,15 @@ bool CollisionChecker::inCollision(
   return footprint_cost >= static_cast<double>(LETHAL_OBSTACLE);
 }
 
+void CollisionChecker::warnCostmapTooSmall()
+{
+  RCLCPP_WARN_THROTTLE(
+    logger_, *(clock_), 30000,
+    "The dimensions of the costmap is too small to successfully check for "
+    "collisions as far ahead as requested. Proceed at your own risk, slow the robot, or "
+    "increase your costmap size.");
+}
+
 
 double CollisionChecker::costAtPose(const double & x, const double & y)
 {
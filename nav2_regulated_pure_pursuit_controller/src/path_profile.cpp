@@ -0,0 +1,72 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "nav2_regulated_pure_pursuit_controller/path_profile.hpp"
+
+namespace nav2_regulated_pure_pursuit_controller
+{
+
+void PathProfile::update(const nav_msgs::msg::Path & path)
+{
+  const auto & poses = path.poses;
+  max_distances_.resize(poses.size());
+  path_length_ = 0.0;
+  cusp_distance_ = std::numeric_limits<double>::max();
+  goal_distance_ = 0.0;
+
+  double max_distance = 0.0;
+  for (size_t i = 0; i < poses.size(); ++i) {
+    const auto & position = poses[i].pose.position;
+    // The path is in the robot base frame, so the robot is at the origin
+    const double distance = std::hypot(position.x, position.y);
+    max_distance = std::max(max_distance, distance);
+    max_distances_[i] = max_distance;
+    if (i == 0) {
+      continue;
+    }
+
+    const auto & prev_position = poses[i - 1].pose.position;
+    const double oa_x = position.x - prev_position.x;
+    const double oa_y = position.y - prev_position.y;
+    path_length_ += std::hypot(oa_x, oa_y);
+
+    // A cusp is a pose where the path turns back, the dot product of the
+    // segments before and after it being negative
+    if (cusp_distance_ == std::numeric_limits<double>::max() && i + 1 < poses.size()) {
+      const double ab_x = poses[i + 1].pose.position.x - position.x;
+      const double ab_y = poses[i + 1].pose.position.y - position.y;
+      if ((oa_x * ab_x) + (oa_y * ab_y) < 0.0) {
+        cusp_distance_ = distance;
+      }
+    }
+  }
+
+  if (!poses.empty()) {
+    goal_distance_ = std::hypot(poses.back().pose.position.x, poses.back().pose.position.y);
+  }
+}
+
+size_t PathProfile::findFirstPoseBeyond(const double & dist) const
+{
+  return static_cast<size_t>(
+    std::lower_bound(max_distances_.begin(), max_distances_.end(), dist) -
+    max_distances_.begin());
+}
+
+}  // namespace nav2_regulated_pure_pursuit_controller
@@ -171,13 +171,16 @@ geometry_msgs::msg::TwistStamped RegulatedPurePursuitController::computeVelocity
     pose, params_->max_robot_pose_search_dist);
   global_path_pub_->publish(transformed_plan);
 
+  // Distances along the path for all the queries of this cycle
+  path_profile_.update(transformed_plan);
+
   // Find look ahead distance and point on path and publish
   double lookahead_dist = getLookAheadDistance(speed);
 
   // Check for reverse driving
   if (params_->allow_reversing) {
     // Cusp check
-    const double dist_to_cusp = findVelocitySignChange(transformed_plan);
+    const double dist_to_cusp = path_profile_.getCuspDistance();
 
     // if the lookahead distance is further than the cusp, use the cusp distance instead
     if (dist_to_cusp < lookahead_dist) {
@@ -186,7 +189,7 @@ geometry_msgs::msg::TwistStamped RegulatedPurePursuitController::computeVelocity
   }
 
   // Get the particular point on the path at the lookahead distance
-  auto carrot_pose = getLookAheadPoint(lookahead_dist, transformed_plan);
+  auto carrot_pose = getLookAheadPoint(lookahead_dist, transformed_plan, path_profile_);
   carrot_pub_->publish(createCarrotMsg(carrot_pose));
 
   double linear_vel, angular_vel;
@@ -197,7 +200,7 @@ geometry_msgs::msg::TwistStamped RegulatedPurePursuitController::computeVelocity
   if (params_->use_fixed_curvature_lookahead) {
     auto curvature_lookahead_pose = getLookAheadPoint(
       params_->curvature_lookahead_dist,
-      transformed_plan);
+      transformed_plan, path_profile_);
     regulation_curvature = calculateCurvature(curvature_lookahead_pose.pose.position);
   }
 
@@ -219,7 +222,7 @@ geometry_msgs::msg::TwistStamped RegulatedPurePursuitController::computeVelocity
   } else {
     applyConstraints(
       regulation_curvature, speed,
-      collision_checker_->costAtPose(pose.pose.position.x, pose.pose.position.y), transformed_plan,
+      collision_checker_->costAtPose(pose.pose.position.x, pose.pose.position.y), path_profile_,
       linear_vel, sign);
 
     // Apply curvature to angular velocity after constraining linear velocity
@@ -312,12 +315,20 @@ geometry_msgs::msg::Point RegulatedPurePursuitController::circleSegmentIntersect
 geometry_msgs::msg::PoseStamped RegulatedPurePursuitController::getLookAheadPoint(
   const double & lookahead_dist,
   const nav_msgs::msg::Path & transformed_plan)
+{
+  PathProfile path_profile;
+  path_profile.update(transformed_plan);
+  return getLookAheadPoint(lookahead_dist, transformed_plan, path_profile);
+}
+
+geometry_msgs::msg::PoseStamped RegulatedPurePursuitController::getLookAheadPoint(
+  const double & lookahead_dist,
+  const nav_msgs::msg::Path & transformed_plan,
+  const PathProfile & path_profile)
 {
   // Find the first pose which is at a distance greater than the lookahead distance
-  auto goal_pose_it = std::find_if(
-    transformed_plan.poses.begin(), transformed_plan.poses.end(), [&](const auto & ps) {
-      return hypot(ps.pose.position.x, ps.pose.position.y) >= lookahead_dist;
-    });
+  auto goal_pose_it = transformed_plan.poses.begin() +
+    path_profile.findFirstPoseBeyond(lookahead_dist);
 
   // If the no pose is not far enough, take the last pose
   if (goal_pose_it == transformed_plan.poses.end()) {
@@ -326,7 +337,7 @@ geometry_msgs::msg::PoseStamped RegulatedPurePursuitController::getLookAheadPoin
     // Find the point on the line segment between the two poses
     // that is exactly the lookahead distance away from the robot pose (the origin)
     // This can be found with a closed form for the intersection of a segment and a circle
-    // Because of the way we did the std::find_if, prev_pose is guaranteed to be inside the circle,
+    // Because it is the first pose that far, prev_pose is guaranteed to be inside the circle,
     // and goal_pose is guaranteed to be outside the circle.
     auto prev_pose_it = std::prev(goal_pose_it);
     auto point = circleSegmentIntersection(
@@ -344,7 +355,8 @@ geometry_msgs::msg::PoseStamped RegulatedPurePursuitController::getLookAheadPoin
 
 void RegulatedPurePursuitController::applyConstraints(
   const double & curvature, const geometry_msgs::msg::Twist & /*curr_speed*/,
-  const double & pose_cost, const nav_msgs::msg::Path & path, double & linear_vel, double & sign)
+  const double & pose_cost, const PathProfile & path_profile, double & linear_vel,
+  double & sign)
 {
   double curvature_vel = linear_vel, cost_vel = linear_vel;
 
@@ -364,9 +376,11 @@ void RegulatedPurePursuitController::applyConstraints(
   linear_vel = std::max(linear_vel, params_->regulated_linear_scaling_min_speed);
 
   // Apply constraint to reduce speed on approach to the final goal pose
-  linear_vel = heuristics::approachVelocityConstraint(
-    linear_vel, path, params_->min_approach_linear_velocity,
+  const double velocity_scaling = heuristics::approachVelocityScalingFactor(
+    path_profile.getPathLength(), path_profile.getGoalDistance(),
     params_->approach_velocity_scaling_dist);
+  linear_vel = heuristics::approachVelocityConstraint(
+    linear_vel, velocity_scaling, params_->min_approach_linear_velocity);
 
   // Limit linear velocities to be valid
   linear_vel = std::clamp(fabs(linear_vel), 0.0, params_->desired_linear_vel);
@@ -401,31 +415,9 @@ void RegulatedPurePursuitController::setSpeedLimit(
 double RegulatedPurePursuitController::findVelocitySignChange(
   const nav_msgs::msg::Path & transformed_plan)
 {
-  // Iterating through the transformed global path to determine the position of the cusp
-  for (unsigned int pose_id = 1; pose_id < transformed_plan.poses.size() - 1; ++pose_id) {
-    // We have two vectors for the dot product OA and AB. Determining the vectors.
-    double oa_x = transformed_plan.poses[pose_id].pose.position.x -
-      transformed_plan.poses[pose_id - 1].pose.position.x;
-    double oa_y = transformed_plan.poses[pose_id].pose.position.y -
-      transformed_plan.poses[pose_id - 1].pose.position.y;
-    double ab_x = transformed_plan.poses[pose_id + 1].pose.position.x -
-      transformed_plan.poses[pose_id].pose.position.x;
-    double ab_y = transformed_plan.poses[pose_id + 1].pose.position.y -
-      transformed_plan.poses[pose_id].pose.position.y;
-
-    /* Checking for the existance of cusp, in the path, using the dot product
-    and determine it's distance from the robot. If there is no cusp in the path,
-    then just determine the distance to the goal location. */
-    if ( (oa_x * ab_x) + (oa_y * ab_y) < 0.0) {
-      // returning the distance if there is a cusp
-      // The transformed path is in the robots frame, so robot is at the origin
-      return hypot(
-        transformed_plan.poses[pose_id].pose.position.x,
-        transformed_plan.poses[pose_id].pose.position.y);
-    }
-  }
-
-  return std::numeric_limits<double>::max();
+  PathProfile path_profile;
+  path_profile.update(transformed_plan);
+  return path_profile.getCuspDistance();
 }
 }  // namespace nav2_regulated_pure_pursuit_controller
 
@@ -13,8 +13,10 @@
 // limitations under the License.
 
 #include <math.h>
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 #include <limits>
 
@@ -96,8 +98,10 @@ public:
     const double & curvature, const geometry_msgs::msg::Twist & curr_speed,
     const double & pose_cost, const nav_msgs::msg::Path & path, double & linear_vel, double & sign)
   {
+    nav2_regulated_pure_pursuit_controller::PathProfile path_profile;
+    path_profile.update(path);
     return applyConstraints(
-      curvature, curr_speed, pose_cost, path,
+      curvature, curr_speed, pose_cost, path_profile,
       linear_vel, sign);
   }
 
@@ -206,6 +210,43 @@ TEST(RegulatedPurePursuitTest, findVelocitySignChange)
   EXPECT_EQ(rtn, std::numeric_limits<double>::max());
 }
 
+TEST(RegulatedPurePursuitTest, pathProfile)
+{
+  // Out and back, with a cusp at (2, 1)
+  nav_msgs::msg::Path path;
+  path.poses.resize(6);
+  const std::vector<std::pair<double, double>> positions =
+  {{0.0, 0.0}, {1.0, 0.0}, {2.0, 1.0}, {1.5, 1.0}, {0.5, 1.0}, {0.0, 1.0}};
+  for (unsigned int i = 0; i != path.poses.size(); i++) {
+    path.poses[i].pose.position.x = positions[i].first;
+    path.poses[i].pose.position.y = positions[i].second;
+  }
+
+  nav2_regulated_pure_pursuit_controller::PathProfile profile;
+  profile.update(path);
+  EXPECT_DOUBLE_EQ(profile.getPathLength(), nav2_util::geometry_utils::calculate_path_length(path));
+  EXPECT_DOUBLE_EQ(profile.getCuspDistance(), hypot(2.0, 1.0));
+  EXPECT_DOUBLE_EQ(profile.getGoalDistance(), 1.0);
+
+  // Same pose as the linear search for the first pose far enough, even on the way back
+  for (double dist = 0.0; dist < 3.0; dist += 0.05) {
+    auto it = std::find_if(
+      path.poses.begin(), path.poses.end(), [&](const auto & ps) {
+        return hypot(ps.pose.position.x, ps.pose.position.y) >= dist;
+      });
+    EXPECT_EQ(
+      profile.findFirstPoseBeyond(dist),
+      static_cast<size_t>(std::distance(path.poses.begin(), it)));
+  }
+
+  // Updating reuses the profile
+  path.poses.resize(2);
+  profile.update(path);
+  EXPECT_DOUBLE_EQ(profile.getPathLength(), 1.0);
+  EXPECT_EQ(profile.getCuspDistance(), std::numeric_limits<double>::max());
+  EXPECT_EQ(profile.findFirstPoseBeyond(1.5), 2u);
+}
+
 using CircleSegmentIntersectionParam = std::tuple<
   std::pair<double, double>,
   std::pair<double, double>,
@@ -29,8 +29,8 @@
 #include "nav2_core/controller.hpp"
 #include "nav2_core/controller_exceptions.hpp"
 #include "nav2_util/node_utils.hpp"
-#include "nav2_costmap_2d/footprint_collision_checker.hpp"
 #include "angles/angles.h"
+#include "nav2_rotation_shim_controller/rotation_sweep.hpp"
 
 namespace nav2_rotation_shim_controller
 {
@@ -97,6 +97,13 @@ public:
    */
   void setPlan(const nav_msgs::msg::Path & path) override;
 
+  /**
+   * @brief nav2_core updatePlan - Updates the global plan after a replan which kept its start
+   * @param path The global plan
+   * @param first_changed_index Index of the first pose differing from the previous plan
+   */
+  void updatePlan(const nav_msgs::msg::Path & path, size_t first_changed_index) override;
+
   /**
    * @brief Limits the maximum linear speed of the robot.
    * @param speed_limit expressed in absolute value (in m/s)
@@ -122,6 +129,16 @@ protected:
    */
   geometry_msgs::msg::Pose transformPoseToBaseFrame(const geometry_msgs::msg::PoseStamped & pt);
 
+  /**
+   * @brief Find the location of the sampled path point in base frame, from the robot pose
+   * if they are in the same frame, else using TF
+   * @param pt location of the sampled path point
+   * @param robot_pose Current robot pose
+   * @return location of the pose in base frame
+   */
+  geometry_msgs::msg::Pose transformPoseToBaseFrame(
+    const geometry_msgs::msg::PoseStamped & pt, const geometry_msgs::msg::PoseStamped & robot_pose);
+
   /**
    * @brief Rotates the robot to the rough heading
    * @param angular_distance Angular distance to the goal remaining
@@ -135,7 +152,8 @@ protected:
     const geometry_msgs::msg::Twist & velocity);
 
   /**
-   * @brief Checks if rotation is safe
+   * @brief Checks if rotation is safe, over the area swept until the hand off to the
+   * primary controller, computed once while rotating towards it
    * @param cmd_vel Velocity to check over
    * @param angular_distance_to_heading Angular distance to heading requested
    * @param pose Starting pose of robot
@@ -158,13 +176,14 @@ protected:
   rclcpp::Logger logger_ {rclcpp::get_logger("RotationShimController")};
   rclcpp::Clock::SharedPtr clock_;
   std::shared_ptr<nav2_costmap_2d::Costmap2DROS> costmap_ros_;
-  std::unique_ptr<nav2_costmap_2d::FootprintCollisionChecker<nav2_costmap_2d::Costmap2D *>>
-  collision_checker_;
+  RotationSweep rotation_sweep_;
 
   pluginlib::ClassLoader<nav2_core::Controller> lp_loader_;
   nav2_core::Controller::Ptr primary_controller_;
   bool path_updated_;
   nav_msgs::msg::Path current_path_;
+  // Index of the sampled path point in the current path, 0 until found
+  size_t sampled_pt_index_;
   double forward_sampling_distance_, angular_dist_threshold_;
   double rotate_to_heading_angular_vel_, max_angular_accel_;
   double control_duration_, simulate_ahead_time_;
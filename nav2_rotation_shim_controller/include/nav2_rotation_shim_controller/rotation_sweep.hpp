@@ -0,0 +1,119 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NAV2_ROTATION_SHIM_CONTROLLER__ROTATION_SWEEP_HPP_
+#define NAV2_ROTATION_SHIM_CONTROLLER__ROTATION_SWEEP_HPP_
+
+#include <vector>
+
+#include "geometry_msgs/msg/pose2_d.hpp"
+#include "nav2_costmap_2d/costmap_2d.hpp"
+#include "nav2_costmap_2d/footprint.hpp"
+
+namespace nav2_rotation_shim_controller
+{
+
+/**
+ * @class nav2_rotation_shim_controller::RotationSweep
+ * @brief Costmap cells swept by the footprint outline while rotating in place, each with
+ * the ranges of rotation over which the outline crosses it. A cell may be left and crossed
+ * again, by another edge or once a corner comes back round. Computed once for a rotation,
+ * the costs over any part of it are then found with a single scan of these cells, however
+ * finely the rotation is simulated.
+ */
+class RotationSweep
+{
+public:
+  /**
+   * @brief Constructor for nav2_rotation_shim_controller::RotationSweep
+   */
+  RotationSweep() = default;
+
+  /**
+   * @brief Compute the cells swept by a rotation in place
+   * @param costmap Costmap to sweep
+   * @param pose Pose to start rotating from
+   * @param rotation Signed angle to rotate by
+   * @param footprint Unoriented footprint of the robot
+   */
+  void compute(
+    const nav2_costmap_2d::Costmap2D & costmap, const geometry_msgs::msg::Pose2D & pose,
+    const double & rotation, const nav2_costmap_2d::Footprint & footprint);
+
+  /**
+   * @brief Whether the computed sweep contains a rotation, which may start from further along it
+   * @param costmap Costmap to sweep
+   * @param pose Pose to start rotating from
+   * @param rotation Signed angle to rotate by
+   * @param footprint Unoriented footprint of the robot
+   * @return If the rotation can be checked with this sweep
+   */
+  bool contains(
+    const nav2_costmap_2d::Costmap2D & costmap, const geometry_msgs::msg::Pose2D & pose,
+    const double & rotation, const nav2_costmap_2d::Footprint & footprint) const;
+
+  /**
+   * @brief Get the highest cost swept by a rotation contained in the sweep
+   * @param costmap Costmap to read the costs from
+   * @param pose Pose to start rotating from
+   * @param rotation Signed angle to rotate by
+   * @return Highest cost, LETHAL_OBSTACLE if the footprint leaves the costmap
+   */
+  double cost(
+    const nav2_costmap_2d::Costmap2D & costmap, const geometry_msgs::msg::Pose2D & pose,
+    const double & rotation) const;
+
+  /**
+   * @brief Forget the computed sweep
+   */
+  void reset()
+  {
+    cells_.clear();
+    valid_ = false;
+  }
+
+protected:
+  /**
+   * @brief Get the angle rotated from the start of the sweep to a heading
+   * @param yaw Heading
+   * @return Angle rotated, in the direction of the sweep
+   */
+  double getAngleFromStart(const double & yaw) const;
+
+  /**
+   * @struct nav2_rotation_shim_controller::RotationSweep::Cell
+   * @brief Cell crossed by the footprint outline at every sampled angle from the first to
+   * the last, a cell crossed over several ranges has one per range
+   */
+  struct Cell
+  {
+    unsigned int index;
+    float first_angle;
+    float last_angle;
+  };
+
+  std::vector<Cell> cells_;
+  bool valid_{false};
+  geometry_msgs::msg::Pose2D start_;
+  double direction_{1.0};
+  double angle_{0.0};
+  // Angle from which the footprint leaves the costmap, beyond angle_ if it never does
+  double off_map_angle_{0.0};
+  nav2_costmap_2d::Footprint footprint_;
+  double origin_x_{0.0}, origin_y_{0.0}, resolution_{0.0};
+};
+
+}  // namespace nav2_rotation_shim_controller
+
+#endif  // NAV2_ROTATION_SHIM_CONTROLLER__ROTATION_SWEEP_HPP_
@@ -28,7 +28,8 @@ namespace nav2_rotation_shim_controller
 RotationShimController::RotationShimController()
 : lp_loader_("nav2_core", "nav2_core::Controller"),
   primary_controller_(nullptr),
-  path_updated_(false)
+  path_updated_(false),
+  sampled_pt_index_(0)
 {
 }
 
@@ -86,10 +87,6 @@ void RotationShimController::configure(
   }
 
   primary_controller_->configure(parent, name, tf, costmap_ros);
-
-  // initialize collision checker and set costmap
-  collision_checker_ = std::make_unique<nav2_costmap_2d::
-      FootprintCollisionChecker<nav2_costmap_2d::Costmap2D *>>(costmap_ros->getCostmap());
 }
 
 void RotationShimController::activate()
@@ -142,7 +139,7 @@ geometry_msgs::msg::TwistStamped RotationShimController::computeVelocityCommands
   if (path_updated_) {
     std::lock_guard<std::mutex> lock_reinit(mutex_);
     try {
-      geometry_msgs::msg::Pose sampled_pt_base = transformPoseToBaseFrame(getSampledPathPt());
+      geometry_msgs::msg::Pose sampled_pt_base = transformPoseToBaseFrame(getSampledPathPt(), pose);
 
       double angular_distance_to_heading =
         std::atan2(sampled_pt_base.position.y, sampled_pt_base.position.x);
@@ -178,20 +175,29 @@ geometry_msgs::msg::PoseStamped RotationShimController::getSampledPathPt()
             "Path is too short to find a valid sampled path point for rotation.");
   }
 
-  geometry_msgs::msg::Pose start = current_path_.poses.front().pose;
-  double dx, dy;
-
-  // Find the first point at least sampling distance away
-  for (unsigned int i = 1; i != current_path_.poses.size(); i++) {
-    dx = current_path_.poses[i].pose.position.x - start.position.x;
-    dy = current_path_.poses[i].pose.position.y - start.position.y;
-    if (hypot(dx, dy) >= forward_sampling_distance_) {
-      current_path_.poses[i].header.frame_id = current_path_.header.frame_id;
-      current_path_.poses[i].header.stamp = clock_->now();  // Get current time transformation
-      return current_path_.poses[i];
+  // Only searched once per path, the start of the path not changing while rotating
+  if (sampled_pt_index_ == 0) {
+    geometry_msgs::msg::Pose start = current_path_.poses.front().pose;
+    double dx, dy;
+
+    // Find the first point at least sampling distance away
+    for (unsigned int i = 1; i != current_path_.poses.size(); i++) {
+      dx = current_path_.poses[i].pose.position.x - start.position.x;
+      dy = current_path_.poses[i].pose.position.y - start.position.y;
+      if (hypot(dx, dy) >= forward_sampling_distance_) {
+        sampled_pt_index_ = i;
+        break;
+      }
     }
   }
 
+  if (sampled_pt_index_ != 0) {
+    auto & sampled_pt = current_path_.poses[sampled_pt_index_];
+    sampled_pt.header.frame_id = current_path_.header.frame_id;
+    sampled_pt.header.stamp = clock_->now();  // Get current time transformation
+    return sampled_pt;
+  }
+
   throw nav2_core::ControllerException(
           std::string(
             "Unable to find a sampling point at least %0.2f from the robot,"
@@ -208,6 +214,27 @@ RotationShimController::transformPoseToBaseFrame(const geometry_msgs::msg::PoseS
   return pt_base.pose;
 }
 
+geometry_msgs::msg::Pose
+RotationShimController::transformPoseToBaseFrame(
+  const geometry_msgs::msg::PoseStamped & pt, const geometry_msgs::msg::PoseStamped & robot_pose)
+{
+  if (pt.header.frame_id != robot_pose.header.frame_id) {
+    return transformPoseToBaseFrame(pt);
+  }
+
+  // Already in the frame of the robot pose, no need to look the transform up
+  const double yaw = tf2::getYaw(robot_pose.pose.orientation);
+  const double dx = pt.pose.position.x - robot_pose.pose.position.x;
+  const double dy = pt.pose.position.y - robot_pose.pose.position.y;
+  geometry_msgs::msg::Pose pt_base;
+  pt_base.position.x = dx * cos(yaw) + dy * sin(yaw);
+  pt_base.position.y = -dx * sin(yaw) + dy * cos(yaw);
+  pt_base.position.z = pt.pose.position.z;
+  pt_base.orientation = nav2_util::geometry_utils::orientationAroundZAxis(
+    angles::normalize_angle(tf2::getYaw(pt.pose.orientation) - yaw));
+  return pt_base;
+}
+
 geometry_msgs::msg::TwistStamped
 RotationShimController::computeRotateToHeadingCommand(
   const double & angular_distance_to_heading,
@@ -233,38 +260,41 @@ void RotationShimController::isCollisionFree(
   const double & angular_distance_to_heading,
   const geometry_msgs::msg::PoseStamped & pose)
 {
-  // Simulate rotation ahead by time in control frequency increments
-  double simulated_time = 0.0;
-  double initial_yaw = tf2::getYaw(pose.pose.orientation);
-  double yaw = 0.0;
-  double footprint_cost = 0.0;
-  double remaining_rotation_before_thresh =
+  // Only check the rotation up to the point it would be passed onto the primary controller
+  const double remaining_rotation_before_thresh =
     fabs(angular_distance_to_heading) - angular_dist_threshold_;
+  if (remaining_rotation_before_thresh <= 0.0) {
+    return;
+  }
 
-  while (simulated_time < simulate_ahead_time_) {
-    simulated_time += control_duration_;
-    yaw = initial_yaw + cmd_vel.twist.angular.z * simulated_time;
-
-    // Stop simulating past the point it would be passed onto the primary controller
-    if (angles::shortest_angular_distance(yaw, initial_yaw) >= remaining_rotation_before_thresh) {
-      break;
-    }
+  geometry_msgs::msg::Pose2D start;
+  start.x = pose.pose.position.x;
+  start.y = pose.pose.position.y;
+  start.theta = tf2::getYaw(pose.pose.orientation);
+  const double direction = cmd_vel.twist.angular.z >= 0.0 ? 1.0 : -1.0;
+  const double rotation = direction * std::min(
+    fabs(cmd_vel.twist.angular.z) * simulate_ahead_time_, remaining_rotation_before_thresh);
+
+  // The area swept up to the hand off is computed once, and reused while rotating towards it
+  const nav2_costmap_2d::Costmap2D & costmap = *costmap_ros_->getCostmap();
+  const nav2_costmap_2d::Footprint & footprint = costmap_ros_->getRobotFootprint();
+  if (!rotation_sweep_.contains(costmap, start, rotation, footprint)) {
+    rotation_sweep_.compute(
+      costmap, start, direction * remaining_rotation_before_thresh, footprint);
+  }
 
-    using namespace nav2_costmap_2d;  // NOLINT
-    footprint_cost = collision_checker_->footprintCostAtPose(
-      pose.pose.position.x, pose.pose.position.y,
-      yaw, costmap_ros_->getRobotFootprint());
+  using namespace nav2_costmap_2d;  // NOLINT
+  const double footprint_cost = rotation_sweep_.cost(costmap, start, rotation);
 
-    if (footprint_cost == static_cast<double>(NO_INFORMATION) &&
-      costmap_ros_->getLayeredCostmap()->isTrackingUnknown())
-    {
-      throw nav2_core::NoValidControl(
-              "RotationShimController detected a potential collision ahead!");
-    }
+  if (footprint_cost == static_cast<double>(NO_INFORMATION) &&
+    costmap_ros_->getLayeredCostmap()->isTrackingUnknown())
+  {
+    throw nav2_core::NoValidControl(
+            "RotationShimController detected a potential collision ahead!");
+  }
 
-    if (footprint_cost >= static_cast<double>(LETHAL_OBSTACLE)) {
-      throw nav2_core::NoValidControl("RotationShimController detected collision ahead!");
-    }
+  if (footprint_cost >= static_cast<double>(LETHAL_OBSTACLE)) {
+    throw nav2_core::NoValidControl("RotationShimController detected collision ahead!");
   }
 }
 
@@ -272,9 +302,25 @@ void RotationShimController::setPlan(const nav_msgs::msg::Path & path)
 {
   path_updated_ = true;
   current_path_ = path;
+  sampled_pt_index_ = 0;
+  rotation_sweep_.reset();
   primary_controller_->setPlan(path);
 }
 
+void RotationShimController::updatePlan(
+  const nav_msgs::msg::Path & path, size_t first_changed_index)
+{
+  // A change past the sampled point keeps the heading, so tracking is not interrupted.
+  // Otherwise the heading may have moved, so check it again as for a new path.
+  current_path_ = path;
+  if (first_changed_index <= sampled_pt_index_) {
+    path_updated_ = true;
+    sampled_pt_index_ = 0;
+    rotation_sweep_.reset();
+  }
+  primary_controller_->updatePlan(path, first_changed_index);
+}
+
 void RotationShimController::setSpeedLimit(const double & speed_limit, const bool & percentage)
 {
   primary_controller_->setSpeedLimit(speed_limit, percentage);
@@ -295,6 +341,7 @@ RotationShimController::dynamicParametersCallback(std::vector<rclcpp::Parameter>
         angular_dist_threshold_ = parameter.as_double();
       } else if (name == plugin_name_ + ".forward_sampling_distance") {
         forward_sampling_distance_ = parameter.as_double();
+        sampled_pt_index_ = 0;
       } else if (name == plugin_name_ + ".rotate_to_heading_angular_vel") {
         rotate_to_heading_angular_vel_ = parameter.as_double();
       } else if (name == plugin_name_ + ".max_angular_accel") {
@@ -0,0 +1,156 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "angles/angles.h"
+#include "nav2_costmap_2d/cost_values.hpp"
+#include "nav2_util/line_iterator.hpp"
+#include "nav2_rotation_shim_controller/rotation_sweep.hpp"
+
+namespace nav2_rotation_shim_controller
+{
+
+void RotationSweep::compute(
+  const nav2_costmap_2d::Costmap2D & costmap, const geometry_msgs::msg::Pose2D & pose,
+  const double & rotation, const nav2_costmap_2d::Footprint & footprint)
+{
+  cells_.clear();
+  valid_ = true;
+  start_ = pose;
+  direction_ = rotation >= 0.0 ? 1.0 : -1.0;
+  angle_ = std::fabs(rotation);
+  off_map_angle_ = angle_ + 1.0;
+  footprint_ = footprint;
+  origin_x_ = costmap.getOriginX();
+  origin_y_ = costmap.getOriginY();
+  resolution_ = costmap.getResolution();
+
+  if (footprint.empty()) {
+    return;
+  }
+
+  // Sample the rotation finely enough for the farthest vertex to move by half a cell at most
+  double max_radius = 0.0;
+  for (const auto & point : footprint) {
+    max_radius = std::max(max_radius, std::hypot(point.x, point.y));
+  }
+  unsigned int num_steps = 1;
+  if (max_radius > 0.0) {
+    num_steps = std::max(
+      1u, static_cast<unsigned int>(std::ceil(angle_ * 2.0 * max_radius / resolution_)));
+  }
+
+  // Cell index to its latest interval, and the step it was last crossed at
+  std::unordered_map<unsigned int, std::pair<size_t, unsigned int>> intervals;
+  std::vector<int> xs(footprint.size()), ys(footprint.size());
+  for (unsigned int step = 0; step <= num_steps; ++step) {
+    const double angle = angle_ * step / num_steps;
+    const double yaw = start_.theta + direction_ * angle;
+    const double cos_th = std::cos(yaw);
+    const double sin_th = std::sin(yaw);
+
+    bool on_map = true;
+    for (size_t i = 0; i < footprint.size() && on_map; ++i) {
+      unsigned int mx, my;
+      on_map = costmap.worldToMap(
+        start_.x + (footprint[i].x * cos_th - footprint[i].y * sin_th),
+        start_.y + (footprint[i].x * sin_th + footprint[i].y * cos_th), mx, my);
+      xs[i] = static_cast<int>(mx);
+      ys[i] = static_cast<int>(my);
+    }
+    if (!on_map) {
+      // The outline can't be checked from here on
+      off_map_angle_ = angle;
+      return;
+    }
+
+    // Rasterize the outline, as FootprintCollisionChecker::footprintCost does
+    for (size_t i = 0; i < footprint.size(); ++i) {
+      const size_t j = (i + 1) % footprint.size();
+      for (nav2_util::LineIterator line(xs[i], ys[i], xs[j], ys[j]); line.isValid();
+        line.advance())
+      {
+        const unsigned int index = costmap.getIndex(line.getX(), line.getY());
+        auto inserted = intervals.emplace(index, std::make_pair(cells_.size(), step));
+        auto & interval = inserted.first->second;
+        if (!inserted.second && interval.second + 1 >= step) {
+          // Still crossed since the previous step
+          cells_[interval.first].last_angle = static_cast<float>(angle);
+          interval.second = step;
+          continue;
+        }
+
+        // First crossed, or crossed again after the outline left it
+        interval = std::make_pair(cells_.size(), step);
+        cells_.push_back(Cell{index, static_cast<float>(angle), static_cast<float>(angle)});
+      }
+    }
+  }
+}
+
+bool RotationSweep::contains(
+  const nav2_costmap_2d::Costmap2D & costmap, const geometry_msgs::msg::Pose2D & pose,
+  const double & rotation, const nav2_costmap_2d::Footprint & footprint) const
+{
+  if (!valid_ || (rotation >= 0.0 ? 1.0 : -1.0) != direction_ ||
+    costmap.getOriginX() != origin_x_ || costmap.getOriginY() != origin_y_ ||
+    costmap.getResolution() != resolution_ || footprint != footprint_)
+  {
+    return false;
+  }
+
+  // Rotating in place drifts a little, within a quarter cell the outline is close enough
+  if (std::hypot(pose.x - start_.x, pose.y - start_.y) > 0.25 * resolution_) {
+    return false;
+  }
+
+  // Small tolerance as the cells store their angles in single precision
+  constexpr double tolerance = 1e-4;
+  const double start = getAngleFromStart(pose.theta);
+  return start >= -tolerance && start + std::fabs(rotation) <= angle_ + tolerance;
+}
+
+double RotationSweep::cost(
+  const nav2_costmap_2d::Costmap2D & costmap, const geometry_msgs::msg::Pose2D & pose,
+  const double & rotation) const
+{
+  const double start = getAngleFromStart(pose.theta);
+  const double end = start + std::fabs(rotation);
+  if (off_map_angle_ <= end) {
+    return static_cast<double>(nav2_costmap_2d::LETHAL_OBSTACLE);
+  }
+
+  // Same tolerance as contains(), for the angles stored in single precision
+  constexpr double tolerance = 1e-4;
+  unsigned char max_cost = nav2_costmap_2d::FREE_SPACE;
+  for (const Cell & cell : cells_) {
+    // Crossed by the outline within the rotation, as a check at each heading would find
+    if (cell.last_angle >= start - tolerance && cell.first_angle <= end + tolerance) {
+      max_cost = std::max(max_cost, costmap.getCost(cell.index));
+    }
+  }
+  return static_cast<double>(max_cost);
+}
+
+double RotationSweep::getAngleFromStart(const double & yaw) const
+{
+  return direction_ * angles::shortest_angular_distance(start_.theta, yaw);
+}
+
+}  // namespace nav2_rotation_shim_controller
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <math.h>
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -21,6 +22,8 @@
 #include "gtest/gtest.h"
 #include "rclcpp/rclcpp.hpp"
 #include "nav2_costmap_2d/costmap_2d.hpp"
+#include "nav2_costmap_2d/cost_values.hpp"
+#include "nav2_costmap_2d/footprint_collision_checker.hpp"
 #include "nav2_util/lifecycle_node.hpp"
 #include "nav2_controller/plugins/simple_goal_checker.hpp"
 #include "nav2_rotation_shim_controller/nav2_rotation_shim_controller.hpp"
@@ -57,6 +60,11 @@ public:
     return path_updated_;
   }
 
+  void clearPathUpdated()
+  {
+    path_updated_ = false;
+  }
+
   geometry_msgs::msg::PoseStamped getSampledPathPtWrapper()
   {
     return getSampledPathPt();
@@ -165,6 +173,58 @@ TEST(RotationShimControllerTest, setPlanAndSampledPointsTests)
   EXPECT_THROW(controller->getSampledPathPtWrapper(), std::runtime_error);
 }
 
+TEST(RotationShimControllerTest, updatePlanTests)
+{
+  auto node = std::make_shared<rclcpp_lifecycle::LifecycleNode>("ShimControllerTest");
+  std::string name = "PathFollower";
+  auto tf = std::make_shared<tf2_ros::Buffer>(node->get_clock());
+  auto costmap = std::make_shared<nav2_costmap_2d::Costmap2DROS>("fake_costmap");
+  rclcpp_lifecycle::State state;
+  costmap->on_configure(state);
+
+  node->declare_parameter(
+    "PathFollower.primary_controller",
+    std::string("nav2_regulated_pure_pursuit_controller::RegulatedPurePursuitController"));
+
+  auto controller = std::make_shared<RotationShimShim>();
+  controller->configure(node, name, tf, costmap);
+  controller->activate();
+
+  nav_msgs::msg::Path path;
+  path.header.frame_id = "fake_frame";
+  path.poses.resize(10);
+  for (unsigned int i = 0; i != path.poses.size(); i++) {
+    path.poses[i].pose.position.x = 0.3 * i;
+  }
+  controller->setPlan(path);
+  auto pose = controller->getSampledPathPtWrapper();
+  EXPECT_NEAR(pose.pose.position.x, 0.6, 1e-6);  // default forward sampling is 0.5
+  controller->clearPathUpdated();
+
+  // A change past the sampled point keeps tracking with the primary controller
+  nav_msgs::msg::Path updated = path;
+  for (unsigned int i = 5; i != updated.poses.size(); i++) {
+    updated.poses[i].pose.position.y = 1.0;
+  }
+  controller->updatePlan(updated, 5);
+  EXPECT_FALSE(controller->isPathUpdated());
+  EXPECT_NEAR(controller->getPath().poses[5].pose.position.y, 1.0, 1e-6);
+  pose = controller->getSampledPathPtWrapper();
+  EXPECT_NEAR(pose.pose.position.x, 0.6, 1e-6);
+  EXPECT_NEAR(pose.pose.position.y, 0.0, 1e-6);
+
+  // A change reaching the sampled point may turn the heading, so it is checked again
+  for (unsigned int i = 1; i != updated.poses.size(); i++) {
+    updated.poses[i].pose.position.x = 0.0;
+    updated.poses[i].pose.position.y = -0.3 * i;
+  }
+  controller->updatePlan(updated, 1);
+  EXPECT_TRUE(controller->isPathUpdated());
+  pose = controller->getSampledPathPtWrapper();
+  EXPECT_NEAR(pose.pose.position.x, 0.0, 1e-6);
+  EXPECT_NEAR(pose.pose.position.y, -0.6, 1e-6);
+}
+
 TEST(RotationShimControllerTest, rotationAndTransformTests)
 {
   auto ctrl = std::make_shared<RotationShimShim>();
@@ -350,3 +410,106 @@ TEST(RotationShimControllerTest, testDynamicParameter)
   EXPECT_EQ(node->get_parameter("test.max_angular_accel").as_double(), 7.0);
   EXPECT_EQ(node->get_parameter("test.simulate_ahead_time").as_double(), 7.0);
 }
+
+TEST(RotationShimControllerTest, rotationSweep)
+{
+  nav2_costmap_2d::Costmap2D costmap(100, 100, 0.05, 0.0, 0.0, 0);
+  nav2_costmap_2d::FootprintCollisionChecker<nav2_costmap_2d::Costmap2D *> checker(&costmap);
+
+  // 0.8 x 0.4 rectangle, rotating from heading along x
+  nav2_costmap_2d::Footprint footprint(4);
+  footprint[0].x = 0.4;
+  footprint[0].y = 0.2;
+  footprint[1].x = -0.4;
+  footprint[1].y = 0.2;
+  footprint[2].x = -0.4;
+  footprint[2].y = -0.2;
+  footprint[3].x = 0.4;
+  footprint[3].y = -0.2;
+  geometry_msgs::msg::Pose2D start;
+  start.x = 2.5;
+  start.y = 2.5;
+
+  nav2_rotation_shim_controller::RotationSweep sweep;
+  EXPECT_FALSE(sweep.contains(costmap, start, 1.5, footprint));
+  sweep.compute(costmap, start, 1.5, footprint);
+  EXPECT_TRUE(sweep.contains(costmap, start, 1.5, footprint));
+  EXPECT_FALSE(sweep.contains(costmap, start, 1.6, footprint));
+  EXPECT_FALSE(sweep.contains(costmap, start, -0.5, footprint));
+
+  // Further along the rotation, with a little drift
+  geometry_msgs::msg::Pose2D pose = start;
+  pose.x += 0.01;
+  pose.theta = 1.0;
+  EXPECT_TRUE(sweep.contains(costmap, pose, 0.5, footprint));
+  EXPECT_FALSE(sweep.contains(costmap, pose, 0.6, footprint));
+  pose.x += 0.1;
+  EXPECT_FALSE(sweep.contains(costmap, pose, 0.5, footprint));
+
+  // An obstacle above the robot is only reached once rotated enough
+  costmap.setCost(50, 57, nav2_costmap_2d::LETHAL_OBSTACLE);
+  EXPECT_EQ(sweep.cost(costmap, start, 0.3), 0.0);
+  EXPECT_EQ(sweep.cost(costmap, start, 1.5), nav2_costmap_2d::LETHAL_OBSTACLE);
+  pose = start;
+  pose.theta = 1.0;
+  EXPECT_EQ(sweep.cost(costmap, pose, 0.5), nav2_costmap_2d::LETHAL_OBSTACLE);
+
+  // At least the cost of the footprint at any heading sampled within the rotation
+  costmap.setCost(50, 57, nav2_costmap_2d::FREE_SPACE);
+  costmap.setCost(58, 53, 100);
+  costmap.setCost(44, 52, 200);
+  for (double rotation = 0.1; rotation <= 1.5; rotation += 0.1) {
+    double max_cost = 0.0;
+    for (double yaw = 0.0; yaw <= rotation; yaw += 0.01) {
+      max_cost = std::max(
+        max_cost, checker.footprintCostAtPose(start.x, start.y, yaw, footprint));
+    }
+    EXPECT_GE(sweep.cost(costmap, start, rotation), max_cost);
+  }
+
+  // Leaving the costmap is a collision
+  start.x = 0.3;
+  sweep.compute(costmap, start, 1.5, footprint);
+  EXPECT_EQ(sweep.cost(costmap, start, 0.1), nav2_costmap_2d::LETHAL_OBSTACLE);
+}
+
+TEST(RotationShimControllerTest, rotationSweepCornerComingBack)
+{
+  nav2_costmap_2d::Costmap2D costmap(100, 100, 0.05, 0.0, 0.0, 0);
+  nav2_costmap_2d::FootprintCollisionChecker<nav2_costmap_2d::Costmap2D *> checker(&costmap);
+
+  // 0.8 x 0.4 rectangle, turning half a revolution
+  nav2_costmap_2d::Footprint footprint(4);
+  footprint[0].x = 0.4;
+  footprint[0].y = 0.2;
+  footprint[1].x = -0.4;
+  footprint[1].y = 0.2;
+  footprint[2].x = -0.4;
+  footprint[2].y = -0.2;
+  footprint[3].x = 0.4;
+  footprint[3].y = -0.2;
+  geometry_msgs::msg::Pose2D start;
+  start.x = 2.51;
+  start.y = 2.51;
+  nav2_rotation_shim_controller::RotationSweep sweep;
+  sweep.compute(costmap, start, 3.13, footprint);
+
+  // Under the front left corner, which leaves it and comes back with the opposite corner
+  costmap.setCost(58, 54, nav2_costmap_2d::LETHAL_OBSTACLE);
+  EXPECT_EQ(sweep.cost(costmap, start, 0.1), nav2_costmap_2d::LETHAL_OBSTACLE);
+  geometry_msgs::msg::Pose2D pose = start;
+  pose.theta = 3.0;
+  EXPECT_EQ(sweep.cost(costmap, pose, 0.13), nav2_costmap_2d::LETHAL_OBSTACLE);
+
+  // The same as checking the footprint at each heading in between
+  for (double yaw = 1.2; yaw <= 2.9; yaw += 0.1) {
+    pose.theta = yaw;
+    double max_cost = 0.0;
+    for (double angle = yaw; angle <= 2.9; angle += 0.01) {
+      max_cost = std::max(
+        max_cost, checker.footprintCostAtPose(start.x, start.y, angle, footprint));
+    }
+    EXPECT_EQ(max_cost, 0.0);
+    EXPECT_EQ(sweep.cost(costmap, pose, 2.9 - yaw), max_cost);
+  }
+}
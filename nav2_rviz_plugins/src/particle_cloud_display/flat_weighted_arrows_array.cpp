@@ -72,6 +72,7 @@ void FlatWeightedArrowsArray::createAndAttachManualObject(Ogre::SceneNode * scen
   manual_object_ = scene_manager_->createManualObject();
   manual_object_->setDynamic(true);
   scene_node->attachObject(manual_object_);
+  setManualObjectMaterial();
 }
 
 void FlatWeightedArrowsArray::updateManualObject(
@@ -81,14 +82,17 @@ void FlatWeightedArrowsArray::updateManualObject(
   float max_length,
   const std::vector<nav2_rviz_plugins::OgrePoseWithWeight> & poses)
 {
-  clear();
-
   color.a = alpha;
-  setManualObjectMaterial();
   rviz_rendering::MaterialManager::enableAlphaBlending(material_, alpha);
 
-  manual_object_->begin(
-    material_->getName(), Ogre::RenderOperation::OT_LINE_LIST, "rviz_rendering");
+  // Rewrite the existing section in place when possible, so the dynamic hardware
+  // buffers are reused instead of being reallocated on every message
+  if (manual_object_->getNumSections() > 0) {
+    manual_object_->beginUpdate(0);
+  } else {
+    manual_object_->begin(
+      material_->getName(), Ogre::RenderOperation::OT_LINE_LIST, "rviz_rendering");
+  }
   setManualObjectVertices(color, min_length, max_length, poses);
   manual_object_->end();
 }
@@ -34,6 +34,7 @@
 #include "nav2_smac_planner/node_hybrid.hpp"
 #include "nav2_smac_planner/node_lattice.hpp"
 #include "nav2_smac_planner/node_basic.hpp"
+#include "nav2_smac_planner/open_list.hpp"
 #include "nav2_smac_planner/types.hpp"
 #include "nav2_smac_planner/constants.hpp"
 
@@ -51,25 +52,13 @@ public:
   typedef NodeT * NodePtr;
   typedef robin_hood::unordered_node_map<unsigned int, NodeT> Graph;
   typedef std::vector<NodePtr> NodeVector;
-  typedef std::pair<float, NodeBasic<NodeT>> NodeElement;
   typedef typename NodeT::Coordinates Coordinates;
   typedef typename NodeT::CoordinateVector CoordinateVector;
+  typedef typename NodeT::SearchContext SearchContext;
   typedef typename NodeVector::iterator NeighborIterator;
   typedef std::function<bool (const unsigned int &, NodeT * &)> NodeGetter;
 
-  /**
-   * @struct nav2_smac_planner::NodeComparator
-   * @brief Node comparison for priority queue sorting
-   */
-  struct NodeComparator
-  {
-    bool operator()(const NodeElement & a, const NodeElement & b) const
-    {
-      return a.first > b.first;
-    }
-  };
-
-  typedef std::priority_queue<NodeElement, std::vector<NodeElement>, NodeComparator> NodeQueue;
+  typedef OpenList<NodeBasic<NodeT>> NodeQueue;
 
   /**
    * @brief A constructor for nav2_smac_planner::PlannerServer
@@ -188,6 +177,13 @@ public:
    */
   unsigned int & getSizeDim3();
 
+  /**
+   * @brief Get the search context of this planner, e.g. its motion table and
+   * heuristic lookup tables, which are not shared with other planner instances
+   * @return Reference to the search context
+   */
+  SearchContext & getSearchContext();
+
 protected:
   /**
    * @brief Get pointer to next goal in open set
@@ -272,6 +268,7 @@ protected:
 
   GridCollisionChecker * _collision_checker;
   nav2_costmap_2d::Costmap2D * _costmap;
+  SearchContext _context;
   std::unique_ptr<AnalyticExpansion<NodeT>> _expander;
 };
 
@@ -35,6 +35,7 @@ class AnalyticExpansion
 public:
   typedef NodeT * NodePtr;
   typedef typename NodeT::Coordinates Coordinates;
+  typedef typename NodeT::SearchContext SearchContext;
   typedef std::function<bool (const unsigned int &, NodeT * &)> NodeGetter;
 
   /**
@@ -62,12 +63,14 @@ public:
 
   /**
    * @brief Constructor for analytic expansion object
+   * @param context Search context of the planner, which must outlive this object
    */
   AnalyticExpansion(
     const MotionModel & motion_model,
     const SearchInfo & search_info,
     const bool & traverse_unknown,
-    const unsigned int & dim_3_size);
+    const unsigned int & dim_3_size,
+    SearchContext * context);
 
   /**
    * @brief Sets the collision checker and costmap to use in expansion validation
@@ -125,6 +128,7 @@ protected:
   bool _traverse_unknown;
   unsigned int _dim_3_size;
   GridCollisionChecker * _collision_checker;
+  SearchContext * _context;
   std::list<std::unique_ptr<NodeT>> _detached_nodes;
 };
 
@@ -59,6 +59,41 @@ inline MotionModel fromString(const std::string & n)
   }
 }
 
+enum class OpenListType
+{
+  UNKNOWN = 0,
+  BINARY_HEAP = 1,
+  QUATERNARY_HEAP = 2,
+  BUCKET = 3,
+};
+
+inline std::string toString(const OpenListType & n)
+{
+  switch (n) {
+    case OpenListType::BINARY_HEAP:
+      return "Binary Heap";
+    case OpenListType::QUATERNARY_HEAP:
+      return "Quaternary Heap";
+    case OpenListType::BUCKET:
+      return "Bucket";
+    default:
+      return "Unknown";
+  }
+}
+
+inline OpenListType openListFromString(const std::string & n)
+{
+  if (n == "BINARY_HEAP") {
+    return OpenListType::BINARY_HEAP;
+  } else if (n == "QUATERNARY_HEAP") {
+    return OpenListType::QUATERNARY_HEAP;
+  } else if (n == "BUCKET") {
+    return OpenListType::BUCKET;
+  } else {
+    return OpenListType::UNKNOWN;
+  }
+}
+
 const float UNKNOWN = 255.0;
 const float OCCUPIED = 254.0;
 const float INSCRIBED = 253.0;
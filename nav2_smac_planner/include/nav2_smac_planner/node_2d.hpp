@@ -32,6 +32,17 @@
 namespace nav2_smac_planner
 {
 
+/**
+ * @struct nav2_smac_planner::Node2DSearchContext
+ * @brief State shared by the 2D nodes of a single planner's search,
+ * so that several planners can search concurrently in one process
+ */
+struct Node2DSearchContext
+{
+  float cost_travel_multiplier{2.0f};
+  std::vector<int> neighbors_grid_offsets;
+};
+
 /**
  * @class nav2_smac_planner::Node2D
  * @brief Node2D implementation for graph
@@ -42,6 +53,7 @@ public:
   typedef Node2D * NodePtr;
   typedef std::unique_ptr<std::vector<Node2D>> Graph;
   typedef std::vector<NodePtr> NodeVector;
+  typedef Node2DSearchContext SearchContext;
 
   /**
    * @class nav2_smac_planner::Node2D::Coordinates
@@ -165,18 +177,23 @@ public:
 
   /**
    * @brief Check if this node is valid
+   * @param context Search context of the planner
    * @param traverse_unknown If we can explore unknown nodes on the graph
    * @param collision_checker Pointer to collision checker object
    * @return whether this node is valid and collision free
    */
-  bool isNodeValid(const bool & traverse_unknown, GridCollisionChecker * collision_checker);
+  bool isNodeValid(
+    const SearchContext & context,
+    const bool & traverse_unknown,
+    GridCollisionChecker * collision_checker);
 
   /**
    * @brief get traversal cost from this node to child node
+   * @param context Search context of the planner
    * @param child Node pointer to this node's child
    * @return traversal cost
    */
-  float getTraversalCost(const NodePtr & child);
+  float getTraversalCost(const SearchContext & context, const NodePtr & child);
 
   /**
    * @brief Get index
@@ -210,23 +227,26 @@ public:
 
   /**
    * @brief Get index
+   * @param context Search context of the planner
    * @param Index Index of point
    * @return coordinates of point
    */
-  static inline Coordinates getCoords(const unsigned int & index)
+  static inline Coordinates getCoords(const SearchContext & context, const unsigned int & index)
   {
-    const unsigned int & size_x = _neighbors_grid_offsets[3];
+    const unsigned int & size_x = context.neighbors_grid_offsets[3];
     return Coordinates(index % size_x, index / size_x);
   }
 
   /**
    * @brief Get cost of heuristic of node
+   * @param context Search context of the planner
    * @param node Node index current
    * @param node Node index of new
    * @param costmap Costmap ptr to use
    * @return Heuristic cost between the nodes
    */
   static float getHeuristicCost(
+    SearchContext & context,
     const Coordinates & node_coords,
     const Coordinates & goal_coordinates,
     const nav2_costmap_2d::Costmap2D * costmap);
@@ -234,6 +254,7 @@ public:
   /**
    * @brief Initialize the neighborhood to be used in A*
    * We support 4-connect (VON_NEUMANN) and 8-connect (MOORE)
+   * @param context Search context of the planner to initialize
    * @param neighborhood The desired neighborhood type
    * @param x_size_uint The total x size to find neighbors
    * @param y_size The total y size to find neighbors
@@ -241,6 +262,7 @@ public:
    * @param search_info Search parameters, unused by 2D node
    */
   static void initMotionModel(
+    SearchContext & context,
     const MotionModel & motion_model,
     unsigned int & size_x,
     unsigned int & size_y,
@@ -249,12 +271,14 @@ public:
 
   /**
    * @brief Retrieve all valid neighbors of a node.
+   * @param context Search context of the planner
    * @param validity_checker Functor for state validity checking
    * @param collision_checker Collision checker to use
    * @param traverse_unknown If unknown costs are valid to traverse
    * @param neighbors Vector of neighbors to be filled
    */
   void getNeighbors(
+    const SearchContext & context,
     std::function<bool(const unsigned int &, nav2_smac_planner::Node2D * &)> & validity_checker,
     GridCollisionChecker * collision_checker,
     const bool & traverse_unknown,
@@ -262,14 +286,13 @@ public:
 
   /**
    * @brief Set the starting pose for planning, as a node index
+   * @param context Search context of the planner
    * @param path Reference to a vector of indicies of generated path
    * @return whether the path was able to be backtraced
    */
-  bool backtracePath(CoordinateVector & path);
+  bool backtracePath(const SearchContext & context, CoordinateVector & path);
 
   Node2D * parent;
-  static float cost_travel_multiplier;
-  static std::vector<int> _neighbors_grid_offsets;
 
 private:
   float _cell_cost;
@@ -94,36 +94,36 @@ struct HybridMotionTable
    * @param node Ptr to NodeHybrid
    * @return A set of motion poses
    */
-  MotionPoses getProjections(const NodeHybrid * node);
+  MotionPoses getProjections(const NodeHybrid * node) const;
 
   /**
    * @brief Get the angular bin to use from a raw orientation
    * @param theta Angle in radians
    * @return bin index of closest angle to request
    */
-  unsigned int getClosestAngularBin(const double & theta);
+  unsigned int getClosestAngularBin(const double & theta) const;
 
   /**
    * @brief Get the raw orientation from an angular bin
    * @param bin_idx Index of the bin
    * @return Raw orientation in radians
    */
-  float getAngleFromBin(const unsigned int & bin_idx);
+  float getAngleFromBin(const unsigned int & bin_idx) const;
 
   MotionModel motion_model = MotionModel::UNKNOWN;
   MotionPoses projections;
-  unsigned int size_x;
-  unsigned int num_angle_quantization;
-  float num_angle_quantization_float;
-  float min_turning_radius;
-  float bin_size;
-  float change_penalty;
-  float non_straight_penalty;
-  float cost_penalty;
-  float reverse_penalty;
-  float travel_distance_reward;
-  bool downsample_obstacle_heuristic;
-  bool use_quadratic_cost_penalty;
+  unsigned int size_x{0};
+  unsigned int num_angle_quantization{0};
+  float num_angle_quantization_float{0.0f};
+  float min_turning_radius{0.0f};
+  float bin_size{0.0f};
+  float change_penalty{0.0f};
+  float non_straight_penalty{0.0f};
+  float cost_penalty{0.0f};
+  float reverse_penalty{0.0f};
+  float travel_distance_reward{0.0f};
+  bool downsample_obstacle_heuristic{false};
+  bool use_quadratic_cost_penalty{false};
   ompl::base::StateSpacePtr state_space;
   std::vector<std::vector<double>> delta_xs;
   std::vector<std::vector<double>> delta_ys;
@@ -131,6 +131,35 @@ struct HybridMotionTable
   std::vector<float> travel_costs;
 };
 
+/**
+ * @struct nav2_smac_planner::ObstacleHeuristicContext
+ * @brief Wavefront of the obstacle heuristic, expanded only as far as a search requires
+ */
+struct ObstacleHeuristicContext
+{
+  LookupTable lookup_table;
+  ObstacleHeuristicQueue queue;
+  nav2_costmap_2d::Costmap2D * sampled_costmap{nullptr};
+  CostmapDownsampler downsampler;
+  bool downsample{false};
+  bool use_quadratic_cost_penalty{false};
+};
+
+/**
+ * @struct nav2_smac_planner::HybridSearchContext
+ * @brief State shared by the Hybrid-A* nodes of a single planner's search,
+ * so that several planners can search concurrently in one process
+ */
+struct HybridSearchContext
+{
+  HybridMotionTable motion_table;
+  double travel_distance_cost{std::sqrt(2.0)};
+  ObstacleHeuristicContext obstacle_heuristic;
+  // Dubin / Reeds-Shepp lookup and size for dereferencing
+  LookupTable dist_heuristic_lookup_table;
+  float size_lookup{25.0f};
+};
+
 /**
  * @class nav2_smac_planner::NodeHybrid
  * @brief NodeHybrid implementation for graph, Hybrid-A*
@@ -141,6 +170,7 @@ public:
   typedef NodeHybrid * NodePtr;
   typedef std::unique_ptr<std::vector<NodeHybrid>> Graph;
   typedef std::vector<NodePtr> NodeVector;
+  typedef HybridSearchContext SearchContext;
 
   /**
    * @class nav2_smac_planner::NodeHybrid::Coordinates
@@ -296,17 +326,22 @@ public:
 
   /**
    * @brief Check if this node is valid
+   * @param context Search context of the planner
    * @param traverse_unknown If we can explore unknown nodes on the graph
    * @return whether this node is valid and collision free
    */
-  bool isNodeValid(const bool & traverse_unknown, GridCollisionChecker * collision_checker);
+  bool isNodeValid(
+    const SearchContext & context,
+    const bool & traverse_unknown,
+    GridCollisionChecker * collision_checker);
 
   /**
    * @brief Get traversal cost of parent node to child node
+   * @param context Search context of the planner
    * @param child Node pointer to child
    * @return traversal cost
    */
-  float getTraversalCost(const NodePtr & child);
+  float getTraversalCost(const SearchContext & context, const NodePtr & child);
 
   /**
    * @brief Get index at coordinates
@@ -326,17 +361,19 @@ public:
 
   /**
    * @brief Get index at coordinates
+   * @param context Search context of the planner
    * @param x X coordinate of point
    * @param y Y coordinate of point
    * @param angle Theta coordinate of point
    * @return Index
    */
   static inline unsigned int getIndex(
+    const SearchContext & context,
     const unsigned int & x, const unsigned int & y, const unsigned int & angle)
   {
     return getIndex(
-      x, y, angle, motion_table.size_x,
-      motion_table.num_angle_quantization);
+      x, y, angle, context.motion_table.size_x,
+      context.motion_table.num_angle_quantization);
   }
 
   /**
@@ -358,18 +395,21 @@ public:
 
   /**
    * @brief Get cost of heuristic of node
+   * @param context Search context of the planner
    * @param node Node index current
    * @param node Node index of new
    * @param costmap Costmap ptr to use
    * @return Heuristic cost between the nodes
    */
   static float getHeuristicCost(
+    SearchContext & context,
     const Coordinates & node_coords,
     const Coordinates & goal_coordinates,
     const nav2_costmap_2d::Costmap2D * costmap);
 
   /**
    * @brief Initialize motion models
+   * @param context Search context of the planner to initialize
    * @param motion_model Motion model enum to use
    * @param size_x Size of X of graph
    * @param size_y Size of y of graph
@@ -377,6 +417,7 @@ public:
    * @param search_info Search info to use
    */
   static void initMotionModel(
+    SearchContext & context,
     const MotionModel & motion_model,
     unsigned int & size_x,
     unsigned int & size_y,
@@ -385,6 +426,7 @@ public:
 
   /**
    * @brief Compute the SE2 distance heuristic
+   * @param context Search context of the planner to populate
    * @param lookup_table_dim Size, in costmap pixels, of the
    * each lookup table dimension to populate
    * @param motion_model Motion model to use for state space
@@ -392,6 +434,7 @@ public:
    * @param search_info Info containing minimum radius to use
    */
   static void precomputeDistanceHeuristic(
+    SearchContext & context,
     const float & lookup_table_dim,
     const MotionModel & motion_model,
     const unsigned int & dim_3_size,
@@ -399,17 +442,20 @@ public:
 
   /**
    * @brief Compute the Obstacle heuristic
+   * @param context Obstacle heuristic wavefront of the planner
    * @param node_coords Coordinates to get heuristic at
    * @param goal_coords Coordinates to compute heuristic to
    * @return heuristic Heuristic value
    */
   static float getObstacleHeuristic(
+    ObstacleHeuristicContext & context,
     const Coordinates & node_coords,
     const Coordinates & goal_coords,
     const double & cost_penalty);
 
   /**
    * @brief Compute the Distance heuristic
+   * @param context Search context of the planner
    * @param node_coords Coordinates to get heuristic at
    * @param goal_coords Coordinates to compute heuristic to
    * @param obstacle_heuristic Value of the obstacle heuristic to compute
@@ -417,28 +463,33 @@ public:
    * @return heuristic Heuristic value
    */
   static float getDistanceHeuristic(
+    const SearchContext & context,
     const Coordinates & node_coords,
     const Coordinates & goal_coords,
     const float & obstacle_heuristic);
 
   /**
    * @brief reset the obstacle heuristic state
+   * @param context Obstacle heuristic wavefront of the planner to reset
    * @param costmap Costmap to use
    * @param goal_coords Coordinates to start heuristic expansion at
    */
   static void resetObstacleHeuristic(
+    ObstacleHeuristicContext & context,
     nav2_costmap_2d::Costmap2D * costmap,
     const unsigned int & start_x, const unsigned int & start_y,
     const unsigned int & goal_x, const unsigned int & goal_y);
 
   /**
    * @brief Retrieve all valid neighbors of a node.
+   * @param context Search context of the planner
    * @param validity_checker Functor for state validity checking
    * @param collision_checker Collision checker to use
    * @param traverse_unknown If unknown costs are valid to traverse
    * @param neighbors Vector of neighbors to be filled
    */
   void getNeighbors(
+    const SearchContext & context,
     std::function<bool(const unsigned int &, nav2_smac_planner::NodeHybrid * &)> & validity_checker,
     GridCollisionChecker * collision_checker,
     const bool & traverse_unknown,
@@ -446,27 +497,15 @@ public:
 
   /**
    * @brief Set the starting pose for planning, as a node index
+   * @param context Search context of the planner
    * @param path Reference to a vector of indicies of generated path
    * @return whether the path was able to be backtraced
    */
-  bool backtracePath(CoordinateVector & path);
+  bool backtracePath(const SearchContext & context, CoordinateVector & path);
 
   NodeHybrid * parent;
   Coordinates pose;
 
-  // Constants required across all nodes but don't want to allocate more than once
-  static double travel_distance_cost;
-  static HybridMotionTable motion_table;
-  // Wavefront lookup and queue for continuing to expand as needed
-  static LookupTable obstacle_heuristic_lookup_table;
-  static ObstacleHeuristicQueue obstacle_heuristic_queue;
-
-  static nav2_costmap_2d::Costmap2D * sampled_costmap;
-  static CostmapDownsampler downsampler;
-  // Dubin / Reeds-Shepp lookup and size for dereferencing
-  static LookupTable dist_heuristic_lookup_table;
-  static float size_lookup;
-
 private:
   float _cell_cost;
   float _accumulated_cost;
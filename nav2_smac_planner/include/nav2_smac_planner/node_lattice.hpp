@@ -87,24 +87,24 @@ struct LatticeMotionTable
    * @param theta Angle in radians
    * @return bin index of closest angle to request
    */
-  unsigned int getClosestAngularBin(const double & theta);
+  unsigned int getClosestAngularBin(const double & theta) const;
 
   /**
    * @brief Get the raw orientation from an angular bin
    * @param bin_idx Index of the bin
    * @return Raw orientation in radians
    */
-  float & getAngleFromBin(const unsigned int & bin_idx);
-
-  unsigned int size_x;
-  unsigned int num_angle_quantization;
-  float change_penalty;
-  float non_straight_penalty;
-  float cost_penalty;
-  float reverse_penalty;
-  float travel_distance_reward;
-  float rotation_penalty;
-  bool allow_reverse_expansion;
+  float getAngleFromBin(const unsigned int & bin_idx) const;
+
+  unsigned int size_x{0};
+  unsigned int num_angle_quantization{0};
+  float change_penalty{0.0f};
+  float non_straight_penalty{0.0f};
+  float cost_penalty{0.0f};
+  float reverse_penalty{0.0f};
+  float travel_distance_reward{0.0f};
+  float rotation_penalty{0.0f};
+  bool allow_reverse_expansion{false};
   std::vector<std::vector<MotionPrimitive>> motion_primitives;
   ompl::base::StateSpacePtr state_space;
   std::vector<TrigValues> trig_values;
@@ -112,6 +112,20 @@ struct LatticeMotionTable
   LatticeMetadata lattice_metadata;
 };
 
+/**
+ * @struct nav2_smac_planner::LatticeSearchContext
+ * @brief State shared by the State Lattice nodes of a single planner's search,
+ * so that several planners can search concurrently in one process
+ */
+struct LatticeSearchContext
+{
+  LatticeMotionTable motion_table;
+  ObstacleHeuristicContext obstacle_heuristic;
+  // Dubin / Reeds-Shepp lookup and size for dereferencing
+  LookupTable dist_heuristic_lookup_table;
+  float size_lookup{25.0f};
+};
+
 /**
  * @class nav2_smac_planner::NodeLattice
  * @brief NodeLattice implementation for graph, Hybrid-A*
@@ -124,6 +138,7 @@ public:
   typedef std::vector<NodePtr> NodeVector;
   typedef NodeHybrid::Coordinates Coordinates;
   typedef NodeHybrid::CoordinateVector CoordinateVector;
+  typedef LatticeSearchContext SearchContext;
 
   /**
    * @brief A constructor for nav2_smac_planner::NodeLattice
@@ -250,6 +265,7 @@ public:
 
   /**
    * @brief Check if this node is valid
+   * @param context Search context of the planner
    * @param traverse_unknown If we can explore unknown nodes on the graph
    * @param collision_checker Collision checker object to aid in validity checking
    * @param primitive Optional argument if needing to check over a primitive
@@ -259,6 +275,7 @@ public:
    * @return whether this node is valid and collision free
    */
   bool isNodeValid(
+    const SearchContext & context,
     const bool & traverse_unknown,
     GridCollisionChecker * collision_checker,
     MotionPrimitive * primitive = nullptr,
@@ -266,25 +283,28 @@ public:
 
   /**
    * @brief Get traversal cost of parent node to child node
+   * @param context Search context of the planner
    * @param child Node pointer to child
    * @return traversal cost
    */
-  float getTraversalCost(const NodePtr & child);
+  float getTraversalCost(const SearchContext & context, const NodePtr & child);
 
   /**
    * @brief Get index at coordinates
+   * @param context Search context of the planner
    * @param x X coordinate of point
    * @param y Y coordinate of point
    * @param angle Theta coordinate of point
    * @return Index
    */
   static inline unsigned int getIndex(
+    const SearchContext & context,
     const unsigned int & x, const unsigned int & y, const unsigned int & angle)
   {
     // Hybrid-A* and State Lattice share a coordinate system
     return NodeHybrid::getIndex(
-      x, y, angle, motion_table.size_x,
-      motion_table.num_angle_quantization);
+      x, y, angle, context.motion_table.size_x,
+      context.motion_table.num_angle_quantization);
   }
 
   /**
@@ -307,18 +327,21 @@ public:
 
   /**
    * @brief Get cost of heuristic of node
+   * @param context Search context of the planner
    * @param node Node index current
    * @param node Node index of new
    * @param costmap Costmap ptr to use
    * @return Heuristic cost between the nodes
    */
   static float getHeuristicCost(
+    SearchContext & context,
     const Coordinates & node_coords,
     const Coordinates & goal_coordinates,
     const nav2_costmap_2d::Costmap2D * costmap);
 
   /**
    * @brief Initialize motion models
+   * @param context Search context of the planner to initialize
    * @param motion_model Motion model enum to use
    * @param size_x Size of X of graph
    * @param size_y Size of y of graph
@@ -326,6 +349,7 @@ public:
    * @param search_info Search info to use
    */
   static void initMotionModel(
+    SearchContext & context,
     const MotionModel & motion_model,
     unsigned int & size_x,
     unsigned int & size_y,
@@ -334,6 +358,7 @@ public:
 
   /**
    * @brief Compute the SE2 distance heuristic
+   * @param context Search context of the planner to populate
    * @param lookup_table_dim Size, in costmap pixels, of the
    * each lookup table dimension to populate
    * @param motion_model Motion model to use for state space
@@ -341,6 +366,7 @@ public:
    * @param search_info Info containing minimum radius to use
    */
   static void precomputeDistanceHeuristic(
+    SearchContext & context,
     const float & lookup_table_dim,
     const MotionModel & motion_model,
     const unsigned int & dim_3_size,
@@ -348,34 +374,39 @@ public:
 
   /**
    * @brief Compute the wavefront heuristic
+   * @param context Obstacle heuristic wavefront of the planner to reset
    * @param costmap Costmap to use
    * @param goal_coords Coordinates to start heuristic expansion at
    */
   static void resetObstacleHeuristic(
+    ObstacleHeuristicContext & context,
     nav2_costmap_2d::Costmap2D * costmap,
     const unsigned int & start_x, const unsigned int & start_y,
     const unsigned int & goal_x, const unsigned int & goal_y)
   {
     // State Lattice and Hybrid-A* share this heuristics
-    NodeHybrid::resetObstacleHeuristic(costmap, start_x, start_y, goal_x, goal_y);
+    NodeHybrid::resetObstacleHeuristic(context, costmap, start_x, start_y, goal_x, goal_y);
   }
 
   /**
    * @brief Compute the Obstacle heuristic
+   * @param context Obstacle heuristic wavefront of the planner
    * @param node_coords Coordinates to get heuristic at
    * @param goal_coords Coordinates to compute heuristic to
    * @return heuristic Heuristic value
    */
   static float getObstacleHeuristic(
+    ObstacleHeuristicContext & context,
     const Coordinates & node_coords,
     const Coordinates & goal_coords,
     const double & cost_penalty)
   {
-    return NodeHybrid::getObstacleHeuristic(node_coords, goal_coords, cost_penalty);
+    return NodeHybrid::getObstacleHeuristic(context, node_coords, goal_coords, cost_penalty);
   }
 
   /**
    * @brief Compute the Distance heuristic
+   * @param context Search context of the planner
    * @param node_coords Coordinates to get heuristic at
    * @param goal_coords Coordinates to compute heuristic to
    * @param obstacle_heuristic Value of the obstacle heuristic to compute
@@ -383,18 +414,21 @@ public:
    * @return heuristic Heuristic value
    */
   static float getDistanceHeuristic(
+    const SearchContext & context,
     const Coordinates & node_coords,
     const Coordinates & goal_coords,
     const float & obstacle_heuristic);
 
   /**
    * @brief Retrieve all valid neighbors of a node.
+   * @param context Search context of the planner
    * @param validity_checker Functor for state validity checking
    * @param collision_checker Collision checker to use
    * @param traverse_unknown If unknown costs are valid to traverse
    * @param neighbors Vector of neighbors to be filled
    */
   void getNeighbors(
+    SearchContext & context,
     std::function<bool(const unsigned int &,
     nav2_smac_planner::NodeLattice * &)> & validity_checker,
     GridCollisionChecker * collision_checker,
@@ -403,23 +437,22 @@ public:
 
   /**
    * @brief Set the starting pose for planning, as a node index
+   * @param context Search context of the planner
    * @param path Reference to a vector of indicies of generated path
    * @return whether the path was able to be backtraced
    */
-  bool backtracePath(CoordinateVector & path);
+  bool backtracePath(const SearchContext & context, CoordinateVector & path);
 
   /**
    * \brief add node to the path
+   * \param context Search context of the planner
    * \param current_node
    */
-  void addNodeToPath(NodePtr current_node, CoordinateVector & path);
+  void addNodeToPath(
+    const SearchContext & context, NodePtr current_node, CoordinateVector & path);
 
   NodeLattice * parent;
   Coordinates pose;
-  static LatticeMotionTable motion_table;
-  // Dubin / Reeds-Shepp lookup and size for dereferencing
-  static LookupTable dist_heuristic_lookup_table;
-  static float size_lookup;
 
 private:
   float _cell_cost;
@@ -0,0 +1,366 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License. Reserved.
+
+#ifndef NAV2_SMAC_PLANNER__OPEN_LIST_HPP_
+#define NAV2_SMAC_PLANNER__OPEN_LIST_HPP_
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "nav2_smac_planner/constants.hpp"
+
+namespace nav2_smac_planner
+{
+
+/**
+ * @class nav2_smac_planner::OpenList
+ * @brief Open set of a search, ordered by lowest cost. Templated on the payload cached
+ * for each queued node (e.g. NodeBasic).
+ *
+ * BINARY_HEAP keeps a std::priority_queue of (cost, payload) and queues a node again each
+ * time a cheaper path to it is found, leaving the older entries to be skipped once visited.
+ *
+ * QUATERNARY_HEAP and BUCKET queue each node once: payloads stay in a slot table, found
+ * from the node index through a paged index map, and are only updated in place when a cheaper
+ * path is found (decrease-key). QUATERNARY_HEAP sorts compact (cost, slot) keys in a 4-ary
+ * heap, which is shallower and more cache friendly than a binary one. BUCKET stores slots
+ * in buckets of bucket_width cost, popping the lowest bucket last-in first-out, which is
+ * O(1) but only orders nodes up to bucket_width. It suits the 2D search, where costs are
+ * dominated by unit steps.
+ */
+template<typename PayloadT>
+class OpenList
+{
+public:
+  /**
+   * @brief A constructor for nav2_smac_planner::OpenList
+   * @param type Data structure to use
+   * @param bucket_width Width of the cost buckets, for the BUCKET type
+   */
+  explicit OpenList(
+    const OpenListType & type = OpenListType::BINARY_HEAP, const float & bucket_width = 1.0f)
+  : _type(type), _bucket_width(bucket_width), _size(0), _lowest_bucket(0)
+  {
+    if (_type == OpenListType::UNKNOWN) {
+      _type = OpenListType::BINARY_HEAP;
+    }
+  }
+
+  /**
+   * @brief Get the data structure used
+   * @return Open list type
+   */
+  const OpenListType & getType() const
+  {
+    return _type;
+  }
+
+  /**
+   * @brief Whether no node is queued
+   * @return If empty
+   */
+  bool empty() const
+  {
+    return _type == OpenListType::BINARY_HEAP ? _binary_heap.empty() : _size == 0;
+  }
+
+  /**
+   * @brief Get the number of queued entries
+   * @return Number of entries
+   */
+  size_t size() const
+  {
+    return _type == OpenListType::BINARY_HEAP ? _binary_heap.size() : _size;
+  }
+
+  /**
+   * @brief Remove all entries, keeping the allocated memory for the next search
+   */
+  void clear()
+  {
+    _binary_heap = BinaryHeap();
+    // Only the entries still queued are left in the index map
+    for (const Key & key : _heap) {
+      getSlotId(_slots[key.slot].index) = NO_SLOT;
+    }
+    _heap.clear();
+    for (auto & bucket : _buckets) {
+      for (const unsigned int & slot_id : bucket) {
+        getSlotId(_slots[slot_id].index) = NO_SLOT;
+      }
+      bucket.clear();
+    }
+    _slots.clear();
+    _free_slots.clear();
+    _size = 0;
+    _lowest_bucket = 0;
+  }
+
+  /**
+   * @brief Queue a node, or lower its cost if it is already queued for more
+   * @param cost Cost to sort the node by
+   * @param index Index of the node
+   * @param payload State to cache for the node until it is popped
+   */
+  void push(const float & cost, const unsigned int & index, const PayloadT & payload)
+  {
+    if (_type == OpenListType::BINARY_HEAP) {
+      _binary_heap.emplace(cost, payload);
+      return;
+    }
+
+    unsigned int & queued_slot_id = getSlotId(index);
+    if (queued_slot_id != NO_SLOT) {
+      // Already queued, only a cheaper path replaces the cached state
+      Slot & slot = _slots[queued_slot_id];
+      if (!(cost < slot.cost)) {
+        return;
+      }
+      slot.cost = cost;
+      slot.payload = payload;
+      if (_type == OpenListType::QUATERNARY_HEAP) {
+        _heap[slot.position].cost = cost;
+        siftUp(slot.position);
+      } else {
+        removeFromBucket(queued_slot_id);
+        addToBucket(queued_slot_id);
+      }
+      return;
+    }
+
+    unsigned int slot_id;
+    if (_free_slots.empty()) {
+      slot_id = static_cast<unsigned int>(_slots.size());
+      _slots.push_back(Slot{payload, cost, index, 0u, 0u});
+    } else {
+      slot_id = _free_slots.back();
+      _free_slots.pop_back();
+      _slots[slot_id] = Slot{payload, cost, index, 0u, 0u};
+    }
+    queued_slot_id = slot_id;
+    _size++;
+
+    if (_type == OpenListType::QUATERNARY_HEAP) {
+      _heap.push_back(Key{cost, slot_id});
+      siftUp(static_cast<unsigned int>(_heap.size() - 1));
+    } else {
+      addToBucket(slot_id);
+    }
+  }
+
+  /**
+   * @brief Remove the lowest cost entry, must not be empty
+   * @return The payload cached for it
+   */
+  PayloadT pop()
+  {
+    if (_type == OpenListType::BINARY_HEAP) {
+      PayloadT payload = _binary_heap.top().second;
+      _binary_heap.pop();
+      return payload;
+    }
+
+    unsigned int slot_id;
+    if (_type == OpenListType::QUATERNARY_HEAP) {
+      slot_id = _heap.front().slot;
+      const Key last = _heap.back();
+      _heap.pop_back();
+      if (!_heap.empty()) {
+        _heap.front() = last;
+        _slots[last.slot].position = 0;
+        siftDown(0);
+      }
+    } else {
+      while (_buckets[_lowest_bucket].empty()) {
+        _lowest_bucket++;
+      }
+      slot_id = _buckets[_lowest_bucket].back();
+      _buckets[_lowest_bucket].pop_back();
+    }
+
+    Slot & slot = _slots[slot_id];
+    getSlotId(slot.index) = NO_SLOT;
+    _free_slots.push_back(slot_id);
+    _size--;
+    return slot.payload;
+  }
+
+protected:
+  /**
+   * @struct nav2_smac_planner::OpenList::Key
+   * @brief Compact heap key, the slot holding the rest of the entry
+   */
+  struct Key
+  {
+    float cost;
+    unsigned int slot;
+  };
+
+  /**
+   * @struct nav2_smac_planner::OpenList::Slot
+   * @brief Queued entry, with its position in the heap or in its bucket
+   */
+  struct Slot
+  {
+    PayloadT payload;
+    float cost;
+    unsigned int index;
+    unsigned int position;
+    unsigned int bucket;
+  };
+
+  /**
+   * @struct nav2_smac_planner::OpenList::Comparator
+   * @brief Lowest cost first ordering for the binary heap
+   */
+  struct Comparator
+  {
+    bool operator()(
+      const std::pair<float, PayloadT> & a, const std::pair<float, PayloadT> & b) const
+    {
+      return a.first > b.first;
+    }
+  };
+
+  static constexpr unsigned int NO_SLOT = std::numeric_limits<unsigned int>::max();
+  static constexpr unsigned int PAGE_BITS = 12;
+  static constexpr unsigned int PAGE_SIZE = 1u << PAGE_BITS;
+
+  typedef std::priority_queue<std::pair<float, PayloadT>,
+      std::vector<std::pair<float, PayloadT>>, Comparator> BinaryHeap;
+
+  /**
+   * @brief Get the slot of a node in the index map, allocating its page on first use
+   * @param index Index of the node
+   * @return Reference to its slot, NO_SLOT if it is not queued
+   */
+  unsigned int & getSlotId(const unsigned int & index)
+  {
+    const unsigned int page = index >> PAGE_BITS;
+    if (page >= _pages.size()) {
+      _pages.resize(page + 1);
+    }
+    if (!_pages[page]) {
+      _pages[page] = std::make_unique<unsigned int[]>(PAGE_SIZE);
+      std::fill_n(_pages[page].get(), PAGE_SIZE, NO_SLOT);
+    }
+    return _pages[page][index & (PAGE_SIZE - 1)];
+  }
+
+  /**
+   * @brief Move a heap key up until its parent is not more expensive
+   * @param position Position of the key in the heap
+   */
+  void siftUp(unsigned int position)
+  {
+    const Key key = _heap[position];
+    while (position > 0) {
+      const unsigned int parent = (position - 1) / 4;
+      if (!(key.cost < _heap[parent].cost)) {
+        break;
+      }
+      _heap[position] = _heap[parent];
+      _slots[_heap[position].slot].position = position;
+      position = parent;
+    }
+    _heap[position] = key;
+    _slots[key.slot].position = position;
+  }
+
+  /**
+   * @brief Move a heap key down until none of its children is cheaper
+   * @param position Position of the key in the heap
+   */
+  void siftDown(unsigned int position)
+  {
+    const Key key = _heap[position];
+    const unsigned int size = static_cast<unsigned int>(_heap.size());
+    while (true) {
+      const unsigned int first_child = 4 * position + 1;
+      if (first_child >= size) {
+        break;
+      }
+      const unsigned int last_child = std::min(first_child + 4, size);
+      unsigned int best = first_child;
+      for (unsigned int child = first_child + 1; child < last_child; ++child) {
+        if (_heap[child].cost < _heap[best].cost) {
+          best = child;
+        }
+      }
+      if (!(_heap[best].cost < key.cost)) {
+        break;
+      }
+      _heap[position] = _heap[best];
+      _slots[_heap[position].slot].position = position;
+      position = best;
+    }
+    _heap[position] = key;
+    _slots[key.slot].position = position;
+  }
+
+  /**
+   * @brief Add a slot to the bucket of its cost
+   * @param slot_id Slot to add
+   */
+  void addToBucket(const unsigned int & slot_id)
+  {
+    Slot & slot = _slots[slot_id];
+    const unsigned int bucket =
+      static_cast<unsigned int>(std::max(slot.cost, 0.0f) / _bucket_width);
+    if (bucket >= _buckets.size()) {
+      _buckets.resize(std::max(static_cast<size_t>(bucket) + 1, 2 * _buckets.size()));
+    }
+    slot.bucket = bucket;
+    slot.position = static_cast<unsigned int>(_buckets[bucket].size());
+    _buckets[bucket].push_back(slot_id);
+    if (_size == 1 || bucket < _lowest_bucket) {
+      _lowest_bucket = bucket;
+    }
+  }
+
+  /**
+   * @brief Remove a slot from its bucket, filling the gap with the last one
+   * @param slot_id Slot to remove
+   */
+  void removeFromBucket(const unsigned int & slot_id)
+  {
+    const Slot & slot = _slots[slot_id];
+    std::vector<unsigned int> & bucket = _buckets[slot.bucket];
+    const unsigned int last = bucket.back();
+    bucket[slot.position] = last;
+    _slots[last].position = slot.position;
+    bucket.pop_back();
+  }
+
+  OpenListType _type;
+  float _bucket_width;
+  size_t _size;
+  unsigned int _lowest_bucket;
+
+  BinaryHeap _binary_heap;
+  std::vector<Key> _heap;
+  std::vector<std::vector<unsigned int>> _buckets;
+  std::vector<Slot> _slots;
+  std::vector<unsigned int> _free_slots;
+  // Index map from node index to slot, in pages allocated for the indices searched
+  std::vector<std::unique_ptr<unsigned int[]>> _pages;
+};
+
+}  // namespace nav2_smac_planner
+
+#endif  // NAV2_SMAC_PLANNER__OPEN_LIST_HPP_
@@ -44,6 +44,7 @@ AStarAlgorithm<NodeT>::AStarAlgorithm(
   _goal_coordinates(Coordinates()),
   _start(nullptr),
   _goal(nullptr),
+  _queue(search_info.open_list_type),
   _motion_model(motion_model)
 {
   _graph.reserve(100000);
@@ -67,10 +68,11 @@ void AStarAlgorithm<NodeT>::initialize(
   _max_iterations = max_iterations;
   _max_on_approach_iterations = max_on_approach_iterations;
   _max_planning_time = max_planning_time;
-  NodeT::precomputeDistanceHeuristic(lookup_table_size, _motion_model, dim_3_size, _search_info);
+  NodeT::precomputeDistanceHeuristic(
+    _context, lookup_table_size, _motion_model, dim_3_size, _search_info);
   _dim3_size = dim_3_size;
   _expander = std::make_unique<AnalyticExpansion<NodeT>>(
-    _motion_model, _search_info, _traverse_unknown, _dim3_size);
+    _motion_model, _search_info, _traverse_unknown, _dim3_size, &_context);
 }
 
 template<>
@@ -92,7 +94,7 @@ void AStarAlgorithm<Node2D>::initialize(
   }
   _dim3_size = dim_3_size;
   _expander = std::make_unique<AnalyticExpansion<Node2D>>(
-    _motion_model, _search_info, _traverse_unknown, _dim3_size);
+    _motion_model, _search_info, _traverse_unknown, _dim3_size, &_context);
 }
 
 template<typename NodeT>
@@ -108,7 +110,7 @@ void AStarAlgorithm<NodeT>::setCollisionChecker(GridCollisionChecker * collision
   if (getSizeX() != x_size || getSizeY() != y_size) {
     _x_size = x_size;
     _y_size = y_size;
-    NodeT::initMotionModel(_motion_model, _x_size, _y_size, _dim3_size, _search_info);
+    NodeT::initMotionModel(_context, _motion_model, _x_size, _y_size, _dim3_size, _search_info);
   }
   _expander->setCollisionChecker(collision_checker);
 }
@@ -143,7 +145,7 @@ void AStarAlgorithm<NodeT>::setStart(
   const unsigned int & my,
   const unsigned int & dim_3)
 {
-  _start = addToGraph(NodeT::getIndex(mx, my, dim_3));
+  _start = addToGraph(NodeT::getIndex(_context, mx, my, dim_3));
   _start->setPose(
     Coordinates(
       static_cast<float>(mx),
@@ -156,7 +158,7 @@ void AStarAlgorithm<Node2D>::populateExpansionsLog(
   const NodePtr & node,
   std::vector<std::tuple<float, float, float>> * expansions_log)
 {
-  Node2D::Coordinates coords = node->getCoords(node->getIndex());
+  Node2D::Coordinates coords = node->getCoords(_context, node->getIndex());
   expansions_log->emplace_back(
     _costmap->getOriginX() + ((coords.x + 0.5) * _costmap->getResolution()),
     _costmap->getOriginY() + ((coords.y + 0.5) * _costmap->getResolution()),
@@ -172,7 +174,7 @@ void AStarAlgorithm<NodeT>::populateExpansionsLog(
   expansions_log->emplace_back(
     _costmap->getOriginX() + ((coords.x + 0.5) * _costmap->getResolution()),
     _costmap->getOriginY() + ((coords.y + 0.5) * _costmap->getResolution()),
-    NodeT::motion_table.getAngleFromBin(coords.theta));
+    _context.motion_table.getAngleFromBin(coords.theta));
 }
 
 template<>
@@ -195,7 +197,7 @@ void AStarAlgorithm<NodeT>::setGoal(
   const unsigned int & my,
   const unsigned int & dim_3)
 {
-  _goal = addToGraph(NodeT::getIndex(mx, my, dim_3));
+  _goal = addToGraph(NodeT::getIndex(_context, mx, my, dim_3));
 
   typename NodeT::Coordinates goal_coords(
     static_cast<float>(mx),
@@ -207,7 +209,8 @@ void AStarAlgorithm<NodeT>::setGoal(
       throw std::runtime_error("Start must be set before goal.");
     }
 
-    NodeT::resetObstacleHeuristic(_costmap, _start->pose.x, _start->pose.y, mx, my);
+    NodeT::resetObstacleHeuristic(
+      _context.obstacle_heuristic, _costmap, _start->pose.x, _start->pose.y, mx, my);
   }
 
   _goal_coordinates = goal_coords;
@@ -229,13 +232,13 @@ bool AStarAlgorithm<NodeT>::areInputsValid()
 
   // Check if ending point is valid
   if (getToleranceHeuristic() < 0.001 &&
-    !_goal->isNodeValid(_traverse_unknown, _collision_checker))
+    !_goal->isNodeValid(_context, _traverse_unknown, _collision_checker))
   {
     throw nav2_core::GoalOccupied("Goal was in lethal cost");
   }
 
   // Check if starting point is valid
-  if (!_start->isNodeValid(_traverse_unknown, _collision_checker)) {
+  if (!_start->isNodeValid(_context, _traverse_unknown, _collision_checker)) {
     throw nav2_core::StartOccupied("Start was in lethal cost");
   }
 
@@ -324,18 +327,19 @@ bool AStarAlgorithm<NodeT>::createPath(
 
     // 3) Check if we're at the goal, backtrace if required
     if (isGoal(current_node)) {
-      return current_node->backtracePath(path);
+      return current_node->backtracePath(_context, path);
     } else if (_best_heuristic_node.first < getToleranceHeuristic()) {
       // Optimization: Let us find when in tolerance and refine within reason
       approach_iterations++;
       if (approach_iterations >= getOnApproachMaxIterations()) {
-        return _graph.at(_best_heuristic_node.second).backtracePath(path);
+        return _graph.at(_best_heuristic_node.second).backtracePath(_context, path);
       }
     }
 
     // 4) Expand neighbors of Nbest not visited
     neighbors.clear();
-    current_node->getNeighbors(neighborGetter, _collision_checker, _traverse_unknown, neighbors);
+    current_node->getNeighbors(
+      _context, neighborGetter, _collision_checker, _traverse_unknown, neighbors);
 
     for (neighbor_iterator = neighbors.begin();
       neighbor_iterator != neighbors.end(); ++neighbor_iterator)
@@ -343,7 +347,8 @@ bool AStarAlgorithm<NodeT>::createPath(
       neighbor = *neighbor_iterator;
 
       // 4.1) Compute the cost to go to this node
-      g_cost = current_node->getAccumulatedCost() + current_node->getTraversalCost(neighbor);
+      g_cost = current_node->getAccumulatedCost() +
+        current_node->getTraversalCost(_context, neighbor);
 
       // 4.2) If this is a lower cost than prior, we set this as the new cost and new approach
       if (g_cost < neighbor->getAccumulatedCost()) {
@@ -358,7 +363,7 @@ bool AStarAlgorithm<NodeT>::createPath(
 
   if (_best_heuristic_node.first < getToleranceHeuristic()) {
     // If we run out of serach options, return the path that is closest, if within tolerance.
-    return _graph.at(_best_heuristic_node.second).backtracePath(path);
+    return _graph.at(_best_heuristic_node.second).backtracePath(_context, path);
   }
 
   return false;
@@ -385,8 +390,7 @@ typename AStarAlgorithm<NodeT>::NodePtr & AStarAlgorithm<NodeT>::getGoal()
 template<typename NodeT>
 typename AStarAlgorithm<NodeT>::NodePtr AStarAlgorithm<NodeT>::getNextNode()
 {
-  NodeBasic<NodeT> node = _queue.top().second;
-  _queue.pop();
+  NodeBasic<NodeT> node = _queue.pop();
   node.processSearchNode();
   return node.graph_node_ptr;
 }
@@ -396,7 +400,7 @@ void AStarAlgorithm<NodeT>::addNode(const float & cost, NodePtr & node)
 {
   NodeBasic<NodeT> queued_node(node->getIndex());
   queued_node.populateSearchNode(node);
-  _queue.emplace(cost, queued_node);
+  _queue.push(cost, queued_node.index, queued_node);
 }
 
 template<typename NodeT>
@@ -405,7 +409,7 @@ float AStarAlgorithm<NodeT>::getHeuristicCost(const NodePtr & node)
   const Coordinates node_coords =
     NodeT::getCoords(node->getIndex(), getSizeX(), getSizeDim3());
   float heuristic = NodeT::getHeuristicCost(
-    node_coords, _goal_coordinates, _costmap);
+    _context, node_coords, _goal_coordinates, _costmap);
 
   if (heuristic < _best_heuristic_node.first) {
     _best_heuristic_node = {heuristic, node->getIndex()};
@@ -417,8 +421,7 @@ float AStarAlgorithm<NodeT>::getHeuristicCost(const NodePtr & node)
 template<typename NodeT>
 void AStarAlgorithm<NodeT>::clearQueue()
 {
-  NodeQueue q;
-  std::swap(_queue, q);
+  _queue.clear();
 }
 
 template<typename NodeT>
@@ -465,6 +468,12 @@ unsigned int & AStarAlgorithm<NodeT>::getSizeDim3()
   return _dim3_size;
 }
 
+template<typename NodeT>
+typename AStarAlgorithm<NodeT>::SearchContext & AStarAlgorithm<NodeT>::getSearchContext()
+{
+  return _context;
+}
+
 // Instantiate algorithm for the supported template types
 template class AStarAlgorithm<Node2D>;
 template class AStarAlgorithm<NodeHybrid>;
@@ -30,12 +30,14 @@ AnalyticExpansion<NodeT>::AnalyticExpansion(
   const MotionModel & motion_model,
   const SearchInfo & search_info,
   const bool & traverse_unknown,
-  const unsigned int & dim_3_size)
+  const unsigned int & dim_3_size,
+  SearchContext * context)
 : _motion_model(motion_model),
   _search_info(search_info),
   _traverse_unknown(traverse_unknown),
   _dim_3_size(dim_3_size),
-  _collision_checker(nullptr)
+  _collision_checker(nullptr),
+  _context(context)
 {
 }
 
@@ -62,7 +64,8 @@ typename AnalyticExpansion<NodeT>::NodePtr AnalyticExpansion<NodeT>::tryAnalytic
       NodeT::getCoords(current_node->getIndex(), costmap->getSizeInCellsX(), _dim_3_size);
     closest_distance = std::min(
       closest_distance,
-      static_cast<int>(NodeT::getHeuristicCost(node_coords, goal_node->pose, costmap)));
+      static_cast<int>(
+        NodeT::getHeuristicCost(*_context, node_coords, goal_node->pose, costmap)));
 
     // We want to expand at a rate of d/expansion_ratio,
     // but check to see if we are so close that we would be expanding every iteration
@@ -122,16 +125,17 @@ typename AnalyticExpansion<NodeT>::AnalyticExpansionNodes AnalyticExpansion<Node
   const NodePtr & goal,
   const NodeGetter & node_getter)
 {
-  static ompl::base::ScopedState<> from(node->motion_table.state_space), to(
-    node->motion_table.state_space), s(node->motion_table.state_space);
+  const auto & motion_table = _context->motion_table;
+  ompl::base::ScopedState<> from(motion_table.state_space), to(motion_table.state_space),
+    s(motion_table.state_space);
   from[0] = node->pose.x;
   from[1] = node->pose.y;
-  from[2] = node->motion_table.getAngleFromBin(node->pose.theta);
+  from[2] = motion_table.getAngleFromBin(node->pose.theta);
   to[0] = goal->pose.x;
   to[1] = goal->pose.y;
-  to[2] = node->motion_table.getAngleFromBin(goal->pose.theta);
+  to[2] = motion_table.getAngleFromBin(goal->pose.theta);
 
-  float d = node->motion_table.state_space->distance(from(), to());
+  float d = motion_table.state_space->distance(from(), to());
 
   // If the length is too far, exit. This prevents unsafe shortcutting of paths
   // into higher cost areas far out from the goal itself, let search to the work of getting
@@ -162,15 +166,16 @@ typename AnalyticExpansion<NodeT>::AnalyticExpansionNodes AnalyticExpansion<Node
 
   // Check intermediary poses (non-goal, non-start)
   for (float i = 1; i < num_intervals; i++) {
-    node->motion_table.state_space->interpolate(from(), to(), i / num_intervals, s());
+    motion_table.state_space->interpolate(from(), to(), i / num_intervals, s());
     reals = s.reals();
     // Make sure in range [0, 2PI)
     theta = (reals[2] < 0.0) ? (reals[2] + 2.0 * M_PI) : reals[2];
     theta = (theta > 2.0 * M_PI) ? (theta - 2.0 * M_PI) : theta;
-    angle = node->motion_table.getClosestAngularBin(theta);
+    angle = motion_table.getClosestAngularBin(theta);
 
     // Turn the pose into a node, and check if it is valid
     index = NodeT::getIndex(
+      *_context,
       static_cast<unsigned int>(reals[0]),
       static_cast<unsigned int>(reals[1]),
       static_cast<unsigned int>(angle));
@@ -179,7 +184,7 @@ typename AnalyticExpansion<NodeT>::AnalyticExpansionNodes AnalyticExpansion<Node
       Coordinates initial_node_coords = next->pose;
       proposed_coordinates = {static_cast<float>(reals[0]), static_cast<float>(reals[1]), angle};
       next->setPose(proposed_coordinates);
-      if (next->isNodeValid(_traverse_unknown, _collision_checker) && next != prev) {
+      if (next->isNodeValid(*_context, _traverse_unknown, _collision_checker) && next != prev) {
         // Save the node, and its previous coordinates in case we need to abort
         possible_nodes.emplace_back(next, initial_node_coords, proposed_coordinates);
         prev = next;
@@ -21,10 +21,6 @@
 namespace nav2_smac_planner
 {
 
-// defining static member for all instance to share
-std::vector<int> Node2D::_neighbors_grid_offsets;
-float Node2D::cost_travel_multiplier = 2.0;
-
 Node2D::Node2D(const unsigned int index)
 : parent(nullptr),
   _cell_cost(std::numeric_limits<float>::quiet_NaN()),
@@ -50,6 +46,7 @@ void Node2D::reset()
 }
 
 bool Node2D::isNodeValid(
+  const SearchContext & /*context*/,
   const bool & traverse_unknown,
   GridCollisionChecker * collision_checker)
 {
@@ -61,25 +58,26 @@ bool Node2D::isNodeValid(
   return true;
 }
 
-float Node2D::getTraversalCost(const NodePtr & child)
+float Node2D::getTraversalCost(const SearchContext & context, const NodePtr & child)
 {
   float normalized_cost = child->getCost() / 252.0;
-  const Coordinates A = getCoords(child->getIndex());
-  const Coordinates B = getCoords(this->getIndex());
+  const Coordinates A = getCoords(context, child->getIndex());
+  const Coordinates B = getCoords(context, this->getIndex());
   const float & dx = A.x - B.x;
   const float & dy = A.y - B.y;
   static float sqrt_2 = sqrt(2);
 
   // If a diagonal move, travel cost is sqrt(2) not 1.0.
   if ((dx * dx + dy * dy) > 1.05) {
-    return sqrt_2 * (1.0 + cost_travel_multiplier * normalized_cost);
+    return sqrt_2 * (1.0 + context.cost_travel_multiplier * normalized_cost);
   }
 
   // Length = 1.0
-  return 1.0 + cost_travel_multiplier * normalized_cost;
+  return 1.0 + context.cost_travel_multiplier * normalized_cost;
 }
 
 float Node2D::getHeuristicCost(
+  SearchContext & /*context*/,
   const Coordinates & node_coords,
   const Coordinates & goal_coordinates,
   const nav2_costmap_2d::Costmap2D * /*costmap*/)
@@ -92,6 +90,7 @@ float Node2D::getHeuristicCost(
 }
 
 void Node2D::initMotionModel(
+  SearchContext & context,
   const MotionModel & motion_model,
   unsigned int & x_size_uint,
   unsigned int & /*size_y*/,
@@ -103,12 +102,13 @@ void Node2D::initMotionModel(
   }
 
   int x_size = static_cast<int>(x_size_uint);
-  cost_travel_multiplier = search_info.cost_penalty;
-  _neighbors_grid_offsets = {-1, +1, -x_size, +x_size, -x_size - 1,
+  context.cost_travel_multiplier = search_info.cost_penalty;
+  context.neighbors_grid_offsets = {-1, +1, -x_size, +x_size, -x_size - 1,
     -x_size + 1, +x_size - 1, +x_size + 1};
 }
 
 void Node2D::getNeighbors(
+  const SearchContext & context,
   std::function<bool(const unsigned int &, nav2_smac_planner::Node2D * &)> & NeighborGetter,
   GridCollisionChecker * collision_checker,
   const bool & traverse_unknown,
@@ -128,27 +128,30 @@ void Node2D::getNeighbors(
   int index;
   NodePtr neighbor;
   int node_i = this->getIndex();
-  const Coordinates parent = getCoords(this->getIndex());
+  const Coordinates parent = getCoords(context, this->getIndex());
+  const std::vector<int> & neighbors_grid_offsets = context.neighbors_grid_offsets;
   Coordinates child;
 
-  for (unsigned int i = 0; i != _neighbors_grid_offsets.size(); ++i) {
-    index = node_i + _neighbors_grid_offsets[i];
+  for (unsigned int i = 0; i != neighbors_grid_offsets.size(); ++i) {
+    index = node_i + neighbors_grid_offsets[i];
 
     // Check for wrap around conditions
-    child = getCoords(index);
+    child = getCoords(context, index);
     if (fabs(parent.x - child.x) > 1 || fabs(parent.y - child.y) > 1) {
       continue;
     }
 
     if (NeighborGetter(index, neighbor)) {
-      if (neighbor->isNodeValid(traverse_unknown, collision_checker) && !neighbor->wasVisited()) {
+      if (neighbor->isNodeValid(context, traverse_unknown, collision_checker) &&
+        !neighbor->wasVisited())
+      {
         neighbors.push_back(neighbor);
       }
     }
   }
 }
 
-bool Node2D::backtracePath(CoordinateVector & path)
+bool Node2D::backtracePath(const SearchContext & context, CoordinateVector & path)
 {
   if (!this->parent) {
     return false;
@@ -158,12 +161,12 @@ bool Node2D::backtracePath(CoordinateVector & path)
 
   while (current_node->parent) {
     path.push_back(
-      Node2D::getCoords(current_node->getIndex()));
+      Node2D::getCoords(context, current_node->getIndex()));
     current_node = current_node->parent;
   }
 
   // add the start pose
-  path.push_back(Node2D::getCoords(current_node->getIndex()));
+  path.push_back(Node2D::getCoords(context, current_node->getIndex()));
 
   return true;
 }
@@ -34,16 +34,6 @@ using namespace std::chrono;  // NOLINT
 namespace nav2_smac_planner
 {
 
-// defining static member for all instance to share
-LookupTable NodeHybrid::obstacle_heuristic_lookup_table;
-double NodeHybrid::travel_distance_cost = sqrt(2);
-HybridMotionTable NodeHybrid::motion_table;
-float NodeHybrid::size_lookup = 25;
-LookupTable NodeHybrid::dist_heuristic_lookup_table;
-nav2_costmap_2d::Costmap2D * NodeHybrid::sampled_costmap = nullptr;
-CostmapDownsampler NodeHybrid::downsampler;
-ObstacleHeuristicQueue NodeHybrid::obstacle_heuristic_queue;
-
 // Each of these tables are the projected motion models through
 // time and space applied to the search on the current node in
 // continuous map-coordinates (e.g. not meters but partial map cells)
@@ -298,7 +288,7 @@ void HybridMotionTable::initReedsShepp(
   }
 }
 
-MotionPoses HybridMotionTable::getProjections(const NodeHybrid * node)
+MotionPoses HybridMotionTable::getProjections(const NodeHybrid * node) const
 {
   MotionPoses projection_list;
   projection_list.reserve(projections.size());
@@ -327,12 +317,12 @@ MotionPoses HybridMotionTable::getProjections(const NodeHybrid * node)
   return projection_list;
 }
 
-unsigned int HybridMotionTable::getClosestAngularBin(const double & theta)
+unsigned int HybridMotionTable::getClosestAngularBin(const double & theta) const
 {
   return static_cast<unsigned int>(floor(theta / bin_size));
 }
 
-float HybridMotionTable::getAngleFromBin(const unsigned int & bin_idx)
+float HybridMotionTable::getAngleFromBin(const unsigned int & bin_idx) const
 {
   return bin_idx * bin_size;
 }
@@ -366,6 +356,7 @@ void NodeHybrid::reset()
 }
 
 bool NodeHybrid::isNodeValid(
+  const SearchContext & /*context*/,
   const bool & traverse_unknown,
   GridCollisionChecker * collision_checker)
 {
@@ -379,8 +370,9 @@ bool NodeHybrid::isNodeValid(
   return true;
 }
 
-float NodeHybrid::getTraversalCost(const NodePtr & child)
+float NodeHybrid::getTraversalCost(const SearchContext & context, const NodePtr & child)
 {
+  const HybridMotionTable & motion_table = context.motion_table;
   const float normalized_cost = child->getCost() / 252.0f;
   if (std::isnan(normalized_cost)) {
     throw std::runtime_error(
@@ -390,7 +382,7 @@ float NodeHybrid::getTraversalCost(const NodePtr & child)
 
   // this is the first node
   if (getMotionPrimitiveIndex() == std::numeric_limits<unsigned int>::max()) {
-    return NodeHybrid::travel_distance_cost;
+    return context.travel_distance_cost;
   }
 
   const TurnDirection & child_turn_dir = child->getTurnDirection();
@@ -432,23 +424,27 @@ float NodeHybrid::getTraversalCost(const NodePtr & child)
 }
 
 float NodeHybrid::getHeuristicCost(
+  SearchContext & context,
   const Coordinates & node_coords,
   const Coordinates & goal_coords,
   const nav2_costmap_2d::Costmap2D * /*costmap*/)
 {
-  const float obstacle_heuristic =
-    getObstacleHeuristic(node_coords, goal_coords, motion_table.cost_penalty);
-  const float dist_heuristic = getDistanceHeuristic(node_coords, goal_coords, obstacle_heuristic);
+  const float obstacle_heuristic = getObstacleHeuristic(
+    context.obstacle_heuristic, node_coords, goal_coords, context.motion_table.cost_penalty);
+  const float dist_heuristic =
+    getDistanceHeuristic(context, node_coords, goal_coords, obstacle_heuristic);
   return std::max(obstacle_heuristic, dist_heuristic);
 }
 
 void NodeHybrid::initMotionModel(
+  SearchContext & context,
   const MotionModel & motion_model,
   unsigned int & size_x,
   unsigned int & size_y,
   unsigned int & num_angle_quantization,
   SearchInfo & search_info)
 {
+  HybridMotionTable & motion_table = context.motion_table;
   // find the motion model selected
   switch (motion_model) {
     case MotionModel::DUBIN:
@@ -464,7 +460,9 @@ void NodeHybrid::initMotionModel(
               " Reeds-Shepp (Ackermann forward and back).");
   }
 
-  travel_distance_cost = motion_table.projections[0]._x;
+  context.travel_distance_cost = motion_table.projections[0]._x;
+  context.obstacle_heuristic.downsample = motion_table.downsample_obstacle_heuristic;
+  context.obstacle_heuristic.use_quadratic_cost_penalty = motion_table.use_quadratic_cost_penalty;
 }
 
 inline float distanceHeuristic2D(
@@ -477,6 +475,7 @@ inline float distanceHeuristic2D(
 }
 
 void NodeHybrid::resetObstacleHeuristic(
+  ObstacleHeuristicContext & context,
   nav2_costmap_2d::Costmap2D * costmap,
   const unsigned int & start_x, const unsigned int & start_y,
   const unsigned int & goal_x, const unsigned int & goal_y)
@@ -485,61 +484,63 @@ void NodeHybrid::resetObstacleHeuristic(
   // the planner considerably to search through 75% less cells with no detectable
   // erosion of path quality after even modest smoothing. The error would be no more
   // than 0.05 * normalized cost. Since this is just a search prior, there's no loss in generality
-  sampled_costmap = costmap;
-  if (motion_table.downsample_obstacle_heuristic) {
+  context.sampled_costmap = costmap;
+  if (context.downsample) {
     std::weak_ptr<nav2_util::LifecycleNode> ptr;
-    downsampler.on_configure(ptr, "fake_frame", "fake_topic", costmap, 2.0, true);
-    downsampler.on_activate();
-    sampled_costmap = downsampler.downsample(2.0);
+    context.downsampler.on_configure(ptr, "fake_frame", "fake_topic", costmap, 2.0, true);
+    context.downsampler.on_activate();
+    context.sampled_costmap = context.downsampler.downsample(2.0);
   }
 
   // Clear lookup table
-  unsigned int size = sampled_costmap->getSizeInCellsX() * sampled_costmap->getSizeInCellsY();
-  if (obstacle_heuristic_lookup_table.size() == size) {
+  unsigned int size =
+    context.sampled_costmap->getSizeInCellsX() * context.sampled_costmap->getSizeInCellsY();
+  if (context.lookup_table.size() == size) {
     // must reset all values
     std::fill(
-      obstacle_heuristic_lookup_table.begin(),
-      obstacle_heuristic_lookup_table.end(), 0.0);
+      context.lookup_table.begin(),
+      context.lookup_table.end(), 0.0);
   } else {
-    unsigned int obstacle_size = obstacle_heuristic_lookup_table.size();
-    obstacle_heuristic_lookup_table.resize(size, 0.0);
+    unsigned int obstacle_size = context.lookup_table.size();
+    context.lookup_table.resize(size, 0.0);
     // must reset values for non-constructed indices
     std::fill_n(
-      obstacle_heuristic_lookup_table.begin(), obstacle_size, 0.0);
+      context.lookup_table.begin(), obstacle_size, 0.0);
   }
 
-  obstacle_heuristic_queue.clear();
-  obstacle_heuristic_queue.reserve(
-    sampled_costmap->getSizeInCellsX() * sampled_costmap->getSizeInCellsY());
+  context.queue.clear();
+  context.queue.reserve(
+    context.sampled_costmap->getSizeInCellsX() * context.sampled_costmap->getSizeInCellsY());
 
   // Set initial goal point to queue from. Divided by 2 due to downsampled costmap.
-  const unsigned int size_x = sampled_costmap->getSizeInCellsX();
+  const unsigned int size_x = context.sampled_costmap->getSizeInCellsX();
   unsigned int goal_index;
-  if (motion_table.downsample_obstacle_heuristic) {
+  if (context.downsample) {
     goal_index = floor(goal_y / 2.0f) * size_x + floor(goal_x / 2.0f);
   } else {
     goal_index = floor(goal_y) * size_x + floor(goal_x);
   }
 
-  obstacle_heuristic_queue.emplace_back(
+  context.queue.emplace_back(
     distanceHeuristic2D(goal_index, size_x, start_x, start_y), goal_index);
 
   // initialize goal cell with a very small value to differentiate it from 0.0 (~uninitialized)
   // the negative value means the cell is in the open set
-  obstacle_heuristic_lookup_table[goal_index] = -0.00001f;
+  context.lookup_table[goal_index] = -0.00001f;
 }
 
 float NodeHybrid::getObstacleHeuristic(
+  ObstacleHeuristicContext & context,
   const Coordinates & node_coords,
   const Coordinates & goal_coords,
   const double & cost_penalty)
 {
   // If already expanded, return the cost
-  const unsigned int size_x = sampled_costmap->getSizeInCellsX();
+  const unsigned int size_x = context.sampled_costmap->getSizeInCellsX();
 
   // Divided by 2 due to downsampled costmap.
   unsigned int start_y, start_x;
-  const bool & downsample_H = motion_table.downsample_obstacle_heuristic;
+  const bool & downsample_H = context.downsample;
   if (downsample_H) {
     start_y = floor(node_coords.y / 2.0f);
     start_x = floor(node_coords.x / 2.0f);
@@ -549,7 +550,7 @@ float NodeHybrid::getObstacleHeuristic(
   }
 
   const unsigned int start_index = start_y * size_x + start_x;
-  const float & requested_node_cost = obstacle_heuristic_lookup_table[start_index];
+  const float & requested_node_cost = context.lookup_table[start_index];
   if (requested_node_cost > 0.0f) {
     // costs are doubled due to downsampling
     return downsample_H ? 2.0f * requested_node_cost : requested_node_cost;
@@ -563,16 +564,16 @@ float NodeHybrid::getObstacleHeuristic(
 
   // start_x and start_y have changed since last call
   // we need to recompute 2D distance heuristic and reprioritize queue
-  for (auto & n : obstacle_heuristic_queue) {
-    n.first = -obstacle_heuristic_lookup_table[n.second] +
+  for (auto & n : context.queue) {
+    n.first = -context.lookup_table[n.second] +
       distanceHeuristic2D(n.second, size_x, start_x, start_y);
   }
   std::make_heap(
-    obstacle_heuristic_queue.begin(), obstacle_heuristic_queue.end(),
+    context.queue.begin(), context.queue.end(),
     ObstacleHeuristicComparator{});
 
   const int size_x_int = static_cast<int>(size_x);
-  const unsigned int size_y = sampled_costmap->getSizeInCellsY();
+  const unsigned int size_y = context.sampled_costmap->getSizeInCellsY();
   const float sqrt2 = sqrt(2.0f);
   float c_cost, cost, travel_cost, new_cost, existing_cost;
   unsigned int idx, mx, my;
@@ -583,20 +584,20 @@ float NodeHybrid::getObstacleHeuristic(
     size_x_int + 1, size_x_int - 1,  // upper diagonals
     -size_x_int + 1, -size_x_int - 1};  // lower diagonals
 
-  while (!obstacle_heuristic_queue.empty()) {
-    idx = obstacle_heuristic_queue.front().second;
+  while (!context.queue.empty()) {
+    idx = context.queue.front().second;
     std::pop_heap(
-      obstacle_heuristic_queue.begin(), obstacle_heuristic_queue.end(),
+      context.queue.begin(), context.queue.end(),
       ObstacleHeuristicComparator{});
-    obstacle_heuristic_queue.pop_back();
-    c_cost = obstacle_heuristic_lookup_table[idx];
+    context.queue.pop_back();
+    c_cost = context.lookup_table[idx];
     if (c_cost > 0.0f) {
       // cell has been processed and closed, no further cost improvements
       // are mathematically possible thanks to euclidean distance heuristic consistency
       continue;
     }
     c_cost = -c_cost;
-    obstacle_heuristic_lookup_table[idx] = c_cost;  // set a positive value to close the cell
+    context.lookup_table[idx] = c_cost;  // set a positive value to close the cell
 
     // find neighbors
     for (unsigned int i = 0; i != neighborhood.size(); i++) {
@@ -604,7 +605,7 @@ float NodeHybrid::getObstacleHeuristic(
 
       // if neighbor path is better and non-lethal, set new cost and add to queue
       if (new_idx < size_x * size_y) {
-        cost = static_cast<float>(sampled_costmap->getCost(new_idx));
+        cost = static_cast<float>(context.sampled_costmap->getCost(new_idx));
         if (cost >= INSCRIBED) {
           continue;
         }
@@ -619,9 +620,9 @@ float NodeHybrid::getObstacleHeuristic(
           continue;
         }
 
-        existing_cost = obstacle_heuristic_lookup_table[new_idx];
+        existing_cost = context.lookup_table[new_idx];
         if (existing_cost <= 0.0f) {
-          if (motion_table.use_quadratic_cost_penalty) {
+          if (context.use_quadratic_cost_penalty) {
             travel_cost =
               (i <= 3 ? 1.0f : sqrt2) * (1.0f + (cost_penalty * cost * cost / 64516.0f));  // 254^2
           } else {
@@ -632,11 +633,11 @@ float NodeHybrid::getObstacleHeuristic(
           new_cost = c_cost + travel_cost;
           if (existing_cost == 0.0f || -existing_cost > new_cost) {
             // the negative value means the cell is in the open set
-            obstacle_heuristic_lookup_table[new_idx] = -new_cost;
-            obstacle_heuristic_queue.emplace_back(
+            context.lookup_table[new_idx] = -new_cost;
+            context.queue.emplace_back(
               new_cost + distanceHeuristic2D(new_idx, size_x, start_x, start_y), new_idx);
             std::push_heap(
-              obstacle_heuristic_queue.begin(), obstacle_heuristic_queue.end(),
+              context.queue.begin(), context.queue.end(),
               ObstacleHeuristicComparator{});
           }
         }
@@ -661,7 +662,7 @@ float NodeHybrid::getObstacleHeuristic(
   // msg.header.stamp = node->now();
   // msg.data.resize(size_x * size_y, 0);
   // for (unsigned int i = 0; i != size_y * size_x; i++) {
-  //   msg.data.at(i) = obstacle_heuristic_lookup_table[i] / 10.0;
+  //   msg.data.at(i) = context.lookup_table[i] / 10.0;
   // }
   // pub->publish(std::move(msg));
 
@@ -671,10 +672,12 @@ float NodeHybrid::getObstacleHeuristic(
 }
 
 float NodeHybrid::getDistanceHeuristic(
+  const SearchContext & context,
   const Coordinates & node_coords,
   const Coordinates & goal_coords,
   const float & obstacle_heuristic)
 {
+  const HybridMotionTable & motion_table = context.motion_table;
   // rotate and translate node_coords such that goal_coords relative is (0,0,0)
   // Due to the rounding involved in exact cell increments for caching,
   // this is not an exact replica of a live heuristic, but has bounded error.
@@ -705,8 +708,8 @@ float NodeHybrid::getDistanceHeuristic(
   // to apply the distance heuristic. Since the lookup table is contains only the positive
   // X axis, we mirror the Y and theta values across the X axis to find the heuristic values.
   float motion_heuristic = 0.0;
-  const int floored_size = floor(size_lookup / 2.0);
-  const int ceiling_size = ceil(size_lookup / 2.0);
+  const int floored_size = floor(context.size_lookup / 2.0);
+  const int ceiling_size = ceil(context.size_lookup / 2.0);
   const float mirrored_relative_y = abs(node_coords_relative.y);
   if (abs(node_coords_relative.x) < floored_size && mirrored_relative_y < floored_size) {
     // Need to mirror angle if Y coordinate was mirrored
@@ -722,11 +725,11 @@ float NodeHybrid::getDistanceHeuristic(
       x_pos * ceiling_size * motion_table.num_angle_quantization +
       y_pos * motion_table.num_angle_quantization +
       theta_pos;
-    motion_heuristic = dist_heuristic_lookup_table[index];
+    motion_heuristic = context.dist_heuristic_lookup_table[index];
   } else if (obstacle_heuristic <= 0.0) {
     // If no obstacle heuristic value, must have some H to use
     // In nominal situations, this should never be called.
-    static ompl::base::ScopedState<> from(motion_table.state_space), to(motion_table.state_space);
+    ompl::base::ScopedState<> from(motion_table.state_space), to(motion_table.state_space);
     to[0] = goal_coords.x;
     to[1] = goal_coords.y;
     to[2] = goal_coords.theta * motion_table.num_angle_quantization;
@@ -740,11 +743,15 @@ float NodeHybrid::getDistanceHeuristic(
 }
 
 void NodeHybrid::precomputeDistanceHeuristic(
+  SearchContext & context,
   const float & lookup_table_dim,
   const MotionModel & motion_model,
   const unsigned int & dim_3_size,
   const SearchInfo & search_info)
 {
+  HybridMotionTable & motion_table = context.motion_table;
+  LookupTable & dist_heuristic_lookup_table = context.dist_heuristic_lookup_table;
+  float & size_lookup = context.size_lookup;
   // Dubin or Reeds-Shepp shortest distances
   if (motion_model == MotionModel::DUBIN) {
     motion_table.state_space = std::make_unique<ompl::base::DubinsStateSpace>(
@@ -789,6 +796,7 @@ void NodeHybrid::precomputeDistanceHeuristic(
 }
 
 void NodeHybrid::getNeighbors(
+  const SearchContext & context,
   std::function<bool(const unsigned int &, nav2_smac_planner::NodeHybrid * &)> & NeighborGetter,
   GridCollisionChecker * collision_checker,
   const bool & traverse_unknown,
@@ -797,6 +805,7 @@ void NodeHybrid::getNeighbors(
   unsigned int index = 0;
   NodePtr neighbor = nullptr;
   Coordinates initial_node_coords;
+  const HybridMotionTable & motion_table = context.motion_table;
   const MotionPoses motion_projections = motion_table.getProjections(this);
 
   for (unsigned int i = 0; i != motion_projections.size(); i++) {
@@ -815,7 +824,7 @@ void NodeHybrid::getNeighbors(
           motion_projections[i]._x,
           motion_projections[i]._y,
           motion_projections[i]._theta));
-      if (neighbor->isNodeValid(traverse_unknown, collision_checker)) {
+      if (neighbor->isNodeValid(context, traverse_unknown, collision_checker)) {
         neighbor->setMotionPrimitiveIndex(i, motion_projections[i]._turn_dir);
         neighbors.push_back(neighbor);
       } else {
@@ -825,7 +834,7 @@ void NodeHybrid::getNeighbors(
   }
 }
 
-bool NodeHybrid::backtracePath(CoordinateVector & path)
+bool NodeHybrid::backtracePath(const SearchContext & context, CoordinateVector & path)
 {
   if (!this->parent) {
     return false;
@@ -836,14 +845,14 @@ bool NodeHybrid::backtracePath(CoordinateVector & path)
   while (current_node->parent) {
     path.push_back(current_node->pose);
     // Convert angle to radians
-    path.back().theta = NodeHybrid::motion_table.getAngleFromBin(path.back().theta);
+    path.back().theta = context.motion_table.getAngleFromBin(path.back().theta);
     current_node = current_node->parent;
   }
 
   // add the start pose
   path.push_back(current_node->pose);
   // Convert angle to radians
-  path.back().theta = NodeHybrid::motion_table.getAngleFromBin(path.back().theta);
+  path.back().theta = context.motion_table.getAngleFromBin(path.back().theta);
 
   return true;
 }
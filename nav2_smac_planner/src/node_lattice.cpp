@@ -34,11 +34,6 @@ using namespace std::chrono;  // NOLINT
 namespace nav2_smac_planner
 {
 
-// defining static member for all instance to share
-LatticeMotionTable NodeLattice::motion_table;
-float NodeLattice::size_lookup = 25;
-LookupTable NodeLattice::dist_heuristic_lookup_table;
-
 // Each of these tables are the projected motion models through
 // time and space applied to the search on the current node in
 // continuous map-coordinates (e.g. not meters but partial map cells)
@@ -152,7 +147,7 @@ LatticeMetadata LatticeMotionTable::getLatticeMetadata(const std::string & latti
   return metadata;
 }
 
-unsigned int LatticeMotionTable::getClosestAngularBin(const double & theta)
+unsigned int LatticeMotionTable::getClosestAngularBin(const double & theta) const
 {
   float min_dist = std::numeric_limits<float>::max();
   unsigned int closest_idx = 0;
@@ -167,7 +162,7 @@ unsigned int LatticeMotionTable::getClosestAngularBin(const double & theta)
   return closest_idx;
 }
 
-float & LatticeMotionTable::getAngleFromBin(const unsigned int & bin_idx)
+float LatticeMotionTable::getAngleFromBin(const unsigned int & bin_idx) const
 {
   return lattice_metadata.heading_angles[bin_idx];
 }
@@ -203,15 +198,18 @@ void NodeLattice::reset()
 }
 
 bool NodeLattice::isNodeValid(
+  const SearchContext & context,
   const bool & traverse_unknown,
   GridCollisionChecker * collision_checker,
   MotionPrimitive * motion_primitive,
   bool is_backwards)
 {
+  const LatticeMotionTable & motion_table = context.motion_table;
+
   // Check primitive end pose
   // Convert grid quantization of primitives to radians, then collision checker quantization
-  static const double bin_size = 2.0 * M_PI / collision_checker->getPrecomputedAngles().size();
-  const double & angle = motion_table.getAngleFromBin(this->pose.theta) / bin_size;
+  const double bin_size = 2.0 * M_PI / collision_checker->getPrecomputedAngles().size();
+  const double angle = motion_table.getAngleFromBin(this->pose.theta) / bin_size;
   if (collision_checker->inCollision(
       this->pose.x, this->pose.y, angle /*bin in collision checker*/, traverse_unknown))
   {
@@ -267,8 +265,9 @@ bool NodeLattice::isNodeValid(
   return true;
 }
 
-float NodeLattice::getTraversalCost(const NodePtr & child)
+float NodeLattice::getTraversalCost(const SearchContext & context, const NodePtr & child)
 {
+  const LatticeMotionTable & motion_table = context.motion_table;
   const float normalized_cost = child->getCost() / 252.0;
   if (std::isnan(normalized_cost)) {
     throw std::runtime_error(
@@ -318,19 +317,21 @@ float NodeLattice::getTraversalCost(const NodePtr & child)
 }
 
 float NodeLattice::getHeuristicCost(
+  SearchContext & context,
   const Coordinates & node_coords,
   const Coordinates & goal_coords,
   const nav2_costmap_2d::Costmap2D * /*costmap*/)
 {
   // get obstacle heuristic value
   const float obstacle_heuristic = getObstacleHeuristic(
-    node_coords, goal_coords, motion_table.cost_penalty);
+    context.obstacle_heuristic, node_coords, goal_coords, context.motion_table.cost_penalty);
   const float distance_heuristic =
-    getDistanceHeuristic(node_coords, goal_coords, obstacle_heuristic);
+    getDistanceHeuristic(context, node_coords, goal_coords, obstacle_heuristic);
   return std::max(obstacle_heuristic, distance_heuristic);
 }
 
 void NodeLattice::initMotionModel(
+  SearchContext & context,
   const MotionModel & motion_model,
   unsigned int & size_x,
   unsigned int & /*size_y*/,
@@ -343,14 +344,16 @@ void NodeLattice::initMotionModel(
             " STATE_LATTICE and provide a valid lattice file.");
   }
 
-  motion_table.initMotionModel(size_x, search_info);
+  context.motion_table.initMotionModel(size_x, search_info);
 }
 
 float NodeLattice::getDistanceHeuristic(
+  const SearchContext & context,
   const Coordinates & node_coords,
   const Coordinates & goal_coords,
   const float & obstacle_heuristic)
 {
+  const LatticeMotionTable & motion_table = context.motion_table;
   // rotate and translate node_coords such that goal_coords relative is (0,0,0)
   // Due to the rounding involved in exact cell increments for caching,
   // this is not an exact replica of a live heuristic, but has bounded error.
@@ -381,8 +384,8 @@ float NodeLattice::getDistanceHeuristic(
   // to apply the distance heuristic. Since the lookup table is contains only the positive
   // X axis, we mirror the Y and theta values across the X axis to find the heuristic values.
   float motion_heuristic = 0.0;
-  const int floored_size = floor(size_lookup / 2.0);
-  const int ceiling_size = ceil(size_lookup / 2.0);
+  const int floored_size = floor(context.size_lookup / 2.0);
+  const int ceiling_size = ceil(context.size_lookup / 2.0);
   const float mirrored_relative_y = abs(node_coords_relative.y);
   if (abs(node_coords_relative.x) < floored_size && mirrored_relative_y < floored_size) {
     // Need to mirror angle if Y coordinate was mirrored
@@ -398,9 +401,9 @@ float NodeLattice::getDistanceHeuristic(
       x_pos * ceiling_size * motion_table.num_angle_quantization +
       y_pos * motion_table.num_angle_quantization +
       theta_pos;
-    motion_heuristic = dist_heuristic_lookup_table[index];
+    motion_heuristic = context.dist_heuristic_lookup_table[index];
   } else if (obstacle_heuristic == 0.0) {
-    static ompl::base::ScopedState<> from(motion_table.state_space), to(motion_table.state_space);
+    ompl::base::ScopedState<> from(motion_table.state_space), to(motion_table.state_space);
     to[0] = goal_coords.x;
     to[1] = goal_coords.y;
     to[2] = motion_table.getAngleFromBin(goal_coords.theta);
@@ -414,11 +417,15 @@ float NodeLattice::getDistanceHeuristic(
 }
 
 void NodeLattice::precomputeDistanceHeuristic(
+  SearchContext & context,
   const float & lookup_table_dim,
   const MotionModel & /*motion_model*/,
   const unsigned int & dim_3_size,
   const SearchInfo & search_info)
 {
+  LatticeMotionTable & motion_table = context.motion_table;
+  LookupTable & dist_heuristic_lookup_table = context.dist_heuristic_lookup_table;
+  float & size_lookup = context.size_lookup;
   // Dubin or Reeds-Shepp shortest distances
   if (!search_info.allow_reverse_expansion) {
     motion_table.state_space = std::make_unique<ompl::base::DubinsStateSpace>(
@@ -460,6 +467,7 @@ void NodeLattice::precomputeDistanceHeuristic(
 }
 
 void NodeLattice::getNeighbors(
+  SearchContext & context,
   std::function<bool(const unsigned int &, nav2_smac_planner::NodeLattice * &)> & NeighborGetter,
   GridCollisionChecker * collision_checker,
   const bool & traverse_unknown,
@@ -470,6 +478,7 @@ void NodeLattice::getNeighbors(
   bool backwards = false;
   NodePtr neighbor = nullptr;
   Coordinates initial_node_coords, motion_projection;
+  LatticeMotionTable & motion_table = context.motion_table;
   MotionPrimitivePtrs motion_primitives = motion_table.getMotionPrimitives(this);
   const float & grid_resolution = motion_table.lattice_metadata.grid_resolution;
 
@@ -488,6 +497,7 @@ void NodeLattice::getNeighbors(
     motion_projection.theta = motion_primitives[i]->end_angle /*this is the ending angular bin*/;
 
     index = NodeLattice::getIndex(
+      context,
       static_cast<unsigned int>(motion_projection.x),
       static_cast<unsigned int>(motion_projection.y),
       static_cast<unsigned int>(motion_projection.theta));
@@ -522,7 +532,7 @@ void NodeLattice::getNeighbors(
       // Using a special isNodeValid API here, giving the motion primitive to use to
       // validity check the transition of the current node to the new node over
       if (neighbor->isNodeValid(
-          traverse_unknown, collision_checker, motion_primitives[i], backwards))
+          context, traverse_unknown, collision_checker, motion_primitives[i], backwards))
       {
         neighbor->setMotionPrimitive(motion_primitives[i]);
         // Marking if this search was obtained in the reverse direction
@@ -535,7 +545,7 @@ void NodeLattice::getNeighbors(
   }
 }
 
-bool NodeLattice::backtracePath(CoordinateVector & path)
+bool NodeLattice::backtracePath(const SearchContext & context, CoordinateVector & path)
 {
   if (!this->parent) {
     return false;
@@ -544,30 +554,31 @@ bool NodeLattice::backtracePath(CoordinateVector & path)
   NodePtr current_node = this;
 
   while (current_node->parent) {
-    addNodeToPath(current_node, path);
+    addNodeToPath(context, current_node, path);
     current_node = current_node->parent;
   }
 
   // add start to path
-  addNodeToPath(current_node, path);
+  addNodeToPath(context, current_node, path);
 
   return true;
 }
 
 void NodeLattice::addNodeToPath(
+  const SearchContext & context,
   NodeLattice::NodePtr current_node,
   NodeLattice::CoordinateVector & path)
 {
   Coordinates initial_pose, prim_pose;
   MotionPrimitive * prim = nullptr;
-  const float & grid_resolution = NodeLattice::motion_table.lattice_metadata.grid_resolution;
+  const float & grid_resolution = context.motion_table.lattice_metadata.grid_resolution;
   prim = current_node->getMotionPrimitive();
   // if motion primitive is valid, then was searched (rather than analytically expanded),
   // include dense path of subpoints making up the primitive at grid resolution
   if (prim) {
     initial_pose.x = current_node->pose.x - (prim->poses.back()._x / grid_resolution);
     initial_pose.y = current_node->pose.y - (prim->poses.back()._y / grid_resolution);
-    initial_pose.theta = NodeLattice::motion_table.getAngleFromBin(prim->start_angle);
+    initial_pose.theta = context.motion_table.getAngleFromBin(prim->start_angle);
 
     for (auto it = prim->poses.crbegin(); it != prim->poses.crend(); ++it) {
       // Convert primitive pose into grid space if it should be checked
@@ -585,7 +596,7 @@ void NodeLattice::addNodeToPath(
   } else {
     // For analytic expansion nodes where there is no valid motion primitive
     path.push_back(current_node->pose);
-    path.back().theta = NodeLattice::motion_table.getAngleFromBin(path.back().theta);
+    path.back().theta = context.motion_table.getAngleFromBin(path.back().theta);
   }
 }
 
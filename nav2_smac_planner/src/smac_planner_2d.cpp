@@ -91,6 +91,20 @@ void SmacPlanner2D::configure(
     node, name + ".max_planning_time", rclcpp::ParameterValue(2.0));
   node->get_parameter(name + ".max_planning_time", _max_planning_time);
 
+  std::string open_list;
+  nav2_util::declare_parameter_if_not_declared(
+    node, name + ".open_list", rclcpp::ParameterValue(std::string("BINARY_HEAP")));
+  node->get_parameter(name + ".open_list", open_list);
+  _search_info.open_list_type = openListFromString(open_list);
+  if (_search_info.open_list_type == OpenListType::UNKNOWN) {
+    RCLCPP_WARN(
+      _logger,
+      "Unable to get open list type. Given '%s', "
+      "valid options are BINARY_HEAP, QUATERNARY_HEAP, BUCKET. Using BINARY_HEAP.",
+      open_list.c_str());
+    _search_info.open_list_type = OpenListType::BINARY_HEAP;
+  }
+
   _motion_model = MotionModel::TWOD;
 
   if (_max_on_approach_iterations <= 0) {
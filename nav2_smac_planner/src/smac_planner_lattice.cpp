@@ -120,6 +120,20 @@ void SmacPlannerLattice::configure(
   nav2_util::declare_parameter_if_not_declared(
     node, name + ".max_planning_time", rclcpp::ParameterValue(5.0));
   node->get_parameter(name + ".max_planning_time", _max_planning_time);
+
+  std::string open_list;
+  nav2_util::declare_parameter_if_not_declared(
+    node, name + ".open_list", rclcpp::ParameterValue(std::string("BINARY_HEAP")));
+  node->get_parameter(name + ".open_list", open_list);
+  _search_info.open_list_type = openListFromString(open_list);
+  if (_search_info.open_list_type == OpenListType::UNKNOWN) {
+    RCLCPP_WARN(
+      _logger,
+      "Unable to get open list type. Given '%s', "
+      "valid options are BINARY_HEAP, QUATERNARY_HEAP, BUCKET. Using BINARY_HEAP.",
+      open_list.c_str());
+    _search_info.open_list_type = OpenListType::BINARY_HEAP;
+  }
   nav2_util::declare_parameter_if_not_declared(
     node, name + ".lookup_table_size", rclcpp::ParameterValue(20.0));
   node->get_parameter(name + ".lookup_table_size", _lookup_table_size);
@@ -254,7 +268,8 @@ nav_msgs::msg::Path SmacPlannerLattice::createPlan(
   }
   _a_star->setStart(
     mx, my,
-    NodeLattice::motion_table.getClosestAngularBin(tf2::getYaw(start.pose.orientation)));
+    _a_star->getSearchContext().motion_table.getClosestAngularBin(
+      tf2::getYaw(start.pose.orientation)));
 
   // Set goal point, in A* bin search coordinates
   if (!_costmap->worldToMap(goal.pose.position.x, goal.pose.position.y, mx, my)) {
@@ -264,7 +279,8 @@ nav_msgs::msg::Path SmacPlannerLattice::createPlan(
   }
   _a_star->setGoal(
     mx, my,
-    NodeLattice::motion_table.getClosestAngularBin(tf2::getYaw(goal.pose.orientation)));
+    _a_star->getSearchContext().motion_table.getClosestAngularBin(
+      tf2::getYaw(goal.pose.orientation)));
 
   // Setup message
   nav_msgs::msg::Path plan;
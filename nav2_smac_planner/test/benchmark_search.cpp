@@ -0,0 +1,160 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License. Reserved.
+
+// Compares the open list types. Run the benchmark_search executable from the build
+// directory, each benchmark reports its expansions per second in the "expansions" counter.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "nav2_costmap_2d/costmap_2d.hpp"
+#include "nav2_smac_planner/a_star.hpp"
+#include "nav2_smac_planner/collision_checker.hpp"
+#include "nav2_smac_planner/open_list.hpp"
+
+using nav2_smac_planner::OpenListType;
+
+class RosLockGuard
+{
+public:
+  RosLockGuard() {rclcpp::init(0, nullptr);}
+  ~RosLockGuard() {rclcpp::shutdown();}
+};
+
+RosLockGuard g_rclcpp;
+
+// Open list alone, on a search-like workload: pop the cheapest node, then queue
+// 8 neighbors one step more expensive, some of which are already queued
+template<OpenListType type>
+static void BM_OpenList(benchmark::State & state)
+{
+  typedef nav2_smac_planner::NodeBasic<nav2_smac_planner::NodeHybrid> Payload;
+  const unsigned int num_indices = 100000;
+  nav2_smac_planner::OpenList<Payload> open_list(type);
+  std::vector<float> costs(num_indices);
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<float> step(1.0f, 1.5f);
+  std::uniform_int_distribution<unsigned int> neighbor(1, 2000);
+
+  int64_t expansions = 0;
+  for (auto _ : state) {
+    std::fill(costs.begin(), costs.end(), std::numeric_limits<float>::max());
+    open_list.clear();
+    costs[0] = 0.0f;
+    open_list.push(0.0f, 0u, Payload(0u));
+    for (unsigned int i = 0; i != 20000 && !open_list.empty(); i++) {
+      const unsigned int index = open_list.pop().index;
+      for (unsigned int j = 0; j != 8; j++) {
+        const unsigned int neighbor_index = (index + neighbor(gen)) % num_indices;
+        const float cost = costs[index] + step(gen);
+        if (cost < costs[neighbor_index]) {
+          costs[neighbor_index] = cost;
+          open_list.push(cost, neighbor_index, Payload(neighbor_index));
+        }
+      }
+      expansions++;
+    }
+  }
+  state.counters["expansions"] = benchmark::Counter(
+    static_cast<double>(expansions), benchmark::Counter::kIsRate);
+}
+
+// Fills a square costmap with lethal islands surrounded by a cost gradient
+static void addIslands(nav2_costmap_2d::Costmap2D & costmap)
+{
+  const unsigned int size = costmap.getSizeInCellsX();
+  for (unsigned int x = size / 10; x < size; x += size / 5) {
+    for (unsigned int y = size / 10; y < size; y += size / 5) {
+      for (unsigned int i = x; i < std::min(x + size / 10, size); ++i) {
+        for (unsigned int j = y; j < std::min(y + size / 10, size); ++j) {
+          costmap.setCost(i, j, 254);
+        }
+      }
+      for (unsigned int i = x - 3; i < std::min(x + size / 10 + 3, size); ++i) {
+        for (unsigned int j = y - 3; j < std::min(y + size / 10 + 3, size); ++j) {
+          if (costmap.getCost(i, j) == 0) {
+            costmap.setCost(i, j, 100);
+          }
+        }
+      }
+    }
+  }
+}
+
+template<typename NodeT>
+static void runSearch(
+  benchmark::State & state, const nav2_smac_planner::MotionModel & motion_model,
+  const OpenListType & type, const unsigned int & size, const unsigned int & size_theta)
+{
+  auto node = std::make_shared<rclcpp_lifecycle::LifecycleNode>("benchmark_search");
+  nav2_smac_planner::SearchInfo info;
+  info.minimum_turning_radius = 8;  // in grid coordinates
+  info.analytic_expansion_max_length = 20.0;  // in grid coordinates
+  info.open_list_type = type;
+  int max_iterations = std::numeric_limits<int>::max();
+  nav2_smac_planner::AStarAlgorithm<NodeT> a_star(motion_model, info);
+  a_star.initialize(false, max_iterations, 1000, 60.0, 401, size_theta);
+
+  nav2_costmap_2d::Costmap2D costmap(size, size, 0.05, 0.0, 0.0, 0);
+  addIslands(costmap);
+  nav2_smac_planner::GridCollisionChecker checker(&costmap, size_theta, node);
+  checker.setFootprint(nav2_costmap_2d::Footprint(), true, 0.0);
+  a_star.setCollisionChecker(&checker);
+
+  int64_t expansions = 0;
+  typename NodeT::CoordinateVector path;
+  for (auto _ : state) {
+    a_star.setStart(size / 20, size / 20, 0u);
+    a_star.setGoal(17 * size / 20, 17 * size / 20, 0u);
+    path.clear();
+    int num_iterations = 0;
+    if (!a_star.createPath(path, num_iterations, 0.0)) {
+      state.SkipWithError("No path found");
+      break;
+    }
+    expansions += num_iterations;
+  }
+  state.counters["expansions"] = benchmark::Counter(
+    static_cast<double>(expansions), benchmark::Counter::kIsRate);
+}
+
+template<OpenListType type>
+static void BM_Search2D(benchmark::State & state)
+{
+  runSearch<nav2_smac_planner::Node2D>(state, nav2_smac_planner::MotionModel::TWOD, type, 800, 1);
+}
+
+template<OpenListType type>
+static void BM_SearchHybrid(benchmark::State & state)
+{
+  runSearch<nav2_smac_planner::NodeHybrid>(
+    state, nav2_smac_planner::MotionModel::DUBIN, type, 400, 72);
+}
+
+BENCHMARK_TEMPLATE(BM_OpenList, OpenListType::BINARY_HEAP)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_OpenList, OpenListType::QUATERNARY_HEAP)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_OpenList, OpenListType::BUCKET)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Search2D, OpenListType::BINARY_HEAP)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Search2D, OpenListType::QUATERNARY_HEAP)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Search2D, OpenListType::BUCKET)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SearchHybrid, OpenListType::BINARY_HEAP)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SearchHybrid, OpenListType::QUATERNARY_HEAP)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -15,6 +15,7 @@
 #include <math.h>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 #include <limits>
 
@@ -292,6 +293,147 @@ TEST(AStarTest, test_se2_single_pose_path)
   delete costmapA;
 }
 
+TEST(AStarTest, test_concurrent_planners)
+{
+  // Planners with different motion models and costmap sizes keep their own search state,
+  // so they may run concurrently and find the same paths as when run alone
+  auto lnode = std::make_shared<rclcpp_lifecycle::LifecycleNode>("test");
+  unsigned int size_theta = 72;
+  int max_iterations = 10000;
+  int it_on_approach = 10;
+  double max_planning_time = 120.0;
+  float tolerance = 10.0;
+
+  auto plan = [&](
+    const nav2_smac_planner::MotionModel & motion_model, const float & turning_radius,
+    const unsigned int & size, nav2_smac_planner::NodeHybrid::CoordinateVector & path)
+    {
+      nav2_smac_planner::SearchInfo info;
+      info.change_penalty = 0.1;
+      info.non_straight_penalty = 1.1;
+      info.reverse_penalty = 2.0;
+      info.retrospective_penalty = 0.015;
+      info.minimum_turning_radius = turning_radius;  // in grid coordinates
+      info.analytic_expansion_max_length = 20.0;  // in grid coordinates
+      info.analytic_expansion_ratio = 3.5;
+      info.cost_penalty = 1.7;
+      nav2_smac_planner::AStarAlgorithm<nav2_smac_planner::NodeHybrid> a_star(
+        motion_model, info);
+      a_star.initialize(
+        false, max_iterations, it_on_approach, max_planning_time, 401, size_theta);
+
+      nav2_costmap_2d::Costmap2D costmap(size, size, 0.1, 0.0, 0.0, 0);
+      // island in the middle of lethal cost to cross
+      for (unsigned int i = 2 * size / 5; i <= 3 * size / 5; ++i) {
+        for (unsigned int j = 2 * size / 5; j <= 3 * size / 5; ++j) {
+          costmap.setCost(i, j, 254);
+        }
+      }
+      nav2_smac_planner::GridCollisionChecker checker(&costmap, size_theta, lnode);
+      checker.setFootprint(nav2_costmap_2d::Footprint(), true, 0.0);
+
+      int num_it = 0;
+      a_star.setCollisionChecker(&checker);
+      a_star.setStart(size / 10, size / 10, 0u);
+      a_star.setGoal(4 * size / 5, 4 * size / 5, 40u);
+      return a_star.createPath(path, num_it, tolerance);
+    };
+
+  nav2_smac_planner::NodeHybrid::CoordinateVector dubin_path, reeds_path;
+  ASSERT_TRUE(plan(nav2_smac_planner::MotionModel::DUBIN, 8, 100, dubin_path));
+  ASSERT_TRUE(plan(nav2_smac_planner::MotionModel::REEDS_SHEPP, 4, 150, reeds_path));
+
+  std::vector<nav2_smac_planner::NodeHybrid::CoordinateVector> dubin_paths(2), reeds_paths(2);
+  std::vector<std::thread> threads;
+  bool success[4] = {false, false, false, false};
+  for (unsigned int i = 0; i != 2; i++) {
+    threads.emplace_back(
+      [&, i]() {
+        success[2 * i] = plan(nav2_smac_planner::MotionModel::DUBIN, 8, 100, dubin_paths[i]);
+      });
+    threads.emplace_back(
+      [&, i]() {
+        success[2 * i + 1] =
+        plan(nav2_smac_planner::MotionModel::REEDS_SHEPP, 4, 150, reeds_paths[i]);
+      });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  for (unsigned int i = 0; i != 2; i++) {
+    EXPECT_TRUE(success[2 * i]);
+    EXPECT_TRUE(success[2 * i + 1]);
+    ASSERT_EQ(dubin_paths[i].size(), dubin_path.size());
+    ASSERT_EQ(reeds_paths[i].size(), reeds_path.size());
+    for (unsigned int j = 0; j != dubin_path.size(); j++) {
+      EXPECT_EQ(dubin_paths[i][j].x, dubin_path[j].x);
+      EXPECT_EQ(dubin_paths[i][j].y, dubin_path[j].y);
+      EXPECT_EQ(dubin_paths[i][j].theta, dubin_path[j].theta);
+    }
+    for (unsigned int j = 0; j != reeds_path.size(); j++) {
+      EXPECT_EQ(reeds_paths[i][j].x, reeds_path[j].x);
+      EXPECT_EQ(reeds_paths[i][j].y, reeds_path[j].y);
+      EXPECT_EQ(reeds_paths[i][j].theta, reeds_path[j].theta);
+    }
+  }
+}
+
+TEST(AStarTest, test_open_lists)
+{
+  auto lnode = std::make_shared<rclcpp_lifecycle::LifecycleNode>("test");
+  int max_iterations = 10000;
+  int it_on_approach = 10;
+  double max_planning_time = 120.0;
+  float tolerance = 0.0;
+
+  nav2_costmap_2d::Costmap2D costmap(100, 100, 0.1, 0.0, 0.0, 0);
+  // island in the middle of lethal cost to cross
+  for (unsigned int i = 40; i <= 60; ++i) {
+    for (unsigned int j = 40; j <= 60; ++j) {
+      costmap.setCost(i, j, 254);
+    }
+  }
+  nav2_smac_planner::GridCollisionChecker checker(&costmap, 1, lnode);
+  checker.setFootprint(nav2_costmap_2d::Footprint(), true, 0.0);
+
+  auto plan = [&](const nav2_smac_planner::OpenListType & type, float & length)
+    {
+      nav2_smac_planner::SearchInfo info;
+      info.open_list_type = type;
+      nav2_smac_planner::AStarAlgorithm<nav2_smac_planner::Node2D> a_star(
+        nav2_smac_planner::MotionModel::TWOD, info);
+      a_star.initialize(false, max_iterations, it_on_approach, max_planning_time, 0.0, 1);
+      a_star.setCollisionChecker(&checker);
+      a_star.setStart(20u, 20u, 0);
+      a_star.setGoal(80u, 80u, 0);
+
+      int num_it = 0;
+      nav2_smac_planner::Node2D::CoordinateVector path;
+      if (!a_star.createPath(path, num_it, tolerance)) {
+        return false;
+      }
+      length = 0.0;
+      for (unsigned int i = 0; i != path.size(); i++) {
+        EXPECT_EQ(costmap.getCost(path[i].x, path[i].y), 0);
+        if (i > 0) {
+          length += hypotf(path[i].x - path[i - 1].x, path[i].y - path[i - 1].y);
+        }
+      }
+      return true;
+    };
+
+  float binary_length = 0.0, quaternary_length = 0.0, bucket_length = 0.0;
+  EXPECT_TRUE(plan(nav2_smac_planner::OpenListType::BINARY_HEAP, binary_length));
+  EXPECT_TRUE(plan(nav2_smac_planner::OpenListType::QUATERNARY_HEAP, quaternary_length));
+  EXPECT_TRUE(plan(nav2_smac_planner::OpenListType::BUCKET, bucket_length));
+
+  // Both heaps find an optimal path, buckets are only ordered up to a unit of cost
+  EXPECT_NEAR(quaternary_length, binary_length, 1e-3);
+  EXPECT_GE(bucket_length, binary_length - 1e-3);
+  EXPECT_LE(bucket_length, binary_length + 1.0);
+}
+
 TEST(AStarTest, test_constants)
 {
   nav2_smac_planner::MotionModel mm = nav2_smac_planner::MotionModel::UNKNOWN;  // unknown
@@ -50,26 +50,27 @@ TEST(Node2DTest, test_node_2d)
   nav2_smac_planner::SearchInfo info;
   info.cost_penalty = 1.0;
   unsigned int size = 10;
+  nav2_smac_planner::Node2D::SearchContext context;
   nav2_smac_planner::Node2D::initMotionModel(
-    nav2_smac_planner::MotionModel::TWOD, size, size, size, info);
+    context, nav2_smac_planner::MotionModel::TWOD, size, size, size, info);
 
   // test reset
   testA.reset();
   EXPECT_TRUE(std::isnan(testA.getCost()));
 
   // check collision checking
-  EXPECT_EQ(testA.isNodeValid(false, checker.get()), true);
+  EXPECT_EQ(testA.isNodeValid(context, false, checker.get()), true);
   testA.setCost(255);
-  EXPECT_EQ(testA.isNodeValid(true, checker.get()), true);
+  EXPECT_EQ(testA.isNodeValid(context, true, checker.get()), true);
   testA.setCost(10);
 
   // check traversal cost computation
-  EXPECT_NEAR(testB.getTraversalCost(&testA), 1.03f, 0.1f);
+  EXPECT_NEAR(testB.getTraversalCost(context, &testA), 1.03f, 0.1f);
 
   // check heuristic cost computation
   nav2_smac_planner::Node2D::Coordinates A(0.0, 0.0);
   nav2_smac_planner::Node2D::Coordinates B(10.0, 5.0);
-  EXPECT_NEAR(testB.getHeuristicCost(A, B, nullptr), 11.18, 0.02);
+  EXPECT_NEAR(testB.getHeuristicCost(context, A, B, nullptr), 11.18, 0.02);
 
   // check operator== works on index
   unsigned char costC = '2';
@@ -109,18 +110,19 @@ TEST(Node2DTest, test_node_2d_neighbors)
   unsigned int quant = 0u;
   // test neighborhood computation
   size_x = 100u;
+  nav2_smac_planner::Node2D::SearchContext context;
   nav2_smac_planner::Node2D::initMotionModel(
-    nav2_smac_planner::MotionModel::TWOD, size_x, size_y,
+    context, nav2_smac_planner::MotionModel::TWOD, size_x, size_y,
     quant, info);
-  EXPECT_EQ(nav2_smac_planner::Node2D::_neighbors_grid_offsets.size(), 8u);
-  EXPECT_EQ(nav2_smac_planner::Node2D::_neighbors_grid_offsets[0], -1);
-  EXPECT_EQ(nav2_smac_planner::Node2D::_neighbors_grid_offsets[1], 1);
-  EXPECT_EQ(nav2_smac_planner::Node2D::_neighbors_grid_offsets[2], -100);
-  EXPECT_EQ(nav2_smac_planner::Node2D::_neighbors_grid_offsets[3], 100);
-  EXPECT_EQ(nav2_smac_planner::Node2D::_neighbors_grid_offsets[4], -101);
-  EXPECT_EQ(nav2_smac_planner::Node2D::_neighbors_grid_offsets[5], -99);
-  EXPECT_EQ(nav2_smac_planner::Node2D::_neighbors_grid_offsets[6], 99);
-  EXPECT_EQ(nav2_smac_planner::Node2D::_neighbors_grid_offsets[7], 101);
+  EXPECT_EQ(context.neighbors_grid_offsets.size(), 8u);
+  EXPECT_EQ(context.neighbors_grid_offsets[0], -1);
+  EXPECT_EQ(context.neighbors_grid_offsets[1], 1);
+  EXPECT_EQ(context.neighbors_grid_offsets[2], -100);
+  EXPECT_EQ(context.neighbors_grid_offsets[3], 100);
+  EXPECT_EQ(context.neighbors_grid_offsets[4], -101);
+  EXPECT_EQ(context.neighbors_grid_offsets[5], -99);
+  EXPECT_EQ(context.neighbors_grid_offsets[6], 99);
+  EXPECT_EQ(context.neighbors_grid_offsets[7], 101);
 
   nav2_costmap_2d::Costmap2D costmapA(10, 10, 0.05, 0.0, 0.0, 0);
   std::unique_ptr<nav2_smac_planner::GridCollisionChecker> checker =
@@ -135,7 +137,7 @@ TEST(Node2DTest, test_node_2d_neighbors)
     };
 
   nav2_smac_planner::Node2D::NodeVector neighbors;
-  node->getNeighbors(neighborGetter, checker.get(), false, neighbors);
+  node->getNeighbors(context, neighborGetter, checker.get(), false, neighbors);
   delete node;
 
   // should be empty since totally invalid
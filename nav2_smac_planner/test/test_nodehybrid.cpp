@@ -50,10 +50,11 @@ TEST(NodeHybridTest, test_node_hybrid)
 
   // Check defaulted constants
   nav2_smac_planner::NodeHybrid testA(49);
-  EXPECT_EQ(testA.travel_distance_cost, sqrt(2));
+  nav2_smac_planner::NodeHybrid::SearchContext context;
+  EXPECT_EQ(context.travel_distance_cost, sqrt(2));
 
   nav2_smac_planner::NodeHybrid::initMotionModel(
-    nav2_smac_planner::MotionModel::DUBIN, size_x, size_y, size_theta, info);
+    context, nav2_smac_planner::MotionModel::DUBIN, size_x, size_y, size_theta, info);
 
   nav2_costmap_2d::Costmap2D * costmapA = new nav2_costmap_2d::Costmap2D(
     10, 10, 0.05, 0.0, 0.0, 0);
@@ -69,8 +70,8 @@ TEST(NodeHybridTest, test_node_hybrid)
   testA.pose.x = 5;
   testA.pose.y = 5;
   testA.pose.theta = 0;
-  EXPECT_EQ(testA.isNodeValid(true, checker.get()), true);
-  EXPECT_EQ(testA.isNodeValid(false, checker.get()), true);
+  EXPECT_EQ(testA.isNodeValid(context, true, checker.get()), true);
+  EXPECT_EQ(testA.isNodeValid(context, false, checker.get()), true);
   EXPECT_EQ(testA.getCost(), 0.0f);
 
   // test reset
@@ -78,34 +79,34 @@ TEST(NodeHybridTest, test_node_hybrid)
   EXPECT_TRUE(std::isnan(testA.getCost()));
 
   // Check motion-specific constants
-  EXPECT_NEAR(testA.travel_distance_cost, 2.08842, 0.1);
+  EXPECT_NEAR(context.travel_distance_cost, 2.08842, 0.1);
 
   // check collision checking
-  EXPECT_EQ(testA.isNodeValid(false, checker.get()), true);
+  EXPECT_EQ(testA.isNodeValid(context, false, checker.get()), true);
 
   // check traversal cost computation
   // simulated first node, should return neutral cost
-  EXPECT_NEAR(testB.getTraversalCost(&testA), 2.088, 0.1);
+  EXPECT_NEAR(testB.getTraversalCost(context, &testA), 2.088, 0.1);
   // now with straight motion, cost is 0, so will be neutral as well
   // but now reduced by retrospective penalty (10%)
   testB.setMotionPrimitiveIndex(1, nav2_smac_planner::TurnDirection::LEFT);
   testA.setMotionPrimitiveIndex(0, nav2_smac_planner::TurnDirection::FORWARD);
-  EXPECT_NEAR(testB.getTraversalCost(&testA), 2.088f * 0.9, 0.1);
+  EXPECT_NEAR(testB.getTraversalCost(context, &testA), 2.088f * 0.9, 0.1);
   // same direction as parent, testB
   testA.setMotionPrimitiveIndex(1, nav2_smac_planner::TurnDirection::LEFT);
-  EXPECT_NEAR(testB.getTraversalCost(&testA), 2.294f * 0.9, 0.01);
+  EXPECT_NEAR(testB.getTraversalCost(context, &testA), 2.294f * 0.9, 0.01);
   // opposite direction as parent, testB
   testA.setMotionPrimitiveIndex(2, nav2_smac_planner::TurnDirection::RIGHT);
-  EXPECT_NEAR(testB.getTraversalCost(&testA), 2.506f * 0.9, 0.01);
+  EXPECT_NEAR(testB.getTraversalCost(context, &testA), 2.506f * 0.9, 0.01);
   // reverse direction as parent, testB
   testA.setMotionPrimitiveIndex(1, nav2_smac_planner::TurnDirection::REV_RIGHT);
-  EXPECT_NEAR(testB.getTraversalCost(&testA), 2.513f * 0.9 * 2.0, 0.01);
+  EXPECT_NEAR(testB.getTraversalCost(context, &testA), 2.513f * 0.9 * 2.0, 0.01);
   // reverse direction as parent, testB
   testA.setMotionPrimitiveIndex(2, nav2_smac_planner::TurnDirection::REV_LEFT);
-  EXPECT_NEAR(testB.getTraversalCost(&testA), 2.513f * 0.9 * 2.0, 0.01);
+  EXPECT_NEAR(testB.getTraversalCost(context, &testA), 2.513f * 0.9 * 2.0, 0.01);
 
   // will throw because never collision checked testB
-  EXPECT_THROW(testA.getTraversalCost(&testB), std::runtime_error);
+  EXPECT_THROW(testA.getTraversalCost(context, &testB), std::runtime_error);
 
   // check motion primitives
   EXPECT_EQ(testA.getMotionPrimitiveIndex(), 2u);
@@ -155,8 +156,9 @@ TEST(NodeHybridTest, test_obstacle_heuristic)
   unsigned int size_y = 100;
   unsigned int size_theta = 72;
 
+  nav2_smac_planner::NodeHybrid::SearchContext context;
   nav2_smac_planner::NodeHybrid::initMotionModel(
-    nav2_smac_planner::MotionModel::DUBIN, size_x, size_y, size_theta, info);
+    context, nav2_smac_planner::MotionModel::DUBIN, size_x, size_y, size_theta, info);
 
   nav2_costmap_2d::Costmap2D * costmapA = new nav2_costmap_2d::Costmap2D(
     100, 100, 0.1, 0.0, 0.0, 0);
@@ -196,8 +198,9 @@ TEST(NodeHybridTest, test_obstacle_heuristic)
     costmapA->setCost(50, j, 254);
   }
   nav2_smac_planner::NodeHybrid::resetObstacleHeuristic(
-    costmapA, testA.pose.x, testA.pose.y, testB.pose.x, testB.pose.y);
+    context.obstacle_heuristic, costmapA, testA.pose.x, testA.pose.y, testB.pose.x, testB.pose.y);
   float wide_passage_cost = nav2_smac_planner::NodeHybrid::getObstacleHeuristic(
+    context.obstacle_heuristic,
     testA.pose,
     testB.pose,
     info.cost_penalty);
@@ -211,9 +214,10 @@ TEST(NodeHybridTest, test_obstacle_heuristic)
     costmapA->setCost(50, j, 250);
   }
   nav2_smac_planner::NodeHybrid::resetObstacleHeuristic(
-    costmapA,
+    context.obstacle_heuristic, costmapA,
     testA.pose.x, testA.pose.y, testB.pose.x, testB.pose.y);
   float two_passages_cost = nav2_smac_planner::NodeHybrid::getObstacleHeuristic(
+    context.obstacle_heuristic,
     testA.pose,
     testB.pose,
     info.cost_penalty);
@@ -234,22 +238,23 @@ TEST(NodeHybridTest, test_node_debin_neighbors)
   unsigned int size_x = 100;
   unsigned int size_y = 100;
   unsigned int size_theta = 72;
+  nav2_smac_planner::NodeHybrid::SearchContext context;
   nav2_smac_planner::NodeHybrid::initMotionModel(
-    nav2_smac_planner::MotionModel::DUBIN, size_x, size_y, size_theta, info);
+    context, nav2_smac_planner::MotionModel::DUBIN, size_x, size_y, size_theta, info);
 
   // test neighborhood computation
-  EXPECT_EQ(nav2_smac_planner::NodeHybrid::motion_table.projections.size(), 3u);
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[0]._x, 1.731517, 0.01);
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[0]._y, 0, 0.01);
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[0]._theta, 0, 0.01);
-
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[1]._x, 1.69047, 0.01);
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[1]._y, 0.3747, 0.01);
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[1]._theta, 5, 0.01);
-
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[2]._x, 1.69047, 0.01);
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[2]._y, -0.3747, 0.01);
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[2]._theta, -5, 0.01);
+  EXPECT_EQ(context.motion_table.projections.size(), 3u);
+  EXPECT_NEAR(context.motion_table.projections[0]._x, 1.731517, 0.01);
+  EXPECT_NEAR(context.motion_table.projections[0]._y, 0, 0.01);
+  EXPECT_NEAR(context.motion_table.projections[0]._theta, 0, 0.01);
+
+  EXPECT_NEAR(context.motion_table.projections[1]._x, 1.69047, 0.01);
+  EXPECT_NEAR(context.motion_table.projections[1]._y, 0.3747, 0.01);
+  EXPECT_NEAR(context.motion_table.projections[1]._theta, 5, 0.01);
+
+  EXPECT_NEAR(context.motion_table.projections[2]._x, 1.69047, 0.01);
+  EXPECT_NEAR(context.motion_table.projections[2]._y, -0.3747, 0.01);
+  EXPECT_NEAR(context.motion_table.projections[2]._theta, -5, 0.01);
 }
 
 TEST(NodeHybridTest, test_interpolation_prims)
@@ -267,10 +272,11 @@ TEST(NodeHybridTest, test_interpolation_prims)
 
   // Test to make sure the right num. of prims are generated when interpolation is on
   info.allow_primitive_interpolation = true;
+  nav2_smac_planner::NodeHybrid::SearchContext context;
   nav2_smac_planner::NodeHybrid::initMotionModel(
-    nav2_smac_planner::MotionModel::DUBIN, size_x, size_y, size_theta, info);
+    context, nav2_smac_planner::MotionModel::DUBIN, size_x, size_y, size_theta, info);
 
-  EXPECT_EQ(nav2_smac_planner::NodeHybrid::motion_table.projections.size(), 5u);
+  EXPECT_EQ(context.motion_table.projections.size(), 5u);
 }
 
 TEST(NodeHybridTest, test_interpolation_prims2)
@@ -288,10 +294,11 @@ TEST(NodeHybridTest, test_interpolation_prims2)
 
   // Test to make sure the right num. of prims are generated when interpolation is on
   info.allow_primitive_interpolation = true;
+  nav2_smac_planner::NodeHybrid::SearchContext context;
   nav2_smac_planner::NodeHybrid::initMotionModel(
-    nav2_smac_planner::MotionModel::DUBIN, size_x, size_y, size_theta, info);
+    context, nav2_smac_planner::MotionModel::DUBIN, size_x, size_y, size_theta, info);
 
-  EXPECT_EQ(nav2_smac_planner::NodeHybrid::motion_table.projections.size(), 7u);
+  EXPECT_EQ(context.motion_table.projections.size(), 7u);
 }
 
 TEST(NodeHybridTest, test_node_reeds_neighbors)
@@ -306,33 +313,34 @@ TEST(NodeHybridTest, test_node_reeds_neighbors)
   unsigned int size_x = 100;
   unsigned int size_y = 100;
   unsigned int size_theta = 72;
+  nav2_smac_planner::NodeHybrid::SearchContext context;
   nav2_smac_planner::NodeHybrid::initMotionModel(
-    nav2_smac_planner::MotionModel::REEDS_SHEPP, size_x, size_y, size_theta, info);
+    context, nav2_smac_planner::MotionModel::REEDS_SHEPP, size_x, size_y, size_theta, info);
 
-  EXPECT_EQ(nav2_smac_planner::NodeHybrid::motion_table.projections.size(), 6u);
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[0]._x, 2.088, 0.01);
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[0]._y, 0, 0.01);
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[0]._theta, 0, 0.01);
+  EXPECT_EQ(context.motion_table.projections.size(), 6u);
+  EXPECT_NEAR(context.motion_table.projections[0]._x, 2.088, 0.01);
+  EXPECT_NEAR(context.motion_table.projections[0]._y, 0, 0.01);
+  EXPECT_NEAR(context.motion_table.projections[0]._theta, 0, 0.01);
 
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[1]._x, 2.070, 0.01);
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[1]._y, 0.272, 0.01);
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[1]._theta, 3, 0.01);
+  EXPECT_NEAR(context.motion_table.projections[1]._x, 2.070, 0.01);
+  EXPECT_NEAR(context.motion_table.projections[1]._y, 0.272, 0.01);
+  EXPECT_NEAR(context.motion_table.projections[1]._theta, 3, 0.01);
 
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[2]._x, 2.070, 0.01);
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[2]._y, -0.272, 0.01);
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[2]._theta, -3, 0.01);
+  EXPECT_NEAR(context.motion_table.projections[2]._x, 2.070, 0.01);
+  EXPECT_NEAR(context.motion_table.projections[2]._y, -0.272, 0.01);
+  EXPECT_NEAR(context.motion_table.projections[2]._theta, -3, 0.01);
 
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[3]._x, -2.088, 0.01);
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[3]._y, 0, 0.01);
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[3]._theta, 0, 0.01);
+  EXPECT_NEAR(context.motion_table.projections[3]._x, -2.088, 0.01);
+  EXPECT_NEAR(context.motion_table.projections[3]._y, 0, 0.01);
+  EXPECT_NEAR(context.motion_table.projections[3]._theta, 0, 0.01);
 
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[4]._x, -2.07, 0.01);
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[4]._y, 0.272, 0.01);
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[4]._theta, -3, 0.01);
+  EXPECT_NEAR(context.motion_table.projections[4]._x, -2.07, 0.01);
+  EXPECT_NEAR(context.motion_table.projections[4]._y, 0.272, 0.01);
+  EXPECT_NEAR(context.motion_table.projections[4]._theta, -3, 0.01);
 
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[5]._x, -2.07, 0.01);
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[5]._y, -0.272, 0.01);
-  EXPECT_NEAR(nav2_smac_planner::NodeHybrid::motion_table.projections[5]._theta, 3, 0.01);
+  EXPECT_NEAR(context.motion_table.projections[5]._x, -2.07, 0.01);
+  EXPECT_NEAR(context.motion_table.projections[5]._y, -0.272, 0.01);
+  EXPECT_NEAR(context.motion_table.projections[5]._theta, 3, 0.01);
 
   nav2_costmap_2d::Costmap2D costmapA(100, 100, 0.05, 0.0, 0.0, 0);
   std::unique_ptr<nav2_smac_planner::GridCollisionChecker> checker =
@@ -347,7 +355,7 @@ TEST(NodeHybridTest, test_node_reeds_neighbors)
     };
 
   nav2_smac_planner::NodeHybrid::NodeVector neighbors;
-  node->getNeighbors(neighborGetter, checker.get(), false, neighbors);
+  node->getNeighbors(context, neighborGetter, checker.get(), false, neighbors);
   delete node;
 
   // should be empty since totally invalid
@@ -116,20 +116,21 @@ TEST(NodeLatticeTest, test_node_lattice_neighbors_and_parsing)
   unsigned int y = 100;
   unsigned int angle_quantization = 16;
 
+  nav2_smac_planner::NodeLattice::SearchContext context;
   nav2_smac_planner::NodeLattice::initMotionModel(
-    nav2_smac_planner::MotionModel::STATE_LATTICE, x, y, angle_quantization, info);
+    context, nav2_smac_planner::MotionModel::STATE_LATTICE, x, y, angle_quantization, info);
 
   nav2_smac_planner::NodeLattice aNode(0);
   aNode.setPose(nav2_smac_planner::NodeHybrid::Coordinates(0, 0, 0));
   nav2_smac_planner::MotionPrimitivePtrs projections =
-    nav2_smac_planner::NodeLattice::motion_table.getMotionPrimitives(&aNode);
+    context.motion_table.getMotionPrimitives(&aNode);
 
   EXPECT_NEAR(projections[0]->poses.back()._x, 0.5, 0.01);
   EXPECT_NEAR(projections[0]->poses.back()._y, -0.35, 0.01);
   EXPECT_NEAR(projections[0]->poses.back()._theta, 5.176, 0.01);
 
   EXPECT_NEAR(
-    nav2_smac_planner::NodeLattice::motion_table.getLatticeMetadata(
+    nav2_smac_planner::LatticeMotionTable::getLatticeMetadata(
       filePath).grid_resolution, 0.05, 0.005);
 }
 
@@ -156,19 +157,20 @@ TEST(NodeLatticeTest, test_node_lattice_conversions)
   unsigned int y = 100;
   unsigned int angle_quantization = 16;
 
+  nav2_smac_planner::NodeLattice::SearchContext context;
   nav2_smac_planner::NodeLattice::initMotionModel(
-    nav2_smac_planner::MotionModel::STATE_LATTICE, x, y, angle_quantization, info);
+    context, nav2_smac_planner::MotionModel::STATE_LATTICE, x, y, angle_quantization, info);
 
   nav2_smac_planner::NodeLattice aNode(0);
   aNode.setPose(nav2_smac_planner::NodeHybrid::Coordinates(0, 0, 0));
 
-  EXPECT_NEAR(aNode.motion_table.getAngleFromBin(0u), 0.0, 0.005);
-  EXPECT_NEAR(aNode.motion_table.getAngleFromBin(1u), 0.46364, 0.005);
-  EXPECT_NEAR(aNode.motion_table.getAngleFromBin(2u), 0.78539, 0.005);
+  EXPECT_NEAR(context.motion_table.getAngleFromBin(0u), 0.0, 0.005);
+  EXPECT_NEAR(context.motion_table.getAngleFromBin(1u), 0.46364, 0.005);
+  EXPECT_NEAR(context.motion_table.getAngleFromBin(2u), 0.78539, 0.005);
 
-  EXPECT_EQ(aNode.motion_table.getClosestAngularBin(0.0), 0u);
-  EXPECT_EQ(aNode.motion_table.getClosestAngularBin(0.5), 1u);
-  EXPECT_EQ(aNode.motion_table.getClosestAngularBin(1.5), 4u);
+  EXPECT_EQ(context.motion_table.getClosestAngularBin(0.0), 0u);
+  EXPECT_EQ(context.motion_table.getClosestAngularBin(0.5), 1u);
+  EXPECT_EQ(context.motion_table.getClosestAngularBin(1.5), 4u);
 }
 
 TEST(NodeLatticeTest, test_node_lattice)
@@ -196,8 +198,9 @@ TEST(NodeLatticeTest, test_node_lattice)
   unsigned int y = 100;
   unsigned int angle_quantization = 16;
 
+  nav2_smac_planner::NodeLattice::SearchContext context;
   nav2_smac_planner::NodeLattice::initMotionModel(
-    nav2_smac_planner::MotionModel::STATE_LATTICE, x, y, angle_quantization, info);
+    context, nav2_smac_planner::MotionModel::STATE_LATTICE, x, y, angle_quantization, info);
 
   // Check defaults
   nav2_smac_planner::NodeLattice aNode(0);
@@ -224,12 +227,12 @@ TEST(NodeLatticeTest, test_node_lattice)
   testA.pose.x = 5;
   testA.pose.y = 5;
   testA.pose.theta = 0;
-  EXPECT_EQ(testA.isNodeValid(true, checker.get()), true);
-  EXPECT_EQ(testA.isNodeValid(false, checker.get()), true);
+  EXPECT_EQ(testA.isNodeValid(context, true, checker.get()), true);
+  EXPECT_EQ(testA.isNodeValid(context, false, checker.get()), true);
   EXPECT_EQ(testA.getCost(), 0.0f);
 
   // check collision checking
-  EXPECT_EQ(testA.isNodeValid(false, checker.get()), true);
+  EXPECT_EQ(testA.isNodeValid(context, false, checker.get()), true);
 
   // check operator== works on index
   nav2_smac_planner::NodeLattice testC(49);
@@ -274,8 +277,9 @@ TEST(NodeLatticeTest, test_get_neighbors)
   unsigned int y = 100;
   unsigned int angle_quantization = 16;
 
+  nav2_smac_planner::NodeLattice::SearchContext context;
   nav2_smac_planner::NodeLattice::initMotionModel(
-    nav2_smac_planner::MotionModel::STATE_LATTICE, x, y, angle_quantization, info);
+    context, nav2_smac_planner::MotionModel::STATE_LATTICE, x, y, angle_quantization, info);
 
   nav2_smac_planner::NodeLattice node(49);
 
@@ -293,7 +297,7 @@ TEST(NodeLatticeTest, test_get_neighbors)
     };
 
   nav2_smac_planner::NodeLattice::NodeVector neighbors;
-  node.getNeighbors(neighborGetter, checker.get(), false, neighbors);
+  node.getNeighbors(context, neighborGetter, checker.get(), false, neighbors);
   // should be empty since totally invalid
   EXPECT_EQ(neighbors.size(), 0u);
 
@@ -325,8 +329,9 @@ TEST(NodeLatticeTest, test_node_lattice_custom_footprint)
   unsigned int y = 100;
   unsigned int angle_quantization = 16;
 
+  nav2_smac_planner::NodeLattice::SearchContext context;
   nav2_smac_planner::NodeLattice::initMotionModel(
-    nav2_smac_planner::MotionModel::STATE_LATTICE, x, y, angle_quantization, info);
+    context, nav2_smac_planner::MotionModel::STATE_LATTICE, x, y, angle_quantization, info);
 
   nav2_smac_planner::NodeLattice node(49);
 
@@ -358,11 +363,11 @@ TEST(NodeLatticeTest, test_node_lattice_custom_footprint)
   node.pose.theta = 0;
   // Test that the node is valid though all motion primitives poses for custom footprint
   nav2_smac_planner::MotionPrimitivePtrs motion_primitives =
-    nav2_smac_planner::NodeLattice::motion_table.getMotionPrimitives(&node);
+    context.motion_table.getMotionPrimitives(&node);
   EXPECT_GT(motion_primitives.size(), 0u);
   for (unsigned int i = 0; i < motion_primitives.size(); i++) {
-    EXPECT_EQ(node.isNodeValid(true, checker.get(), motion_primitives[i], false), true);
-    EXPECT_EQ(node.isNodeValid(true, checker.get(), motion_primitives[i], true), true);
+    EXPECT_EQ(node.isNodeValid(context, true, checker.get(), motion_primitives[i], false), true);
+    EXPECT_EQ(node.isNodeValid(context, true, checker.get(), motion_primitives[i], true), true);
   }
 
   delete costmap;
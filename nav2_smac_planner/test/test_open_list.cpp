@@ -0,0 +1,145 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License. Reserved.
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "nav2_smac_planner/open_list.hpp"
+
+using nav2_smac_planner::OpenList;
+using nav2_smac_planner::OpenListType;
+
+struct Payload
+{
+  unsigned int index;
+  float cost;
+};
+
+TEST(OpenListTest, test_types)
+{
+  EXPECT_EQ(nav2_smac_planner::openListFromString("BINARY_HEAP"), OpenListType::BINARY_HEAP);
+  EXPECT_EQ(
+    nav2_smac_planner::openListFromString("QUATERNARY_HEAP"), OpenListType::QUATERNARY_HEAP);
+  EXPECT_EQ(nav2_smac_planner::openListFromString("BUCKET"), OpenListType::BUCKET);
+  EXPECT_EQ(nav2_smac_planner::openListFromString("FIBONACCI"), OpenListType::UNKNOWN);
+  EXPECT_EQ(nav2_smac_planner::toString(OpenListType::BUCKET), "Bucket");
+
+  OpenList<Payload> list(OpenListType::UNKNOWN);
+  EXPECT_EQ(list.getType(), OpenListType::BINARY_HEAP);
+}
+
+TEST(OpenListTest, test_ordering)
+{
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<float> dist(0.0f, 500.0f);
+  std::vector<float> costs(2000);
+  for (auto & cost : costs) {
+    cost = dist(gen);
+  }
+
+  for (auto type :
+    {OpenListType::BINARY_HEAP, OpenListType::QUATERNARY_HEAP, OpenListType::BUCKET})
+  {
+    OpenList<Payload> list(type);
+    // Interleave pushes and pops, as a search does
+    float last = -1.0f;
+    for (unsigned int i = 0; i != costs.size(); i++) {
+      const float cost = last + 1.0f + costs[i];
+      list.push(cost, i, Payload{i, cost});
+      if (i % 3 == 0) {
+        const Payload popped = list.pop();
+        if (type == OpenListType::BUCKET) {
+          EXPECT_GE(std::floor(popped.cost), std::floor(last));
+        } else {
+          EXPECT_GE(popped.cost, last);
+        }
+        last = popped.cost;
+      }
+    }
+    EXPECT_EQ(list.size(), costs.size() - (costs.size() + 2) / 3);
+
+    while (!list.empty()) {
+      const Payload popped = list.pop();
+      if (type == OpenListType::BUCKET) {
+        EXPECT_GE(std::floor(popped.cost), std::floor(last));
+      } else {
+        EXPECT_GE(popped.cost, last);
+      }
+      last = popped.cost;
+    }
+    EXPECT_EQ(list.size(), 0u);
+  }
+}
+
+TEST(OpenListTest, test_decrease_key)
+{
+  for (auto type : {OpenListType::QUATERNARY_HEAP, OpenListType::BUCKET}) {
+    OpenList<Payload> list(type);
+    list.push(10.0f, 5u, Payload{5u, 10.0f});
+    list.push(20.0f, 6u, Payload{6u, 20.0f});
+    list.push(30.0f, 7u, Payload{7u, 30.0f});
+
+    // A cheaper path replaces the queued entry, a more expensive one is ignored
+    list.push(3.0f, 7u, Payload{7u, 3.0f});
+    list.push(40.0f, 5u, Payload{5u, 40.0f});
+    EXPECT_EQ(list.size(), 3u);
+
+    Payload popped = list.pop();
+    EXPECT_EQ(popped.index, 7u);
+    EXPECT_EQ(popped.cost, 3.0f);
+    popped = list.pop();
+    EXPECT_EQ(popped.index, 5u);
+    EXPECT_EQ(popped.cost, 10.0f);
+
+    // Once popped, a node can be queued again
+    list.push(25.0f, 7u, Payload{7u, 25.0f});
+    EXPECT_EQ(list.size(), 2u);
+    EXPECT_EQ(list.pop().index, 6u);
+    EXPECT_EQ(list.pop().index, 7u);
+    EXPECT_TRUE(list.empty());
+  }
+
+  // The binary heap keeps the duplicates, ordered by cost
+  OpenList<Payload> list(OpenListType::BINARY_HEAP);
+  list.push(10.0f, 5u, Payload{5u, 10.0f});
+  list.push(3.0f, 5u, Payload{5u, 3.0f});
+  EXPECT_EQ(list.size(), 2u);
+  EXPECT_EQ(list.pop().cost, 3.0f);
+  EXPECT_EQ(list.pop().cost, 10.0f);
+}
+
+TEST(OpenListTest, test_clear)
+{
+  for (auto type :
+    {OpenListType::BINARY_HEAP, OpenListType::QUATERNARY_HEAP, OpenListType::BUCKET})
+  {
+    OpenList<Payload> list(type);
+    for (unsigned int i = 0; i != 100; i++) {
+      list.push(static_cast<float>(100 - i), i, Payload{i, static_cast<float>(100 - i)});
+    }
+    list.pop();
+    list.clear();
+    EXPECT_TRUE(list.empty());
+
+    // Reused for the next search, with the same indices
+    list.push(5.0f, 10u, Payload{10u, 5.0f});
+    list.push(2.0f, 99u, Payload{99u, 2.0f});
+    EXPECT_EQ(list.size(), 2u);
+    EXPECT_EQ(list.pop().index, 99u);
+    EXPECT_EQ(list.pop().index, 10u);
+    EXPECT_TRUE(list.empty());
+  }
+}
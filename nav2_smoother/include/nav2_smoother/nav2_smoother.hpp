@@ -28,6 +28,7 @@
 #include "nav2_costmap_2d/costmap_topic_collision_checker.hpp"
 #include "nav2_costmap_2d/footprint_subscriber.hpp"
 #include "nav2_msgs/action/smooth_path.hpp"
+#include "nav2_smoother/velocity_profile.hpp"
 #include "nav2_util/lifecycle_node.hpp"
 #include "nav2_util/robot_utils.hpp"
 #include "nav2_util/simple_action_server.hpp"
@@ -143,6 +144,13 @@ protected:
    */
   bool validate(const nav_msgs::msg::Path & path);
 
+  /**
+   * @brief Time-parameterize the smoothed path of the result if enabled, setting the
+   * velocity at each pose and the time at which it is reached
+   * @param result Result holding the smoothed path
+   */
+  void applyVelocityProfile(ActionResult & result);
+
   // Our action server implements the SmoothPath action
   std::unique_ptr<ActionServer> action_server_;
 
@@ -166,6 +174,7 @@ protected:
   std::shared_ptr<nav2_costmap_2d::CostmapSubscriber> costmap_sub_;
   std::shared_ptr<nav2_costmap_2d::FootprintSubscriber> footprint_sub_;
   std::shared_ptr<nav2_costmap_2d::CostmapTopicCollisionChecker> collision_checker_;
+  std::unique_ptr<VelocityProfile> velocity_profile_;
 
   rclcpp::Clock steady_clock_;
 };
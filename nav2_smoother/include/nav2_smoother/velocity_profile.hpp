@@ -0,0 +1,105 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License. Reserved.
+
+#ifndef NAV2_SMOOTHER__VELOCITY_PROFILE_HPP_
+#define NAV2_SMOOTHER__VELOCITY_PROFILE_HPP_
+
+#include <vector>
+
+#include "nav2_costmap_2d/costmap_2d.hpp"
+#include "nav_msgs/msg/path.hpp"
+
+namespace nav2_smoother
+{
+
+/**
+ * @struct nav2_smoother::VelocityProfileParams
+ * @brief Limits of the velocity profile along a path
+ */
+struct VelocityProfileParams
+{
+  double max_velocity{0.5};
+  double min_velocity{0.05};
+  double max_accel{0.5};
+  double max_decel{0.5};
+  double max_lateral_accel{0.5};
+  // Bound the time of in-place rotations, turning from and to a standstill
+  double max_angular_velocity{1.0};
+  double max_angular_accel{1.0};
+  // Fraction of max_velocity removed at the inscribed cost, 0 disables cost limits
+  double cost_scaling_gain{0.0};
+};
+
+/**
+ * @class nav2_smoother::VelocityProfile
+ * @brief Time-parameterizes a path with the fastest velocity profile respecting the
+ * velocity, acceleration, curvature and costmap proximity limits. The velocity limit at
+ * each pose is bounded by a forward pass for acceleration and a backward pass for
+ * deceleration, in linear time. The robot stops at cusps, in-place rotations and the goal,
+ * and is not slowed down at the start, as it may already be moving along a replanned path.
+ */
+class VelocityProfile
+{
+public:
+  /**
+   * @brief A constructor for nav2_smoother::VelocityProfile
+   * @param params Limits of the velocity profile
+   */
+  explicit VelocityProfile(const VelocityProfileParams & params);
+
+  /**
+   * @brief Compute the velocity profile of a path. The path is left unchanged, its
+   * pose stamps remaining those of the poses and not the times at which they are reached
+   * @param path Path to time-parameterize
+   * @param times Filled with the time at which each pose is reached, in seconds from the
+   * start of the path
+   * @param costmap Costmap in the frame of the path for proximity limits, may be null
+   * @return Velocity at each pose of the path
+   */
+  std::vector<double> compute(
+    const nav_msgs::msg::Path & path, std::vector<double> & times,
+    const nav2_costmap_2d::Costmap2D * costmap = nullptr) const;
+
+  /**
+   * @brief Whether the profile is limited by costmap proximity
+   * @return true if a costmap should be given to compute
+   */
+  bool usesCostmap() const {return params_.cost_scaling_gain > 0.0;}
+
+protected:
+  /**
+   * @brief Get the velocity limit at a pose of the path from the curvature and costmap
+   * @param path Path
+   * @param idx Index of the pose
+   * @param costmap Costmap for proximity limits, may be null
+   * @return Velocity limit
+   */
+  double getVelocityLimit(
+    const nav_msgs::msg::Path & path, size_t idx,
+    const nav2_costmap_2d::Costmap2D * costmap) const;
+
+  /**
+   * @brief Get the time of an in-place rotation, accelerating from a standstill and
+   * decelerating to one within the angular velocity and acceleration limits
+   * @param angle Angle of the rotation
+   * @return Time of the rotation
+   */
+  double getRotationTime(const double angle) const;
+
+  VelocityProfileParams params_;
+};
+
+}  // namespace nav2_smoother
+
+#endif  // NAV2_SMOOTHER__VELOCITY_PROFILE_HPP_
@@ -55,6 +55,17 @@ SmootherServer::SmootherServer(const rclcpp::NodeOptions & options)
   declare_parameter("smoother_plugins", default_ids_);
 
   declare_parameter("action_server_result_timeout", 10.0);
+
+  // Optional velocity profile of the smoothed paths
+  declare_parameter("velocity_profile.enabled", false);
+  declare_parameter("velocity_profile.max_velocity", 0.5);
+  declare_parameter("velocity_profile.min_velocity", 0.05);
+  declare_parameter("velocity_profile.max_accel", 0.5);
+  declare_parameter("velocity_profile.max_decel", 0.5);
+  declare_parameter("velocity_profile.max_lateral_accel", 0.5);
+  declare_parameter("velocity_profile.max_angular_velocity", 1.0);
+  declare_parameter("velocity_profile.max_angular_accel", 1.0);
+  declare_parameter("velocity_profile.cost_scaling_gain", 0.0);
 }
 
 SmootherServer::~SmootherServer()
@@ -103,6 +114,22 @@ SmootherServer::on_configure(const rclcpp_lifecycle::State &)
     return nav2_util::CallbackReturn::FAILURE;
   }
 
+  bool velocity_profile_enabled;
+  get_parameter("velocity_profile.enabled", velocity_profile_enabled);
+  if (velocity_profile_enabled) {
+    VelocityProfileParams params;
+    get_parameter("velocity_profile.max_velocity", params.max_velocity);
+    get_parameter("velocity_profile.min_velocity", params.min_velocity);
+    get_parameter("velocity_profile.max_accel", params.max_accel);
+    get_parameter("velocity_profile.max_decel", params.max_decel);
+    get_parameter("velocity_profile.max_lateral_accel", params.max_lateral_accel);
+    get_parameter("velocity_profile.max_angular_velocity", params.max_angular_velocity);
+    get_parameter("velocity_profile.max_angular_accel", params.max_angular_accel);
+    get_parameter("velocity_profile.cost_scaling_gain", params.cost_scaling_gain);
+    velocity_profile_ = std::make_unique<VelocityProfile>(params);
+    RCLCPP_INFO(get_logger(), "Smoothed paths will be time-parameterized");
+  }
+
   // Initialize pubs & subs
   plan_publisher_ = create_publisher<nav_msgs::msg::Path>("plan_smoothed", 1);
 
@@ -217,6 +244,7 @@ SmootherServer::on_cleanup(const rclcpp_lifecycle::State &)
   footprint_sub_.reset();
   costmap_sub_.reset();
   collision_checker_.reset();
+  velocity_profile_.reset();
 
   return nav2_util::CallbackReturn::SUCCESS;
 }
@@ -295,6 +323,8 @@ void SmootherServer::smoothPlan()
         rclcpp::Duration(result->smoothing_duration).seconds());
     }
 
+    applyVelocityProfile(*result);
+
     plan_publisher_->publish(result->path);
 
     // Check for collisions
@@ -375,6 +405,32 @@ bool SmootherServer::validate(const nav_msgs::msg::Path & path)
   return true;
 }
 
+void SmootherServer::applyVelocityProfile(ActionResult & result)
+{
+  if (!velocity_profile_) {
+    return;
+  }
+
+  // The costmap is only needed for proximity limits, which are skipped until it is received
+  std::shared_ptr<nav2_costmap_2d::Costmap2D> costmap;
+  if (velocity_profile_->usesCostmap()) {
+    try {
+      costmap = costmap_sub_->getCostmap();
+    } catch (const std::runtime_error & ex) {
+      RCLCPP_WARN(get_logger(), "Velocity profile without costmap limits: %s", ex.what());
+    }
+  }
+
+  // The timing is returned aside, the poses keep the stamps they are transformed at
+  std::vector<double> times;
+  result.velocities = velocity_profile_->compute(result.path, times, costmap.get());
+  result.times_from_start.clear();
+  result.times_from_start.reserve(times.size());
+  for (const double time : times) {
+    result.times_from_start.push_back(rclcpp::Duration::from_seconds(time));
+  }
+}
+
 }  // namespace nav2_smoother
 
 #include "rclcpp_components/register_node_macro.hpp"
@@ -0,0 +1,139 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License. Reserved.
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "nav2_smoother/velocity_profile.hpp"
+#include "nav2_smoother/smoother_utils.hpp"
+
+namespace nav2_smoother
+{
+
+VelocityProfile::VelocityProfile(const VelocityProfileParams & params)
+: params_(params)
+{
+}
+
+double VelocityProfile::getVelocityLimit(
+  const nav_msgs::msg::Path & path, size_t idx,
+  const nav2_costmap_2d::Costmap2D * costmap) const
+{
+  double limit = params_.max_velocity;
+
+  // Curvature from the circle through the pose and its neighbors
+  if (idx > 0 && idx + 1 < path.poses.size()) {
+    const auto & p0 = path.poses[idx - 1].pose.position;
+    const auto & p1 = path.poses[idx].pose.position;
+    const auto & p2 = path.poses[idx + 1].pose.position;
+    const double a = std::hypot(p1.x - p0.x, p1.y - p0.y);
+    const double b = std::hypot(p2.x - p1.x, p2.y - p1.y);
+    const double c = std::hypot(p2.x - p0.x, p2.y - p0.y);
+    const double cross = std::fabs((p1.x - p0.x) * (p2.y - p0.y) - (p1.y - p0.y) * (p2.x - p0.x));
+    if (a > 1e-6 && b > 1e-6 && c > 1e-6 && cross > 1e-9) {
+      const double curvature = 2.0 * cross / (a * b * c);
+      limit = std::min(limit, std::sqrt(params_.max_lateral_accel / curvature));
+    }
+  }
+
+  // Slow down proportionally to the cost near obstacles
+  if (costmap && params_.cost_scaling_gain > 0.0) {
+    unsigned int mx, my;
+    const auto & position = path.poses[idx].pose.position;
+    if (costmap->worldToMap(position.x, position.y, mx, my)) {
+      const double cost = std::min(
+        static_cast<double>(costmap->getCost(mx, my)),
+        static_cast<double>(nav2_costmap_2d::INSCRIBED_INFLATED_OBSTACLE));
+      limit = std::min(
+        limit, params_.max_velocity *
+        (1.0 - params_.cost_scaling_gain * cost / nav2_costmap_2d::INSCRIBED_INFLATED_OBSTACLE));
+    }
+  }
+
+  return std::max(limit, params_.min_velocity);
+}
+
+double VelocityProfile::getRotationTime(const double angle) const
+{
+  const double w = params_.max_angular_velocity;
+  const double a = params_.max_angular_accel;
+  // Triangular profile if the maximum angular velocity is not reached, else trapezoidal
+  if (angle * a <= w * w) {
+    return 2.0 * std::sqrt(angle / a);
+  }
+  return angle / w + w / a;
+}
+
+std::vector<double> VelocityProfile::compute(
+  const nav_msgs::msg::Path & path, std::vector<double> & times,
+  const nav2_costmap_2d::Costmap2D * costmap) const
+{
+  const size_t size = path.poses.size();
+  std::vector<double> velocities(size, 0.0);
+  times.assign(size, 0.0);
+  if (size < 2) {
+    return velocities;
+  }
+
+  std::vector<double> lengths(size, 0.0);
+  for (size_t i = 0; i < size; ++i) {
+    velocities[i] = getVelocityLimit(path, i, costmap);
+    if (i > 0) {
+      lengths[i] = nav2_util::geometry_utils::euclidean_distance(
+        path.poses[i - 1].pose, path.poses[i].pose);
+    }
+  }
+
+  // Stop at cusps and in-place rotations, where the direction of motion changes,
+  // and at the goal
+  const auto segments = smoother_utils::findDirectionalPathSegments(path);
+  for (const auto & segment : segments) {
+    if (segment.end + 1 < size) {
+      velocities[segment.end] = 0.0;
+    }
+  }
+  velocities.back() = 0.0;
+
+  // Forward pass bounds the acceleration, backward pass the deceleration
+  for (size_t i = 1; i < size; ++i) {
+    velocities[i] = std::min(
+      velocities[i],
+      std::sqrt(velocities[i - 1] * velocities[i - 1] + 2.0 * params_.max_accel * lengths[i]));
+  }
+  for (size_t i = size - 1; i > 0; --i) {
+    velocities[i - 1] = std::min(
+      velocities[i - 1],
+      std::sqrt(velocities[i] * velocities[i] + 2.0 * params_.max_decel * lengths[i]));
+  }
+
+  // Constant acceleration between poses gives the time to reach each of them,
+  // in-place rotations taking the time to turn within the angular limits
+  for (size_t i = 1; i < size; ++i) {
+    const double mean_velocity = 0.5 * (velocities[i - 1] + velocities[i]);
+    if (lengths[i] < 1e-4) {
+      const double angle = std::fabs(
+        angles::shortest_angular_distance(
+          tf2::getYaw(path.poses[i - 1].pose.orientation),
+          tf2::getYaw(path.poses[i].pose.orientation)));
+      times[i] = times[i - 1] + getRotationTime(angle);
+    } else {
+      times[i] = times[i - 1] + (mean_velocity > 0.0 ? lengths[i] / mean_velocity : 0.0);
+    }
+  }
+
+  return velocities;
+}
+
+}  // namespace nav2_smoother
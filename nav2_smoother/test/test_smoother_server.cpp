@@ -27,6 +27,8 @@
 #include "nav2_core/planner_exceptions.hpp"
 #include "nav2_msgs/action/smooth_path.hpp"
 #include "nav2_smoother/nav2_smoother.hpp"
+#include "nav2_util/robot_utils.hpp"
+#include "tf2_ros/buffer.h"
 
 using SmoothAction = nav2_msgs::action::SmoothPath;
 using ClientGoalHandle = rclcpp_action::ClientGoalHandle<SmoothAction>;
@@ -69,6 +71,7 @@ public:
 
     // place dummy pose in the middle of the path
     geometry_msgs::msg::PoseStamped pose;
+    pose.header = path.poses.back().header;
     pose.pose.position.x =
       (path.poses.front().pose.position.x + path.poses.back().pose.position.x) / 2;
     pose.pose.position.y =
@@ -266,11 +269,16 @@ public:
     std::string smoother_id, double x_start, double y_start, double x_goal,
     double y_goal, std::chrono::milliseconds max_time, bool check_for_collisions)
   {
-    if (!client_->wait_for_action_server(4s)) {
-      std::cout << "Server not up" << std::endl;
-      return false;
-    }
+    return sendGoal(
+      makeGoal(
+        smoother_id, x_start, y_start, x_goal, y_goal, max_time,
+        check_for_collisions));
+  }
 
+  SmoothAction::Goal makeGoal(
+    std::string smoother_id, double x_start, double y_start, double x_goal,
+    double y_goal, std::chrono::milliseconds max_time, bool check_for_collisions)
+  {
     geometry_msgs::msg::PoseStamped pose;
     pose.pose.orientation.w = 1.0;
 
@@ -284,6 +292,15 @@ public:
     goal.path.poses.push_back(pose);
     goal.check_for_collisions = check_for_collisions;
     goal.max_smoothing_duration = rclcpp::Duration(max_time);
+    return goal;
+  }
+
+  bool sendGoal(const SmoothAction::Goal & goal)
+  {
+    if (!client_->wait_for_action_server(4s)) {
+      std::cout << "Server not up" << std::endl;
+      return false;
+    }
 
     auto future_goal = client_->async_send_goal(goal);
 
@@ -383,6 +400,54 @@ TEST_F(SmootherTest, testingCollisionCheckDisabled)
   SUCCEED();
 }
 
+TEST_F(SmootherTest, testingVelocityProfile)
+{
+  // Without the profile, no timing is returned
+  ASSERT_TRUE(sendGoal("DummySmoothPath", 0.0, 0.0, 1.0, 0.0, 500ms, false));
+  auto result = getResult();
+  EXPECT_EQ(result.code, rclcpp_action::ResultCode::SUCCEEDED);
+  EXPECT_TRUE(result.result->velocities.empty());
+  EXPECT_TRUE(result.result->times_from_start.empty());
+
+  smoother_server_->deactivate();
+  smoother_server_->cleanup();
+  smoother_server_->set_parameter(rclcpp::Parameter("velocity_profile.enabled", true));
+  smoother_server_->configure();
+  smoother_server_->activate();
+
+  auto goal = makeGoal("DummySmoothPath", 0.0, 0.0, 1.0, 0.0, 500ms, false);
+  const rclcpp::Time stamp = node_->now();
+  goal.path.header.frame_id = "map";
+  goal.path.header.stamp = stamp;
+  for (auto & pose : goal.path.poses) {
+    pose.header = goal.path.header;
+  }
+  ASSERT_TRUE(sendGoal(goal));
+  result = getResult();
+  EXPECT_EQ(result.code, rclcpp_action::ResultCode::SUCCEEDED);
+  const auto & path = result.result->path;
+  ASSERT_EQ(result.result->velocities.size(), path.poses.size());
+  ASSERT_EQ(result.result->times_from_start.size(), path.poses.size());
+  EXPECT_GT(rclcpp::Duration(result.result->times_from_start.back()).seconds(), 0.0);
+
+  // The end pose keeps the stamp it can be transformed at, as the controller does to check
+  // the goal, with only the transform at that time known
+  tf2_ros::Buffer tf(node_->get_clock());
+  geometry_msgs::msg::TransformStamped transform;
+  transform.header.frame_id = "odom";
+  transform.header.stamp = stamp;
+  transform.child_frame_id = "map";
+  transform.transform.translation.x = 1.0;
+  transform.transform.rotation.w = 1.0;
+  tf.setTransform(transform, "test", false);
+
+  EXPECT_EQ(rclcpp::Time(path.poses.back().header.stamp), stamp);
+  geometry_msgs::msg::PoseStamped end_pose;
+  ASSERT_TRUE(
+    nav2_util::transformPoseInTargetFrame(path.poses.back(), end_pose, tf, "odom", 0.0));
+  EXPECT_DOUBLE_EQ(end_pose.pose.position.x, path.poses.back().pose.position.x + 1.0);
+}
+
 TEST(SmootherConfigTest, testingConfigureSuccessWithValidSmootherPlugin)
 {
   auto smoother_server = std::make_shared<DummySmootherServer>();
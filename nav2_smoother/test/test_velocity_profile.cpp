@@ -0,0 +1,239 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License. Reserved.
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "rclcpp/rclcpp.hpp"
+#include "nav2_costmap_2d/cost_values.hpp"
+#include "nav2_smoother/velocity_profile.hpp"
+
+using nav2_smoother::VelocityProfile;
+using nav2_smoother::VelocityProfileParams;
+
+static nav_msgs::msg::Path makePath(const std::vector<std::pair<double, double>> & points)
+{
+  nav_msgs::msg::Path path;
+  path.header.frame_id = "map";
+  path.header.stamp = rclcpp::Time(100, 0);
+  for (size_t i = 0; i < points.size(); ++i) {
+    geometry_msgs::msg::PoseStamped pose;
+    pose.pose.position.x = points[i].first;
+    pose.pose.position.y = points[i].second;
+    // Face the direction of the path, which the cusp detection relies on
+    const size_t next = i + 1 < points.size() ? i + 1 : i;
+    const size_t prev = i + 1 < points.size() ? i : i - 1;
+    const double yaw = std::atan2(
+      points[next].second - points[prev].second, points[next].first - points[prev].first);
+    pose.pose.orientation.z = std::sin(yaw / 2.0);
+    pose.pose.orientation.w = std::cos(yaw / 2.0);
+    path.poses.push_back(pose);
+  }
+  return path;
+}
+
+static void checkLimits(
+  const nav_msgs::msg::Path & path, const std::vector<double> & velocities,
+  const std::vector<double> & times, const VelocityProfileParams & params)
+{
+  ASSERT_EQ(velocities.size(), path.poses.size());
+  ASSERT_EQ(times.size(), path.poses.size());
+  EXPECT_DOUBLE_EQ(times.front(), 0.0);
+  EXPECT_DOUBLE_EQ(velocities.back(), 0.0);
+  for (size_t i = 1; i < velocities.size(); ++i) {
+    EXPECT_LE(velocities[i], params.max_velocity + 1e-9);
+    const double length = std::hypot(
+      path.poses[i].pose.position.x - path.poses[i - 1].pose.position.x,
+      path.poses[i].pose.position.y - path.poses[i - 1].pose.position.y);
+    const double accel =
+      (velocities[i] * velocities[i] - velocities[i - 1] * velocities[i - 1]) / (2.0 * length);
+    EXPECT_LE(accel, params.max_accel + 1e-6);
+    EXPECT_GE(accel, -params.max_decel - 1e-6);
+
+    // Constant acceleration between the poses
+    EXPECT_NEAR(
+      times[i] - times[i - 1], 2.0 * length / (velocities[i - 1] + velocities[i]), 1e-6);
+  }
+}
+
+TEST(VelocityProfileTest, straightPath)
+{
+  VelocityProfileParams params;
+  params.max_velocity = 0.5;
+  params.max_accel = 0.5;
+  params.max_decel = 0.25;
+  VelocityProfile profile(params);
+
+  std::vector<std::pair<double, double>> points;
+  for (int i = 0; i <= 50; ++i) {
+    points.emplace_back(0.1 * i, 0.0);
+  }
+  const auto path = makePath(points);
+  std::vector<double> times;
+  const auto velocities = profile.compute(path, times);
+  checkLimits(path, velocities, times, params);
+
+  // Cruises at the maximum velocity, then decelerates to stop at the goal
+  EXPECT_DOUBLE_EQ(velocities.front(), 0.5);
+  EXPECT_DOUBLE_EQ(velocities[20], 0.5);
+  EXPECT_NEAR(velocities[45], std::sqrt(2.0 * 0.25 * 0.5), 1e-9);
+  EXPECT_GT(times.back(), 5.0 / 0.5);
+}
+
+TEST(VelocityProfileTest, curvatureLimit)
+{
+  VelocityProfileParams params;
+  params.max_velocity = 1.0;
+  params.max_accel = 10.0;
+  params.max_decel = 10.0;
+  params.max_lateral_accel = 0.1;
+  VelocityProfile profile(params);
+
+  // Half circle of radius 1
+  std::vector<std::pair<double, double>> points;
+  for (int i = 0; i <= 30; ++i) {
+    const double angle = M_PI * i / 30;
+    points.emplace_back(std::cos(angle), std::sin(angle));
+  }
+  const auto path = makePath(points);
+  std::vector<double> times;
+  const auto velocities = profile.compute(path, times);
+  checkLimits(path, velocities, times, params);
+
+  for (size_t i = 1; i + 1 < velocities.size(); ++i) {
+    EXPECT_LE(velocities[i], std::sqrt(0.1 * 1.0) + 1e-3);
+  }
+  EXPECT_NEAR(velocities[15], std::sqrt(0.1 * 1.0), 1e-3);
+}
+
+TEST(VelocityProfileTest, stopAtCusp)
+{
+  VelocityProfileParams params;
+  VelocityProfile profile(params);
+
+  // Forward along x, then reversing back
+  std::vector<std::pair<double, double>> points;
+  for (int i = 0; i <= 20; ++i) {
+    points.emplace_back(0.1 * i, 0.0);
+  }
+  for (int i = 19; i >= 10; --i) {
+    points.emplace_back(0.1 * i, 0.0);
+  }
+  auto path = makePath(points);
+  // Reversing poses keep facing forward
+  for (size_t i = 20; i < path.poses.size(); ++i) {
+    path.poses[i].pose.orientation = path.poses[0].pose.orientation;
+  }
+  std::vector<double> times;
+  const auto velocities = profile.compute(path, times);
+  checkLimits(path, velocities, times, params);
+
+  EXPECT_DOUBLE_EQ(velocities[20], 0.0);
+  EXPECT_GT(velocities[15], 0.0);
+  EXPECT_GT(velocities[25], 0.0);
+}
+
+TEST(VelocityProfileTest, costLimit)
+{
+  VelocityProfileParams params;
+  params.max_velocity = 0.5;
+  params.min_velocity = 0.1;
+  params.max_accel = 10.0;
+  params.max_decel = 10.0;
+  params.cost_scaling_gain = 0.5;
+  VelocityProfile profile(params);
+  EXPECT_TRUE(profile.usesCostmap());
+
+  nav2_costmap_2d::Costmap2D costmap(100, 10, 0.1, 0.0, 0.0, nav2_costmap_2d::FREE_SPACE);
+  for (unsigned int i = 40; i < 60; ++i) {
+    for (unsigned int j = 0; j < 10; ++j) {
+      costmap.setCost(i, j, nav2_costmap_2d::INSCRIBED_INFLATED_OBSTACLE);
+    }
+  }
+
+  std::vector<std::pair<double, double>> points;
+  for (int i = 0; i <= 90; ++i) {
+    points.emplace_back(0.05 + 0.1 * i, 0.55);
+  }
+  const auto path = makePath(points);
+  std::vector<double> times;
+  const auto velocities = profile.compute(path, times, &costmap);
+  checkLimits(path, velocities, times, params);
+
+  EXPECT_DOUBLE_EQ(velocities[20], 0.5);
+  EXPECT_DOUBLE_EQ(velocities[50], 0.25);
+  EXPECT_DOUBLE_EQ(velocities[70], 0.5);
+}
+
+TEST(VelocityProfileTest, keepsStamps)
+{
+  VelocityProfile profile(VelocityProfileParams{});
+
+  std::vector<std::pair<double, double>> points;
+  for (int i = 0; i <= 10; ++i) {
+    points.emplace_back(0.1 * i, 0.0);
+  }
+  const auto path = makePath(points);
+  auto profiled = path;
+  std::vector<double> times;
+  profile.compute(profiled, times);
+  EXPECT_EQ(profiled, path);
+  EXPECT_GT(times.back(), 0.0);
+
+  // Paths too short to profile
+  profiled.poses.resize(1);
+  EXPECT_EQ(profile.compute(profiled, times), std::vector<double>(1, 0.0));
+  EXPECT_EQ(times, std::vector<double>(1, 0.0));
+}
+
+TEST(VelocityProfileTest, inPlaceRotation)
+{
+  VelocityProfileParams params;
+  params.max_angular_velocity = 1.0;
+  params.max_angular_accel = 2.0;
+  VelocityProfile profile(params);
+
+  // Along x, turning in place in two steps at x = 1, then along y
+  std::vector<std::pair<double, double>> points;
+  for (int i = 0; i <= 10; ++i) {
+    points.emplace_back(0.1 * i, 0.0);
+  }
+  for (int i = 1; i <= 10; ++i) {
+    points.emplace_back(1.0, 0.1 * i);
+  }
+  auto path = makePath(points);
+  path.poses[10].pose.orientation = path.poses[9].pose.orientation;
+  path.poses.insert(path.poses.begin() + 11, 2, path.poses[10]);
+  const double yaws[] = {0.4, M_PI_2};
+  for (size_t i = 0; i < 2; ++i) {
+    path.poses[11 + i].pose.orientation.z = std::sin(yaws[i] / 2.0);
+    path.poses[11 + i].pose.orientation.w = std::cos(yaws[i] / 2.0);
+  }
+
+  std::vector<double> times;
+  const auto velocities = profile.compute(path, times);
+  ASSERT_EQ(times.size(), path.poses.size());
+  EXPECT_DOUBLE_EQ(velocities[10], 0.0);
+  EXPECT_DOUBLE_EQ(velocities[11], 0.0);
+  EXPECT_DOUBLE_EQ(velocities[12], 0.0);
+
+  // The angular velocity limit is not reached over the first step, taking
+  // 2 * sqrt(angle / accel), and is over the second, taking angle / velocity + velocity / accel
+  EXPECT_NEAR(times[11] - times[10], 2.0 * std::sqrt(0.4 / 2.0), 1e-6);
+  EXPECT_NEAR(times[12] - times[11], (M_PI_2 - 0.4) / 1.0 + 1.0 / 2.0, 1e-6);
+  for (size_t i = 1; i < times.size(); ++i) {
+    EXPECT_GT(times[i], times[i - 1]);
+  }
+}
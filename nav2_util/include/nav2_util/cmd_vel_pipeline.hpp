@@ -0,0 +1,118 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NAV2_UTIL__CMD_VEL_PIPELINE_HPP_
+#define NAV2_UTIL__CMD_VEL_PIPELINE_HPP_
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "geometry_msgs/msg/twist.hpp"
+
+namespace nav2_util
+{
+
+/**
+ * @class CmdVelPipeline
+ * @brief Chains velocity command stages (e.g. velocity smoothing, collision monitoring)
+ * as direct function calls on a single command, for servers composed in the same process.
+ * Stages are registered once, processing a command then neither allocates nor serializes
+ * it, and the latency of each stage and of the whole chain is measured.
+ */
+class CmdVelPipeline
+{
+public:
+  /**
+   * @brief A stage modifies the command in place, and returns false to drop it
+   */
+  using Stage = std::function<bool (geometry_msgs::msg::Twist & cmd)>;
+
+  /**
+   * @brief Resets the state a stage keeps between commands
+   */
+  using Reset = std::function<void ()>;
+
+  /**
+   * @brief Add a stage at the end of the pipeline
+   * @param name Name of the stage
+   * @param stage Stage to call
+   * @param reset Called to reset the stage when a stop command bypassed it, may be empty
+   */
+  void addStage(const std::string & name, Stage stage, Reset reset = Reset());
+
+  /**
+   * @brief Run the command through all the stages in order
+   * @param cmd Command to process, modified in place
+   * @return false if a stage dropped the command, which should then not be sent
+   */
+  bool process(geometry_msgs::msg::Twist & cmd);
+
+  /**
+   * @brief Reset the stages after a stop command. Stop commands are sent bypassing the
+   * pipeline, as stages such as a velocity smoother would delay them, so that the stages
+   * then resume from a standstill
+   */
+  void reset();
+
+  /**
+   * @brief Get the number of stages
+   * @return Number of stages
+   */
+  size_t size() const {return stages_.size();}
+
+  /**
+   * @brief Get the name of a stage
+   * @param idx Index of the stage
+   * @return Name of the stage
+   */
+  const std::string & getStageName(size_t idx) const {return stages_[idx].name;}
+
+  /**
+   * @brief Get the time spent in a stage by the last command reaching it
+   * @param idx Index of the stage
+   * @return Latency (s)
+   */
+  double getStageLatency(size_t idx) const {return stages_[idx].latency;}
+
+  /**
+   * @brief Get the time spent in the pipeline by the last command
+   * @return Latency (s)
+   */
+  double getLatency() const {return latency_;}
+
+  /**
+   * @brief Get the highest time spent in the pipeline by a command
+   * @return Latency (s)
+   */
+  double getMaxLatency() const {return max_latency_;}
+
+protected:
+  struct StageEntry
+  {
+    std::string name;
+    Stage stage;
+    Reset reset;
+    double latency;
+  };
+
+  std::vector<StageEntry> stages_;
+  double latency_{0.0};
+  double max_latency_{0.0};
+};
+
+}  // namespace nav2_util
+
+#endif  // NAV2_UTIL__CMD_VEL_PIPELINE_HPP_
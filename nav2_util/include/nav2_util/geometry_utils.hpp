@@ -15,7 +15,9 @@
 #ifndef NAV2_UTIL__GEOMETRY_UTILS_HPP_
 #define NAV2_UTIL__GEOMETRY_UTILS_HPP_
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include "geometry_msgs/msg/pose.hpp"
 #include "geometry_msgs/msg/pose_stamped.hpp"
@@ -179,6 +181,109 @@ inline double calculate_path_length(const nav_msgs::msg::Path & path, size_t sta
   return path_length;
 }
 
+/**
+ * @brief Splice a replanned path onto the path it replaces. A replan starts from the robot
+ * pose, part way along the replaced path, and often follows it for a while before departing
+ * from it. Both paths are walked from the replaced pose nearest to the start of the replan,
+ * for as long as their poses stay within tolerance of each other.
+ * @param path Replanned path
+ * @param reference Path it replaces
+ * @param tolerance Distance within which poses of both paths are considered the same
+ * @param spliced Will be set to the poses of reference up to where path departs from it,
+ * followed by the remaining poses of path. The last pose is always the one of path
+ * @param start_index Index of reference from which to search for the start of path
+ * @return Index of the first pose of spliced which is not from reference, or 0 if path does
+ * not start on reference, spliced being left empty
+ */
+inline size_t splice_replanned_path(
+  const nav_msgs::msg::Path & path, const nav_msgs::msg::Path & reference,
+  const double & tolerance, nav_msgs::msg::Path & spliced, const size_t & start_index = 0)
+{
+  spliced.poses.clear();
+  if (path.poses.size() < 2 || start_index >= reference.poses.size()) {
+    return 0;
+  }
+
+  size_t ref_idx = start_index;
+  double min_dist = std::numeric_limits<double>::max();
+  for (size_t idx = start_index; idx < reference.poses.size(); ++idx) {
+    const double dist = euclidean_distance(path.poses.front(), reference.poses[idx]);
+    if (dist < min_dist) {
+      min_dist = dist;
+      ref_idx = idx;
+    }
+  }
+  if (min_dist > tolerance) {
+    return 0;
+  }
+
+  // distance of a pose to the segment of reference between two of its poses
+  auto segment_distance =
+    [&reference](const geometry_msgs::msg::PoseStamped & pose, size_t from, size_t to) {
+      const geometry_msgs::msg::Point & a = reference.poses[from].pose.position;
+      const geometry_msgs::msg::Point & b = reference.poses[to].pose.position;
+      const geometry_msgs::msg::Point & p = pose.pose.position;
+      const double dx = b.x - a.x, dy = b.y - a.y;
+      const double sq_length = dx * dx + dy * dy;
+      double t = 0.0;
+      if (sq_length > 0.0) {
+        t = std::clamp(((p.x - a.x) * dx + (p.y - a.y) * dy) / sq_length, 0.0, 1.0);
+      }
+      return std::hypot(p.x - a.x - t * dx, p.y - a.y - t * dy);
+    };
+
+  // the poses of both paths need not be spaced alike, so each pose of path is matched to the
+  // nearest pose of reference ahead of the previous match, and to the segments around it
+  size_t last_ref_idx = ref_idx;
+  size_t idx = 1;
+  for (; idx + 1 < path.poses.size(); ++idx) {
+    const geometry_msgs::msg::PoseStamped & pose = path.poses[idx];
+    while (ref_idx + 1 < reference.poses.size() &&
+      euclidean_distance(pose, reference.poses[ref_idx + 1]) <=
+      euclidean_distance(pose, reference.poses[ref_idx]))
+    {
+      ++ref_idx;
+    }
+    const double dist = std::min(
+      segment_distance(pose, ref_idx > 0 ? ref_idx - 1 : 0, ref_idx),
+      segment_distance(pose, ref_idx, std::min(ref_idx + 1, reference.poses.size() - 1)));
+    if (dist > tolerance) {
+      break;
+    }
+    last_ref_idx = ref_idx;
+  }
+
+  spliced.header = path.header;
+  spliced.poses.reserve(last_ref_idx + 1 + path.poses.size() - idx);
+  spliced.poses.assign(reference.poses.begin(), reference.poses.begin() + last_ref_idx + 1);
+  spliced.poses.insert(spliced.poses.end(), path.poses.begin() + idx, path.poses.end());
+  return last_ref_idx + 1;
+}
+
+/**
+ * @brief Check whether two paths are the same. Paths differing in header, size or end
+ * poses are told apart without comparing all of their poses. Otherwise all of the poses
+ * are compared, as a path can be modified in place keeping its header and ends.
+ * @param path Path to compare
+ * @param reference Path to compare against
+ * @return true if the paths are the same
+ */
+inline bool is_same_path(const nav_msgs::msg::Path & path, const nav_msgs::msg::Path & reference)
+{
+  if (path.header != reference.header || path.poses.size() != reference.poses.size()) {
+    return false;
+  }
+  if (path.poses.empty()) {
+    return true;
+  }
+  if (path.poses.front() != reference.poses.front() ||
+    path.poses.back() != reference.poses.back())
+  {
+    return false;
+  }
+  return path.poses == reference.poses;
+}
+
 }  // namespace geometry_utils
 }  // namespace nav2_util
 
@@ -0,0 +1,116 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NAV2_UTIL__PATH_PROGRESS_TRACKER_HPP_
+#define NAV2_UTIL__PATH_PROGRESS_TRACKER_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "geometry_msgs/msg/pose_stamped.hpp"
+#include "nav_msgs/msg/path.hpp"
+
+namespace nav2_util
+{
+
+/**
+ * @class PathProgressTracker
+ * @brief Tracks the progress of a robot along a path between calls. The arc length
+ * of the path is integrated once when the path changes, and the closest pose is
+ * searched forward from the last one within a bounded window, so the distance
+ * remaining is obtained without rescanning the whole path on every call.
+ */
+class PathProgressTracker
+{
+public:
+  /**
+   * @brief Constructor
+   * @param search_window Maximum number of poses past the last closest pose
+   * searched on each update
+   */
+  explicit PathProgressTracker(size_t search_window = 500);
+
+  /**
+   * @brief Set the path to track. The progress is reset only if the path is not
+   * the same as the one already tracked
+   * @param path Path to track
+   * @param version Version of the path, if its source increments one each time it is
+   * replaced. Paths of the version already tracked are not compared again
+   * @return true if the tracker was reset to the new path
+   */
+  bool setPath(
+    const nav_msgs::msg::Path::ConstSharedPtr & path,
+    const std::optional<uint64_t> & version = std::nullopt);
+
+  /**
+   * @brief Check whether a version is the one of the tracked path, so that callers
+   * can skip copying a path that was not replaced
+   * @param version Version to compare
+   * @return true if a path of this version is tracked
+   */
+  bool isSameVersion(uint64_t version) const;
+
+  /**
+   * @brief Check whether a path is the one already tracked, see
+   * geometry_utils::is_same_path
+   * @param path Path to compare
+   * @return true if the path is the same as the tracked one
+   */
+  bool isSamePath(const nav_msgs::msg::Path & path) const;
+
+  /**
+   * @brief Advance the closest pose cursor to the given robot pose
+   * @param pose Current robot pose, in the frame of the path
+   * @return Distance remaining along the path from the closest pose
+   */
+  double update(const geometry_msgs::msg::PoseStamped & pose);
+
+  /**
+   * @brief Get the index of the closest pose found by the last update
+   * @return Index of the closest pose
+   */
+  size_t getClosestIndex() const {return closest_idx_;}
+
+  /**
+   * @brief Get the distance remaining along the path from the closest pose
+   * @return Distance remaining (m)
+   */
+  double getDistanceRemaining() const;
+
+  /**
+   * @brief Get the tracked path
+   * @return Tracked path, null if no path was set
+   */
+  const nav_msgs::msg::Path::ConstSharedPtr & getPath() const {return path_;}
+
+  /**
+   * @brief Forget the tracked path
+   */
+  void reset();
+
+protected:
+  nav_msgs::msg::Path::ConstSharedPtr path_;
+  std::optional<uint64_t> version_;
+  // Arc length from the start of the path to each pose
+  std::vector<double> cumulative_length_;
+  size_t closest_idx_;
+  size_t search_window_;
+  bool localized_;
+};
+
+}  // namespace nav2_util
+
+#endif  // NAV2_UTIL__PATH_PROGRESS_TRACKER_HPP_
@@ -0,0 +1,60 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "nav2_util/cmd_vel_pipeline.hpp"
+
+namespace nav2_util
+{
+
+void CmdVelPipeline::addStage(const std::string & name, Stage stage, Reset reset)
+{
+  stages_.push_back({name, std::move(stage), std::move(reset), 0.0});
+}
+
+bool CmdVelPipeline::process(geometry_msgs::msg::Twist & cmd)
+{
+  using Clock = std::chrono::steady_clock;
+  const Clock::time_point start = Clock::now();
+  Clock::time_point stage_start = start;
+
+  bool sent = true;
+  for (auto & entry : stages_) {
+    sent = entry.stage(cmd);
+    const Clock::time_point stage_end = Clock::now();
+    entry.latency = std::chrono::duration<double>(stage_end - stage_start).count();
+    stage_start = stage_end;
+    if (!sent) {
+      break;
+    }
+  }
+
+  latency_ = std::chrono::duration<double>(stage_start - start).count();
+  max_latency_ = std::max(max_latency_, latency_);
+  return sent;
+}
+
+void CmdVelPipeline::reset()
+{
+  for (auto & entry : stages_) {
+    if (entry.reset) {
+      entry.reset();
+    }
+  }
+}
+
+}  // namespace nav2_util
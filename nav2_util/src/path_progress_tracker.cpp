@@ -0,0 +1,113 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <limits>
+
+#include "nav2_util/path_progress_tracker.hpp"
+#include "nav2_util/geometry_utils.hpp"
+
+namespace nav2_util
+{
+
+PathProgressTracker::PathProgressTracker(size_t search_window)
+: closest_idx_(0), search_window_(std::max<size_t>(search_window, 1)), localized_(false)
+{
+}
+
+bool PathProgressTracker::setPath(
+  const nav_msgs::msg::Path::ConstSharedPtr & path,
+  const std::optional<uint64_t> & version)
+{
+  if (path_ && path && version && isSameVersion(*version)) {
+    return false;
+  }
+
+  if (path_ && path && (path_ == path || isSamePath(*path))) {
+    version_ = version;
+    return false;
+  }
+
+  path_ = path;
+  version_ = version;
+  closest_idx_ = 0;
+  localized_ = false;
+  cumulative_length_.clear();
+  if (!path_ || path_->poses.empty()) {
+    return true;
+  }
+
+  cumulative_length_.resize(path_->poses.size());
+  cumulative_length_[0] = 0.0;
+  for (size_t idx = 1; idx < path_->poses.size(); ++idx) {
+    cumulative_length_[idx] = cumulative_length_[idx - 1] +
+      geometry_utils::euclidean_distance(path_->poses[idx - 1].pose, path_->poses[idx].pose);
+  }
+  return true;
+}
+
+bool PathProgressTracker::isSamePath(const nav_msgs::msg::Path & path) const
+{
+  return path_ && geometry_utils::is_same_path(path, *path_);
+}
+
+bool PathProgressTracker::isSameVersion(uint64_t version) const
+{
+  return path_ && version_ && *version_ == version;
+}
+
+double PathProgressTracker::update(const geometry_msgs::msg::PoseStamped & pose)
+{
+  if (cumulative_length_.empty()) {
+    return 0.0;
+  }
+
+  // The first search covers the whole path since the robot may start anywhere on
+  // it, later ones only move the cursor forward within the window
+  const auto & poses = path_->poses;
+  const size_t begin = localized_ ? closest_idx_ : 0;
+  const size_t end = localized_ ? std::min(closest_idx_ + search_window_, poses.size()) :
+    poses.size();
+
+  double min_dist = std::numeric_limits<double>::max();
+  for (size_t idx = begin; idx < end; ++idx) {
+    const double dist = geometry_utils::euclidean_distance(pose, poses[idx]);
+    if (dist < min_dist) {
+      min_dist = dist;
+      closest_idx_ = idx;
+    }
+  }
+
+  localized_ = true;
+  return getDistanceRemaining();
+}
+
+double PathProgressTracker::getDistanceRemaining() const
+{
+  if (cumulative_length_.empty()) {
+    return 0.0;
+  }
+  return cumulative_length_.back() - cumulative_length_[closest_idx_];
+}
+
+void PathProgressTracker::reset()
+{
+  path_.reset();
+  version_.reset();
+  cumulative_length_.clear();
+  closest_idx_ = 0;
+  localized_ = false;
+}
+
+}  // namespace nav2_util
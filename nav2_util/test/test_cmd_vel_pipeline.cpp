@@ -0,0 +1,132 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "nav2_util/cmd_vel_pipeline.hpp"
+
+using namespace std::chrono_literals;  // NOLINT
+
+TEST(CmdVelPipeline, empty)
+{
+  nav2_util::CmdVelPipeline pipeline;
+  geometry_msgs::msg::Twist cmd;
+  cmd.linear.x = 0.3;
+  EXPECT_TRUE(pipeline.process(cmd));
+  EXPECT_EQ(cmd.linear.x, 0.3);
+  EXPECT_EQ(pipeline.size(), 0u);
+}
+
+TEST(CmdVelPipeline, stagesInOrder)
+{
+  nav2_util::CmdVelPipeline pipeline;
+  std::vector<int> calls;
+  pipeline.addStage(
+    "limit", [&calls](geometry_msgs::msg::Twist & cmd) {
+      calls.push_back(0);
+      cmd.linear.x = std::min(cmd.linear.x, 0.5);
+      return true;
+    });
+  pipeline.addStage(
+    "slowdown", [&calls](geometry_msgs::msg::Twist & cmd) {
+      calls.push_back(1);
+      cmd.linear.x *= 0.5;
+      return true;
+    });
+
+  geometry_msgs::msg::Twist cmd;
+  cmd.linear.x = 2.0;
+  EXPECT_TRUE(pipeline.process(cmd));
+  EXPECT_DOUBLE_EQ(cmd.linear.x, 0.25);
+  EXPECT_EQ(calls, (std::vector<int>{0, 1}));
+  ASSERT_EQ(pipeline.size(), 2u);
+  EXPECT_EQ(pipeline.getStageName(0), "limit");
+  EXPECT_EQ(pipeline.getStageName(1), "slowdown");
+}
+
+TEST(CmdVelPipeline, dropCommand)
+{
+  nav2_util::CmdVelPipeline pipeline;
+  bool last_called = false;
+  pipeline.addStage("stop", [](geometry_msgs::msg::Twist &) {return false;});
+  pipeline.addStage(
+    "last", [&last_called](geometry_msgs::msg::Twist &) {
+      last_called = true;
+      return true;
+    });
+
+  geometry_msgs::msg::Twist cmd;
+  EXPECT_FALSE(pipeline.process(cmd));
+  EXPECT_FALSE(last_called);
+}
+
+TEST(CmdVelPipeline, latency)
+{
+  nav2_util::CmdVelPipeline pipeline;
+  pipeline.addStage(
+    "slow", [](geometry_msgs::msg::Twist &) {
+      std::this_thread::sleep_for(5ms);
+      return true;
+    });
+  pipeline.addStage("fast", [](geometry_msgs::msg::Twist &) {return true;});
+
+  geometry_msgs::msg::Twist cmd;
+  EXPECT_TRUE(pipeline.process(cmd));
+  EXPECT_GE(pipeline.getStageLatency(0), 0.005);
+  EXPECT_LT(pipeline.getStageLatency(1), pipeline.getStageLatency(0));
+  // The stage latencies sum up to the total, up to rounding
+  EXPECT_NEAR(
+    pipeline.getLatency(), pipeline.getStageLatency(0) + pipeline.getStageLatency(1), 1e-9);
+  EXPECT_GE(pipeline.getMaxLatency(), pipeline.getLatency());
+}
+
+TEST(CmdVelPipeline, reset)
+{
+  nav2_util::CmdVelPipeline pipeline;
+  // A stage limiting the change of velocity between commands
+  double last = 0.0;
+  pipeline.addStage(
+    "limit", [&last](geometry_msgs::msg::Twist & cmd) {
+      cmd.linear.x = std::clamp(cmd.linear.x, last - 0.1, last + 0.1);
+      last = cmd.linear.x;
+      return true;
+    },
+    [&last]() {last = 0.0;});
+  pipeline.addStage("stateless", [](geometry_msgs::msg::Twist &) {return true;});
+
+  geometry_msgs::msg::Twist cmd;
+  for (unsigned int i = 0; i != 5; i++) {
+    cmd.linear.x = 1.0;
+    EXPECT_TRUE(pipeline.process(cmd));
+  }
+  EXPECT_DOUBLE_EQ(cmd.linear.x, 0.5);
+
+  // A stop command through the stage would only decelerate
+  cmd.linear.x = 0.0;
+  EXPECT_TRUE(pipeline.process(cmd));
+  EXPECT_DOUBLE_EQ(cmd.linear.x, 0.4);
+
+  // Once stopped, bypassing the pipeline, the stages resume from a standstill
+  pipeline.reset();
+  cmd.linear.x = 0.0;
+  EXPECT_TRUE(pipeline.process(cmd));
+  EXPECT_DOUBLE_EQ(cmd.linear.x, 0.0);
+  cmd.linear.x = 1.0;
+  EXPECT_TRUE(pipeline.process(cmd));
+  EXPECT_DOUBLE_EQ(cmd.linear.x, 0.1);
+}
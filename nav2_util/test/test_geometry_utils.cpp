@@ -21,6 +21,7 @@
 
 using nav2_util::geometry_utils::euclidean_distance;
 using nav2_util::geometry_utils::calculate_path_length;
+using nav2_util::geometry_utils::splice_replanned_path;
 
 TEST(GeometryUtils, euclidean_distance_point_3d)
 {
@@ -128,3 +129,88 @@ TEST(GeometryUtils, calculate_path_length)
     calculate_path_length(circle_path),
     2 * pi * polar_distance, 1e-1);
 }
+
+TEST(GeometryUtils, splice_replanned_path)
+{
+  nav_msgs::msg::Path path;
+  for (size_t i = 0; i < 10; ++i) {
+    geometry_msgs::msg::PoseStamped pose_stamped_msg;
+    pose_stamped_msg.pose.position.x = static_cast<double>(i);
+    path.poses.push_back(pose_stamped_msg);
+  }
+
+  nav_msgs::msg::Path spliced, empty_path;
+  EXPECT_EQ(splice_replanned_path(path, empty_path, 0.1, spliced), 0u);
+  EXPECT_EQ(splice_replanned_path(empty_path, path, 0.1, spliced), 0u);
+  EXPECT_TRUE(spliced.poses.empty());
+
+  // A replan from the robot pose, off the poses of the path, rejoining it and then departing
+  // from it with poses spaced differently
+  nav_msgs::msg::Path replanned_path;
+  replanned_path.header.stamp.sec = 5;
+  for (double x : {3.04, 3.52, 4.0, 5.03, 6.0, 7.0}) {
+    geometry_msgs::msg::PoseStamped pose_stamped_msg;
+    pose_stamped_msg.pose.position.x = x;
+    pose_stamped_msg.pose.position.y = x > 5.5 ? 1.0 : 0.0;
+    replanned_path.poses.push_back(pose_stamped_msg);
+  }
+  EXPECT_EQ(splice_replanned_path(replanned_path, path, 0.1, spliced), 6u);
+  EXPECT_EQ(spliced.header.stamp.sec, 5);
+  ASSERT_EQ(spliced.poses.size(), 8u);
+  for (size_t i = 0; i < 6; ++i) {
+    EXPECT_EQ(spliced.poses[i].pose.position.x, static_cast<double>(i));
+  }
+  EXPECT_EQ(spliced.poses[6].pose.position.x, 6.0);
+  EXPECT_EQ(spliced.poses[6].pose.position.y, 1.0);
+  EXPECT_EQ(spliced.poses.back().pose.position.x, 7.0);
+
+  // Poses before the search start are not matched
+  EXPECT_EQ(splice_replanned_path(replanned_path, path, 0.1, spliced, 4), 0u);
+
+  // Too far from the path to rejoin it
+  EXPECT_EQ(splice_replanned_path(replanned_path, path, 0.01, spliced), 0u);
+
+  // The same path, its goal always being the replanned one
+  nav_msgs::msg::Path same_path = path;
+  same_path.poses.back().pose.position.y = 0.05;
+  EXPECT_EQ(splice_replanned_path(same_path, path, 0.1, spliced), 9u);
+  ASSERT_EQ(spliced.poses.size(), 10u);
+  EXPECT_EQ(spliced.poses.back().pose.position.y, 0.05);
+
+  // A replan going past the end of the path
+  nav_msgs::msg::Path extended_path;
+  extended_path.poses = {path.poses[8], path.poses[9], path.poses[9]};
+  extended_path.poses.back().pose.position.x = 10.0;
+  EXPECT_EQ(splice_replanned_path(extended_path, path, 0.1, spliced), 10u);
+  ASSERT_EQ(spliced.poses.size(), 11u);
+  EXPECT_EQ(spliced.poses.back().pose.position.x, 10.0);
+}
+
+TEST(GeometryUtils, is_same_path)
+{
+  nav_msgs::msg::Path path;
+  EXPECT_TRUE(nav2_util::geometry_utils::is_same_path(path, path));
+  for (size_t i = 0; i < 10; ++i) {
+    geometry_msgs::msg::PoseStamped pose_stamped_msg;
+    pose_stamped_msg.pose.position.x = static_cast<double>(i);
+    path.poses.push_back(pose_stamped_msg);
+  }
+
+  // Paths are compared pose by pose
+  nav_msgs::msg::Path other_path = path;
+  EXPECT_TRUE(nav2_util::geometry_utils::is_same_path(other_path, path));
+  other_path.poses[5].pose.position.y = 1.0;
+  EXPECT_FALSE(nav2_util::geometry_utils::is_same_path(other_path, path));
+  other_path.poses.pop_back();
+  EXPECT_FALSE(nav2_util::geometry_utils::is_same_path(other_path, path));
+
+  // Even stamped paths modified in place, keeping their header and ends
+  path.header.stamp.sec = 1;
+  other_path = path;
+  EXPECT_TRUE(nav2_util::geometry_utils::is_same_path(other_path, path));
+  other_path.poses[5].pose.position.y = 1.0;
+  EXPECT_FALSE(nav2_util::geometry_utils::is_same_path(other_path, path));
+  other_path = path;
+  other_path.header.stamp.sec = 2;
+  EXPECT_FALSE(nav2_util::geometry_utils::is_same_path(other_path, path));
+}
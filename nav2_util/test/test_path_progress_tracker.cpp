@@ -0,0 +1,149 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+
+#include "nav2_util/path_progress_tracker.hpp"
+#include "nav2_util/geometry_utils.hpp"
+#include "gtest/gtest.h"
+
+using nav2_util::PathProgressTracker;
+
+nav_msgs::msg::Path::SharedPtr makeStraightPath(size_t size, double spacing, int32_t stamp)
+{
+  auto path = std::make_shared<nav_msgs::msg::Path>();
+  path->header.frame_id = "map";
+  path->header.stamp.sec = stamp;
+  path->poses.resize(size);
+  for (size_t i = 0; i < size; ++i) {
+    path->poses[i].pose.position.x = i * spacing;
+  }
+  return path;
+}
+
+geometry_msgs::msg::PoseStamped makePose(double x, double y)
+{
+  geometry_msgs::msg::PoseStamped pose;
+  pose.pose.position.x = x;
+  pose.pose.position.y = y;
+  return pose;
+}
+
+TEST(PathProgressTracker, empty)
+{
+  PathProgressTracker tracker;
+  EXPECT_EQ(tracker.update(makePose(1.0, 0.0)), 0.0);
+
+  EXPECT_TRUE(tracker.setPath(makeStraightPath(0, 0.1, 1)));
+  EXPECT_EQ(tracker.update(makePose(1.0, 0.0)), 0.0);
+  EXPECT_EQ(tracker.getClosestIndex(), 0u);
+}
+
+TEST(PathProgressTracker, matches_path_length)
+{
+  auto path = makeStraightPath(1000, 0.05, 1);
+  PathProgressTracker tracker(20);
+  tracker.setPath(path);
+
+  // Initial localization searches the whole path
+  EXPECT_NEAR(
+    tracker.update(makePose(10.0, 0.1)),
+    nav2_util::geometry_utils::calculate_path_length(*path, 200), 1e-6);
+  EXPECT_EQ(tracker.getClosestIndex(), 200u);
+
+  for (size_t i = 201; i < 1000; i += 7) {
+    EXPECT_NEAR(
+      tracker.update(makePose(i * 0.05, -0.1)),
+      nav2_util::geometry_utils::calculate_path_length(*path, i), 1e-6);
+    EXPECT_EQ(tracker.getClosestIndex(), i);
+  }
+}
+
+TEST(PathProgressTracker, monotonic_and_bounded)
+{
+  PathProgressTracker tracker(10);
+  tracker.setPath(makeStraightPath(100, 1.0, 1));
+  tracker.update(makePose(50.0, 0.0));
+  EXPECT_EQ(tracker.getClosestIndex(), 50u);
+
+  // Never moves back along the path
+  tracker.update(makePose(20.0, 0.0));
+  EXPECT_EQ(tracker.getClosestIndex(), 50u);
+
+  // Catches up within the search window per update
+  tracker.update(makePose(90.0, 0.0));
+  EXPECT_EQ(tracker.getClosestIndex(), 59u);
+  tracker.update(makePose(90.0, 0.0));
+  EXPECT_EQ(tracker.getClosestIndex(), 68u);
+  EXPECT_DOUBLE_EQ(tracker.getDistanceRemaining(), 31.0);
+}
+
+TEST(PathProgressTracker, reset_on_new_path)
+{
+  PathProgressTracker tracker;
+  auto path = makeStraightPath(100, 1.0, 1);
+  EXPECT_TRUE(tracker.setPath(path));
+  tracker.update(makePose(50.0, 0.0));
+
+  // A copy of the same path keeps the progress
+  auto copy = std::make_shared<nav_msgs::msg::Path>(*path);
+  EXPECT_TRUE(tracker.isSamePath(*copy));
+  EXPECT_FALSE(tracker.setPath(copy));
+  EXPECT_EQ(tracker.getPath(), path);
+  EXPECT_EQ(tracker.getClosestIndex(), 50u);
+
+  // A replanned path resets it
+  auto replanned = makeStraightPath(100, 1.0, 2);
+  EXPECT_FALSE(tracker.isSamePath(*replanned));
+  EXPECT_TRUE(tracker.setPath(replanned));
+  EXPECT_EQ(tracker.getClosestIndex(), 0u);
+  tracker.update(makePose(20.0, 0.0));
+  EXPECT_EQ(tracker.getClosestIndex(), 20u);
+
+  tracker.reset();
+  EXPECT_EQ(tracker.getPath(), nullptr);
+  EXPECT_EQ(tracker.getDistanceRemaining(), 0.0);
+}
+
+TEST(PathProgressTracker, versions)
+{
+  PathProgressTracker tracker;
+  auto path = makeStraightPath(100, 1.0, 1);
+  EXPECT_FALSE(tracker.isSameVersion(1));
+  EXPECT_TRUE(tracker.setPath(path, 1));
+  EXPECT_TRUE(tracker.isSameVersion(1));
+  tracker.update(makePose(50.0, 0.0));
+
+  // A path of the same version is not compared again
+  EXPECT_FALSE(tracker.setPath(makeStraightPath(100, 1.0, 2), 1));
+  EXPECT_EQ(tracker.getPath(), path);
+  EXPECT_EQ(tracker.getClosestIndex(), 50u);
+
+  // A new version of the same path keeps the progress
+  EXPECT_FALSE(tracker.setPath(std::make_shared<nav_msgs::msg::Path>(*path), 2));
+  EXPECT_TRUE(tracker.isSameVersion(2));
+  EXPECT_EQ(tracker.getClosestIndex(), 50u);
+
+  // A new version of a replanned path resets it
+  EXPECT_TRUE(tracker.setPath(makeStraightPath(100, 1.0, 2), 3));
+  EXPECT_TRUE(tracker.isSameVersion(3));
+  EXPECT_EQ(tracker.getClosestIndex(), 0u);
+
+  // Unversioned paths are compared
+  EXPECT_TRUE(tracker.setPath(path));
+  EXPECT_FALSE(tracker.isSameVersion(3));
+
+  tracker.reset();
+  EXPECT_FALSE(tracker.isSameVersion(3));
+}
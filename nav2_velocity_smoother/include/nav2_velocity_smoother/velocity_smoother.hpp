@@ -15,6 +15,7 @@
 #ifndef NAV2_VELOCITY_SMOOTHER__VELOCITY_SMOOTHER_HPP_
 #define NAV2_VELOCITY_SMOOTHER__VELOCITY_SMOOTHER_HPP_
 
+#include <atomic>
 #include <chrono>
 #include <limits>
 #include <memory>
@@ -26,6 +27,7 @@
 #include "nav2_util/node_utils.hpp"
 #include "nav2_util/odometry_utils.hpp"
 #include "nav2_util/robot_utils.hpp"
+#include "std_msgs/msg/float64.hpp"
 
 namespace nav2_velocity_smoother
 {
@@ -60,6 +62,19 @@ public:
     const double v_curr, const double v_cmd,
     const double accel, const double decel);
 
+  /**
+   * @brief Find the scale factor, eta, which scales axis into acceleration range
+   * @param v_curr current velocity
+   * @param v_cmd commanded velocity
+   * @param accel maximum acceleration
+   * @param decel maximum deceleration
+   * @param dt time over which the velocity changes
+   * @return Scale factor, eta
+   */
+  double findEtaConstraint(
+    const double v_curr, const double v_cmd,
+    const double accel, const double decel, const double dt);
+
   /**
    * @brief Apply acceleration and scale factor constraints
    * @param v_curr current velocity
@@ -73,6 +88,39 @@ public:
     const double v_curr, const double v_cmd,
     const double accel, const double decel, const double eta);
 
+  /**
+   * @brief Apply acceleration and scale factor constraints
+   * @param v_curr current velocity
+   * @param v_cmd commanded velocity
+   * @param accel maximum acceleration
+   * @param decel maximum deceleration
+   * @param eta Scale factor
+   * @param dt time over which the velocity changes
+   * @return Velocity command
+   */
+  double applyConstraints(
+    const double v_curr, const double v_cmd,
+    const double accel, const double decel, const double eta, const double dt);
+
+  /**
+   * @brief Smooth a command in place, as a stage of an in-process command pipeline
+   * when the smoother is composed with the controller server, instead of subscribing
+   * to its output. The acceleration is limited over the time elapsed since the last
+   * command smoothed, up to a timer period.
+   * It may be called from another thread than the node callbacks. Once it or stop() was
+   * called, commands received on the cmd_vel topic are ignored, so that the smoothing state
+   * is only updated by the pipeline.
+   * @param cmd Velocity command to smooth
+   * @return false if the command is invalid and should be dropped
+   */
+  bool smooth(geometry_msgs::msg::Twist & cmd);
+
+  /**
+   * @brief Reset the smoother to a standstill, as the reset of its pipeline stage once
+   * a stop command was sent bypassing it, rather than decelerated by it
+   */
+  void stop();
+
 protected:
   /**
    * @brief Configures parameters and member variables
@@ -120,6 +168,26 @@ protected:
    */
   void smootherTimer();
 
+  /**
+   * @brief Apply the velocity constraints to the current command and publish it
+   */
+  void smoothCommand();
+
+  /**
+   * @brief Get the time over which the velocity changes to the next output, a timer
+   * period unless measured since the last output, for commands smoothed as they arrive
+   * @param measured Whether to measure the time since the last output
+   * @return Time step in seconds, at most a timer period
+   */
+  double getStepDuration(bool measured);
+
+  /**
+   * @brief Apply the velocity, acceleration and deadband constraints to a command
+   * @param cmd Velocity command, modified in place
+   * @param dt Time over which the velocity changes from the last output
+   */
+  void smoothTwist(geometry_msgs::msg::Twist & cmd, const double dt);
+
   /**
    * @brief Dynamic reconfigure callback
    * @param parameters Parameter list to change
@@ -128,9 +196,11 @@ protected:
     std::vector<rclcpp::Parameter> parameters);
 
   // Network interfaces
-  std::unique_ptr<nav2_util::OdomSmoother> odom_smoother_;
+  // Replaced with atomic_store on feedback parameter changes, read with atomic_load
+  std::shared_ptr<nav2_util::OdomSmoother> odom_smoother_;
   rclcpp_lifecycle::LifecyclePublisher<geometry_msgs::msg::Twist>::SharedPtr
     smoothed_cmd_pub_;
+  rclcpp_lifecycle::LifecyclePublisher<std_msgs::msg::Float64>::SharedPtr latency_pub_;
   rclcpp::Subscription<geometry_msgs::msg::Twist>::SharedPtr cmd_sub_;
   rclcpp::TimerBase::SharedPtr timer_;
 
@@ -138,20 +208,40 @@ protected:
   geometry_msgs::msg::Twist last_cmd_;
   geometry_msgs::msg::Twist::SharedPtr command_;
 
+  /**
+   * @brief Parameters read to smooth a command. The dynamic parameters callback replaces
+   * them as a whole with atomic_store, so that smoothing, possibly from the pipeline thread,
+   * reads a consistent set with atomic_load without waiting for the update
+   */
+  struct Limits
+  {
+    double smoothing_frequency;
+    bool open_loop;
+    bool scale_velocities;
+    std::vector<double> max_velocities;
+    std::vector<double> min_velocities;
+    std::vector<double> max_accels;
+    std::vector<double> max_decels;
+    std::vector<double> deadband_velocities;
+  };
+  std::shared_ptr<const Limits> limits_;
+
   // Parameters
-  double smoothing_frequency_;
   double odom_duration_;
   std::string odom_topic_;
-  bool open_loop_;
   bool stopped_{true};
-  bool scale_velocities_;
-  std::vector<double> max_velocities_;
-  std::vector<double> min_velocities_;
-  std::vector<double> max_accels_;
-  std::vector<double> max_decels_;
-  std::vector<double> deadband_velocities_;
   rclcpp::Duration velocity_timeout_{0, 0};
   rclcpp::Time last_command_time_;
+  rclcpp::Time last_output_time_;
+  // Smooth commands as they arrive, the timer only handling timeouts
+  bool event_driven_{false};
+  // Arrival of the command not yet published, to measure the latency of the smoother
+  std::chrono::steady_clock::time_point pending_command_time_;
+  bool command_pending_{false};
+
+  // Set once used as a pipeline stage, from then on the only writer of the smoothing state
+  // (last_cmd_, last_output_time_, stopped_), the node callbacks leaving it untouched
+  std::atomic<bool> pipelined_{false};
 
   rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr dyn_params_handler_;
 };
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
 #include <chrono>
 #include <limits>
 #include <memory>
@@ -31,7 +32,8 @@ namespace nav2_velocity_smoother
 
 VelocitySmoother::VelocitySmoother(const rclcpp::NodeOptions & options)
 : LifecycleNode("velocity_smoother", "", options),
-  last_command_time_{0, 0, get_clock()->get_clock_type()}
+  last_command_time_{0, 0, get_clock()->get_clock_type()},
+  last_output_time_{0, 0, get_clock()->get_clock_type()}
 {
 }
 
@@ -50,15 +52,21 @@ VelocitySmoother::on_configure(const rclcpp_lifecycle::State &)
   auto node = shared_from_this();
   std::string feedback_type;
   double velocity_timeout_dbl;
+  auto limits = std::make_shared<Limits>();
 
   // Smoothing metadata
   declare_parameter_if_not_declared(node, "smoothing_frequency", rclcpp::ParameterValue(20.0));
   declare_parameter_if_not_declared(
     node, "feedback", rclcpp::ParameterValue(std::string("OPEN_LOOP")));
   declare_parameter_if_not_declared(node, "scale_velocities", rclcpp::ParameterValue(false));
-  node->get_parameter("smoothing_frequency", smoothing_frequency_);
+  declare_parameter_if_not_declared(node, "event_driven", rclcpp::ParameterValue(false));
+  declare_parameter_if_not_declared(node, "publish_latency", rclcpp::ParameterValue(false));
+  node->get_parameter("smoothing_frequency", limits->smoothing_frequency);
   node->get_parameter("feedback", feedback_type);
-  node->get_parameter("scale_velocities", scale_velocities_);
+  node->get_parameter("scale_velocities", limits->scale_velocities);
+  node->get_parameter("event_driven", event_driven_);
+  bool publish_latency;
+  node->get_parameter("publish_latency", publish_latency);
 
   // Kinematics
   declare_parameter_if_not_declared(
@@ -69,21 +77,21 @@ VelocitySmoother::on_configure(const rclcpp_lifecycle::State &)
     node, "max_accel", rclcpp::ParameterValue(std::vector<double>{2.5, 0.0, 3.2}));
   declare_parameter_if_not_declared(
     node, "max_decel", rclcpp::ParameterValue(std::vector<double>{-2.5, 0.0, -3.2}));
-  node->get_parameter("max_velocity", max_velocities_);
-  node->get_parameter("min_velocity", min_velocities_);
-  node->get_parameter("max_accel", max_accels_);
-  node->get_parameter("max_decel", max_decels_);
+  node->get_parameter("max_velocity", limits->max_velocities);
+  node->get_parameter("min_velocity", limits->min_velocities);
+  node->get_parameter("max_accel", limits->max_accels);
+  node->get_parameter("max_decel", limits->max_decels);
 
   for (unsigned int i = 0; i != 3; i++) {
-    if (max_decels_[i] > 0.0) {
+    if (limits->max_decels[i] > 0.0) {
       throw std::runtime_error(
               "Positive values set of deceleration! These should be negative to slow down!");
     }
-    if (max_accels_[i] < 0.0) {
+    if (limits->max_accels[i] < 0.0) {
       throw std::runtime_error(
               "Negative values set of acceleration! These should be positive to speed up!");
     }
-    if (min_velocities_[i] > max_velocities_[i]) {
+    if (limits->min_velocities[i] > limits->max_velocities[i]) {
       throw std::runtime_error(
               "Min velocities are higher than max velocities!");
     }
@@ -97,12 +105,13 @@ VelocitySmoother::on_configure(const rclcpp_lifecycle::State &)
   declare_parameter_if_not_declared(node, "velocity_timeout", rclcpp::ParameterValue(1.0));
   node->get_parameter("odom_topic", odom_topic_);
   node->get_parameter("odom_duration", odom_duration_);
-  node->get_parameter("deadband_velocity", deadband_velocities_);
+  node->get_parameter("deadband_velocity", limits->deadband_velocities);
   node->get_parameter("velocity_timeout", velocity_timeout_dbl);
   velocity_timeout_ = rclcpp::Duration::from_seconds(velocity_timeout_dbl);
 
-  if (max_velocities_.size() != 3 || min_velocities_.size() != 3 ||
-    max_accels_.size() != 3 || max_decels_.size() != 3 || deadband_velocities_.size() != 3)
+  if (limits->max_velocities.size() != 3 || limits->min_velocities.size() != 3 ||
+    limits->max_accels.size() != 3 || limits->max_decels.size() != 3 ||
+    limits->deadband_velocities.size() != 3)
   {
     throw std::runtime_error(
             "Invalid setting of kinematic and/or deadband limits!"
@@ -111,16 +120,20 @@ VelocitySmoother::on_configure(const rclcpp_lifecycle::State &)
 
   // Get control type
   if (feedback_type == "OPEN_LOOP") {
-    open_loop_ = true;
+    limits->open_loop = true;
   } else if (feedback_type == "CLOSED_LOOP") {
-    open_loop_ = false;
-    odom_smoother_ = std::make_unique<nav2_util::OdomSmoother>(node, odom_duration_, odom_topic_);
+    limits->open_loop = false;
+    odom_smoother_ = std::make_shared<nav2_util::OdomSmoother>(node, odom_duration_, odom_topic_);
   } else {
     throw std::runtime_error("Invalid feedback_type, options are OPEN_LOOP and CLOSED_LOOP.");
   }
+  limits_ = limits;
 
   // Setup inputs / outputs
   smoothed_cmd_pub_ = create_publisher<geometry_msgs::msg::Twist>("cmd_vel_smoothed", 1);
+  if (publish_latency) {
+    latency_pub_ = create_publisher<std_msgs::msg::Float64>("~/latency", 1);
+  }
   cmd_sub_ = create_subscription<geometry_msgs::msg::Twist>(
     "cmd_vel", rclcpp::QoS(1),
     std::bind(&VelocitySmoother::inputCommandCallback, this, std::placeholders::_1));
@@ -133,7 +146,10 @@ VelocitySmoother::on_activate(const rclcpp_lifecycle::State &)
 {
   RCLCPP_INFO(get_logger(), "Activating");
   smoothed_cmd_pub_->on_activate();
-  double timer_duration_ms = 1000.0 / smoothing_frequency_;
+  if (latency_pub_) {
+    latency_pub_->on_activate();
+  }
+  double timer_duration_ms = 1000.0 / limits_->smoothing_frequency;
   timer_ = create_wall_timer(
     std::chrono::milliseconds(static_cast<int>(timer_duration_ms)),
     std::bind(&VelocitySmoother::smootherTimer, this));
@@ -155,6 +171,9 @@ VelocitySmoother::on_deactivate(const rclcpp_lifecycle::State &)
     timer_.reset();
   }
   smoothed_cmd_pub_->on_deactivate();
+  if (latency_pub_) {
+    latency_pub_->on_deactivate();
+  }
   dyn_params_handler_.reset();
 
   // destroy bond connection
@@ -167,6 +186,7 @@ VelocitySmoother::on_cleanup(const rclcpp_lifecycle::State &)
 {
   RCLCPP_INFO(get_logger(), "Cleaning up");
   smoothed_cmd_pub_.reset();
+  latency_pub_.reset();
   odom_smoother_.reset();
   cmd_sub_.reset();
   return nav2_util::CallbackReturn::SUCCESS;
@@ -187,12 +207,34 @@ void VelocitySmoother::inputCommandCallback(const geometry_msgs::msg::Twist::Sha
     return;
   }
 
+  // The smoothing state belongs to the pipeline once the smoother is used as a stage
+  if (pipelined_) {
+    RCLCPP_WARN_ONCE(
+      get_logger(), "Used as a command pipeline stage, ignoring commands on the cmd_vel topic");
+    return;
+  }
+
   command_ = msg;
   last_command_time_ = now();
+  pending_command_time_ = std::chrono::steady_clock::now();
+  command_pending_ = true;
+
+  // Rather than waiting up to a timer period, smooth the command right away
+  if (event_driven_ && smoothed_cmd_pub_->is_activated()) {
+    smoothCommand();
+  }
 }
 
 double VelocitySmoother::findEtaConstraint(
   const double v_curr, const double v_cmd, const double accel, const double decel)
+{
+  return findEtaConstraint(
+    v_curr, v_cmd, accel, decel, 1.0 / std::atomic_load(&limits_)->smoothing_frequency);
+}
+
+double VelocitySmoother::findEtaConstraint(
+  const double v_curr, const double v_cmd, const double accel, const double decel,
+  const double dt)
 {
   // Exploiting vector scaling properties
   double dv = v_cmd - v_curr;
@@ -204,11 +246,11 @@ double VelocitySmoother::findEtaConstraint(
   // and if v_cmd and v_curr have the same sign (i.e. speed is NOT passing through 0.0)
   // Decelerating otherwise
   if (abs(v_cmd) >= abs(v_curr) && v_curr * v_cmd >= 0.0) {
-    v_component_max = accel / smoothing_frequency_;
-    v_component_min = -accel / smoothing_frequency_;
+    v_component_max = accel * dt;
+    v_component_min = -accel * dt;
   } else {
-    v_component_max = -decel / smoothing_frequency_;
-    v_component_min = decel / smoothing_frequency_;
+    v_component_max = -decel * dt;
+    v_component_min = decel * dt;
   }
 
   if (dv > v_component_max) {
@@ -225,6 +267,14 @@ double VelocitySmoother::findEtaConstraint(
 double VelocitySmoother::applyConstraints(
   const double v_curr, const double v_cmd,
   const double accel, const double decel, const double eta)
+{
+  return applyConstraints(
+    v_curr, v_cmd, accel, decel, eta, 1.0 / std::atomic_load(&limits_)->smoothing_frequency);
+}
+
+double VelocitySmoother::applyConstraints(
+  const double v_curr, const double v_cmd,
+  const double accel, const double decel, const double eta, const double dt)
 {
   double dv = v_cmd - v_curr;
 
@@ -235,11 +285,11 @@ double VelocitySmoother::applyConstraints(
   // and if v_cmd and v_curr have the same sign (i.e. speed is NOT passing through 0.0)
   // Decelerating otherwise
   if (abs(v_cmd) >= abs(v_curr) && v_curr * v_cmd >= 0.0) {
-    v_component_max = accel / smoothing_frequency_;
-    v_component_min = -accel / smoothing_frequency_;
+    v_component_max = accel * dt;
+    v_component_min = -accel * dt;
   } else {
-    v_component_max = -decel / smoothing_frequency_;
-    v_component_min = decel / smoothing_frequency_;
+    v_component_max = -decel * dt;
+    v_component_min = decel * dt;
   }
 
   return v_curr + std::clamp(eta * dv, v_component_min, v_component_max);
@@ -247,13 +297,11 @@ double VelocitySmoother::applyConstraints(
 
 void VelocitySmoother::smootherTimer()
 {
-  // Wait until the first command is received
-  if (!command_) {
+  // Wait until the first command is received, the pipeline smoothing its own otherwise
+  if (!command_ || pipelined_) {
     return;
   }
 
-  auto cmd_vel = std::make_unique<geometry_msgs::msg::Twist>();
-
   // Check for velocity timeout. If nothing received, publish zeros to apply deceleration
   if (now() - last_command_time_ > velocity_timeout_) {
     if (last_cmd_ == geometry_msgs::msg::Twist() || stopped_) {
@@ -261,22 +309,86 @@ void VelocitySmoother::smootherTimer()
       return;
     }
     *command_ = geometry_msgs::msg::Twist();
+  } else if (event_driven_) {
+    // Commands are already smoothed as they arrive
+    return;
   }
 
+  smoothCommand();
+}
+
+void VelocitySmoother::smoothCommand()
+{
+  auto cmd_vel = std::make_unique<geometry_msgs::msg::Twist>(*command_);
   stopped_ = false;
+  smoothTwist(*cmd_vel, getStepDuration(event_driven_));
+  smoothed_cmd_pub_->publish(std::move(cmd_vel));
 
-  // Get current velocity based on feedback type
-  geometry_msgs::msg::Twist current_;
-  if (open_loop_) {
-    current_ = last_cmd_;
-  } else {
-    current_ = odom_smoother_->getTwist();
+  // Latency added by the smoother to the last command received
+  if (command_pending_) {
+    command_pending_ = false;
+    if (latency_pub_) {
+      auto latency = std::make_unique<std_msgs::msg::Float64>();
+      latency->data = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - pending_command_time_).count();
+      latency_pub_->publish(std::move(latency));
+    }
+  }
+}
+
+bool VelocitySmoother::smooth(geometry_msgs::msg::Twist & cmd)
+{
+  if (!nav2_util::validateTwist(cmd)) {
+    RCLCPP_ERROR(get_logger(), "Velocity message contains NaNs or Infs! Ignoring as invalid!");
+    return false;
+  }
+
+  pipelined_ = true;
+  stopped_ = false;
+  smoothTwist(cmd, getStepDuration(true));
+  return true;
+}
+
+void VelocitySmoother::stop()
+{
+  pipelined_ = true;
+  last_cmd_ = geometry_msgs::msg::Twist();
+  last_output_time_ = rclcpp::Time(0, 0, get_clock()->get_clock_type());
+  stopped_ = true;
+}
+
+double VelocitySmoother::getStepDuration(bool measured)
+{
+  const double period = 1.0 / std::atomic_load(&limits_)->smoothing_frequency;
+  const rclcpp::Time time = now();
+  double dt = period;
+
+  // Commands arriving faster than the timer must not exceed the acceleration limits,
+  // nor may a command after a pause accelerate more than a timer period
+  if (measured && last_output_time_.nanoseconds() != 0) {
+    dt = std::clamp((time - last_output_time_).seconds(), 0.0, period);
+  }
+  last_output_time_ = time;
+  return dt;
+}
+
+void VelocitySmoother::smoothTwist(geometry_msgs::msg::Twist & cmd, const double dt)
+{
+  const auto limits = std::atomic_load(&limits_);
+
+  // Get current velocity based on feedback type, open loop while switching to closed loop
+  geometry_msgs::msg::Twist current_ = last_cmd_;
+  if (!limits->open_loop) {
+    const auto odom_smoother = std::atomic_load(&odom_smoother_);
+    if (odom_smoother) {
+      current_ = odom_smoother->getTwist();
+    }
   }
 
   // Apply absolute velocity restrictions to the command
-  command_->linear.x = std::clamp(command_->linear.x, min_velocities_[0], max_velocities_[0]);
-  command_->linear.y = std::clamp(command_->linear.y, min_velocities_[1], max_velocities_[1]);
-  command_->angular.z = std::clamp(command_->angular.z, min_velocities_[2], max_velocities_[2]);
+  cmd.linear.x = std::clamp(cmd.linear.x, limits->min_velocities[0], limits->max_velocities[0]);
+  cmd.linear.y = std::clamp(cmd.linear.y, limits->min_velocities[1], limits->max_velocities[1]);
+  cmd.angular.z = std::clamp(cmd.angular.z, limits->min_velocities[2], limits->max_velocities[2]);
 
   // Find if any component is not within the acceleration constraints. If so, store the most
   // significant scale factor to apply to the vector <dvx, dvy, dvw>, eta, to reduce all axes
@@ -284,43 +396,40 @@ void VelocitySmoother::smootherTimer()
   // In case eta reduces another axis out of its own limit, apply accel constraint to guarantee
   // output is within limits, even if it deviates from requested command slightly.
   double eta = 1.0;
-  if (scale_velocities_) {
+  if (limits->scale_velocities) {
     double curr_eta = -1.0;
 
     curr_eta = findEtaConstraint(
-      current_.linear.x, command_->linear.x, max_accels_[0], max_decels_[0]);
+      current_.linear.x, cmd.linear.x, limits->max_accels[0], limits->max_decels[0], dt);
     if (curr_eta > 0.0 && std::fabs(1.0 - curr_eta) > std::fabs(1.0 - eta)) {
       eta = curr_eta;
     }
 
     curr_eta = findEtaConstraint(
-      current_.linear.y, command_->linear.y, max_accels_[1], max_decels_[1]);
+      current_.linear.y, cmd.linear.y, limits->max_accels[1], limits->max_decels[1], dt);
     if (curr_eta > 0.0 && std::fabs(1.0 - curr_eta) > std::fabs(1.0 - eta)) {
       eta = curr_eta;
     }
 
     curr_eta = findEtaConstraint(
-      current_.angular.z, command_->angular.z, max_accels_[2], max_decels_[2]);
+      current_.angular.z, cmd.angular.z, limits->max_accels[2], limits->max_decels[2], dt);
     if (curr_eta > 0.0 && std::fabs(1.0 - curr_eta) > std::fabs(1.0 - eta)) {
       eta = curr_eta;
     }
   }
 
-  cmd_vel->linear.x = applyConstraints(
-    current_.linear.x, command_->linear.x, max_accels_[0], max_decels_[0], eta);
-  cmd_vel->linear.y = applyConstraints(
-    current_.linear.y, command_->linear.y, max_accels_[1], max_decels_[1], eta);
-  cmd_vel->angular.z = applyConstraints(
-    current_.angular.z, command_->angular.z, max_accels_[2], max_decels_[2], eta);
-  last_cmd_ = *cmd_vel;
-
-  // Apply deadband restrictions & publish
-  cmd_vel->linear.x = fabs(cmd_vel->linear.x) < deadband_velocities_[0] ? 0.0 : cmd_vel->linear.x;
-  cmd_vel->linear.y = fabs(cmd_vel->linear.y) < deadband_velocities_[1] ? 0.0 : cmd_vel->linear.y;
-  cmd_vel->angular.z = fabs(cmd_vel->angular.z) <
-    deadband_velocities_[2] ? 0.0 : cmd_vel->angular.z;
-
-  smoothed_cmd_pub_->publish(std::move(cmd_vel));
+  cmd.linear.x = applyConstraints(
+    current_.linear.x, cmd.linear.x, limits->max_accels[0], limits->max_decels[0], eta, dt);
+  cmd.linear.y = applyConstraints(
+    current_.linear.y, cmd.linear.y, limits->max_accels[1], limits->max_decels[1], eta, dt);
+  cmd.angular.z = applyConstraints(
+    current_.angular.z, cmd.angular.z, limits->max_accels[2], limits->max_decels[2], eta, dt);
+  last_cmd_ = cmd;
+
+  // Apply deadband restrictions
+  cmd.linear.x = fabs(cmd.linear.x) < limits->deadband_velocities[0] ? 0.0 : cmd.linear.x;
+  cmd.linear.y = fabs(cmd.linear.y) < limits->deadband_velocities[1] ? 0.0 : cmd.linear.y;
+  cmd.angular.z = fabs(cmd.angular.z) < limits->deadband_velocities[2] ? 0.0 : cmd.angular.z;
 }
 
 rcl_interfaces::msg::SetParametersResult
@@ -328,6 +437,7 @@ VelocitySmoother::dynamicParametersCallback(std::vector<rclcpp::Parameter> param
 {
   rcl_interfaces::msg::SetParametersResult result;
   result.successful = true;
+  auto limits = std::make_shared<Limits>(*limits_);
 
   for (auto parameter : parameters) {
     const auto & type = parameter.get_type();
@@ -335,13 +445,13 @@ VelocitySmoother::dynamicParametersCallback(std::vector<rclcpp::Parameter> param
 
     if (type == ParameterType::PARAMETER_DOUBLE) {
       if (name == "smoothing_frequency") {
-        smoothing_frequency_ = parameter.as_double();
+        limits->smoothing_frequency = parameter.as_double();
         if (timer_) {
           timer_->cancel();
           timer_.reset();
         }
 
-        double timer_duration_ms = 1000.0 / smoothing_frequency_;
+        double timer_duration_ms = 1000.0 / limits->smoothing_frequency;
         timer_ = create_wall_timer(
           std::chrono::milliseconds(static_cast<int>(timer_duration_ms)),
           std::bind(&VelocitySmoother::smootherTimer, this));
@@ -349,9 +459,9 @@ VelocitySmoother::dynamicParametersCallback(std::vector<rclcpp::Parameter> param
         velocity_timeout_ = rclcpp::Duration::from_seconds(parameter.as_double());
       } else if (name == "odom_duration") {
         odom_duration_ = parameter.as_double();
-        odom_smoother_ =
-          std::make_unique<nav2_util::OdomSmoother>(
-          shared_from_this(), odom_duration_, odom_topic_);
+        std::atomic_store(
+          &odom_smoother_, std::make_shared<nav2_util::OdomSmoother>(
+            shared_from_this(), odom_duration_, odom_topic_));
       }
     } else if (type == ParameterType::PARAMETER_DOUBLE_ARRAY) {
       if (parameter.as_double_array().size() != 3) {
@@ -361,9 +471,9 @@ VelocitySmoother::dynamicParametersCallback(std::vector<rclcpp::Parameter> param
       }
 
       if (name == "max_velocity") {
-        max_velocities_ = parameter.as_double_array();
+        limits->max_velocities = parameter.as_double_array();
       } else if (name == "min_velocity") {
-        min_velocities_ = parameter.as_double_array();
+        limits->min_velocities = parameter.as_double_array();
       } else if (name == "max_accel") {
         for (unsigned int i = 0; i != 3; i++) {
           if (parameter.as_double_array()[i] < 0.0) {
@@ -373,7 +483,7 @@ VelocitySmoother::dynamicParametersCallback(std::vector<rclcpp::Parameter> param
             result.successful = false;
           }
         }
-        max_accels_ = parameter.as_double_array();
+        limits->max_accels = parameter.as_double_array();
       } else if (name == "max_decel") {
         for (unsigned int i = 0; i != 3; i++) {
           if (parameter.as_double_array()[i] > 0.0) {
@@ -383,20 +493,20 @@ VelocitySmoother::dynamicParametersCallback(std::vector<rclcpp::Parameter> param
             result.successful = false;
           }
         }
-        max_decels_ = parameter.as_double_array();
+        limits->max_decels = parameter.as_double_array();
       } else if (name == "deadband_velocity") {
-        deadband_velocities_ = parameter.as_double_array();
+        limits->deadband_velocities = parameter.as_double_array();
       }
     } else if (type == ParameterType::PARAMETER_STRING) {
       if (name == "feedback") {
         if (parameter.as_string() == "OPEN_LOOP") {
-          open_loop_ = true;
-          odom_smoother_.reset();
+          limits->open_loop = true;
+          std::atomic_store(&odom_smoother_, std::shared_ptr<nav2_util::OdomSmoother>());
         } else if (parameter.as_string() == "CLOSED_LOOP") {
-          open_loop_ = false;
-          odom_smoother_ =
-            std::make_unique<nav2_util::OdomSmoother>(
-            shared_from_this(), odom_duration_, odom_topic_);
+          limits->open_loop = false;
+          std::atomic_store(
+            &odom_smoother_, std::make_shared<nav2_util::OdomSmoother>(
+              shared_from_this(), odom_duration_, odom_topic_));
         } else {
           RCLCPP_WARN(
             get_logger(), "Invalid feedback_type, options are OPEN_LOOP and CLOSED_LOOP.");
@@ -405,13 +515,14 @@ VelocitySmoother::dynamicParametersCallback(std::vector<rclcpp::Parameter> param
         }
       } else if (name == "odom_topic") {
         odom_topic_ = parameter.as_string();
-        odom_smoother_ =
-          std::make_unique<nav2_util::OdomSmoother>(
-          shared_from_this(), odom_duration_, odom_topic_);
+        std::atomic_store(
+          &odom_smoother_, std::make_shared<nav2_util::OdomSmoother>(
+            shared_from_this(), odom_duration_, odom_topic_));
       }
     }
   }
 
+  std::atomic_store(&limits_, std::shared_ptr<const Limits>(limits));
   return result;
 }
 
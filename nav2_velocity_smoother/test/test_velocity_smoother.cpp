@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <math.h>
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -20,9 +21,11 @@
 
 #include "gtest/gtest.h"
 #include "rclcpp/rclcpp.hpp"
+#include "nav2_util/cmd_vel_pipeline.hpp"
 #include "nav2_velocity_smoother/velocity_smoother.hpp"
 #include "nav_msgs/msg/odometry.hpp"
 #include "geometry_msgs/msg/twist.hpp"
+#include "std_msgs/msg/float64.hpp"
 
 using namespace std::chrono_literals;
 
@@ -171,6 +174,172 @@ TEST(VelocitySmootherTest, approxClosedLoopTestTimer)
   }
 }
 
+TEST(VelocitySmootherTest, eventDrivenTest)
+{
+  auto smoother =
+    std::make_shared<VelSmootherShim>();
+  smoother->declare_parameter("event_driven", rclcpp::ParameterValue(true));
+  smoother->declare_parameter("publish_latency", rclcpp::ParameterValue(true));
+  rclcpp_lifecycle::State state;
+  smoother->configure(state);
+  smoother->activate(state);
+
+  std::vector<double> linear_vels;
+  auto subscription = smoother->create_subscription<geometry_msgs::msg::Twist>(
+    "cmd_vel_smoothed",
+    1,
+    [&](geometry_msgs::msg::Twist::SharedPtr msg) {
+      linear_vels.push_back(msg->linear.x);
+    });
+  std::vector<double> latencies;
+  auto latency_subscription = smoother->create_subscription<std_msgs::msg::Float64>(
+    "velocity_smoother/latency",
+    1,
+    [&](std_msgs::msg::Float64::SharedPtr msg) {
+      latencies.push_back(msg->data);
+    });
+
+  // Let the subscriptions connect
+  auto start = smoother->now();
+  while (smoother->now() - start < 0.1s) {
+    rclcpp::spin_some(smoother->get_node_base_interface());
+  }
+
+  // Each command is smoothed and published as it is received, not on the timer
+  auto cmd = std::make_shared<geometry_msgs::msg::Twist>();
+  cmd->linear.x = 1.0;
+  std::vector<rclcpp::Time> times;
+  for (unsigned int i = 0; i != 3; i++) {
+    times.push_back(smoother->now());
+    smoother->sendCommandMsg(std::make_shared<geometry_msgs::msg::Twist>(*cmd));
+    start = smoother->now();
+    while (smoother->now() - start < 0.01s) {
+      rclcpp::spin_some(smoother->get_node_base_interface());
+    }
+  }
+
+  // A timer period of acceleration for the first command, at the default 20 Hz and 2.5 m/s^2,
+  // then the acceleration over the time elapsed since the previous one
+  ASSERT_EQ(linear_vels.size(), 3u);
+  EXPECT_NEAR(linear_vels[0], 0.125, 1e-6);
+  for (unsigned int i = 1; i != 3; i++) {
+    EXPECT_GT(linear_vels[i], linear_vels[i - 1]);
+    EXPECT_LE(
+      linear_vels[i] - linear_vels[i - 1], 2.5 * (times[i] - times[i - 1]).seconds() + 5e-3);
+  }
+
+  // The smoother added less latency than a timer period to the commands
+  ASSERT_EQ(latencies.size(), 3u);
+  for (const auto & latency : latencies) {
+    EXPECT_GE(latency, 0.0);
+    EXPECT_LT(latency, 0.05);
+  }
+
+  // The timer still decelerates to a stop once commands time out
+  start = smoother->now();
+  while (smoother->now() - start < 1.5s) {
+    rclcpp::spin_some(smoother->get_node_base_interface());
+  }
+  EXPECT_EQ(linear_vels.back(), 0.0);
+}
+
+TEST(VelocitySmootherTest, eventDrivenFastCommandsTest)
+{
+  auto smoother =
+    std::make_shared<VelSmootherShim>();
+  smoother->declare_parameter("event_driven", rclcpp::ParameterValue(true));
+  rclcpp_lifecycle::State state;
+  smoother->configure(state);
+  smoother->activate(state);
+
+  std::vector<double> linear_vels;
+  auto subscription = smoother->create_subscription<geometry_msgs::msg::Twist>(
+    "cmd_vel_smoothed",
+    1,
+    [&](geometry_msgs::msg::Twist::SharedPtr msg) {
+      linear_vels.push_back(msg->linear.x);
+    });
+
+  auto start = smoother->now();
+  while (smoother->now() - start < 0.1s) {
+    rclcpp::spin_some(smoother->get_node_base_interface());
+  }
+
+  // Commands at twice the default 20 Hz smoothing frequency, accelerating and decelerating
+  auto cmd = std::make_shared<geometry_msgs::msg::Twist>();
+  std::vector<rclcpp::Time> times;
+  for (unsigned int i = 0; i != 20; i++) {
+    cmd->linear.x = i < 10 ? 0.5 : 0.0;
+    times.push_back(smoother->now());
+    smoother->sendCommandMsg(std::make_shared<geometry_msgs::msg::Twist>(*cmd));
+    start = smoother->now();
+    while (smoother->now() - start < 0.025s) {
+      rclcpp::spin_some(smoother->get_node_base_interface());
+    }
+  }
+
+  // The change of velocity is limited by the time elapsed between the commands,
+  // 2.5 m/s^2 in acceleration and deceleration, not by one step per command
+  ASSERT_EQ(linear_vels.size(), 20u);
+  EXPECT_NEAR(linear_vels[0], 0.125, 1e-6);
+  for (unsigned int i = 1; i != 20; i++) {
+    const double max_dv = 2.5 * (times[i] - times[i - 1]).seconds() + 5e-3;
+    EXPECT_LE(std::fabs(linear_vels[i] - linear_vels[i - 1]), max_dv);
+  }
+}
+
+TEST(VelocitySmootherTest, pipelineStageTest)
+{
+  auto smoother =
+    std::make_shared<VelSmootherShim>();
+  rclcpp_lifecycle::State state;
+  smoother->configure(state);
+  smoother->activate(state);
+
+  nav2_util::CmdVelPipeline pipeline;
+  pipeline.addStage(
+    "velocity_smoother",
+    [&smoother](geometry_msgs::msg::Twist & cmd) {return smoother->smooth(cmd);},
+    [&smoother]() {smoother->stop();});
+
+  // Commands are limited by the time elapsed between them, 2.5 m/s^2 by default
+  geometry_msgs::msg::Twist cmd;
+  double last_vel = 0.0;
+  auto last_time = smoother->now();
+  for (unsigned int i = 0; i != 10; i++) {
+    cmd = geometry_msgs::msg::Twist();
+    cmd.linear.x = 0.5;
+    ASSERT_TRUE(pipeline.process(cmd));
+    const auto time = smoother->now();
+    EXPECT_GE(cmd.linear.x, last_vel);
+    // A timer period of acceleration for the first command
+    const double dt = i == 0 ? 0.05 : std::min((time - last_time).seconds(), 0.05);
+    EXPECT_LE(cmd.linear.x - last_vel, 2.5 * dt + 1e-3);
+    last_vel = cmd.linear.x;
+    last_time = time;
+    rclcpp::sleep_for(20ms);
+  }
+  EXPECT_GT(last_vel, 0.0);
+
+  // Through the stage, a stop command is only decelerated
+  cmd = geometry_msgs::msg::Twist();
+  ASSERT_TRUE(pipeline.process(cmd));
+  EXPECT_GT(cmd.linear.x, 0.0);
+
+  // Once the stop command was sent bypassing the stage, it resumes from a standstill
+  pipeline.reset();
+  cmd = geometry_msgs::msg::Twist();
+  ASSERT_TRUE(pipeline.process(cmd));
+  EXPECT_EQ(cmd.linear.x, 0.0);
+  cmd.linear.x = 0.5;
+  ASSERT_TRUE(pipeline.process(cmd));
+  EXPECT_LE(cmd.linear.x, 0.125 + 1e-6);
+
+  // Invalid commands are dropped
+  cmd.linear.x = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_FALSE(pipeline.process(cmd));
+}
+
 TEST(VelocitySmootherTest, testfindEtaConstraint)
 {
   auto smoother =
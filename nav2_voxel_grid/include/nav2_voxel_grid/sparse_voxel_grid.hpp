@@ -0,0 +1,454 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NAV2_VOXEL_GRID__SPARSE_VOXEL_GRID_HPP_
+#define NAV2_VOXEL_GRID__SPARSE_VOXEL_GRID_HPP_
+
+#include <stdint.h>
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include "nav2_voxel_grid/voxel_grid.hpp"
+
+namespace nav2_voxel_grid
+{
+
+/**
+ * @class SparseVoxelGrid
+ * @brief A 3D grid of unknown, free and marked voxels with no limit on the number of z
+ * levels, a sparse counterpart to VoxelGrid with the same interface and raytracing.
+ *
+ * Voxels are stored in bricks of 8x8x8, two 512 bit masks for known and marked voxels,
+ * found from their brick coordinates in a hash table. Bricks never observed are unknown and
+ * not allocated, and bricks with every voxel free collapse into a table entry without
+ * storage, so memory scales with the observed and occupied space rather than the volume.
+ * The number of known and marked voxels of each column is kept up to date, giving the
+ * column status projected into the 2D costmap in constant time.
+ *
+ * Bricks are addressed in grid coordinates relative to a moving origin, so a rolling
+ * window only drops the voxels leaving it instead of copying the grid.
+ */
+class SparseVoxelGrid
+{
+public:
+  /**
+   * @brief Constructor for a sparse voxel grid
+   * @param size_x The x size of the grid
+   * @param size_y The y size of the grid
+   * @param size_z The z size of the grid
+   */
+  SparseVoxelGrid(unsigned int size_x, unsigned int size_y, unsigned int size_z);
+
+  /**
+   * @brief Resizes the grid to the desired size, resetting it to unknown
+   * @param size_x The x size of the grid
+   * @param size_y The y size of the grid
+   * @param size_z The z size of the grid
+   */
+  void resize(unsigned int size_x, unsigned int size_y, unsigned int size_z);
+
+  /**
+   * @brief Resets every voxel to unknown, releasing the bricks
+   */
+  void reset();
+
+  /**
+   * @brief Moves the grid window, voxels leaving it are dropped and the ones entering it
+   * are unknown
+   * @param cell_ox Cell of the current grid which becomes the new x origin
+   * @param cell_oy Cell of the current grid which becomes the new y origin
+   */
+  void updateOrigin(int cell_ox, int cell_oy);
+
+  inline void markVoxel(unsigned int x, unsigned int y, unsigned int z)
+  {
+    if (x >= size_x_ || y >= size_y_ || z >= size_z_) {
+      return;
+    }
+    setVoxel<true>(x, y, z);
+  }
+
+  inline bool markVoxelInMap(
+    unsigned int x, unsigned int y, unsigned int z,
+    unsigned int marked_threshold)
+  {
+    if (x >= size_x_ || y >= size_y_ || z >= size_z_) {
+      return false;
+    }
+    setVoxel<true>(x, y, z);
+    return marked_counts_[y * size_x_ + x] > marked_threshold;
+  }
+
+  inline void clearVoxel(unsigned int x, unsigned int y, unsigned int z)
+  {
+    if (x >= size_x_ || y >= size_y_ || z >= size_z_) {
+      return;
+    }
+    setVoxel<false>(x, y, z);
+    releaseCachedBrick();
+  }
+
+  /**
+   * @brief Clears every voxel of a column
+   * @param index Index of the column, y * size_x + x
+   */
+  void clearVoxelColumn(unsigned int index);
+
+  void markVoxelLine(
+    double x0, double y0, double z0, double x1, double y1, double z1,
+    unsigned int max_length = UINT_MAX);
+  void clearVoxelLine(
+    double x0, double y0, double z0, double x1, double y1, double z1,
+    unsigned int max_length = UINT_MAX, unsigned int min_length = 0);
+  void clearVoxelLineInMap(
+    double x0, double y0, double z0, double x1, double y1, double z1, unsigned char * map_2d,
+    unsigned int unknown_threshold, unsigned int mark_threshold,
+    unsigned char free_cost = 0, unsigned char unknown_cost = 255,
+    unsigned int max_length = UINT_MAX, unsigned int min_length = 0);
+
+  VoxelStatus getVoxel(unsigned int x, unsigned int y, unsigned int z) const;
+
+  /**
+   * @brief Status of a column, from the number of its marked and unknown voxels. Unlike
+   * VoxelGrid, only the size_z voxels of the column count as unknown
+   */
+  VoxelStatus getVoxelColumn(
+    unsigned int x, unsigned int y,
+    unsigned int unknown_threshold = 0, unsigned int marked_threshold = 0) const;
+
+  /**
+   * @brief Writes the columns in the dense VoxelGrid format, for the VoxelGrid message.
+   * Only the lowest 16 z levels fit in this format
+   * @param data Array of sizeX() * sizeY() columns
+   */
+  void getDenseData(uint32_t * data) const;
+
+  unsigned int sizeX() const {return size_x_;}
+  unsigned int sizeY() const {return size_y_;}
+  unsigned int sizeZ() const {return size_z_;}
+
+  /**
+   * @brief Number of bricks with allocated storage
+   */
+  size_t getNumBricks() const {return bricks_.size() - free_bricks_.size();}
+
+  template<class ActionType>
+  inline void raytraceLine(
+    ActionType at, double x0, double y0, double z0,
+    double x1, double y1, double z1, unsigned int max_length = UINT_MAX,
+    unsigned int min_length = 0)
+  {
+    // Same traversal as VoxelGrid::raytraceLine, on coordinates rather than offsets
+    double dist = sqrt((x0 - x1) * (x0 - x1) + (y0 - y1) * (y0 - y1) + (z0 - z1) * (z0 - z1));
+    if ((unsigned int)(dist) < min_length) {
+      return;
+    }
+    double scale, min_x0, min_y0, min_z0;
+    if (dist > 0.0) {
+      scale = std::min(1.0, max_length / dist);
+      min_x0 = x0 + (x1 - x0) / dist * min_length;
+      min_y0 = y0 + (y1 - y0) / dist * min_length;
+      min_z0 = z0 + (z1 - z0) / dist * min_length;
+    } else {
+      scale = 1.0;
+      min_x0 = x0;
+      min_y0 = y0;
+      min_z0 = z0;
+    }
+
+    const int delta[3] = {
+      int(x1) - int(min_x0),  // NOLINT
+      int(y1) - int(min_y0),  // NOLINT
+      int(z1) - int(min_z0)};  // NOLINT
+    const unsigned int abs_d[3] = {
+      static_cast<unsigned int>(abs(delta[0])),
+      static_cast<unsigned int>(abs(delta[1])),
+      static_cast<unsigned int>(abs(delta[2]))};
+    const int step[3] = {sign(delta[0]), sign(delta[1]), sign(delta[2])};
+    unsigned int p[3] = {
+      (unsigned int)min_x0, (unsigned int)min_y0, (unsigned int)min_z0};
+
+    // dominant axis a, the other two following it
+    unsigned int a = 2, b = 0, c = 1;
+    if (abs_d[0] >= std::max(abs_d[1], abs_d[2])) {
+      a = 0, b = 1, c = 2;
+    } else if (abs_d[1] >= abs_d[2]) {
+      a = 1, b = 0, c = 2;
+    }
+
+    int error_b = abs_d[a] / 2;
+    int error_c = abs_d[a] / 2;
+    const unsigned int end = std::min((unsigned int)(scale * abs_d[a]), abs_d[a]);
+    for (unsigned int i = 0; i < end; ++i) {
+      at(p[0], p[1], p[2]);
+      p[a] += step[a];
+      error_b += abs_d[b];
+      error_c += abs_d[c];
+      if ((unsigned int)error_b >= abs_d[a]) {
+        p[b] += step[b];
+        error_b -= abs_d[a];
+      }
+      if ((unsigned int)error_c >= abs_d[a]) {
+        p[c] += step[c];
+        error_c -= abs_d[a];
+      }
+    }
+    at(p[0], p[1], p[2]);
+    releaseCachedBrick();
+  }
+
+protected:
+  /**
+   * @struct nav2_voxel_grid::SparseVoxelGrid::Brick
+   * @brief 8x8x8 voxels, one 64 bit word of each mask per z level
+   */
+  struct Brick
+  {
+    uint64_t known[8];
+    uint64_t marked[8];
+    unsigned int known_count;
+    unsigned int marked_count;
+  };
+
+  static constexpr uint32_t FREE_BRICK = std::numeric_limits<uint32_t>::max();
+  static constexpr uint32_t NO_BRICK = FREE_BRICK - 1;
+
+  /**
+   * @brief Key of the brick holding a voxel, in coordinates relative to the grid origin
+   */
+  static inline uint64_t brickKey(int x, int y, unsigned int z)
+  {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x >> 3) & 0xFFFFFF) << 40) |
+           (static_cast<uint64_t>(static_cast<uint32_t>(y >> 3) & 0xFFFFFF) << 16) |
+           static_cast<uint64_t>(z >> 3);
+  }
+
+  /**
+   * @brief Bit of a voxel in the word of its z level
+   */
+  static inline uint64_t voxelBit(int x, int y)
+  {
+    return uint64_t(1) << (((y & 7) << 3) | (x & 7));
+  }
+
+  /**
+   * @brief Marks or clears a voxel in the grid, the brick it falls in is kept at hand for
+   * the next voxel of a ray. Must be followed by releaseCachedBrick()
+   */
+  template<bool mark>
+  inline void setVoxel(unsigned int x, unsigned int y, unsigned int z)
+  {
+    const int gx = static_cast<int>(x) + origin_x_;
+    const int gy = static_cast<int>(y) + origin_y_;
+    const uint64_t key = brickKey(gx, gy, z);
+    if (key != cached_key_ || cached_brick_ == NO_BRICK ||
+      (mark && cached_brick_ == FREE_BRICK))
+    {
+      releaseCachedBrick();
+      cached_key_ = key;
+      cached_brick_ = getBrick(key, mark);
+    }
+    if (cached_brick_ == FREE_BRICK) {
+      // clearing a voxel already free
+      return;
+    }
+
+    Brick & brick = bricks_[cached_brick_];
+    const uint64_t bit = voxelBit(gx, gy);
+    uint64_t & known = brick.known[z & 7];
+    uint64_t & marked = brick.marked[z & 7];
+    const unsigned int index = y * size_x_ + x;
+    if (!(known & bit)) {
+      known |= bit;
+      brick.known_count++;
+      known_counts_[index]++;
+    }
+    if (mark && !(marked & bit)) {
+      marked |= bit;
+      brick.marked_count++;
+      marked_counts_[index]++;
+    } else if (!mark && (marked & bit)) {
+      marked &= ~bit;
+      brick.marked_count--;
+      marked_counts_[index]--;
+    }
+  }
+
+  /**
+   * @brief Gets the brick of a key, creating it if needed
+   * @param key Key of the brick
+   * @param mark Whether a voxel is to be marked in it, an all free brick is only expanded
+   * back to storage for marking
+   * @return Index of the brick, or FREE_BRICK
+   */
+  uint32_t getBrick(const uint64_t & key, const bool & mark);
+
+  /**
+   * @brief Collapses the brick kept at hand if all of its voxels in the grid are free
+   */
+  void releaseCachedBrick();
+
+  /**
+   * @brief Allocates a brick
+   * @param all_free Whether its voxels in the grid start free rather than unknown
+   * @param key Key of the brick
+   * @return Index of the brick
+   */
+  uint32_t allocateBrick(const bool & all_free, const uint64_t & key);
+
+  /**
+   * @brief Releases the storage of a brick
+   * @param brick Index of the brick
+   */
+  void releaseBrick(const uint32_t & brick);
+
+  /**
+   * @brief Mask of the voxels of a brick z level which are inside the grid
+   * @param key Key of the brick
+   * @param origin_x Grid coordinates of the cell (0, 0)
+   * @param origin_y Grid coordinates of the cell (0, 0)
+   * @return One bit per voxel of the z level
+   */
+  uint64_t getBrickMask(const uint64_t & key, const int & origin_x, const int & origin_y) const;
+
+  /**
+   * @brief Number of z levels of a brick which are inside the grid
+   * @param key Key of the brick
+   */
+  unsigned int getBrickLevels(const uint64_t & key) const;
+
+  static inline unsigned int numBits(uint64_t n)
+  {
+    return __builtin_popcountll(n);
+  }
+
+  /**
+   * @brief Recounts the known and marked voxels of a brick
+   * @param brick Brick to count
+   * @param marked_count Number of marked voxels
+   * @return Number of known voxels
+   */
+  static inline unsigned int countKnown(const Brick & brick, unsigned int & marked_count)
+  {
+    unsigned int known_count = 0;
+    marked_count = 0;
+    for (unsigned int i = 0; i != 8; i++) {
+      known_count += numBits(brick.known[i]);
+      marked_count += numBits(brick.marked[i]);
+    }
+    return known_count;
+  }
+
+  /**
+   * @brief Brick origin in grid coordinates
+   */
+  static inline void brickOrigin(const uint64_t & key, int & x, int & y, unsigned int & z)
+  {
+    // sign extend the 24 bit coordinates
+    x = static_cast<int32_t>(static_cast<uint32_t>(key >> 40) << 8) >> 5;
+    y = static_cast<int32_t>(static_cast<uint32_t>((key >> 16) & 0xFFFFFF) << 8) >> 5;
+    z = static_cast<unsigned int>(key & 0xFFFF) << 3;
+  }
+
+  inline int sign(int i)
+  {
+    return i > 0 ? 1 : -1;
+  }
+
+  unsigned int size_x_, size_y_, size_z_;
+  // grid coordinates of the cell (0, 0)
+  int origin_x_, origin_y_;
+  std::unordered_map<uint64_t, uint32_t> brick_table_;
+  std::vector<Brick> bricks_;
+  std::vector<uint32_t> free_bricks_;
+  std::vector<uint16_t> known_counts_;
+  std::vector<uint16_t> marked_counts_;
+  uint64_t cached_key_;
+  uint32_t cached_brick_;
+
+  class MarkVoxel
+  {
+public:
+    explicit MarkVoxel(SparseVoxelGrid * grid)
+    : grid_(grid) {}
+    inline void operator()(unsigned int x, unsigned int y, unsigned int z)
+    {
+      grid_->setVoxel<true>(x, y, z);
+    }
+
+private:
+    SparseVoxelGrid * grid_;
+  };
+
+  class ClearVoxel
+  {
+public:
+    explicit ClearVoxel(SparseVoxelGrid * grid)
+    : grid_(grid) {}
+    inline void operator()(unsigned int x, unsigned int y, unsigned int z)
+    {
+      grid_->setVoxel<false>(x, y, z);
+    }
+
+private:
+    SparseVoxelGrid * grid_;
+  };
+
+  class ClearVoxelInMap
+  {
+public:
+    ClearVoxelInMap(
+      SparseVoxelGrid * grid, unsigned char * costmap,
+      unsigned int unknown_clear_threshold, unsigned int marked_clear_threshold,
+      unsigned char free_cost, unsigned char unknown_cost)
+    : grid_(grid), costmap_(costmap),
+      unknown_clear_threshold_(unknown_clear_threshold),
+      marked_clear_threshold_(marked_clear_threshold),
+      free_cost_(free_cost), unknown_cost_(unknown_cost)
+    {
+    }
+
+    inline void operator()(unsigned int x, unsigned int y, unsigned int z)
+    {
+      grid_->setVoxel<false>(x, y, z);
+
+      const unsigned int index = y * grid_->size_x_ + x;
+      if (grid_->marked_counts_[index] <= marked_clear_threshold_) {
+        if (grid_->size_z_ - grid_->known_counts_[index] <= unknown_clear_threshold_) {
+          costmap_[index] = free_cost_;
+        } else {
+          costmap_[index] = unknown_cost_;
+        }
+      }
+    }
+
+private:
+    SparseVoxelGrid * grid_;
+    unsigned char * costmap_;
+    unsigned int unknown_clear_threshold_;
+    unsigned int marked_clear_threshold_;
+    unsigned char free_cost_;
+    unsigned char unknown_cost_;
+  };
+};
+
+}  // namespace nav2_voxel_grid
+
+#endif  // NAV2_VOXEL_GRID__SPARSE_VOXEL_GRID_HPP_
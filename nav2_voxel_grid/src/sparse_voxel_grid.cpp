@@ -0,0 +1,356 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <assert.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "nav2_voxel_grid/sparse_voxel_grid.hpp"
+
+namespace nav2_voxel_grid
+{
+
+SparseVoxelGrid::SparseVoxelGrid(unsigned int size_x, unsigned int size_y, unsigned int size_z)
+: size_x_(0), size_y_(0), size_z_(0), origin_x_(0), origin_y_(0),
+  cached_key_(0), cached_brick_(NO_BRICK)
+{
+  resize(size_x, size_y, size_z);
+}
+
+void SparseVoxelGrid::resize(unsigned int size_x, unsigned int size_y, unsigned int size_z)
+{
+  size_x_ = size_x;
+  size_y_ = size_y;
+  size_z_ = std::min(size_z, static_cast<unsigned int>(std::numeric_limits<uint16_t>::max()));
+  known_counts_.resize(size_x_ * size_y_);
+  marked_counts_.resize(size_x_ * size_y_);
+  reset();
+}
+
+void SparseVoxelGrid::reset()
+{
+  brick_table_.clear();
+  bricks_.clear();
+  free_bricks_.clear();
+  std::fill(known_counts_.begin(), known_counts_.end(), 0);
+  std::fill(marked_counts_.begin(), marked_counts_.end(), 0);
+  origin_x_ = 0;
+  origin_y_ = 0;
+  cached_brick_ = NO_BRICK;
+}
+
+void SparseVoxelGrid::updateOrigin(int cell_ox, int cell_oy)
+{
+  if (cell_ox == 0 && cell_oy == 0) {
+    return;
+  }
+  releaseCachedBrick();
+
+  // shift the column counts, the columns entering the window have no known voxels
+  const int size_x = size_x_;
+  const int size_y = size_y_;
+  std::vector<uint16_t> known_counts(known_counts_.size(), 0);
+  std::vector<uint16_t> marked_counts(marked_counts_.size(), 0);
+  const int lower_x = std::max(-cell_ox, 0);
+  const int upper_x = std::min(size_x - cell_ox, size_x);
+  for (int y = std::max(-cell_oy, 0); y < std::min(size_y - cell_oy, size_y); ++y) {
+    if (lower_x >= upper_x) {
+      break;
+    }
+    const unsigned int index = y * size_x + lower_x;
+    const unsigned int old_index = (y + cell_oy) * size_x + lower_x + cell_ox;
+    std::copy_n(&known_counts_[old_index], upper_x - lower_x, &known_counts[index]);
+    std::copy_n(&marked_counts_[old_index], upper_x - lower_x, &marked_counts[index]);
+  }
+  known_counts_.swap(known_counts);
+  marked_counts_.swap(marked_counts);
+
+  const int old_origin_x = origin_x_;
+  const int old_origin_y = origin_y_;
+  origin_x_ += cell_ox;
+  origin_y_ += cell_oy;
+
+  // drop the voxels which left the window
+  for (auto it = brick_table_.begin(); it != brick_table_.end(); ) {
+    const uint64_t mask = getBrickMask(it->first, origin_x_, origin_y_);
+    if (mask == 0) {
+      if (it->second != FREE_BRICK) {
+        releaseBrick(it->second);
+      }
+      it = brick_table_.erase(it);
+      continue;
+    }
+
+    if (it->second == FREE_BRICK) {
+      // voxels entering the window are unknown, so the brick is only free where both overlap
+      const uint64_t old_mask = getBrickMask(it->first, old_origin_x, old_origin_y);
+      if (mask != old_mask) {
+        const uint32_t brick = allocateBrick(false, it->first);
+        const uint64_t known = mask & old_mask;
+        const unsigned int z_levels = getBrickLevels(it->first);
+        for (unsigned int z = 0; z != z_levels; z++) {
+          bricks_[brick].known[z] = known;
+        }
+        bricks_[brick].known_count = numBits(known) * z_levels;
+        it->second = brick;
+      }
+    } else {
+      Brick & brick = bricks_[it->second];
+      for (unsigned int z = 0; z != 8; z++) {
+        brick.known[z] &= mask;
+        brick.marked[z] &= mask;
+      }
+      brick.known_count = countKnown(brick, brick.marked_count);
+      if (brick.known_count == 0) {
+        releaseBrick(it->second);
+        it = brick_table_.erase(it);
+        continue;
+      }
+    }
+    ++it;
+  }
+}
+
+void SparseVoxelGrid::clearVoxelColumn(unsigned int index)
+{
+  assert(index < size_x_ * size_y_);
+  const unsigned int x = index % size_x_;
+  const unsigned int y = index / size_x_;
+  for (unsigned int z = 0; z < size_z_; ++z) {
+    setVoxel<false>(x, y, z);
+  }
+  releaseCachedBrick();
+}
+
+void SparseVoxelGrid::markVoxelLine(
+  double x0, double y0, double z0, double x1, double y1, double z1,
+  unsigned int max_length)
+{
+  if (x0 >= size_x_ || y0 >= size_y_ || z0 >= size_z_ || x1 >= size_x_ || y1 >= size_y_ ||
+    z1 >= size_z_)
+  {
+    return;
+  }
+
+  MarkVoxel mv(this);
+  raytraceLine(mv, x0, y0, z0, x1, y1, z1, max_length);
+}
+
+void SparseVoxelGrid::clearVoxelLine(
+  double x0, double y0, double z0, double x1, double y1, double z1,
+  unsigned int max_length, unsigned int min_length)
+{
+  if (x0 >= size_x_ || y0 >= size_y_ || z0 >= size_z_ || x1 >= size_x_ || y1 >= size_y_ ||
+    z1 >= size_z_)
+  {
+    return;
+  }
+
+  ClearVoxel cv(this);
+  raytraceLine(cv, x0, y0, z0, x1, y1, z1, max_length, min_length);
+}
+
+void SparseVoxelGrid::clearVoxelLineInMap(
+  double x0, double y0, double z0, double x1, double y1, double z1, unsigned char * map_2d,
+  unsigned int unknown_threshold, unsigned int mark_threshold, unsigned char free_cost,
+  unsigned char unknown_cost, unsigned int max_length, unsigned int min_length)
+{
+  if (map_2d == NULL) {
+    clearVoxelLine(x0, y0, z0, x1, y1, z1, max_length, min_length);
+    return;
+  }
+
+  if (x0 >= size_x_ || y0 >= size_y_ || z0 >= size_z_ || x1 >= size_x_ || y1 >= size_y_ ||
+    z1 >= size_z_)
+  {
+    return;
+  }
+
+  ClearVoxelInMap cvm(this, map_2d, unknown_threshold, mark_threshold, free_cost, unknown_cost);
+  raytraceLine(cvm, x0, y0, z0, x1, y1, z1, max_length, min_length);
+}
+
+VoxelStatus SparseVoxelGrid::getVoxel(unsigned int x, unsigned int y, unsigned int z) const
+{
+  if (x >= size_x_ || y >= size_y_ || z >= size_z_) {
+    return UNKNOWN;
+  }
+
+  const int gx = static_cast<int>(x) + origin_x_;
+  const int gy = static_cast<int>(y) + origin_y_;
+  auto it = brick_table_.find(brickKey(gx, gy, z));
+  if (it == brick_table_.end()) {
+    return UNKNOWN;
+  }
+  if (it->second == FREE_BRICK) {
+    return FREE;
+  }
+
+  const Brick & brick = bricks_[it->second];
+  const uint64_t bit = voxelBit(gx, gy);
+  if (brick.marked[z & 7] & bit) {
+    return MARKED;
+  }
+  return (brick.known[z & 7] & bit) ? FREE : UNKNOWN;
+}
+
+VoxelStatus SparseVoxelGrid::getVoxelColumn(
+  unsigned int x, unsigned int y,
+  unsigned int unknown_threshold, unsigned int marked_threshold) const
+{
+  if (x >= size_x_ || y >= size_y_) {
+    return UNKNOWN;
+  }
+
+  const unsigned int index = y * size_x_ + x;
+  if (marked_counts_[index] > marked_threshold) {
+    return MARKED;
+  }
+  if (size_z_ - known_counts_[index] > unknown_threshold) {
+    return UNKNOWN;
+  }
+  return FREE;
+}
+
+void SparseVoxelGrid::getDenseData(uint32_t * data) const
+{
+  // unknown: 01, free: 00, marked: 11 in the low and high 16 bits
+  std::fill_n(data, size_x_ * size_y_, ~((uint32_t)0) >> 16);
+  const unsigned int dense_size_z = std::min(size_z_, 16u);
+
+  for (const auto & entry : brick_table_) {
+    int bx, by;
+    unsigned int bz;
+    brickOrigin(entry.first, bx, by, bz);
+    if (bz >= dense_size_z) {
+      continue;
+    }
+    const uint64_t mask = getBrickMask(entry.first, origin_x_, origin_y_);
+    const unsigned int z_end = std::min(bz + 8, dense_size_z);
+    for (unsigned int bit = 0; bit != 64; bit++) {
+      if (!(mask & (uint64_t(1) << bit))) {
+        continue;
+      }
+      const unsigned int x = bx + (bit & 7) - origin_x_;
+      const unsigned int y = by + (bit >> 3) - origin_y_;
+      uint32_t & col = data[y * size_x_ + x];
+      for (unsigned int z = bz; z != z_end; z++) {
+        if (entry.second == FREE_BRICK) {
+          col &= ~(uint32_t(1) << z);
+          continue;
+        }
+        const Brick & brick = bricks_[entry.second];
+        if (brick.marked[z & 7] & (uint64_t(1) << bit)) {
+          col |= (uint32_t(1) << z << 16) | (uint32_t(1) << z);
+        } else if (brick.known[z & 7] & (uint64_t(1) << bit)) {
+          col &= ~(uint32_t(1) << z);
+        }
+      }
+    }
+  }
+}
+
+uint32_t SparseVoxelGrid::getBrick(const uint64_t & key, const bool & mark)
+{
+  auto it = brick_table_.find(key);
+  if (it == brick_table_.end()) {
+    const uint32_t brick = allocateBrick(false, key);
+    brick_table_.emplace(key, brick);
+    return brick;
+  }
+  if (it->second == FREE_BRICK && mark) {
+    it->second = allocateBrick(true, key);
+  }
+  return it->second;
+}
+
+void SparseVoxelGrid::releaseCachedBrick()
+{
+  if (cached_brick_ < NO_BRICK && bricks_[cached_brick_].marked_count == 0) {
+    const unsigned int num_voxels =
+      numBits(getBrickMask(cached_key_, origin_x_, origin_y_)) *
+      getBrickLevels(cached_key_);
+    if (bricks_[cached_brick_].known_count == num_voxels) {
+      releaseBrick(cached_brick_);
+      brick_table_[cached_key_] = FREE_BRICK;
+    }
+  }
+  cached_brick_ = NO_BRICK;
+}
+
+uint32_t SparseVoxelGrid::allocateBrick(const bool & all_free, const uint64_t & key)
+{
+  uint32_t brick;
+  if (free_bricks_.empty()) {
+    brick = static_cast<uint32_t>(bricks_.size());
+    bricks_.emplace_back();
+  } else {
+    brick = free_bricks_.back();
+    free_bricks_.pop_back();
+  }
+
+  Brick & new_brick = bricks_[brick];
+  std::fill_n(new_brick.known, 8, 0);
+  std::fill_n(new_brick.marked, 8, 0);
+  new_brick.known_count = 0;
+  new_brick.marked_count = 0;
+  if (all_free) {
+    const uint64_t mask = getBrickMask(key, origin_x_, origin_y_);
+    const unsigned int z_levels = getBrickLevels(key);
+    std::fill_n(new_brick.known, z_levels, mask);
+    new_brick.known_count = numBits(mask) * z_levels;
+  }
+  return brick;
+}
+
+void SparseVoxelGrid::releaseBrick(const uint32_t & brick)
+{
+  free_bricks_.push_back(brick);
+}
+
+uint64_t SparseVoxelGrid::getBrickMask(
+  const uint64_t & key, const int & origin_x, const int & origin_y) const
+{
+  int bx, by;
+  unsigned int bz;
+  brickOrigin(key, bx, by, bz);
+
+  uint64_t row = 0;
+  for (int i = 0; i != 8; i++) {
+    const int x = bx + i - origin_x;
+    if (x >= 0 && x < static_cast<int>(size_x_)) {
+      row |= uint64_t(1) << i;
+    }
+  }
+
+  uint64_t mask = 0;
+  for (int j = 0; j != 8; j++) {
+    const int y = by + j - origin_y;
+    if (y >= 0 && y < static_cast<int>(size_y_)) {
+      mask |= row << (j << 3);
+    }
+  }
+  return mask;
+}
+
+unsigned int SparseVoxelGrid::getBrickLevels(const uint64_t & key) const
+{
+  int bx, by;
+  unsigned int bz;
+  brickOrigin(key, bx, by, bz);
+  return std::min(size_z_ - bz, 8u);
+}
+
+}  // namespace nav2_voxel_grid
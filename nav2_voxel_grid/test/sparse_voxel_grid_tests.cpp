@@ -0,0 +1,150 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "nav2_voxel_grid/sparse_voxel_grid.hpp"
+#include "nav2_voxel_grid/voxel_grid.hpp"
+
+using nav2_voxel_grid::SparseVoxelGrid;
+using nav2_voxel_grid::VoxelGrid;
+
+TEST(sparse_voxel_grid, matchesDenseGrid)
+{
+  const unsigned int size_x = 60, size_y = 45, size_z = 10;
+  VoxelGrid dense(size_x, size_y, size_z);
+  SparseVoxelGrid sparse(size_x, size_y, size_z);
+  std::vector<unsigned char> dense_map(size_x * size_y, 100);
+  std::vector<unsigned char> sparse_map(size_x * size_y, 100);
+  // the dense grid counts the unused bits of its columns as unknown
+  const unsigned int unknown_threshold = 3;
+  const unsigned int dense_unknown_threshold = unknown_threshold + 16 - size_z;
+
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> x_dist(0.0, size_x - 0.01);
+  std::uniform_real_distribution<double> y_dist(0.0, size_y - 0.01);
+  std::uniform_real_distribution<double> z_dist(0.0, size_z - 0.01);
+  for (unsigned int i = 0; i != 2000; i++) {
+    const double x = x_dist(gen), y = y_dist(gen), z = z_dist(gen);
+    if (i % 3 == 0) {
+      EXPECT_EQ(dense.markVoxelInMap(x, y, z, 1), sparse.markVoxelInMap(x, y, z, 1));
+    } else {
+      dense.clearVoxelLineInMap(
+        size_x / 2, size_y / 2, 1.5, x, y, z, dense_map.data(), dense_unknown_threshold, 0,
+        0, 255, 40, 2);
+      sparse.clearVoxelLineInMap(
+        size_x / 2, size_y / 2, 1.5, x, y, z, sparse_map.data(), unknown_threshold, 0,
+        0, 255, 40, 2);
+    }
+  }
+
+  EXPECT_EQ(dense_map, sparse_map);
+  std::vector<uint32_t> dense_data(size_x * size_y);
+  sparse.getDenseData(dense_data.data());
+  for (unsigned int y = 0; y != size_y; y++) {
+    for (unsigned int x = 0; x != size_x; x++) {
+      ASSERT_EQ(dense.getData()[y * size_x + x], dense_data[y * size_x + x]);
+      ASSERT_EQ(
+        dense.getVoxelColumn(x, y, dense_unknown_threshold, 1),
+        sparse.getVoxelColumn(x, y, unknown_threshold, 1));
+      for (unsigned int z = 0; z != size_z; z++) {
+        ASSERT_EQ(dense.getVoxel(x, y, z), sparse.getVoxel(x, y, z));
+      }
+    }
+  }
+}
+
+TEST(sparse_voxel_grid, manyLevels)
+{
+  // 4 m of height at 5 cm, beyond the 16 levels of the dense grid
+  SparseVoxelGrid grid(20, 20, 80);
+  EXPECT_EQ(grid.sizeZ(), 80u);
+  EXPECT_EQ(grid.getVoxelColumn(5, 5, 79), nav2_voxel_grid::UNKNOWN);
+  EXPECT_EQ(grid.getVoxelColumn(5, 5, 80), nav2_voxel_grid::FREE);
+
+  EXPECT_TRUE(grid.markVoxelInMap(5, 5, 75, 0));
+  EXPECT_EQ(grid.getVoxel(5, 5, 75), nav2_voxel_grid::MARKED);
+  EXPECT_EQ(grid.getVoxelColumn(5, 5, 80), nav2_voxel_grid::MARKED);
+
+  // a vertical ray clears the whole column but the marked voxel it ends on
+  grid.clearVoxelLine(5.5, 5.5, 0.5, 5.5, 5.5, 79.5);
+  EXPECT_EQ(grid.getVoxel(5, 5, 75), nav2_voxel_grid::FREE);
+  EXPECT_EQ(grid.getVoxel(5, 5, 79), nav2_voxel_grid::FREE);
+  EXPECT_EQ(grid.getVoxelColumn(5, 5), nav2_voxel_grid::FREE);
+  EXPECT_EQ(grid.getVoxel(5, 6, 40), nav2_voxel_grid::UNKNOWN);
+
+  grid.markVoxelLine(0.5, 0.5, 70.5, 19.5, 19.5, 70.5);
+  for (unsigned int i = 0; i != 20; i++) {
+    EXPECT_EQ(grid.getVoxel(i, i, 70), nav2_voxel_grid::MARKED);
+  }
+}
+
+TEST(sparse_voxel_grid, freeSpaceCollapses)
+{
+  SparseVoxelGrid grid(64, 64, 16);
+  // clear every column of the grid
+  for (unsigned int i = 0; i != 64 * 64; i++) {
+    grid.clearVoxelColumn(i);
+  }
+  EXPECT_EQ(grid.getNumBricks(), 0u);
+  EXPECT_EQ(grid.getVoxel(10, 20, 12), nav2_voxel_grid::FREE);
+  EXPECT_EQ(grid.getVoxelColumn(10, 20), nav2_voxel_grid::FREE);
+
+  // marking only expands the brick it falls in, clearing it back collapses it again
+  grid.markVoxel(10, 20, 12);
+  EXPECT_EQ(grid.getNumBricks(), 1u);
+  EXPECT_EQ(grid.getVoxel(10, 20, 12), nav2_voxel_grid::MARKED);
+  EXPECT_EQ(grid.getVoxel(11, 20, 12), nav2_voxel_grid::FREE);
+  grid.clearVoxel(10, 20, 12);
+  EXPECT_EQ(grid.getNumBricks(), 0u);
+
+  grid.reset();
+  EXPECT_EQ(grid.getVoxel(10, 20, 12), nav2_voxel_grid::UNKNOWN);
+}
+
+TEST(sparse_voxel_grid, updateOrigin)
+{
+  SparseVoxelGrid grid(30, 20, 12);
+  for (unsigned int i = 0; i != 30 * 20; i++) {
+    grid.clearVoxelColumn(i);
+  }
+  grid.markVoxel(12, 9, 3);
+  grid.markVoxel(2, 2, 3);
+
+  // move the window by 5 cells in x and -3 in y
+  grid.updateOrigin(5, -3);
+  EXPECT_EQ(grid.getVoxel(7, 12, 3), nav2_voxel_grid::MARKED);
+  EXPECT_EQ(grid.getVoxelColumn(7, 12), nav2_voxel_grid::MARKED);
+  EXPECT_EQ(grid.getVoxel(8, 12, 3), nav2_voxel_grid::FREE);
+  EXPECT_EQ(grid.getVoxelColumn(8, 12), nav2_voxel_grid::FREE);
+
+  // cells entering the window are unknown, the marked voxel which left it is dropped
+  for (unsigned int x = 0; x != 30; x++) {
+    for (unsigned int y = 0; y != 20; y++) {
+      const bool entered = x >= 25 || y < 3;
+      EXPECT_EQ(grid.getVoxel(x, y, 3) == nav2_voxel_grid::UNKNOWN, entered);
+      EXPECT_EQ(grid.getVoxelColumn(x, y) == nav2_voxel_grid::UNKNOWN, entered);
+    }
+  }
+
+  // and moving back, the area which left the window is unknown too
+  grid.updateOrigin(-5, 3);
+  EXPECT_EQ(grid.getVoxel(12, 9, 3), nav2_voxel_grid::MARKED);
+  EXPECT_EQ(grid.getVoxel(2, 2, 3), nav2_voxel_grid::UNKNOWN);
+  EXPECT_EQ(grid.getVoxel(10, 18, 3), nav2_voxel_grid::UNKNOWN);
+  EXPECT_EQ(grid.getVoxel(29, 5, 3), nav2_voxel_grid::FREE);
+  EXPECT_EQ(grid.getVoxelColumn(29, 5), nav2_voxel_grid::FREE);
+}
@@ -22,10 +22,14 @@
 #define _LIBCPP_NO_EXPERIMENTAL_DEPRECATION_WARNING_FILESYSTEM
 
 
+#include <condition_variable>
+#include <deque>
 #include <filesystem>
 #include <mutex>
 #include <string>
 #include <exception>
+#include <thread>
+#include <utility>
 
 #include "rclcpp/rclcpp.hpp"
 #include "rclcpp_components/register_node_macro.hpp"
@@ -44,6 +48,21 @@ namespace nav2_waypoint_follower
 class PhotoAtWaypoint : public nav2_core::WaypointTaskExecutor
 {
 public:
+  /**
+   * @brief Counters of the photos handled by the background writer
+   */
+  struct WriterStatistics
+  {
+    // photos encoded and written to disk
+    size_t saved{0};
+    // photos which could not be encoded or written
+    size_t failed{0};
+    // photos dropped because the queue was full
+    size_t dropped{0};
+    // photos which had to wait for room in the queue before being queued
+    size_t waited{0};
+  };
+
   /**
   * @brief Construct a new Photo At Waypoint object
   *
@@ -51,7 +70,7 @@ public:
   PhotoAtWaypoint();
 
   /**
-   * @brief Destroy the Photo At Waypoint object
+   * @brief Destroy the Photo At Waypoint object, writing the photos still queued
    *
    */
   ~PhotoAtWaypoint();
@@ -68,16 +87,29 @@ public:
 
 
   /**
-   * @brief Override this to define the body of your task that you would like to execute once the robot arrived to waypoint
+   * @brief Captures the latest frame and queues it to be encoded and written to disk
+   * by the background writer, so that the robot does not wait for it
+   *
+   * When the queue is full, it waits for the writer to make room, or with drop_when_full
+   * drops the oldest queued photo instead, which is logged and counted in the statistics
    *
    * @param curr_pose current pose of the robot
    * @param curr_waypoint_index current waypoint, that robot just arrived
-   * @return true if task execution was successful
-   * @return false if task execution failed
+   * @return true if the photo was queued, even if an older one was dropped for it
+   * @return false if there was no frame to capture or the writer stopped before
+   * there was room for the photo
    */
   bool processAtWaypoint(
     const geometry_msgs::msg::PoseStamped & curr_pose, const int & curr_waypoint_index);
 
+  /**
+   * @brief The photo is taken from the latest frame when the task starts, so the robot
+   * does not need to stay at the waypoint while it is saved
+   *
+   * @return false
+   */
+  bool isBlocking() const override {return false;}
+
   /**
    * @brief
    *
@@ -93,7 +125,26 @@ public:
    */
   static void deepCopyMsg2Mat(const sensor_msgs::msg::Image::SharedPtr & msg, cv::Mat & mat);
 
+  /**
+   * @brief Get the counters of the background writer, which are also logged when it stops
+   *
+   * @return Writer statistics
+   */
+  WriterStatistics getWriterStatistics();
+
 protected:
+  /**
+   * @brief Background writer loop, encoding and writing the queued photos until stopped
+   *
+   */
+  void writerLoop();
+
+  /**
+   * @brief Stops the background writer once the queued photos are written
+   *
+   */
+  void stopWriter();
+
   // to ensure safety when accessing global var curr_frame_
   std::mutex global_mutex_;
   // the taken photos will be saved under this directory
@@ -110,6 +161,20 @@ protected:
   rclcpp::Logger logger_{rclcpp::get_logger("nav2_waypoint_follower")};
   // ros susbcriber to get camera image
   rclcpp::Subscription<sensor_msgs::msg::Image>::SharedPtr camera_image_subscriber_;
+
+  // photos captured and waiting to be written, with their file path
+  std::deque<std::pair<sensor_msgs::msg::Image::SharedPtr, std::filesystem::path>> queue_;
+  // maximum number of photos waiting to be written
+  size_t queue_size_;
+  // whether to drop the oldest photo rather than wait when the queue is full
+  bool drop_when_full_;
+  // to ensure safety when accessing the queue, statistics and stop flag
+  std::mutex queue_mutex_;
+  std::condition_variable queue_cv_;
+  bool stop_writer_{false};
+  WriterStatistics statistics_;
+  // thread encoding and writing the queued photos
+  std::thread writer_thread_;
 };
 }  // namespace nav2_waypoint_follower
 
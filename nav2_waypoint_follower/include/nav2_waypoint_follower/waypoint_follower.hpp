@@ -15,6 +15,7 @@
 #ifndef NAV2_WAYPOINT_FOLLOWER__WAYPOINT_FOLLOWER_HPP_
 #define NAV2_WAYPOINT_FOLLOWER__WAYPOINT_FOLLOWER_HPP_
 
+#include <future>
 #include <memory>
 #include <string>
 #include <vector>
@@ -26,6 +27,7 @@
 #include "geographic_msgs/msg/geo_pose.hpp"
 #include "nav2_util/lifecycle_node.hpp"
 #include "nav2_msgs/action/navigate_to_pose.hpp"
+#include "nav2_msgs/action/compute_path_to_pose.hpp"
 #include "nav2_msgs/action/follow_waypoints.hpp"
 #include "nav2_msgs/msg/missed_waypoint.hpp"
 #include "nav_msgs/msg/path.hpp"
@@ -70,6 +72,8 @@ public:
   using ClientT = nav2_msgs::action::NavigateToPose;
   using ActionServer = nav2_util::SimpleActionServer<ActionT>;
   using ActionClient = rclcpp_action::Client<ClientT>;
+  using PlannerT = nav2_msgs::action::ComputePathToPose;
+  using PlannerClient = rclcpp_action::Client<PlannerT>;
 
   // Shorten the types for GPS waypoint following
   using ActionTGPS = nav2_msgs::action::FollowGPSWaypoints;
@@ -161,6 +165,35 @@ protected:
    */
   void goalResponseCallback(const rclcpp_action::ClientGoalHandle<ClientT>::SharedPtr & goal);
 
+  /**
+   * @brief Requests the path of the next leg from the planner server, to be planned
+   * while the robot drives the current leg and handed to the navigator with its goal
+   * @param start Waypoint the next leg starts from
+   * @param goal Waypoint the next leg ends at
+   * @param goal_index Index of the goal waypoint
+   */
+  void preplanLeg(
+    const geometry_msgs::msg::PoseStamped & start,
+    const geometry_msgs::msg::PoseStamped & goal,
+    const int goal_index);
+
+  /**
+   * @brief Planner action client result callback, keeping the path planned ahead of time
+   * @param result Result of planner server updated asynchronously
+   */
+  void preplanResultCallback(
+    const rclcpp_action::ClientGoalHandle<PlannerT>::WrappedResult & result);
+
+  /**
+   * @brief Gets the result of the task running while the robot drives to the next waypoint,
+   * and reports it as a missed waypoint if it failed
+   * @param missed_waypoints Missed waypoints of the action result
+   * @param wait Whether to wait for the task to complete
+   * @return false if the task completed and failed, true otherwise
+   */
+  bool finishPendingTask(
+    std::vector<nav2_msgs::msg::MissedWaypoint> & missed_waypoints, bool wait);
+
   /**
    * @brief given some gps_poses, converts them to map frame using robot_localization's service `fromLL`.
    *        Constructs a vector of stamped poses in map frame and returns them.
@@ -213,6 +246,21 @@ protected:
   int loop_rate_;
   GoalStatus current_goal_status_;
 
+  // Planning of the next leg while driving the current one
+  bool preplan_next_leg_;
+  std::string preplan_planner_id_;
+  std::string preplanned_behavior_tree_;
+  PlannerClient::SharedPtr compute_path_client_;
+  std::shared_future<rclcpp_action::ClientGoalHandle<PlannerT>::SharedPtr> preplan_goal_handle_;
+  int preplan_index_{-1};
+  nav_msgs::msg::Path preplanned_path_;
+
+  // Non-blocking task running while the robot drives to the next waypoint
+  bool parallel_task_execution_;
+  std::future<bool> pending_task_;
+  int pending_task_index_{-1};
+  geometry_msgs::msg::PoseStamped pending_task_pose_;
+
   // Task Execution At Waypoint Plugin
   pluginlib::ClassLoader<nav2_core::WaypointTaskExecutor>
   waypoint_task_executor_loader_;
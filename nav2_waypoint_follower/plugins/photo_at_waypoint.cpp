@@ -14,8 +14,10 @@
 
 #include "nav2_waypoint_follower/plugins/photo_at_waypoint.hpp"
 
+#include <algorithm>
 #include <string>
 #include <memory>
+#include <utility>
 
 #include "pluginlib/class_list_macros.hpp"
 
@@ -29,6 +31,7 @@ PhotoAtWaypoint::PhotoAtWaypoint()
 
 PhotoAtWaypoint::~PhotoAtWaypoint()
 {
+  stopWriter();
 }
 
 void PhotoAtWaypoint::initialize(
@@ -51,12 +54,22 @@ void PhotoAtWaypoint::initialize(
   nav2_util::declare_parameter_if_not_declared(
     node, plugin_name + ".image_format",
     rclcpp::ParameterValue("png"));
+  nav2_util::declare_parameter_if_not_declared(
+    node, plugin_name + ".queue_size",
+    rclcpp::ParameterValue(4));
+  nav2_util::declare_parameter_if_not_declared(
+    node, plugin_name + ".drop_when_full",
+    rclcpp::ParameterValue(false));
 
   std::string save_dir_as_string;
   node->get_parameter(plugin_name + ".enabled", is_enabled_);
   node->get_parameter(plugin_name + ".image_topic", image_topic_);
   node->get_parameter(plugin_name + ".save_dir", save_dir_as_string);
   node->get_parameter(plugin_name + ".image_format", image_format_);
+  int queue_size;
+  node->get_parameter(plugin_name + ".queue_size", queue_size);
+  queue_size_ = static_cast<size_t>(std::max(queue_size, 1));
+  node->get_parameter(plugin_name + ".drop_when_full", drop_when_full_);
 
   // get inputted save directory and make sure it exists, if not log and create  it
   save_dir_ = save_dir_as_string;
@@ -95,6 +108,9 @@ void PhotoAtWaypoint::initialize(
     camera_image_subscriber_ = node->create_subscription<sensor_msgs::msg::Image>(
       image_topic_, rclcpp::SystemDefaultsQoS(),
       std::bind(&PhotoAtWaypoint::imageCallback, this, std::placeholders::_1));
+    if (!writer_thread_.joinable()) {
+      writer_thread_ = std::thread(&PhotoAtWaypoint::writerLoop, this);
+    }
   }
 }
 
@@ -108,30 +124,52 @@ bool PhotoAtWaypoint::processAtWaypoint(
     );
     return true;
   }
-  try {
-    // construct the full path to image filename
-    std::filesystem::path file_name = std::to_string(
-      curr_waypoint_index) + "_" +
-      std::to_string(curr_pose.header.stamp.sec) + "." + image_format_;
-    std::filesystem::path full_path_image_path = save_dir_ / file_name;
+  // construct the full path to image filename
+  std::filesystem::path file_name = std::to_string(
+    curr_waypoint_index) + "_" +
+    std::to_string(curr_pose.header.stamp.sec) + "." + image_format_;
+  std::filesystem::path full_path_image_path = save_dir_ / file_name;
 
-    // save the taken photo at this waypoint to given directory
+  // take the latest frame, it is only encoded and written by the writer thread
+  sensor_msgs::msg::Image::SharedPtr frame;
+  {
     std::lock_guard<std::mutex> guard(global_mutex_);
-    cv::Mat curr_frame_mat;
-    deepCopyMsg2Mat(curr_frame_msg_, curr_frame_mat);
-    cv::imwrite(full_path_image_path.c_str(), curr_frame_mat);
-    RCLCPP_INFO(
-      logger_,
-      "Photo has been taken sucessfully at waypoint %i", curr_waypoint_index);
-  } catch (const std::exception & e) {
+    frame = curr_frame_msg_;
+  }
+  if (!frame || frame->data.empty()) {
     RCLCPP_ERROR(
       logger_,
-      "Couldn't take photo at waypoint %i! Caught exception: %s \n"
+      "Couldn't take photo at waypoint %i! No image received yet. \n"
       "Make sure that the image topic named: %s is valid and active!",
-      curr_waypoint_index,
-      e.what(), image_topic_.c_str());
+      curr_waypoint_index, image_topic_.c_str());
     return false;
   }
+
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  if (queue_.size() >= queue_size_) {
+    if (drop_when_full_) {
+      statistics_.dropped++;
+      RCLCPP_WARN(
+        logger_, "Photo queue is full, dropping photo %s (%zu dropped so far)",
+        queue_.front().second.c_str(), statistics_.dropped);
+      queue_.pop_front();
+    } else {
+      // Backpressure: wait for the writer to make room
+      statistics_.waited++;
+      queue_cv_.wait(lock, [this]() {return queue_.size() < queue_size_ || stop_writer_;});
+      if (stop_writer_) {
+        statistics_.dropped++;
+        RCLCPP_WARN(
+          logger_, "Photo writer stopped, dropping photo %s", full_path_image_path.c_str());
+        return false;
+      }
+    }
+  }
+  queue_.emplace_back(std::move(frame), std::move(full_path_image_path));
+  queue_cv_.notify_all();
+  RCLCPP_INFO(
+    logger_,
+    "Photo has been taken sucessfully at waypoint %i", curr_waypoint_index);
   return true;
 }
 
@@ -146,11 +184,75 @@ void PhotoAtWaypoint::deepCopyMsg2Mat(
   cv::Mat & mat)
 {
   cv_bridge::CvImageConstPtr cv_bridge_ptr = cv_bridge::toCvShare(msg, msg->encoding);
-  cv::Mat frame = cv_bridge_ptr->image;
+  const cv::Mat & frame = cv_bridge_ptr->image;
+  // convert into the output rather than in place, not to modify the shared message
   if (msg->encoding == "rgb8") {
-    cv::cvtColor(frame, frame, cv::COLOR_RGB2BGR);
+    cv::cvtColor(frame, mat, cv::COLOR_RGB2BGR);
+  } else {
+    frame.copyTo(mat);
+  }
+}
+
+PhotoAtWaypoint::WriterStatistics PhotoAtWaypoint::getWriterStatistics()
+{
+  std::lock_guard<std::mutex> lock(queue_mutex_);
+  return statistics_;
+}
+
+void PhotoAtWaypoint::writerLoop()
+{
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  while (true) {
+    queue_cv_.wait(lock, [this]() {return stop_writer_ || !queue_.empty();});
+    if (queue_.empty()) {
+      // Stopped and all photos written
+      return;
+    }
+
+    auto photo = std::move(queue_.front());
+    queue_.pop_front();
+    queue_cv_.notify_all();
+    lock.unlock();
+
+    bool saved = false;
+    try {
+      cv::Mat curr_frame_mat;
+      deepCopyMsg2Mat(photo.first, curr_frame_mat);
+      saved = cv::imwrite(photo.second.c_str(), curr_frame_mat);
+    } catch (const std::exception & e) {
+      RCLCPP_ERROR(
+        logger_, "Couldn't write photo %s! Caught exception: %s",
+        photo.second.c_str(), e.what());
+    }
+    if (!saved) {
+      RCLCPP_ERROR(logger_, "Failed to save photo %s", photo.second.c_str());
+    }
+
+    lock.lock();
+    if (saved) {
+      statistics_.saved++;
+    } else {
+      statistics_.failed++;
+    }
+  }
+}
+
+void PhotoAtWaypoint::stopWriter()
+{
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    stop_writer_ = true;
   }
-  frame.copyTo(mat);
+  queue_cv_.notify_all();
+  if (!writer_thread_.joinable()) {
+    return;
+  }
+  writer_thread_.join();
+
+  const auto statistics = getWriterStatistics();
+  RCLCPP_INFO(
+    logger_, "Photo writer stopped: %zu saved, %zu failed, %zu dropped, %zu waited for room",
+    statistics.saved, statistics.failed, statistics.dropped, statistics.waited);
 }
 
 }      // namespace nav2_waypoint_follower
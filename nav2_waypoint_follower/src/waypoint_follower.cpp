@@ -21,6 +21,8 @@
 #include <utility>
 #include <vector>
 
+#include "ament_index_cpp/get_package_share_directory.hpp"
+
 namespace nav2_waypoint_follower
 {
 
@@ -41,6 +43,11 @@ WaypointFollower::WaypointFollower(const rclcpp::NodeOptions & options)
 
   declare_parameter("global_frame_id", "map");
 
+  declare_parameter("preplan_next_leg", false);
+  declare_parameter("preplan_planner_id", std::string(""));
+  declare_parameter("preplanned_behavior_tree", std::string(""));
+  declare_parameter("parallel_task_execution", false);
+
   nav2_util::declare_parameter_if_not_declared(
     this, std::string("waypoint_task_executor_plugin"),
     rclcpp::ParameterValue(std::string("wait_at_waypoint")));
@@ -65,6 +72,22 @@ WaypointFollower::on_configure(const rclcpp_lifecycle::State & /*state*/)
   waypoint_task_executor_id_ = get_parameter("waypoint_task_executor_plugin").as_string();
   global_frame_id_ = get_parameter("global_frame_id").as_string();
   global_frame_id_ = nav2_util::strip_leading_slash(global_frame_id_);
+  preplan_next_leg_ = get_parameter("preplan_next_leg").as_bool();
+  preplan_planner_id_ = get_parameter("preplan_planner_id").as_string();
+  preplanned_behavior_tree_ = get_parameter("preplanned_behavior_tree").as_string();
+  if (preplanned_behavior_tree_.empty()) {
+    // Follow the path planned ahead, rather than replanning it at once with the default tree
+    try {
+      preplanned_behavior_tree_ =
+        ament_index_cpp::get_package_share_directory("nav2_bt_navigator") +
+        "/behavior_trees/navigate_w_initial_path_and_replanning_only_if_path_becomes_invalid.xml";
+    } catch (const std::exception & e) {
+      RCLCPP_WARN(
+        get_logger(), "No behavior tree to follow pre-planned paths with, the navigator's "
+        "default one will replan them: %s", e.what());
+    }
+  }
+  parallel_task_execution_ = get_parameter("parallel_task_execution").as_bool();
 
   callback_group_ = create_callback_group(
     rclcpp::CallbackGroupType::MutuallyExclusive,
@@ -78,6 +101,13 @@ WaypointFollower::on_configure(const rclcpp_lifecycle::State & /*state*/)
     get_node_waitables_interface(),
     "navigate_to_pose", callback_group_);
 
+  compute_path_client_ = rclcpp_action::create_client<PlannerT>(
+    get_node_base_interface(),
+    get_node_graph_interface(),
+    get_node_logging_interface(),
+    get_node_waitables_interface(),
+    "compute_path_to_pose", callback_group_);
+
   double action_server_result_timeout;
   get_parameter("action_server_result_timeout", action_server_result_timeout);
   rcl_action_server_options_t server_options = rcl_action_server_get_default_options();
@@ -169,6 +199,7 @@ WaypointFollower::on_cleanup(const rclcpp_lifecycle::State & /*state*/)
 
   xyz_action_server_.reset();
   nav_to_pose_client_.reset();
+  compute_path_client_.reset();
   gps_action_server_.reset();
   from_ll_to_map_client_.reset();
 
@@ -247,6 +278,7 @@ void WaypointFollower::followWaypointsHandler(
       callback_group_executor_.spin_until_future_complete(cancel_future);
       // for result callback processing
       callback_group_executor_.spin_some();
+      finishPendingTask(result->missed_waypoints, true);
       action_server->terminate_all();
       return;
     }
@@ -256,6 +288,8 @@ void WaypointFollower::followWaypointsHandler(
       RCLCPP_INFO(get_logger(), "Preempting the goal pose.");
       goal = action_server->accept_pending_goal();
       poses = getLatestGoalPoses<T>(action_server);
+      finishPendingTask(result->missed_waypoints, true);
+      preplan_index_ = -1;
       if (poses.empty()) {
         RCLCPP_ERROR(
           get_logger(),
@@ -268,6 +302,20 @@ void WaypointFollower::followWaypointsHandler(
       new_goal = true;
     }
 
+    // Check the task running while moving to the current waypoint
+    if (!finishPendingTask(result->missed_waypoints, false) && stop_on_failure_) {
+      RCLCPP_WARN(
+        get_logger(), "Failed to execute task at waypoint %i "
+        " stop on failure is enabled."
+        " Terminating action.", pending_task_index_);
+      auto cancel_future = nav_to_pose_client_->async_cancel_all_goals();
+      callback_group_executor_.spin_until_future_complete(cancel_future);
+      callback_group_executor_.spin_some();
+      action_server->terminate_current(result);
+      current_goal_status_.error_code = 0;
+      return;
+    }
+
     // Check if we need to send a new goal
     if (new_goal) {
       new_goal = false;
@@ -275,6 +323,15 @@ void WaypointFollower::followWaypointsHandler(
       client_goal.pose = poses[goal_index];
       client_goal.pose.header.stamp = this->now();
 
+      // Hand the path planned while driving the previous leg to the navigator
+      if (preplan_index_ == static_cast<int>(goal_index) && !preplanned_path_.poses.empty()) {
+        RCLCPP_DEBUG(get_logger(), "Using the path planned ahead to waypoint %i", goal_index);
+        client_goal.path = preplanned_path_;
+        client_goal.planner_id = preplan_planner_id_;
+        client_goal.behavior_tree = preplanned_behavior_tree_;
+      }
+      preplan_index_ = -1;
+
       auto send_goal_options = rclcpp_action::Client<ClientT>::SendGoalOptions();
       send_goal_options.result_callback = std::bind(
         &WaypointFollower::resultCallback, this,
@@ -286,6 +343,15 @@ void WaypointFollower::followWaypointsHandler(
       future_goal_handle_ =
         nav_to_pose_client_->async_send_goal(client_goal, send_goal_options);
       current_goal_status_.status = ActionStatus::PROCESSING;
+
+      // Plan the next leg while driving this one
+      if (preplan_next_leg_) {
+        if (goal_index + 1 < poses.size()) {
+          preplanLeg(poses[goal_index], poses[goal_index + 1], goal_index + 1);
+        } else if (current_loop_no < no_of_loops) {
+          preplanLeg(poses[goal_index], poses[0], 0);
+        }
+      }
     }
 
     feedback->current_waypoint = goal_index;
@@ -301,11 +367,15 @@ void WaypointFollower::followWaypointsHandler(
       missedWaypoint.error_code = current_goal_status_.error_code;
       result->missed_waypoints.push_back(missedWaypoint);
 
+      // The next leg no longer starts from this waypoint
+      preplan_index_ = -1;
+
       if (stop_on_failure_) {
         RCLCPP_WARN(
           get_logger(), "Failed to process waypoint %i in waypoint "
           "list and stop on failure is enabled."
           " Terminating action.", goal_index);
+        finishPendingTask(result->missed_waypoints, true);
         action_server->terminate_current(result);
         current_goal_status_.error_code = 0;
         return;
@@ -314,6 +384,31 @@ void WaypointFollower::followWaypointsHandler(
           get_logger(), "Failed to process waypoint %i,"
           " moving to next.", goal_index);
       }
+    } else if (
+      current_goal_status_.status == ActionStatus::SUCCEEDED &&
+      parallel_task_execution_ && !waypoint_task_executor_->isBlocking())
+    {
+      // Only one task runs at a time, so wait for the previous one to complete
+      if (!finishPendingTask(result->missed_waypoints, true) && stop_on_failure_) {
+        RCLCPP_WARN(
+          get_logger(), "Failed to execute task at waypoint %i "
+          " stop on failure is enabled."
+          " Terminating action.", pending_task_index_);
+        action_server->terminate_current(result);
+        current_goal_status_.error_code = 0;
+        return;
+      }
+
+      RCLCPP_INFO(
+        get_logger(), "Succeeded processing waypoint %i, executing waypoint task "
+        "while moving to next", goal_index);
+      pending_task_index_ = goal_index;
+      pending_task_pose_ = poses[goal_index];
+      pending_task_ = std::async(
+        std::launch::async, [this]() {
+          return waypoint_task_executor_->processAtWaypoint(
+            pending_task_pose_, pending_task_index_);
+        });
     } else if (current_goal_status_.status == ActionStatus::SUCCEEDED) {
       RCLCPP_INFO(
         get_logger(), "Succeeded processing waypoint %i, processing waypoint task execution",
@@ -339,6 +434,7 @@ void WaypointFollower::followWaypointsHandler(
           " stop on failure is enabled."
           " Terminating action.", goal_index);
 
+        finishPendingTask(result->missed_waypoints, true);
         action_server->terminate_current(result);
         current_goal_status_.error_code = 0;
         return;
@@ -355,6 +451,15 @@ void WaypointFollower::followWaypointsHandler(
       new_goal = true;
       if (goal_index >= poses.size()) {
         if (current_loop_no == no_of_loops) {
+          if (!finishPendingTask(result->missed_waypoints, true) && stop_on_failure_) {
+            RCLCPP_WARN(
+              get_logger(), "Failed to execute task at waypoint %i "
+              " stop on failure is enabled."
+              " Terminating action.", pending_task_index_);
+            action_server->terminate_current(result);
+            current_goal_status_.error_code = 0;
+            return;
+          }
           RCLCPP_INFO(
             get_logger(), "Completed all %zu waypoints requested.",
             poses.size());
@@ -441,6 +546,90 @@ WaypointFollower::goalResponseCallback(
   }
 }
 
+void
+WaypointFollower::preplanLeg(
+  const geometry_msgs::msg::PoseStamped & start,
+  const geometry_msgs::msg::PoseStamped & goal,
+  const int goal_index)
+{
+  preplan_index_ = -1;
+  preplanned_path_.poses.clear();
+  preplan_goal_handle_ = {};
+
+  if (!compute_path_client_->action_server_is_ready()) {
+    RCLCPP_DEBUG(
+      get_logger(), "Planner server not available, waypoint %i will be planned by the navigator",
+      goal_index);
+    return;
+  }
+
+  PlannerT::Goal planner_goal;
+  planner_goal.start = start;
+  planner_goal.start.header.stamp = this->now();
+  planner_goal.goal = goal;
+  planner_goal.goal.header.stamp = this->now();
+  planner_goal.use_start = true;
+  planner_goal.planner_id = preplan_planner_id_;
+
+  auto send_goal_options = rclcpp_action::Client<PlannerT>::SendGoalOptions();
+  send_goal_options.result_callback = std::bind(
+    &WaypointFollower::preplanResultCallback, this,
+    std::placeholders::_1);
+
+  preplan_index_ = goal_index;
+  preplan_goal_handle_ = compute_path_client_->async_send_goal(planner_goal, send_goal_options);
+}
+
+void
+WaypointFollower::preplanResultCallback(
+  const rclcpp_action::ClientGoalHandle<PlannerT>::WrappedResult & result)
+{
+  if (!preplan_goal_handle_.valid() || !preplan_goal_handle_.get() ||
+    result.goal_id != preplan_goal_handle_.get()->get_goal_id())
+  {
+    // Result of a leg no longer planned ahead
+    return;
+  }
+
+  if (result.code != rclcpp_action::ResultCode::SUCCEEDED) {
+    RCLCPP_DEBUG(
+      get_logger(), "Failed to plan ahead to waypoint %i, it will be planned by the navigator",
+      preplan_index_);
+    preplan_index_ = -1;
+    return;
+  }
+
+  preplanned_path_ = result.result->path;
+}
+
+bool
+WaypointFollower::finishPendingTask(
+  std::vector<nav2_msgs::msg::MissedWaypoint> & missed_waypoints, bool wait)
+{
+  if (!pending_task_.valid()) {
+    return true;
+  }
+
+  if (!wait && pending_task_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+    return true;
+  }
+
+  bool is_task_executed = pending_task_.get();
+  RCLCPP_INFO(
+    get_logger(), "Task execution at waypoint %i %s", pending_task_index_,
+    is_task_executed ? "succeeded" : "failed!");
+
+  if (!is_task_executed) {
+    nav2_msgs::msg::MissedWaypoint missedWaypoint;
+    missedWaypoint.index = pending_task_index_;
+    missedWaypoint.goal = pending_task_pose_;
+    missedWaypoint.error_code =
+      nav2_msgs::action::FollowWaypoints::Result::TASK_EXECUTOR_FAILED;
+    missed_waypoints.push_back(missedWaypoint);
+  }
+  return is_task_executed;
+}
+
 rcl_interfaces::msg::SetParametersResult
 WaypointFollower::dynamicParametersCallback(std::vector<rclcpp::Parameter> parameters)
 {
@@ -458,6 +647,10 @@ WaypointFollower::dynamicParametersCallback(std::vector<rclcpp::Parameter> param
     } else if (type == ParameterType::PARAMETER_BOOL) {
       if (name == "stop_on_failure") {
         stop_on_failure_ = parameter.as_bool();
+      } else if (name == "preplan_next_leg") {
+        preplan_next_leg_ = parameter.as_bool();
+      } else if (name == "parallel_task_execution") {
+        parallel_task_execution_ = parameter.as_bool();
       }
     }
   }
@@ -13,7 +13,10 @@
 // limitations under the License. Reserved.
 
 #include <math.h>
+#include <atomic>
 #include <condition_variable>
+#include <filesystem>
+#include <future>
 #include <memory>
 #include <string>
 #include <vector>
@@ -36,6 +39,69 @@ public:
 };
 RclCppFixture g_rclcppfixture;
 
+// Starts the background writer only once released, so that photos pile up in the queue
+class PhotoAtWaypointShim : public nav2_waypoint_follower::PhotoAtWaypoint
+{
+public:
+  PhotoAtWaypointShim()
+  {
+    auto released = release_.get_future().share();
+    writer_thread_ = std::thread(
+      [this, released]() {
+        released.wait();
+        writerLoop();
+      });
+  }
+
+  ~PhotoAtWaypointShim()
+  {
+    releaseWriter();
+    stopWriter();
+  }
+
+  void releaseWriter()
+  {
+    if (!released_) {
+      released_ = true;
+      release_.set_value();
+    }
+  }
+
+  void setFrame(const sensor_msgs::msg::Image::SharedPtr & msg)
+  {
+    imageCallback(msg);
+  }
+
+  size_t getQueueSize()
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    return queue_.size();
+  }
+
+protected:
+  std::promise<void> release_;
+  bool released_{false};
+};
+
+sensor_msgs::msg::Image::SharedPtr makeImage()
+{
+  auto msg = std::make_shared<sensor_msgs::msg::Image>();
+  msg->encoding = "rgb8";
+  msg->height = 24;
+  msg->width = 32;
+  msg->step = 96;
+  msg->data.resize(msg->height * msg->step, 128);
+  return msg;
+}
+
+bool waitForSaved(nav2_waypoint_follower::PhotoAtWaypoint & paw, size_t saved)
+{
+  for (int i = 0; i < 500 && paw.getWriterStatistics().saved < saved; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return paw.getWriterStatistics().saved == saved;
+}
+
 TEST(WaypointFollowerTest, WaitAtWaypoint)
 {
   auto node = std::make_shared<rclcpp_lifecycle::LifecycleNode>("testWaypointNode");
@@ -63,6 +129,9 @@ TEST(WaypointFollowerTest, WaitAtWaypoint)
 
   // plugin is not enabled, should exit
   EXPECT_TRUE(waw->processAtWaypoint(pose, 0));
+
+  // robot waits at the waypoint
+  EXPECT_TRUE(waw->isBlocking());
 }
 
 TEST(WaypointFollowerTest, InputAtWaypoint)
@@ -155,10 +224,92 @@ TEST(WaypointFollowerTest, PhotoAtWaypoint)
   EXPECT_TRUE(paw->processAtWaypoint(pose, 0));
   t1.join();
 
+  // photo is written in the background
+  auto start_time = node->now();
+  while (paw->getWriterStatistics().saved == 0 && (node->now() - start_time).seconds() < 5.0) {
+    rclcpp::Rate(100).sleep();
+  }
+  auto statistics = paw->getWriterStatistics();
+  EXPECT_EQ(statistics.saved, 1u);
+  EXPECT_EQ(statistics.failed, 0u);
+  EXPECT_EQ(statistics.dropped, 0u);
+  EXPECT_TRUE(std::filesystem::exists("/tmp/waypoint_images/0_0.png"));
+
   paw.reset(new nav2_waypoint_follower::PhotoAtWaypoint);
   node->set_parameter(rclcpp::Parameter("PAW.enabled", false));
   paw->initialize(node, std::string("PAW"));
 
   // plugin is not enabled, should exit
   EXPECT_TRUE(paw->processAtWaypoint(pose, 0));
+
+  // photo can be saved while the robot drives to the next waypoint
+  EXPECT_FALSE(paw->isBlocking());
+}
+
+TEST(WaypointFollowerTest, PhotoAtWaypointDropWhenFull)
+{
+  const std::filesystem::path save_dir = "/tmp/waypoint_images_drop_when_full";
+  std::filesystem::remove_all(save_dir);
+  auto node = std::make_shared<rclcpp_lifecycle::LifecycleNode>("testPhotoDropNode");
+  node->declare_parameter("PAW.save_dir", save_dir.string());
+  node->declare_parameter("PAW.queue_size", 2);
+  node->declare_parameter("PAW.drop_when_full", true);
+
+  auto paw = std::make_unique<PhotoAtWaypointShim>();
+  paw->initialize(node, std::string("PAW"));
+  paw->setFrame(makeImage());
+
+  // The oldest photo makes room for the new one, which is still reported as taken
+  geometry_msgs::msg::PoseStamped pose;
+  EXPECT_TRUE(paw->processAtWaypoint(pose, 0));
+  EXPECT_TRUE(paw->processAtWaypoint(pose, 1));
+  EXPECT_TRUE(paw->processAtWaypoint(pose, 2));
+  EXPECT_EQ(paw->getQueueSize(), 2u);
+  auto statistics = paw->getWriterStatistics();
+  EXPECT_EQ(statistics.dropped, 1u);
+  EXPECT_EQ(statistics.waited, 0u);
+
+  paw->releaseWriter();
+  EXPECT_TRUE(waitForSaved(*paw, 2u));
+  EXPECT_FALSE(std::filesystem::exists(save_dir / "0_0.png"));
+  EXPECT_TRUE(std::filesystem::exists(save_dir / "1_0.png"));
+  EXPECT_TRUE(std::filesystem::exists(save_dir / "2_0.png"));
+}
+
+TEST(WaypointFollowerTest, PhotoAtWaypointBackpressure)
+{
+  const std::filesystem::path save_dir = "/tmp/waypoint_images_backpressure";
+  std::filesystem::remove_all(save_dir);
+  auto node = std::make_shared<rclcpp_lifecycle::LifecycleNode>("testPhotoBackpressureNode");
+  node->declare_parameter("PAW.save_dir", save_dir.string());
+  node->declare_parameter("PAW.queue_size", 1);
+
+  auto paw = std::make_unique<PhotoAtWaypointShim>();
+  paw->initialize(node, std::string("PAW"));
+  paw->setFrame(makeImage());
+
+  geometry_msgs::msg::PoseStamped pose;
+  EXPECT_TRUE(paw->processAtWaypoint(pose, 0));
+
+  // The next photo waits for the writer to make room rather than dropping one
+  std::atomic<bool> done{false};
+  bool queued = false;
+  std::thread waiting(
+    [&]() {
+      queued = paw->processAtWaypoint(pose, 1);
+      done = true;
+    });
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  EXPECT_FALSE(done);
+  EXPECT_EQ(paw->getWriterStatistics().waited, 1u);
+
+  paw->releaseWriter();
+  waiting.join();
+  EXPECT_TRUE(queued);
+  EXPECT_TRUE(waitForSaved(*paw, 2u));
+  auto statistics = paw->getWriterStatistics();
+  EXPECT_EQ(statistics.dropped, 0u);
+  EXPECT_EQ(statistics.failed, 0u);
+  EXPECT_TRUE(std::filesystem::exists(save_dir / "0_0.png"));
+  EXPECT_TRUE(std::filesystem::exists(save_dir / "1_0.png"));
 }
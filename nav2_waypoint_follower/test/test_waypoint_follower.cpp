@@ -0,0 +1,301 @@
+// Copyright (c) 2024 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp_action/rclcpp_action.hpp"
+#include "nav2_msgs/action/compute_path_to_pose.hpp"
+#include "nav2_msgs/action/follow_waypoints.hpp"
+#include "nav2_msgs/action/navigate_to_pose.hpp"
+#include "nav2_waypoint_follower/waypoint_follower.hpp"
+
+using namespace std::chrono_literals;  // NOLINT
+using NavigateToPose = nav2_msgs::action::NavigateToPose;
+using ComputePathToPose = nav2_msgs::action::ComputePathToPose;
+using FollowWaypoints = nav2_msgs::action::FollowWaypoints;
+
+class RclCppFixture
+{
+public:
+  RclCppFixture() {rclcpp::init(0, nullptr);}
+  ~RclCppFixture() {rclcpp::shutdown();}
+};
+RclCppFixture g_rclcppfixture;
+
+class WPShim : public nav2_waypoint_follower::WaypointFollower
+{
+public:
+  explicit WPShim(const rclcpp::NodeOptions & options)
+  : nav2_waypoint_follower::WaypointFollower(options)
+  {
+  }
+
+  void configure()
+  {
+    rclcpp_lifecycle::State state;
+    this->on_configure(state);
+  }
+
+  void activate()
+  {
+    rclcpp_lifecycle::State state;
+    this->on_activate(state);
+  }
+
+  void deactivate()
+  {
+    rclcpp_lifecycle::State state;
+    this->on_deactivate(state);
+  }
+
+  void cleanup()
+  {
+    rclcpp_lifecycle::State state;
+    this->on_cleanup(state);
+  }
+};
+
+// Navigator reaching each goal after a while, and planner planning straight lines at once
+class FakeServers : public rclcpp::Node
+{
+public:
+  FakeServers()
+  : rclcpp::Node("fake_servers")
+  {
+    navigate_server_ = rclcpp_action::create_server<NavigateToPose>(
+      this, "navigate_to_pose",
+      [](const rclcpp_action::GoalUUID &, std::shared_ptr<const NavigateToPose::Goal>) {
+        return rclcpp_action::GoalResponse::ACCEPT_AND_EXECUTE;
+      },
+      [](const std::shared_ptr<rclcpp_action::ServerGoalHandle<NavigateToPose>>) {
+        return rclcpp_action::CancelResponse::ACCEPT;
+      },
+      [this](const std::shared_ptr<rclcpp_action::ServerGoalHandle<NavigateToPose>> handle) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        navigate_goals_.push_back(*handle->get_goal());
+        threads_.emplace_back(
+          [handle]() {
+            std::this_thread::sleep_for(300ms);
+            handle->succeed(std::make_shared<NavigateToPose::Result>());
+          });
+      });
+
+    planner_server_ = rclcpp_action::create_server<ComputePathToPose>(
+      this, "compute_path_to_pose",
+      [](const rclcpp_action::GoalUUID &, std::shared_ptr<const ComputePathToPose::Goal>) {
+        return rclcpp_action::GoalResponse::ACCEPT_AND_EXECUTE;
+      },
+      [](const std::shared_ptr<rclcpp_action::ServerGoalHandle<ComputePathToPose>>) {
+        return rclcpp_action::CancelResponse::ACCEPT;
+      },
+      [this](const std::shared_ptr<rclcpp_action::ServerGoalHandle<ComputePathToPose>> handle) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        planner_goals_.push_back(*handle->get_goal());
+        threads_.emplace_back(
+          [handle]() {
+            auto result = std::make_shared<ComputePathToPose::Result>();
+            result->path.poses = {handle->get_goal()->start, handle->get_goal()->goal};
+            handle->succeed(result);
+          });
+      });
+  }
+
+  ~FakeServers()
+  {
+    for (auto & thread : threads_) {
+      thread.join();
+    }
+  }
+
+  std::vector<NavigateToPose::Goal> getNavigateGoals()
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return navigate_goals_;
+  }
+
+  std::vector<ComputePathToPose::Goal> getPlannerGoals()
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return planner_goals_;
+  }
+
+protected:
+  rclcpp_action::Server<NavigateToPose>::SharedPtr navigate_server_;
+  rclcpp_action::Server<ComputePathToPose>::SharedPtr planner_server_;
+  std::mutex mutex_;
+  std::vector<NavigateToPose::Goal> navigate_goals_;
+  std::vector<ComputePathToPose::Goal> planner_goals_;
+  std::vector<std::thread> threads_;
+};
+
+class WaypointFollowerTest : public ::testing::Test
+{
+protected:
+  void start(const std::vector<rclcpp::Parameter> & parameters)
+  {
+    follower_ = std::make_shared<WPShim>(rclcpp::NodeOptions().parameter_overrides(parameters));
+    servers_ = std::make_shared<FakeServers>();
+    client_node_ = std::make_shared<rclcpp::Node>("follow_waypoints_client");
+    client_ = rclcpp_action::create_client<FollowWaypoints>(client_node_, "follow_waypoints");
+
+    follower_->configure();
+    follower_->activate();
+    executor_.add_node(follower_->get_node_base_interface());
+    executor_.add_node(servers_);
+    executor_.add_node(client_node_);
+    spin_thread_ = std::thread([this]() {executor_.spin();});
+    ASSERT_TRUE(client_->wait_for_action_server(5s));
+  }
+
+  void TearDown() override
+  {
+    executor_.cancel();
+    if (spin_thread_.joinable()) {
+      spin_thread_.join();
+    }
+    if (follower_) {
+      follower_->deactivate();
+      follower_->cleanup();
+    }
+  }
+
+  rclcpp_action::ClientGoalHandle<FollowWaypoints>::WrappedResult followWaypoints(
+    const unsigned int num_waypoints)
+  {
+    FollowWaypoints::Goal goal;
+    for (unsigned int i = 0; i != num_waypoints; i++) {
+      geometry_msgs::msg::PoseStamped pose;
+      pose.header.frame_id = "map";
+      pose.pose.position.x = 1.0 + i;
+      pose.pose.orientation.w = 1.0;
+      goal.poses.push_back(pose);
+    }
+
+    auto goal_handle_future = client_->async_send_goal(goal);
+    EXPECT_EQ(goal_handle_future.wait_for(5s), std::future_status::ready);
+    auto goal_handle = goal_handle_future.get();
+    EXPECT_TRUE(goal_handle);
+    auto result_future = client_->async_get_result(goal_handle);
+    EXPECT_EQ(result_future.wait_for(20s), std::future_status::ready);
+    return result_future.get();
+  }
+
+  std::shared_ptr<WPShim> follower_;
+  std::shared_ptr<FakeServers> servers_;
+  rclcpp::Node::SharedPtr client_node_;
+  rclcpp_action::Client<FollowWaypoints>::SharedPtr client_;
+  rclcpp::executors::SingleThreadedExecutor executor_;
+  std::thread spin_thread_;
+};
+
+TEST_F(WaypointFollowerTest, preplanNextLeg)
+{
+  start(
+    {rclcpp::Parameter("preplan_next_leg", true),
+      rclcpp::Parameter("preplan_planner_id", "Custom"),
+      rclcpp::Parameter("preplanned_behavior_tree", "preplanned.xml")});
+
+  auto result = followWaypoints(3);
+  EXPECT_EQ(result.code, rclcpp_action::ResultCode::SUCCEEDED);
+  EXPECT_TRUE(result.result->missed_waypoints.empty());
+
+  // Each leg after the first is planned from the previous waypoint while driving to it
+  auto planner_goals = servers_->getPlannerGoals();
+  ASSERT_EQ(planner_goals.size(), 2u);
+  for (unsigned int i = 0; i != planner_goals.size(); i++) {
+    EXPECT_TRUE(planner_goals[i].use_start);
+    EXPECT_EQ(planner_goals[i].planner_id, "Custom");
+    EXPECT_EQ(planner_goals[i].start.pose.position.x, 1.0 + i);
+    EXPECT_EQ(planner_goals[i].goal.pose.position.x, 2.0 + i);
+  }
+
+  // and handed to the navigator with its goal, the planner and the tree following it
+  auto navigate_goals = servers_->getNavigateGoals();
+  ASSERT_EQ(navigate_goals.size(), 3u);
+  EXPECT_TRUE(navigate_goals[0].path.poses.empty());
+  EXPECT_EQ(navigate_goals[0].behavior_tree, "");
+  for (unsigned int i = 1; i != navigate_goals.size(); i++) {
+    ASSERT_EQ(navigate_goals[i].path.poses.size(), 2u);
+    EXPECT_EQ(navigate_goals[i].path.poses[0].pose.position.x, 0.0 + i);
+    EXPECT_EQ(navigate_goals[i].path.poses[1].pose.position.x, 1.0 + i);
+    EXPECT_EQ(navigate_goals[i].planner_id, "Custom");
+    EXPECT_EQ(navigate_goals[i].behavior_tree, "preplanned.xml");
+  }
+}
+
+TEST_F(WaypointFollowerTest, noPreplanByDefault)
+{
+  start({});
+
+  auto result = followWaypoints(2);
+  EXPECT_EQ(result.code, rclcpp_action::ResultCode::SUCCEEDED);
+  EXPECT_TRUE(servers_->getPlannerGoals().empty());
+  for (const auto & goal : servers_->getNavigateGoals()) {
+    EXPECT_TRUE(goal.path.poses.empty());
+    EXPECT_EQ(goal.behavior_tree, "");
+  }
+}
+
+TEST_F(WaypointFollowerTest, parallelTaskFailures)
+{
+  // Without images, each photo fails once the robot already drives to the next waypoint
+  start(
+    {rclcpp::Parameter("parallel_task_execution", true),
+      rclcpp::Parameter("stop_on_failure", false),
+      rclcpp::Parameter("waypoint_task_executor_plugin", "photo_at_waypoint"),
+      rclcpp::Parameter("photo_at_waypoint.plugin", "nav2_waypoint_follower::PhotoAtWaypoint"),
+      rclcpp::Parameter("photo_at_waypoint.image_topic", "test_waypoint_follower_image"),
+      rclcpp::Parameter("photo_at_waypoint.save_dir", "/tmp/test_waypoint_follower")});
+
+  auto result = followWaypoints(3);
+  EXPECT_EQ(result.code, rclcpp_action::ResultCode::SUCCEEDED);
+  EXPECT_EQ(servers_->getNavigateGoals().size(), 3u);
+
+  // All reported, the last one waited for before completing
+  const auto & missed_waypoints = result.result->missed_waypoints;
+  ASSERT_EQ(missed_waypoints.size(), 3u);
+  for (unsigned int i = 0; i != missed_waypoints.size(); i++) {
+    EXPECT_EQ(missed_waypoints[i].index, i);
+    EXPECT_EQ(missed_waypoints[i].goal.pose.position.x, 1.0 + i);
+    EXPECT_EQ(missed_waypoints[i].error_code, FollowWaypoints::Result::TASK_EXECUTOR_FAILED);
+  }
+}
+
+TEST_F(WaypointFollowerTest, parallelTaskStopOnFailure)
+{
+  start(
+    {rclcpp::Parameter("parallel_task_execution", true),
+      rclcpp::Parameter("stop_on_failure", true),
+      rclcpp::Parameter("waypoint_task_executor_plugin", "photo_at_waypoint"),
+      rclcpp::Parameter("photo_at_waypoint.plugin", "nav2_waypoint_follower::PhotoAtWaypoint"),
+      rclcpp::Parameter("photo_at_waypoint.image_topic", "test_waypoint_follower_image"),
+      rclcpp::Parameter("photo_at_waypoint.save_dir", "/tmp/test_waypoint_follower")});
+
+  // The first photo fails while driving to the second waypoint, which is then canceled
+  auto result = followWaypoints(3);
+  EXPECT_EQ(result.code, rclcpp_action::ResultCode::ABORTED);
+  EXPECT_LT(servers_->getNavigateGoals().size(), 3u);
+  ASSERT_EQ(result.result->missed_waypoints.size(), 1u);
+  EXPECT_EQ(result.result->missed_waypoints[0].index, 0u);
+  EXPECT_EQ(
+    result.result->missed_waypoints[0].error_code,
+    FollowWaypoints::Result::TASK_EXECUTOR_FAILED);
+}